@@ -0,0 +1,77 @@
+# Ciclo completo de otimização guiada por perfil (PGO).
+#
+# Executado como script (cmake -P) pelo target pgo:
+#   1. DESTINO/base: build Release sem PGO (referência)
+#   2. DESTINO/pgo:  build instrumentado (PGO=GERAR) e execução de treino
+#   3. DESTINO/pgo:  recompilação com os perfis (PGO=USAR); o mesmo diretório
+#      é usado nas duas fases porque o GCC associa cada perfil ao caminho
+#      do arquivo objeto
+#   4. Avaliação dos dois executáveis com a mesma matriz e semente e
+#      relatório em DESTINO/relatorio_pgo.txt (analise_hash --comparar-csv)
+#
+# O treino não deve usar --isolamento: os processos filhos terminam com
+# _exit() e não gravam os contadores de perfil.
+#
+# Variáveis esperadas: ORIGEM, DESTINO, GERADOR, COMPILADOR, LTO, TREINO,
+# AVALIACAO
+
+separate_arguments(ARGUMENTOS_TREINO UNIX_COMMAND "${TREINO}")
+separate_arguments(ARGUMENTOS_AVALIACAO UNIX_COMMAND "${AVALIACAO}")
+set(PERFIS "${DESTINO}/perfil")
+
+# Executa um comando e interrompe o ciclo se ele falhar
+function(executar etapa diretorio)
+    message(STATUS "PGO: ${etapa}")
+    execute_process(COMMAND ${ARGN} WORKING_DIRECTORY "${diretorio}" RESULT_VARIABLE resultado)
+    if(NOT resultado EQUAL 0)
+        message(FATAL_ERROR "PGO: ${etapa} falhou (${resultado})")
+    endif()
+endfunction()
+
+# Configura e compila um diretório de build com o modo de PGO informado
+function(construir diretorio modo)
+    executar("configurando ${diretorio} (PGO=${modo}, LTO=${LTO})" "${DESTINO}"
+        "${CMAKE_COMMAND}" -S "${ORIGEM}" -B "${diretorio}" -G "${GERADOR}"
+        -DCMAKE_BUILD_TYPE=Release
+        "-DCMAKE_CXX_COMPILER=${COMPILADOR}"
+        -DLTO=${LTO}
+        -DPGO=${modo}
+        "-DPGO_DIRETORIO=${PERFIS}")
+    executar("compilando ${diretorio}" "${DESTINO}"
+        "${CMAKE_COMMAND}" --build "${diretorio}" --target analise_hash)
+endfunction()
+
+file(MAKE_DIRECTORY "${DESTINO}")
+file(REMOVE_RECURSE "${PERFIS}")
+
+construir("${DESTINO}/base" OFF)
+construir("${DESTINO}/pgo" GERAR)
+executar("treino: analise_hash ${TREINO}" "${DESTINO}/pgo" "${DESTINO}/pgo/analise_hash" ${ARGUMENTOS_TREINO})
+
+# Clang grava .profraw, que precisam ser combinados antes do uso
+file(GLOB PERFIS_CLANG "${PERFIS}/*.profraw")
+if(PERFIS_CLANG)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata REQUIRED)
+    executar("combinando perfis do Clang" "${PERFIS}"
+        "${LLVM_PROFDATA}" merge -output=analise_hash.profdata ${PERFIS_CLANG})
+endif()
+
+construir("${DESTINO}/pgo" USAR)
+
+executar("avaliação sem PGO" "${DESTINO}/base" "${DESTINO}/base/analise_hash" ${ARGUMENTOS_AVALIACAO})
+executar("avaliação com PGO" "${DESTINO}/pgo" "${DESTINO}/pgo/analise_hash" ${ARGUMENTOS_AVALIACAO})
+
+execute_process(
+    COMMAND "${DESTINO}/pgo/analise_hash"
+            "--comparar-csv=${DESTINO}/base/resultados_pgo.csv,${DESTINO}/pgo/resultados_pgo.csv"
+            "--rotulos=sem PGO,com PGO"
+    WORKING_DIRECTORY "${DESTINO}"
+    OUTPUT_VARIABLE RELATORIO
+    RESULT_VARIABLE resultado
+)
+if(NOT resultado EQUAL 0)
+    message(FATAL_ERROR "PGO: relatório falhou (${resultado})")
+endif()
+file(WRITE "${DESTINO}/relatorio_pgo.txt" "${RELATORIO}")
+message("${RELATORIO}")
+message(STATUS "PGO: relatório salvo em ${DESTINO}/relatorio_pgo.txt")
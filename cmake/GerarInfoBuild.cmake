@@ -0,0 +1,39 @@
+# Gera InfoBuild.hpp com a revisão git atual, o compilador e as flags do build.
+#
+# Executado como script (cmake -P) em toda compilação pelo target info_build.
+# configure_file só reescreve o arquivo quando o conteúdo muda, evitando
+# recompilações desnecessárias.
+#
+# Variáveis esperadas: ORIGEM, DESTINO, DIRETORIO_FONTE, GIT_EXECUTABLE,
+# COMPILADOR, TIPO_BUILD, FLAGS_BUILD
+
+set(ANALISE_HASH_REVISAO_GIT "desconhecida")
+set(ANALISE_HASH_COMPILADOR "${COMPILADOR}")
+set(ANALISE_HASH_TIPO_BUILD "${TIPO_BUILD}")
+set(ANALISE_HASH_FLAGS "${FLAGS_BUILD}")
+
+if(GIT_EXECUTABLE)
+    execute_process(
+        COMMAND "${GIT_EXECUTABLE}" rev-parse --short HEAD
+        WORKING_DIRECTORY "${DIRETORIO_FONTE}"
+        OUTPUT_VARIABLE REVISAO
+        RESULT_VARIABLE RESULTADO
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        ERROR_QUIET
+    )
+    if(RESULTADO EQUAL 0 AND REVISAO)
+        set(ANALISE_HASH_REVISAO_GIT "${REVISAO}")
+        execute_process(
+            COMMAND "${GIT_EXECUTABLE}" status --porcelain --untracked-files=no
+            WORKING_DIRECTORY "${DIRETORIO_FONTE}"
+            OUTPUT_VARIABLE ALTERACOES
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+        )
+        if(ALTERACOES)
+            set(ANALISE_HASH_REVISAO_GIT "${ANALISE_HASH_REVISAO_GIT}-sujo")
+        endif()
+    endif()
+endif()
+
+configure_file("${ORIGEM}" "${DESTINO}" @ONLY)
@@ -0,0 +1,93 @@
+/**
+ * @file BenchmarkCompartilhada.hpp
+ * @brief Leitores em processos separados: cópias privadas contra a TabelaCompartilhada
+ *
+ * Para cada número de processos leitores, mede a vazão de buscas em dois
+ * arranjos com as mesmas chaves:
+ * - privada: cada leitor constrói sua própria TabelaAberta (a memória das
+ *   tabelas cresce com o número de leitores)
+ * - compartilhada: o processo pai cria uma TabelaCompartilhada e a altera
+ *   continuamente (remove e reinsere chaves, publicando a cada lote)
+ *   enquanto os leitores a consultam por um mapeamento somente leitura
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Os leitores são filhos criados por fork(); cada um devolve o tempo das
+ * suas buscas por um pipe. Metade das buscas é de chaves inseridas e
+ * metade de chaves sorteadas (em geral ausentes).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Vazão das buscas de um arranjo com um número de leitores
+ */
+struct ResultadoCompartilhada {
+    bool compartilhada;         ///< false: cópias privadas da TabelaAberta
+    size_t leitores;            ///< Processos leitores simultâneos
+    size_t chaves;              ///< Chaves distintas na tabela
+    double mbTabelas;           ///< Memória das tabelas somada entre os processos
+    size_t buscasPorLeitor;     ///< Buscas cronometradas em cada leitor
+    double mBuscasPorSegundo;   ///< Vazão somada dos leitores, em milhões
+    double nsPorBusca;          ///< Média por busca entre os leitores
+    double mutacoesPorSegundo;  ///< Mutações do escritor durante as buscas (0 na privada)
+    size_t versoes;             ///< Publicações do escritor durante as buscas
+    size_t compactacoes;        ///< Compactações sob o seqlock durante as buscas
+};
+
+/**
+ * @brief Classe BenchmarkCompartilhada - Custo e vazão da tabela entre processos
+ */
+class BenchmarkCompartilhada {
+private:
+    size_t quantidade;                              ///< Chaves sorteadas
+    std::vector<size_t> leitores;                   ///< Números de leitores a medir
+    unsigned int seed;                              ///< Semente das chaves
+    std::vector<ResultadoCompartilhada> resultados; ///< Privada e compartilhada por número de leitores
+
+    void medir(const std::vector<int>& chaves, const std::vector<int>& consultas, size_t numLeitores,
+               bool compartilhada);
+
+public:
+    /// Buscas cronometradas em cada leitor
+    static constexpr size_t BUSCAS_POR_LEITOR = 4000000;
+    /// Mutações do escritor entre publicações
+    static constexpr size_t MUTACOES_POR_VERSAO = 1024;
+
+    /**
+     * @brief Construtor
+     * @param chaves Quantidade de chaves sorteadas
+     * @param numerosLeitores Números de processos leitores a comparar
+     * @param semente Semente das chaves e das consultas
+     * @throws std::invalid_argument se não houver chaves, leitores ou se
+     *         algum número de leitores for zero
+     */
+    BenchmarkCompartilhada(size_t chaves, const std::vector<size_t>& numerosLeitores, unsigned int semente);
+
+    /**
+     * @brief Executa os dois arranjos para cada número de leitores
+     * @throws std::runtime_error fora de sistemas POSIX ou se um leitor falhar
+     */
+    void executar();
+
+    /**
+     * @brief Imprime a tabela de resultados
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em CSV
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+};
@@ -0,0 +1,93 @@
+/**
+ * @file BenchmarkConjuntos.hpp
+ * @brief União, interseção e diferença: laço de buscar(), lote, paralelo e std::set_*
+ *
+ * Dois conjuntos de chaves distintas com metade das chaves em comum são
+ * carregados numa tabela de cada motor registrado (fator de carga 0,5). Para
+ * cada operação de OperacoesConjunto.hpp compara:
+ * - laço: enumera uma tabela e chama buscar() na outra chave a chave
+ * - lote: filtrarChaves com buscarLote (pré-busca), numa thread
+ * - paralelo: o mesmo, com as chaves divididas entre as threads
+ * - std::set_*: std::set_intersection, set_union e set_difference sobre os
+ *   mesmos conjuntos em vetores já ordenados
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Cada método é executado REPETICOES vezes e representado pelo menor tempo.
+ * A vazão conta as chaves dos dois conjuntos de entrada. O tempo de ordenar
+ * os vetores é informado à parte na linha do std::set_*.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Tempo de uma operação por um método
+ */
+struct ResultadoConjunto {
+    std::string motor;          ///< Motor das tabelas ("std" para std::set_*)
+    std::string operacao;       ///< intersecao, uniao ou diferenca
+    std::string metodo;         ///< laco, lote, paralelo ou std::set_*
+    size_t threads;             ///< Threads do método
+    size_t chavesEntrada;       ///< Chaves dos dois conjuntos
+    size_t chavesResultado;     ///< Chaves produzidas
+    double ms;                  ///< Menor tempo entre as repetições
+    double mChavesPorSegundo;   ///< Chaves de entrada por segundo, em milhões
+    double aceleracaoLaco;      ///< Tempo do laço do mesmo motor / ms (0 no std::set_*)
+    double msOrdenacao;         ///< Ordenação das entradas (só no std::set_*)
+};
+
+/**
+ * @brief Classe BenchmarkConjuntos - Operações de conjunto sobre os motores
+ */
+class BenchmarkConjuntos {
+private:
+    size_t quantidade;                          ///< Chaves de cada conjunto
+    size_t threads;                             ///< Threads do método paralelo (0 = núcleos)
+    unsigned int seed;                          ///< Semente das chaves
+    std::vector<ResultadoConjunto> resultados;  ///< Motor x operação x método
+
+    template<typename Tabela>
+    void medirMotor(const char* nome, const std::vector<int>& a, const std::vector<int>& b,
+                    const std::vector<size_t>& esperados);
+    void medirStd(const std::vector<int>& a, const std::vector<int>& b, std::vector<size_t>& esperados);
+
+public:
+    /// Execuções de cada método; vale a mais rápida
+    static constexpr size_t REPETICOES = 3;
+
+    /**
+     * @brief Construtor
+     * @param chaves Chaves de cada conjunto
+     * @param threadsParalelo Threads do método paralelo (0 = núcleos disponíveis)
+     * @param semente Semente das chaves
+     * @throws std::invalid_argument se chaves for zero
+     */
+    BenchmarkConjuntos(size_t chaves, size_t threadsParalelo, unsigned int semente);
+
+    /**
+     * @brief Mede as três operações em cada motor e com std::set_*
+     * @throws std::runtime_error se algum método divergir no tamanho do resultado
+     */
+    void executar();
+
+    /**
+     * @brief Imprime a tabela de resultados
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em CSV
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+};
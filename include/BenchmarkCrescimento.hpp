@@ -0,0 +1,99 @@
+/**
+ * @file BenchmarkCrescimento.hpp
+ * @brief Latência de cauda das inserções durante o crescimento da tabela
+ *
+ * Os demais cenários pré-dimensionam a tabela e medem o tempo médio, o que
+ * esconde o custo do rehash. Aqui a TabelaRedimensionavel começa vazia e
+ * recebe as chaves uma a uma até n, cronometrando cada inserção, em cada
+ * modo de rehash (parada total, incremental e segundo plano).
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Métricas por modo:
+ * - Pausa máxima e percentis p50, p99 e p99,9 da latência por inserção
+ * - Inserções acima de LIMIAR_PAUSA_NS
+ * - Vazão total, incluindo a conclusão da migração pendente ao fim
+ */
+
+#pragma once
+
+#include "TabelaRedimensionavel.hpp"
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Resultado de um modo de rehash
+ */
+struct ResultadoCrescimento {
+    TabelaRedimensionavel::Modo modo;  ///< Estratégia de rehash
+    size_t quantidadeChaves;           ///< Inserções realizadas
+    size_t tamanhoFinal;               ///< Posições da tabela ao fim
+    size_t redimensionamentos;         ///< Crescimentos ocorridos
+    double nsMedio;                    ///< Latência média por inserção
+    double nsP50;                      ///< Mediana da latência
+    double nsP99;                      ///< Percentil 99
+    double nsP999;                     ///< Percentil 99,9
+    double nsMaximo;                   ///< Maior pausa observada
+    size_t pausasLongas;               ///< Inserções acima de LIMIAR_PAUSA_NS
+    double tempoTotalMs;               ///< Inserções + finalização da migração
+    double mopsPorSegundo;             ///< Vazão total em milhões de inserções/s
+};
+
+/**
+ * @brief Classe BenchmarkCrescimento - Compara os modos de rehash pela cauda
+ *
+ * Cada inserção é cronometrada individualmente; o custo do relógio (dezenas
+ * de ns) entra em todos os modos igualmente e não afeta a comparação das
+ * pausas, que vão de centenas de µs a dezenas de ms.
+ */
+class BenchmarkCrescimento {
+private:
+    size_t quantidade;                              ///< Chaves inseridas por modo
+    unsigned int seed;                              ///< Semente das chaves
+    std::vector<ResultadoCrescimento> resultados;   ///< Um por modo
+
+    /**
+     * @brief Insere as chaves numa tabela nova e coleta as latências
+     * @param modo Estratégia de rehash
+     * @param chaves Chaves a inserir, em ordem
+     * @throws std::runtime_error se alguma chave não for encontrada depois
+     */
+    void medirModo(TabelaRedimensionavel::Modo modo, const std::vector<int>& chaves);
+
+public:
+    /// Latência a partir da qual uma inserção conta como pausa longa
+    static constexpr double LIMIAR_PAUSA_NS = 100000.0;
+
+    /**
+     * @brief Construtor
+     * @param chaves Quantidade de chaves inseridas por modo
+     * @param semente Semente das chaves geradas
+     * @throws std::invalid_argument se chaves for zero
+     */
+    BenchmarkCrescimento(size_t chaves, unsigned int semente);
+
+    /**
+     * @brief Mede os três modos com as mesmas chaves
+     */
+    void executar();
+
+    /**
+     * @brief Imprime a tabela de pausas e vazão por modo
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em arquivo CSV
+     * @param arquivo Caminho do arquivo de saída
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+};
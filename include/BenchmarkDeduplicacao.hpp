@@ -0,0 +1,103 @@
+/**
+ * @file BenchmarkDeduplicacao.hpp
+ * @brief Contagem de distintas em disco (DeduplicacaoExterna) contra o unordered_set em memória
+ *
+ * Conta as chaves distintas de um dataset de três formas:
+ * - unordered_set: CarregadorDados::analisarDataset(), que carrega o dataset
+ *   e insere todas as chaves num std::unordered_set (só executado quando a
+ *   estimativa de memória cabe em metade da RAM)
+ * - cada motor registrado: deduplicarArquivo() com o orçamento de memória
+ *   dado, particionando em disco quando o dataset não cabe nele
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Sem um dataset, gera um com as chaves sorteadas em [1, distintas],
+ * gravado em blocos (sem mantê-lo em memória) e apagado ao fim. Cada
+ * método é executado uma vez, e o pico de memória residente (VmHWM) é
+ * zerado antes de cada um (Linux; nos demais sistemas não é medido).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Tempo e memória de uma contagem de distintas
+ */
+struct MedicaoDeduplicacao {
+    std::string metodo;         ///< "unordered_set" ou o nome do motor
+    uint64_t chaves;            ///< Chaves do dataset
+    uint64_t unicas;            ///< Chaves distintas
+    size_t particoes;           ///< Partições deduplicadas (1 no unordered_set)
+    size_t niveis;              ///< Níveis de particionamento
+    double mbDerramados;        ///< Bytes gravados em derrames, em MiB
+    double msParticionamento;   ///< Leitura do dataset e derrames
+    double msDeduplicacao;      ///< Partições nas tabelas e saída das únicas
+    double ms;                  ///< Tempo total
+    double mChavesPorSegundo;   ///< Chaves do dataset por segundo, em milhões
+    double mbPicoMemoria;       ///< Pico da memória residente do processo (0 se não medido)
+};
+
+/**
+ * @brief Classe BenchmarkDeduplicacao - Vazão e memória da deduplicação em disco
+ */
+class BenchmarkDeduplicacao {
+private:
+    std::string arquivo;                        ///< Dataset a deduplicar (vazio = gerar)
+    uint64_t chavesGeradas;                     ///< Chaves do dataset gerado
+    uint64_t distintasGeradas;                  ///< Intervalo das chaves geradas
+    size_t bytesMemoria;                        ///< Orçamento de cada motor
+    std::string diretorio;                      ///< Derrames e dataset gerado (vazio = temporário)
+    std::string arquivoUnicos;                  ///< Saída das únicas do primeiro motor (vazio = não grava)
+    unsigned int seed;                          ///< Semente do dataset gerado
+    double mbArquivo;                           ///< Tamanho do dataset medido
+    std::vector<MedicaoDeduplicacao> resultados; ///< Um por método
+
+    template<typename Tabela>
+    void medirMotor(const char* nome, const std::string& dataset, bool gravarUnicas);
+    void medirUnorderedSet(const std::string& dataset);
+
+public:
+    /**
+     * @brief Construtor
+     * @param dataset Dataset a deduplicar (vazio = gerar `chaves` chaves)
+     * @param chaves Chaves do dataset gerado
+     * @param distintas Chaves possíveis no dataset gerado ([1, distintas])
+     * @param memoria Orçamento de memória de cada motor, em bytes
+     * @param diretorioTrabalho Derrames e dataset gerado (vazio = temporário do sistema)
+     * @param saidaUnicas Dataset com as únicas (vazio = não grava)
+     * @param semente Semente do dataset gerado
+     * @throws std::invalid_argument se o dataset for gerado sem chaves ou
+     *         distintas, ou distintas passar de INT_MAX
+     */
+    BenchmarkDeduplicacao(const std::string& dataset, uint64_t chaves, uint64_t distintas, size_t memoria,
+                          const std::string& diretorioTrabalho, const std::string& saidaUnicas,
+                          unsigned int semente);
+
+    /**
+     * @brief Gera o dataset, se preciso, e mede cada método
+     * @throws std::runtime_error se os métodos divergirem nas distintas ou
+     *         se a leitura ou a gravação falhar
+     */
+    void executar();
+
+    /**
+     * @brief Imprime a tabela de resultados
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em CSV
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+};
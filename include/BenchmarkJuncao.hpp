@@ -0,0 +1,103 @@
+/**
+ * @file BenchmarkJuncao.hpp
+ * @brief Junção hash: particionada (radix) contra uma única tabela
+ *
+ * Junta uma coluna de construção e uma de sondagem, geradas pelo
+ * CarregadorDados ou lidas de dois datasets, com juntarSemParticao() e
+ * juntarParticionado() (JuncaoHash.hpp), contando as correspondências e
+ * emitindo os pares, numa thread e com as threads pedidas.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * As partições miram metade da L2 detectada. Cada medição é executada
+ * REPETICOES vezes e representada pela mais rápida; a vazão conta as
+ * linhas das duas colunas. As chaves geradas ficam em [1, 2 x linhas da
+ * construção], o que dá em média meia correspondência por linha sondada.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Tempo de uma junção por um método
+ */
+struct MedicaoJuncao {
+    bool particionada;          ///< false: uma única tabela
+    bool pares;                 ///< true: emite os pares; false: só conta
+    size_t threads;             ///< Threads da junção
+    size_t linhasConstrucao;    ///< Linhas da coluna de construção
+    size_t linhasSonda;         ///< Linhas da coluna de sondagem
+    size_t particoes;           ///< Partições juntadas
+    size_t passagens;           ///< Passagens de particionamento
+    uint64_t correspondencias;  ///< Pares de linhas com a mesma chave
+    double msParticionamento;   ///< Particionamento, na execução mais rápida
+    double msJuncao;            ///< Construção e sondagem, na execução mais rápida
+    double ms;                  ///< Menor tempo total entre as repetições
+    double mTuplasPorSegundo;   ///< Linhas das duas colunas por segundo, em milhões
+    double aceleracao;          ///< Tempo sem particionamento (mesmas threads e saída) / ms
+};
+
+/**
+ * @brief Classe BenchmarkJuncao - Vazão da junção com e sem particionamento
+ */
+class BenchmarkJuncao {
+private:
+    size_t linhasConstrucao;                ///< Linhas geradas da construção
+    size_t linhasSonda;                     ///< Linhas geradas da sondagem
+    std::string arquivoConstrucao;          ///< Dataset da construção (vazio = gerar)
+    std::string arquivoSonda;               ///< Dataset da sondagem (vazio = gerar)
+    size_t threads;                         ///< Threads do método paralelo (0 = núcleos)
+    unsigned int seed;                      ///< Semente das colunas geradas
+    std::vector<MedicaoJuncao> resultados;  ///< Método x saída x threads
+
+    void medir(const std::vector<int>& construcao, const std::vector<int>& sonda, bool particionada, bool pares,
+               size_t numThreads, size_t bytesParticao);
+
+public:
+    /// Execuções de cada medição; vale a mais rápida
+    static constexpr size_t REPETICOES = 3;
+
+    /**
+     * @brief Construtor com colunas geradas
+     * @param construcao Linhas da coluna de construção
+     * @param sonda Linhas da coluna de sondagem
+     * @param threadsParalelo Threads do método paralelo (0 = núcleos disponíveis)
+     * @param semente Semente das colunas
+     * @throws std::invalid_argument se alguma coluna for vazia
+     */
+    BenchmarkJuncao(size_t construcao, size_t sonda, size_t threadsParalelo, unsigned int semente);
+
+    /**
+     * @brief Construtor com as colunas lidas de dois datasets (formato do CarregadorDados)
+     * @throws std::invalid_argument se algum caminho for vazio
+     */
+    BenchmarkJuncao(const std::string& construcao, const std::string& sonda, size_t threadsParalelo);
+
+    /**
+     * @brief Mede os dois métodos, contando e emitindo pares
+     * @throws std::runtime_error se um dataset não puder ser lido ou se os
+     *         métodos divergirem no número de correspondências
+     */
+    void executar();
+
+    /**
+     * @brief Imprime a tabela de resultados
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em CSV
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+};
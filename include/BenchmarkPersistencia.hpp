@@ -0,0 +1,112 @@
+/**
+ * @file BenchmarkPersistencia.hpp
+ * @brief Custo por operação e tempo de recuperação da TabelaDuravel
+ *
+ * Mede as duas faces da persistência (PersistenciaTabela.hpp) sobre uma
+ * TabelaAberta com fator de carga 0,5:
+ * - Custo por inserção para cada tamanho de lote do commit em grupo,
+ *   comparado à mesma sequência numa tabela sem diário
+ * - Tempo de recuperação em função do número de chaves, a partir apenas do
+ *   diário e a partir de um snapshot, e o tempo de gravar o snapshot
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Os arquivos são gravados em subdiretórios de um diretório de trabalho,
+ * apagados ao fim. O custo do fdatasync depende do dispositivo: num tmpfs
+ * ele é praticamente nulo. A recuperação lê os arquivos recém-gravados, em
+ * geral ainda no cache de páginas do sistema.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Custo das inserções para um tamanho de lote de sincronização
+ */
+struct ResultadoCustoPersistencia {
+    bool comDiario;             ///< false na linha de referência sem diário
+    size_t lote;                ///< Mutações por fdatasync (0 = write() a cada uma, sem fdatasync)
+    size_t operacoes;           ///< Inserções medidas
+    double nsMedio;             ///< Média, incluindo a sincronização final
+    double nsP50;               ///< Mediana por inserção
+    double nsP99;               ///< Percentil 99 por inserção
+    double nsMaximo;            ///< Maior latência por inserção
+    size_t sincronizacoes;      ///< fdatasync realizados
+    double mbDiario;            ///< MB gravados no diário
+    double razaoSemDiario;      ///< nsMedio / nsMedio sem diário
+};
+
+/**
+ * @brief Recuperação de um conjunto de chaves
+ */
+struct ResultadoRecuperacao {
+    size_t chaves;              ///< Chaves na tabela recuperada
+    bool deSnapshot;            ///< true: snapshot; false: só diário
+    double mbLidos;             ///< Tamanho dos arquivos recuperados
+    double msGravacao;          ///< Gravação do snapshot (0 na linha do diário)
+    double msRecuperacao;       ///< Leitura e reaplicação
+    double mChavesPorSegundo;   ///< Chaves recuperadas por segundo, em milhões
+};
+
+/**
+ * @brief Classe BenchmarkPersistencia - Custo do diário e da recuperação
+ */
+class BenchmarkPersistencia {
+private:
+    std::vector<size_t> quantidades;                    ///< Chaves por medição de recuperação
+    std::vector<size_t> lotes;                          ///< Tamanhos de lote do commit em grupo
+    std::string diretorio;                              ///< Diretório de trabalho
+    unsigned int seed;                                  ///< Semente das chaves
+    std::vector<ResultadoCustoPersistencia> custos;     ///< Referência + um por lote
+    std::vector<ResultadoRecuperacao> recuperacoes;     ///< Diário e snapshot por quantidade
+
+    void medirCusto(const std::vector<int>& chaves);
+    void medirRecuperacao(size_t quantidade);
+
+public:
+    /// Inserções medidas por lote (menos se ORCAMENTO_SEGUNDOS se esgotar)
+    static constexpr size_t OPERACOES_CUSTO = 200000;
+    /// Tempo máximo de inserções por lote (lote 1 em disco lento)
+    static constexpr double ORCAMENTO_SEGUNDOS = 5.0;
+
+    /**
+     * @brief Construtor
+     * @param chaves Quantidades de chaves das medições de recuperação
+     * @param lotesSincronizacao Mutações por fdatasync a comparar (0 = nunca)
+     * @param diretorioTrabalho Diretório onde os arquivos são criados
+     * @param semente Semente das chaves geradas
+     * @throws std::invalid_argument se alguma lista estiver vazia ou houver
+     *         quantidade zero
+     */
+    BenchmarkPersistencia(const std::vector<size_t>& chaves, const std::vector<size_t>& lotesSincronizacao,
+                          const std::string& diretorioTrabalho, unsigned int semente);
+
+    /**
+     * @brief Executa as medições de custo e de recuperação
+     * @throws std::runtime_error se a recuperação não reproduzir a tabela
+     */
+    void executar();
+
+    /**
+     * @brief Imprime as duas tabelas de resultados
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em dois arquivos CSV
+     * @param arquivoCusto CSV do custo por operação
+     * @param arquivoRecuperacao CSV da recuperação
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar os arquivos
+     */
+    void salvarResultados(const std::string& arquivoCusto, const std::string& arquivoRecuperacao,
+                          const MetadadosExecucao& metadados) const;
+};
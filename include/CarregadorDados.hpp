@@ -14,6 +14,7 @@
  * 
  * Características principais:
  * - Carregamento eficiente de datasets de arquivos de texto
+ * - Leitura em blocos (LeitorDataset) para arquivos maiores que a memória
  * - Geração de números aleatórios para testes de busca
  * - Validação da integridade dos arquivos
  * - Coleta de estatísticas sobre os datasets
@@ -23,6 +24,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <stdexcept>
 #include <random>
@@ -73,6 +75,18 @@ private:
         return str.substr(inicio, fim - inicio + 1);
     }
 
+    /**
+     * @brief Versão de trim sobre uma vista, sem cópia
+     * @param str Trecho a ser processado
+     * @return Vista sem espaços nas extremidades
+     */
+    std::string_view trim(std::string_view str) const {
+        size_t inicio = str.find_first_not_of(" \t\n\r");
+        if (inicio == std::string_view::npos) return {};
+        size_t fim = str.find_last_not_of(" \t\n\r");
+        return str.substr(inicio, fim - inicio + 1);
+    }
+
 public:
     /**
      * @brief Construtor do CarregadorDados
@@ -212,6 +226,59 @@ public:
      * Calcula todas as estatísticas básicas do dataset.
      * 
      * @complexity O(n)
+     * @note Mantém o dataset e um std::unordered_set com todas as chaves em
+     *       memória; para arquivos maiores que a RAM, deduplicarArquivo()
+     *       (DeduplicacaoExterna.hpp) conta as duplicatas com memória limitada
      */
     InfoDataset analisarDataset(const std::string& nomeArquivo);
+};
+
+/**
+ * @brief Leitura de um dataset em blocos, com memória limitada
+ *
+ * Mesmo formato e mesmas regras de carregarDeArquivo() (quantidade na
+ * primeira linha, espaços e CRLF tolerados, linhas inválidas ignoradas com
+ * aviso, leitura até a quantidade declarada), mas o arquivo é lido
+ * bytesBloco por vez e os números são entregues a quem chama em partes,
+ * de modo que arquivos maiores que a memória podem ser percorridos.
+ */
+class LeitorDataset {
+private:
+    std::string nomeArquivo;        ///< Caminho do dataset
+    std::ifstream arquivo;          ///< Arquivo aberto em modo binário
+    std::vector<char> buffer;       ///< Bytes lidos e ainda não consumidos em [inicio, fim)
+    size_t inicio;                  ///< Início da próxima linha no buffer
+    size_t fim;                     ///< Fim dos bytes válidos no buffer
+    bool fimArquivo;                ///< true quando não há mais bytes a ler do arquivo
+    size_t quantidadeDeclarada;     ///< Quantidade da primeira linha
+    size_t numerosLidos;            ///< Números entregues até agora
+    size_t linhaAtual;              ///< Linha do arquivo, para os avisos
+
+    bool proximaLinha(std::string_view& linha);
+
+public:
+    /// Bytes lidos do arquivo por vez
+    static constexpr size_t BYTES_BLOCO_PADRAO = 4 * 1024 * 1024;
+
+    /**
+     * @brief Abre o dataset e lê a quantidade declarada
+     * @param nomeArquivo Caminho do dataset
+     * @param bytesBloco Bytes lidos do arquivo por vez (linhas maiores ampliam o buffer)
+     * @throws std::runtime_error se o arquivo não existir, não abrir ou a
+     *         primeira linha não for uma quantidade positiva
+     */
+    explicit LeitorDataset(const std::string& nomeArquivo, size_t bytesBloco = BYTES_BLOCO_PADRAO);
+
+    /**
+     * @brief Lê os próximos números
+     * @param destino Recebe até `maximo` números
+     * @return Números lidos; 0 no fim do arquivo ou depois da quantidade declarada
+     */
+    size_t ler(int* destino, size_t maximo);
+
+    /// Quantidade declarada na primeira linha (pode exceder a de números válidos)
+    size_t getQuantidadeDeclarada() const { return quantidadeDeclarada; }
+
+    /// Números entregues por ler() até agora
+    size_t getNumerosLidos() const { return numerosLidos; }
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+/**
+ * @file ComparacaoAlocadores.hpp
+ * @brief Comparação de estratégias de alocação dos nós da TabelaEncadeada
+ *
+ * O desempenho da TabelaEncadeada é dominado pela alocação de um nó por
+ * chave. Esta classe executa o mesmo roteiro com cada memory_resource e
+ * mede os tempos das fases e a memória retida:
+ * - new_delete: std::pmr::new_delete_resource() (malloc da libc)
+ * - monotonic: std::pmr::monotonic_buffer_resource (nunca reutiliza memória)
+ * - pool: std::pmr::unsynchronized_pool_resource
+ * - slab: RecursoSlab (blocos fixos com lista livre)
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Fases de cada medição:
+ * 1. Inserção de n chaves (tabela com fator de carga ~1)
+ * 2. Busca de uma amostra de chaves presentes
+ * 3. Rotatividade: remoção de metade das chaves e inserção de igual número
+ *    de chaves novas, que expõe o reuso (ou não) da memória liberada
+ * 4. Destruição da tabela e do recurso
+ *
+ * A fragmentação é medida após a rotatividade como a fração da memória
+ * retida que não contém nós vivos: 1 - bytes dos nós / bytes retidos.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Resultado de um alocador para uma quantidade de chaves
+ */
+struct ResultadoAlocador {
+    std::string alocador;        ///< new_delete, monotonic, pool ou slab
+    size_t quantidadeChaves;     ///< Chaves inseridas
+    size_t tamanhoTabela;        ///< Posições da tabela
+    double nsInsercao;           ///< Mediana de ns por inserção
+    double nsBusca;              ///< Mediana de ns por busca
+    double nsRotatividade;       ///< Mediana de ns por operação da rotatividade
+    double nsDestruicao;         ///< Mediana de ns por nó na destruição
+    size_t bytesNos;             ///< Bytes dos nós vivos após a rotatividade
+    size_t bytesRetidos;         ///< Bytes retidos pelo alocador após a rotatividade
+    double fragmentacao;         ///< 1 - bytesNos / bytesRetidos
+    bool memoriaMedida;          ///< false se bytesRetidos é apenas estimado
+};
+
+/**
+ * @brief Classe ComparacaoAlocadores - Mede a TabelaEncadeada com cada memory_resource
+ *
+ * Os tempos são a mediana de REPETICOES execuções; a memória é a da última.
+ * Para new_delete a memória retida vem de mallinfo2 (glibc >= 2.33) e
+ * inclui cabeçalhos e alinhamento do malloc; nos demais alocadores, de um
+ * RecursoContador usado como upstream.
+ */
+class ComparacaoAlocadores {
+private:
+    std::vector<size_t> quantidades;            ///< Quantidades de chaves a medir
+    unsigned int seed;                          ///< Semente dos datasets
+    std::vector<ResultadoAlocador> resultados;  ///< Resultados na ordem de execução
+
+    /// Execuções por alocador e quantidade (tempos pela mediana)
+    static constexpr size_t REPETICOES = 5;
+
+    /// Tamanho máximo da amostra de buscas
+    static constexpr size_t MAX_AMOSTRA_BUSCA = 1u << 20;
+
+    /**
+     * @brief Mede um alocador com os dados de um passo
+     * @param alocador Nome do alocador
+     * @param dados Chaves inseridas
+     * @param amostra Chaves buscadas
+     * @param removidas Chaves distintas de dados removidas na rotatividade
+     * @param novas Chaves distintas inseridas na rotatividade (fora de dados)
+     */
+    void medirAlocador(const std::string& alocador, const std::vector<int>& dados,
+                       const std::vector<int>& amostra, const std::vector<int>& removidas,
+                       const std::vector<int>& novas);
+
+public:
+    /**
+     * @brief Nomes dos alocadores comparados, na ordem do relatório
+     */
+    static const std::vector<std::string>& alocadores();
+
+    /**
+     * @brief Construtor
+     * @param chaves Quantidades de chaves a medir
+     * @param semente Semente dos datasets gerados
+     * @throws std::invalid_argument se a lista for vazia ou tiver zero
+     */
+    ComparacaoAlocadores(std::vector<size_t> chaves, unsigned int semente);
+
+    /**
+     * @brief Executa todas as medições
+     */
+    void executar();
+
+    /**
+     * @brief Imprime o relatório com a razão de cada tempo para new_delete
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em arquivo CSV
+     * @param arquivo Caminho do arquivo de saída
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+};
@@ -0,0 +1,95 @@
+/**
+ * @file ComparacaoExecucoes.hpp
+ * @brief Comparação entre dois CSVs de resultados da mesma matriz
+ *
+ * Compara, configuração a configuração, os tempos gravados por duas
+ * execuções (por exemplo, um build sem e outro com PGO, ou duas revisões
+ * do código), usando as repetições de cada uma como amostras.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Para cada configuração (dataset x motor x tamanho x hash x mistura x
+ * threads) presente nos dois arquivos e cada fase (inserção, busca quente
+ * e fase mista):
+ * - Mediana de ns/op em cada execução e razão nova / base
+ * - p-valor do teste U de Mann-Whitney, ajustado por Holm-Bonferroni
+ *   sobre todas as linhas (exige ao menos duas repetições de cada lado)
+ * - Média geométrica das razões por fase, que resume o ganho global
+ */
+
+#pragma once
+
+#include "ResultadoTeste.hpp"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Uma fase de uma configuração comparada entre as duas execuções
+ */
+struct DiferencaExecucoes {
+    std::string dataset;        ///< Origem dos dados
+    std::string tipoTabela;     ///< Motor
+    size_t tamanhoTabela;       ///< Posições da tabela
+    std::string tipoFuncaoHash; ///< Função hash
+    std::string mistura;        ///< Mistura da fase mista ("-" se nenhuma)
+    size_t threads;             ///< Threads da busca
+    std::string metrica;        ///< "insercao", "busca" ou "mistura"
+    size_t repeticoesBase;      ///< Amostras da execução base
+    size_t repeticoesNova;      ///< Amostras da execução nova
+    double nsBase;              ///< Mediana de ns/op na base
+    double nsNova;              ///< Mediana de ns/op na nova
+    double razao;               ///< nsNova / nsBase (< 1: a nova é mais rápida)
+    double pValor;              ///< p-valor ajustado (NaN sem repetições suficientes)
+    bool significativa;         ///< pValor < alfa
+};
+
+/**
+ * @brief Classe ComparacaoExecucoes - Diferenças entre dois CSVs de resultados
+ */
+class ComparacaoExecucoes {
+private:
+    std::string arquivoBase;                    ///< CSV da execução de referência
+    std::string arquivoNovo;                    ///< CSV da execução comparada
+    std::string rotuloBase;                     ///< Nome da base no relatório
+    std::string rotuloNovo;                     ///< Nome da nova no relatório
+    double alfa;                                ///< Nível de significância
+    std::vector<DiferencaExecucoes> diferencas; ///< Uma linha por configuração e fase
+    size_t somenteEmUm = 0;                     ///< Configurações ausentes de um dos arquivos
+
+public:
+    /**
+     * @brief Construtor
+     * @param base CSV da execução de referência
+     * @param novo CSV da execução comparada
+     * @param rotuloA Nome da base no relatório
+     * @param rotuloB Nome da nova no relatório
+     * @param nivelSignificancia Alfa após a correção de Holm
+     */
+    ComparacaoExecucoes(const std::string& base, const std::string& novo,
+                        const std::string& rotuloA, const std::string& rotuloB,
+                        double nivelSignificancia = 0.05);
+
+    /**
+     * @brief Lê os dois arquivos e compara as configurações em comum
+     * @throws std::runtime_error se algum arquivo não puder ser lido ou
+     *         não tiver configurações em comum com o outro
+     */
+    void executar();
+
+    /**
+     * @brief Imprime as diferenças e a média geométrica das razões por fase
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva as diferenças em arquivo CSV
+     * @param arquivo Caminho do arquivo de saída
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo) const;
+};
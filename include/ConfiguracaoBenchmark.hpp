@@ -0,0 +1,228 @@
+/**
+ * @file ConfiguracaoBenchmark.hpp
+ * @brief Descrição declarativa da matriz de benchmarks
+ *
+ * Define a estrutura ConfiguracaoBenchmark, que descreve quais motores,
+ * funções hash, tamanhos (ou fatores de carga), datasets, misturas de
+ * operações, repetições, threads e saídas compõem uma execução. A
+ * configuração pode ser lida de um arquivo no estilo INI, sem dependências
+ * externas, para que varreduras recorrentes fiquem versionadas em arquivos
+ * em vez de exigir alterações no main.cpp.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Formato do arquivo (ver config/trabalho2.ini):
+ * @code
+ * # Comentários com '#' ou ';'
+ * [matriz]
+ * motores = Encadeada, Aberta
+ * hashes = Divisao, Multiplicacao
+ * repeticoes = 1
+ * threads = 1
+ * semente = 42
+ *
+ * [Encadeada]
+ * tamanhos = 29, 97, 251, 499, 911
+ *
+ * [Aberta]
+ * fatoresCarga = 0.25, 0.5
+ *
+ * [dados]
+ * arquivos = data/numeros_aleatorios_1000.txt
+ * distribuicoes = uniforme:100000, sequencial:100000
+ * buscas = 1000
+ *
+ * [operacoes]
+ * misturas = busca:90/insercao:5/remocao:5
+ * quantidade = 100000
+ *
+ * [comparacao]
+ * alfa = 0.05
+ * toleranciaSondagem = 0.25
+ *
+ * [estabilidade]
+ * ativa = sim
+ * precisao = 0.02
+ * precisaoP99 = 0
+ * confianca = 0.95
+ * minimo = 6
+ * maximo = 1000
+ * orcamento = 10
+ *
+ * [saida]
+ * csv = resultados_benchmark.csv
+ * comparacoes = comparacoes_benchmark.csv
+ * historico = historico_resultados.jsonl
+ * console = sim
+ * @endcode
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <optional>
+#include <cstddef>
+
+#include "EscritorJson.hpp"
+
+/**
+ * @brief Dimensionamento de um motor: tamanhos fixos e/ou fatores de carga
+ *
+ * Fatores de carga são convertidos em tamanho (menor primo >= n / fator)
+ * para cada dataset, mantendo a carga constante entre datasets.
+ */
+struct DimensionamentoMotor {
+    std::vector<size_t> tamanhos;       ///< Tamanhos absolutos de tabela
+    std::vector<double> fatoresCarga;   ///< Fatores de carga desejados
+};
+
+/**
+ * @brief Dataset gerado sinteticamente
+ *
+ * Tipos suportados:
+ * - uniforme: números aleatórios (com repetição) entre 1 e 1.000.000
+ * - sequencial: 1, 2, ..., n em ordem crescente
+ */
+struct DistribuicaoDados {
+    std::string tipo;       ///< "uniforme" ou "sequencial"
+    size_t quantidade;      ///< Número de chaves geradas
+
+    /**
+     * @brief Rótulo usado nos relatórios
+     * @return Texto como "uniforme:100000"
+     */
+    std::string rotulo() const {
+        return tipo + ":" + std::to_string(quantidade);
+    }
+};
+
+/**
+ * @brief Mistura de operações executada após a construção da tabela
+ *
+ * Os percentuais somam 100. A sequência de operações é gerada antes da
+ * medição: buscas usam os dados de busca, inserções usam chaves novas e
+ * remoções usam chaves do dataset.
+ */
+struct MisturaOperacoes {
+    unsigned busca;     ///< Percentual de buscas
+    unsigned insercao;  ///< Percentual de inserções
+    unsigned remocao;   ///< Percentual de remoções
+
+    /**
+     * @brief Rótulo usado nos relatórios
+     * @return Texto como "b90/i5/r5"
+     */
+    std::string rotulo() const {
+        return "b" + std::to_string(busca) + "/i" + std::to_string(insercao) +
+               "/r" + std::to_string(remocao);
+    }
+
+    /**
+     * @brief Verifica se a mistura altera a tabela
+     * @return true se há inserções ou remoções
+     */
+    bool temEscrita() const {
+        return insercao > 0 || remocao > 0;
+    }
+
+    /**
+     * @brief Interpreta "busca:90/insercao:5/remocao:5" (operações ausentes valem 0)
+     * @throws std::invalid_argument se o texto for inválido
+     */
+    static MisturaOperacoes ler(const std::string& texto);
+};
+
+/**
+ * @brief Critério de parada das repetições no modo até estabilizar
+ *
+ * Cada cenário (dataset x motor x tamanho x hash x mistura x threads) é
+ * repetido até que o intervalo de confiança da mediana dos tempos de
+ * inserção, busca quente e fase mista fique dentro da precisão pedida, ou
+ * até o orçamento de tempo ou o máximo de repetições. Substitui o número
+ * fixo de repetições.
+ */
+struct CriterioEstabilidade {
+    bool ativo = false;             ///< Repete até estabilizar em vez de usar repeticoes
+    double precisao = 0.02;         ///< Semiamplitude relativa máxima do IC da mediana
+    double precisaoP99 = 0.0;       ///< Idem para o p99 (0 = não exigido; com 95% requer >= 368 repetições)
+    double confianca = 0.95;        ///< Nível de confiança dos intervalos
+    size_t minimo = 6;              ///< Repetições antes de avaliar a convergência
+    size_t maximo = 1000;           ///< Repetições no máximo por cenário
+    double orcamentoSegundos = 10.0; ///< Tempo máximo por cenário
+};
+
+/**
+ * @brief Estrutura ConfiguracaoBenchmark - Matriz completa de uma execução
+ *
+ * BenchmarkManager expande esta configuração no produto cartesiano
+ * dataset x motor x tamanho x hash x mistura x threads x repetição.
+ */
+struct ConfiguracaoBenchmark {
+    // [matriz]
+    std::vector<std::string> motores;       ///< Motores de RegistroMotores.hpp ("Encadeada", "Aberta")
+    std::vector<std::string> hashes;        ///< "Divisao" e/ou "Multiplicacao"
+    size_t repeticoes = 1;                  ///< Repetições de cada cenário
+    std::vector<size_t> threads = {1};      ///< Threads concorrentes na fase de busca
+    std::optional<unsigned int> semente;    ///< Semente dos geradores (ausente = aleatória)
+
+    // Uma seção por motor registrado: [Encadeada], [Aberta]
+    std::map<std::string, DimensionamentoMotor> dimensionamento; ///< Tamanhos por motor
+
+    // [dados]
+    std::vector<std::string> arquivos;              ///< Datasets carregados de arquivo
+    std::vector<DistribuicaoDados> distribuicoes;   ///< Datasets gerados
+    size_t quantidadeBuscas = 1000;                 ///< Números aleatórios gerados para busca
+
+    // [operacoes]
+    std::vector<MisturaOperacoes> misturas;         ///< Misturas (vazio = sem fase mista)
+    size_t operacoesMistura = 100000;               ///< Operações por fase mista
+
+    // [comparacao]
+    double alfa = 0.05;                             ///< Nível de significância (Holm-Bonferroni)
+    double toleranciaSondagem = 0.25;               ///< Desvio relativo aceito entre sondagens medidas e teóricas
+
+    // [estabilidade]
+    CriterioEstabilidade estabilidade;              ///< Repetições até estabilizar (inativo = repeticoes fixas)
+
+    // [saida]
+    std::string arquivoCsv = "resultados_benchmark.csv";            ///< CSV (vazio = desativado)
+    std::string arquivoComparacoes = "comparacoes_benchmark.csv";   ///< Comparações (vazio = desativado)
+    std::string arquivoHistorico = "historico_resultados.jsonl";    ///< Histórico (vazio = desativado)
+    std::string arquivoRastreio;                                    ///< Trace-event (vazio = desativado)
+    bool console = true;                                            ///< Relatório no console
+
+    /**
+     * @brief Configuração padrão do Trabalho 2
+     * @return Matriz com os tamanhos e datasets originais do projeto
+     *
+     * Encadeada com tamanhos 29, 97, 251, 499 e 911; Aberta com 50009;
+     * os seis datasets de data/ e 1000 buscas.
+     */
+    static ConfiguracaoBenchmark padrao();
+
+    /**
+     * @brief Lê a configuração de um arquivo INI
+     * @param nomeArquivo Caminho do arquivo
+     * @return Configuração lida (campos ausentes mantêm os valores padrão)
+     * @throws std::runtime_error se o arquivo não existir, tiver sintaxe
+     *         inválida, chaves desconhecidas ou valores inconsistentes
+     */
+    static ConfiguracaoBenchmark carregarArquivo(const std::string& nomeArquivo);
+
+    /**
+     * @brief Verifica a consistência da configuração
+     * @throws std::runtime_error descrevendo o primeiro problema encontrado
+     */
+    void validar() const;
+
+    /**
+     * @brief Escreve a configuração como campos do objeto JSON aberto
+     * @param json Escritor posicionado dentro de um objeto
+     */
+    void escreverJson(EscritorJson& json) const;
+};
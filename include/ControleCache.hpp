@@ -0,0 +1,144 @@
+/**
+ * @file ControleCache.hpp
+ * @brief Utilitários para controlar o estado das caches durante os benchmarks
+ *
+ * Este arquivo define a classe EvictorCache, usada pelo BenchmarkManager para
+ * separar o custo de primeiro acesso (caches frias) do custo em regime
+ * permanente (caches quentes). Sem esse controle, a fase de busca roda logo
+ * após as inserções e tabelas pequenas ficam inteiramente residentes em L1/L2,
+ * produzindo números otimistas. Também expõe a topologia de memória da
+ * máquina (L1/L2/LLC/TLB), usada para anotar as varreduras de working set.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.1
+ *
+ * Características principais:
+ * - Detecção dos tamanhos de L1d, L2 e LLC via sysfs
+ * - Estimativa do alcance da TLB (entradas x tamanho de página)
+ * - Evicção das caches percorrendo um buffer maior que a LLC
+ * - Valor padrão seguro quando a detecção não está disponível
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Estrutura com a hierarquia de memória detectada
+ *
+ * Os tamanhos são lidos de /sys/devices/system/cpu/cpu0/cache. O número
+ * de entradas da TLB não é exposto pelo sysfs; quando /proc/cpuinfo não o
+ * informa ("TLB size"), usa-se uma estimativa típica de STLB.
+ */
+struct TopologiaMemoria {
+    size_t l1d;             ///< Cache L1 de dados em bytes
+    size_t l2;              ///< Cache L2 em bytes
+    size_t llc;             ///< Cache de último nível em bytes
+    size_t tamanhoPagina;   ///< Tamanho da página base em bytes
+    size_t entradasTLB;     ///< Número de entradas da TLB de segundo nível
+    bool tlbEstimada;       ///< true se entradasTLB é uma estimativa
+    size_t memoriaFisica;   ///< Memória física total em bytes (0 se desconhecida)
+
+    /**
+     * @brief Calcula o alcance da TLB
+     * @return Bytes endereçáveis sem falta de TLB (entradas x página)
+     */
+    size_t alcanceTLB() const {
+        return entradasTLB * tamanhoPagina;
+    }
+
+    /**
+     * @brief Classifica um working set pelo nível de memória que o comporta
+     * @param bytes Tamanho do working set
+     * @return "L1", "L2", "LLC" ou "DRAM"
+     */
+    std::string nivelPara(size_t bytes) const {
+        if (bytes <= l1d) return "L1";
+        if (bytes <= l2) return "L2";
+        if (bytes <= llc) return "LLC";
+        return "DRAM";
+    }
+};
+
+/**
+ * @brief Detecta a hierarquia de memória da máquina
+ * @return Estrutura com os tamanhos detectados
+ *
+ * Valores indisponíveis recebem padrões conservadores
+ * (32 KiB, 1 MiB, 32 MiB, 4 KiB, 1536 entradas).
+ */
+TopologiaMemoria detectarTopologiaMemoria();
+
+/**
+ * @brief Detecta o tamanho da cache de último nível (LLC)
+ * @return Tamanho da LLC em bytes
+ *
+ * Lê /sys/devices/system/cpu/cpu0/cache/index* e retorna a maior cache
+ * de dados ou unificada encontrada. Em sistemas sem sysfs (ex.: Windows)
+ * retorna um valor conservador de 32 MiB.
+ */
+size_t detectarTamanhoLLC();
+
+/**
+ * @brief Classe EvictorCache - Expulsa dados das caches entre fases
+ *
+ * Mantém um buffer maior que a LLC e o percorre linha a linha, lendo e
+ * escrevendo cada linha de cache. Ao final da varredura, o conteúdo
+ * anterior das caches (tabela hash, dados de busca) foi substituído pelo
+ * buffer, simulando o primeiro acesso a uma estrutura fria.
+ *
+ * O buffer é alocado uma única vez na construção para que a evicção
+ * não inclua o custo de alocação. Em sistemas POSIX é um mapeamento
+ * anônimo compartilhado: processos filhos do isolamento por cenário
+ * escrevem nas mesmas páginas em vez de copiar o buffer inteiro (do
+ * tamanho da LLC) na primeira evicção.
+ */
+class EvictorCache {
+private:
+    /// Devolve o buffer ao sistema (munmap) ou ao heap
+    struct LiberarBuffer {
+        size_t bytes;           ///< Tamanho do mapeamento
+        bool mapeado;           ///< true se obtido com mmap
+        void operator()(unsigned char* p) const;
+    };
+
+    std::unique_ptr<unsigned char[], LiberarBuffer> buffer;  ///< Buffer percorrido para expulsar as caches
+    size_t tamanho = 0;                                      ///< Bytes do buffer
+
+    /// Tamanho assumido da linha de cache em bytes
+    static constexpr size_t TAMANHO_LINHA = 64;
+
+    /// Multiplicador sobre a LLC para compensar associatividade e políticas de substituição
+    static constexpr double FATOR_BUFFER = 1.5;
+
+public:
+    /**
+     * @brief Construtor do EvictorCache
+     * @param bytes Tamanho do buffer de evicção (0 = 1,5x o tamanho da LLC)
+     */
+    explicit EvictorCache(size_t bytes = 0);
+
+    /**
+     * @brief Percorre o buffer inteiro expulsando o conteúdo das caches
+     *
+     * Cada linha é lida e escrita para também invalidar cópias em estado
+     * compartilhado. O resultado é acumulado numa variável volátil para
+     * impedir que o compilador elimine a varredura.
+     *
+     * @complexity O(b) onde b é o tamanho do buffer
+     */
+    void evictar();
+
+    /**
+     * @brief Obtém o tamanho do buffer de evicção
+     * @return Tamanho em bytes
+     */
+    size_t getTamanho() const {
+        return tamanho;
+    }
+};
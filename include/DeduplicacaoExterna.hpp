@@ -0,0 +1,148 @@
+/**
+ * @file DeduplicacaoExterna.hpp
+ * @brief Contagem de chaves distintas e deduplicação de datasets maiores que a memória
+ *
+ * O dataset (formato do CarregadorDados) é lido em blocos e distribuído
+ * pelos bits de um hash de 64 bits entre arquivos de derrame em disco, até
+ * que cada partição tenha no máximo as chaves que cabem no orçamento de
+ * memória. Cada partição é então lida de volta numa tabela de um motor
+ * registrado, que descarta as repetições; como chaves iguais sempre caem
+ * na mesma partição, a soma das chaves distintas das partições é a do
+ * dataset. As chaves únicas podem ser gravadas num novo dataset.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Cada nível de particionamento divide uma partição em até 256 (8 bits do
+ * hash); uma partição que ainda excede o limite, por exemplo por desvio da
+ * distribuição, é dividida de novo com os 8 bits seguintes. Se uma divisão
+ * não separar nenhuma chave (uma partição com muitas cópias de poucas
+ * chaves), a partição é deduplicada assim mesmo: a tabela só guarda as
+ * chaves distintas. A memória fica limitada pelo orçamento em qualquer
+ * tamanho de dataset; o disco precisa comportar as partições de um nível
+ * (4 bytes por chave) além do dataset.
+ */
+
+#pragma once
+
+#include "MotorTabela.hpp"
+#include "TabelaRedimensionavel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Orçamento de memória, arquivos de derrame e saída da deduplicação
+ */
+struct ConfiguracaoDeduplicacao {
+    size_t bytesMemoria = 256 * 1024 * 1024;    ///< Memória da tabela de uma partição e dos buffers
+    size_t chavesPorParticao = 0;               ///< Limite por partição (0 = calculado pelo orçamento)
+    std::string diretorio;                      ///< Onde criar os derrames (vazio = temporário do sistema)
+    std::string arquivoUnicos;                  ///< Dataset com as chaves únicas (vazio = não grava)
+};
+
+/**
+ * @brief Contagens, formato do particionamento e tempos de uma deduplicação
+ */
+struct ResultadoDeduplicacao {
+    uint64_t chaves = 0;            ///< Chaves lidas do dataset
+    uint64_t unicas = 0;            ///< Chaves distintas
+    int minimo = 0;                 ///< Menor chave
+    int maximo = 0;                 ///< Maior chave
+    double media = 0.0;             ///< Média das chaves
+    size_t particoes = 0;           ///< Partições deduplicadas em memória
+    size_t niveis = 0;              ///< Níveis de particionamento (0 = o dataset coube na memória)
+    uint64_t bytesDerramados = 0;   ///< Bytes gravados em derrames, somados entre os níveis
+    uint64_t maiorParticao = 0;     ///< Chaves da maior partição deduplicada
+    double msParticionamento = 0.0; ///< Leitura do dataset e gravação dos derrames
+    double msDeduplicacao = 0.0;    ///< Leitura dos derrames nas tabelas e gravação das únicas
+
+    /// Chaves repetidas (como InfoDataset::numDuplicatas)
+    uint64_t duplicatas() const { return chaves - unicas; }
+};
+
+/**
+ * @brief Tabela de uma partição, vista pelo particionamento
+ *
+ * Preenchida por deduplicarArquivo() com um motor; o particionamento não
+ * depende do motor.
+ */
+struct TabelaDeduplicacao {
+    size_t bytesPorChave;                                   ///< Memória por chave distinta, com a cópia das únicas
+    std::function<void(size_t capacidade)> iniciar;         ///< Nova tabela para até `capacidade` chaves distintas
+    std::function<void(const int* chaves, size_t n)> inserir; ///< Insere um bloco de chaves
+    std::function<void(std::vector<int>& unicas)> extrair;  ///< Chaves distintas desde iniciar(); libera a tabela
+};
+
+/// Chaves lidas e gravadas por vez nos derrames
+constexpr size_t CHAVES_BLOCO_DERRAME = 64 * 1024;
+/// Bits do hash por nível de particionamento (até 256 partições por nível)
+constexpr size_t BITS_POR_NIVEL = 8;
+
+/**
+ * @brief Particiona o dataset e deduplica as partições com a tabela dada
+ * @throws std::invalid_argument se o orçamento não comportar os buffers (16 MiB)
+ * @throws std::runtime_error se o dataset não puder ser lido, um derrame ou
+ *         a saída não puderem ser gravados, ou uma partição tiver mais
+ *         chaves distintas que o limite
+ *
+ * Os derrames ficam num subdiretório próprio, apagado ao fim mesmo com erro.
+ */
+ResultadoDeduplicacao deduplicarExterno(const std::string& arquivo, const ConfiguracaoDeduplicacao& config,
+                                        const TabelaDeduplicacao& tabela);
+
+/**
+ * @brief Deduplica um dataset com memória limitada, usando o motor Tabela em cada partição
+ * @param arquivo Dataset no formato do CarregadorDados
+ * @param tipo Função hash das tabelas das partições
+ * @param config Orçamento, diretório dos derrames e saída das únicas
+ *
+ * A tabela de cada partição é criada com fator de carga 0,5 para o número
+ * de chaves da partição (limitado a chavesPorParticao) e percorrida com
+ * paraCada() ao fim. As chaves únicas saem agrupadas por partição, sem
+ * ordem definida. O custo por chave que limita as partições vem do motor
+ * (BYTES_POR_POSICAO e bytesPorChave()).
+ */
+template<typename Tabela>
+ResultadoDeduplicacao deduplicarArquivo(const std::string& arquivo, typename Tabela::TipoHash tipo,
+                                        const ConfiguracaoDeduplicacao& config = {}) {
+    static_assert(ehMotorTabela<Tabela>, "Tabela deve satisfazer a interface de MotorTabela.hpp");
+    static_assert(TemIteracao<Tabela>::value, "Tabela deve oferecer paraCada() para extrair as chaves únicas");
+    static_assert(TemCustoMemoria<Tabela>::value,
+                  "Tabela deve declarar BYTES_POR_POSICAO e bytesPorChave() para caber no orçamento");
+
+    std::unique_ptr<Tabela> tabela;
+    size_t capacidade = 0;
+    TabelaDeduplicacao operacoes;
+    // Duas posições por chave (fator de carga 0,5), o que o motor aloca por chave e a cópia das únicas
+    operacoes.bytesPorChave = 2 * Tabela::BYTES_POR_POSICAO + Tabela::bytesPorChave() + sizeof(int);
+    operacoes.iniciar = [&](size_t chaves) {
+        tabela.reset();
+        tabela = std::make_unique<Tabela>(TabelaRedimensionavel::proximoPrimo(2 * chaves + 1));
+        capacidade = chaves;
+    };
+    operacoes.inserir = [&](const int* chaves, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            tabela->inserir(chaves[i], tipo);
+        }
+        if (tabela->getNumElementos() > capacidade) {
+            throw std::runtime_error("Partição com mais de " + std::to_string(capacidade) +
+                                     " chaves distintas; aumente o orçamento de memória");
+        }
+    };
+    operacoes.extrair = [&](std::vector<int>& unicas) {
+        unicas.clear();
+        unicas.reserve(tabela->getNumElementos());
+        tabela->paraCada([&](int chave) { unicas.push_back(chave); });
+        tabela.reset();
+    };
+    return deduplicarExterno(arquivo, config, operacoes);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file DespachoCpu.hpp
+ * @brief Seleção em tempo de execução dos kernels SIMD (SSE2, AVX2, AVX-512)
+ *
+ * Um único executável, compilado para o x86-64 base, atende máquinas com
+ * conjuntos de instruções diferentes: os recursos da CPU são detectados uma
+ * vez (__builtin_cpu_supports) e cada kernel é ligado a um ponteiro de
+ * função da versão mais larga disponível. Os kernels vetoriais são
+ * compilados com atributos target, sem -march no projeto.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Kernels despachados:
+ * - sondarCelulas: varredura da sondagem linear da TabelaAberta, que
+ *   compara várias células por instrução (busca, remoção e inserção)
+ * - hashDivisaoLote / hashMultiplicacaoLote: as funções hash sobre um
+ *   vetor de chaves, com resultados idênticos às versões escalares das tabelas
+ *   (|k| em 64 bits, inclusive para INT_MIN)
+ * - localizarQuebra: fim de linha no CarregadorDados
+ *
+ * O nível pode ser forçado (--isa) para medir cada caminho na mesma máquina;
+ * a escolha deve acontecer antes de qualquer thread usar as tabelas.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+struct Celula;
+
+/**
+ * @brief Níveis de conjunto de instruções, do mais restrito ao mais largo
+ *
+ * Cada nível inclui os anteriores. AVX512 exige AVX-512F e AVX-512BW.
+ */
+enum class NivelIsa {
+    ESCALAR,    ///< Sem intrínsecos vetoriais
+    SSE2,       ///< 128 bits (base do x86-64)
+    AVX2,       ///< 256 bits
+    AVX512      ///< 512 bits
+};
+
+/**
+ * @brief Ponteiros para a implementação de cada kernel num nível de ISA
+ */
+struct KernelsSimd {
+    NivelIsa nivel;     ///< Nível ao qual os ponteiros pertencem
+
+    /**
+     * @brief Primeira célula de [inicio, fim) que encerra a sondagem linear
+     * @return Índice da célula, ou fim se nenhuma encerrar
+     *
+     * Busca: célula VAZIA ou OCUPADA com o valor. Inserção: célula não
+     * OCUPADA ou OCUPADA com o valor (duplicata).
+     */
+    size_t (*sondarCelulas)(const Celula* celulas, size_t inicio, size_t fim, int valor, bool paraInsercao);
+
+    /// indices[i] = |chaves[i]| mod tamanho
+    void (*hashDivisaoLote)(const int* chaves, size_t n, size_t tamanho, size_t* indices);
+
+    /// indices[i] = floor(tamanho * frac(|chaves[i]| * constante))
+    void (*hashMultiplicacaoLote)(const int* chaves, size_t n, size_t tamanho, double constante,
+                                  size_t* indices);
+
+    /// Primeiro '\n' de [inicio, fim), ou fim se não houver
+    const char* (*localizarQuebra)(const char* inicio, const char* fim);
+};
+
+/**
+ * @brief Pede à CPU a linha de cache do endereço, sem esperar por ela
+ *
+ * Apenas uma dica: não altera resultados e não falha com endereço inválido.
+ * Usada pelas buscas em lote dos motores para sobrepor as faltas de cache
+ * de várias chaves.
+ */
+inline void preBuscarLinha(const void* endereco) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(endereco, 0, 3);
+#else
+    (void)endereco;
+#endif
+}
+
+/**
+ * @brief Nome do nível na linha de comando e nos metadados
+ */
+const char* nomeIsa(NivelIsa nivel);
+
+/**
+ * @brief Converte o nome (escalar, sse2, avx2 ou avx512) no nível
+ * @throws std::invalid_argument se o nome for desconhecido
+ */
+NivelIsa isaPorNome(const std::string& nome);
+
+/**
+ * @brief Nível mais largo suportado pela CPU e pelo sistema operacional
+ *
+ * Detectado na primeira chamada; fora do x86-64 é sempre ESCALAR.
+ */
+NivelIsa isaDetectada();
+
+/**
+ * @brief Kernels em uso (por padrão, os do nível detectado)
+ */
+const KernelsSimd& kernelsSimd();
+
+/**
+ * @brief Força os kernels de um nível
+ * @param nivel Nível desejado
+ * @throws std::runtime_error se a CPU não suportar o nível
+ */
+void selecionarIsa(NivelIsa nivel);
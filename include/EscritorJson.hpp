@@ -0,0 +1,197 @@
+/**
+ * @file EscritorJson.hpp
+ * @brief Definição da classe EscritorJson para serialização JSON sem dependências
+ *
+ * O projeto não usa bibliotecas externas; esta classe gera JSON compacto
+ * (uma linha) para o histórico de resultados e demais exportações,
+ * cuidando do escape de strings e da separação por vírgulas.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+
+/**
+ * @brief Classe EscritorJson - Construtor incremental de documentos JSON
+ *
+ * Uso típico:
+ * @code
+ * EscritorJson json;
+ * json.abrirObjeto().campo("host", "maquina").abrirArray("valores");
+ * json.valor(1).valor(2).fecharArray().fecharObjeto();
+ * std::string texto = json.str(); // {"host":"maquina","valores":[1,2]}
+ * @endcode
+ *
+ * A classe não valida o aninhamento; chamadas desbalanceadas geram JSON inválido.
+ */
+class EscritorJson {
+private:
+    std::ostringstream saida;           ///< Documento em construção
+    std::vector<bool> primeiroNivel;    ///< Se o próximo item é o primeiro de cada nível aberto
+
+    /**
+     * @brief Escreve a vírgula separadora quando necessário
+     */
+    void separar() {
+        if (!primeiroNivel.empty()) {
+            if (!primeiroNivel.back()) {
+                saida << ',';
+            }
+            primeiroNivel.back() = false;
+        }
+    }
+
+    /**
+     * @brief Escreve o nome de um campo (vazio dentro de arrays)
+     * @param chave Nome do campo
+     */
+    void escreverChave(const std::string& chave) {
+        separar();
+        if (!chave.empty()) {
+            saida << '"' << escapar(chave) << "\":";
+        }
+    }
+
+    void escreverValor(const std::string& v) { saida << '"' << escapar(v) << '"'; }
+    void escreverValor(const char* v) { escreverValor(std::string(v)); }
+    void escreverValor(bool v) { saida << (v ? "true" : "false"); }
+
+    /**
+     * @brief Escreve um valor numérico
+     *
+     * NaN e infinito não existem em JSON e são escritos como null.
+     */
+    template<typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> escreverValor(T v) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(v)) {
+                saida << "null";
+                return;
+            }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.6g", static_cast<double>(v));
+            saida << buffer;
+        } else {
+            saida << +v;
+        }
+    }
+
+public:
+    /**
+     * @brief Abre um objeto
+     * @param chave Nome do campo (vazio na raiz ou dentro de arrays)
+     * @return Referência para encadeamento
+     */
+    EscritorJson& abrirObjeto(const std::string& chave = "") {
+        escreverChave(chave);
+        saida << '{';
+        primeiroNivel.push_back(true);
+        return *this;
+    }
+
+    /**
+     * @brief Fecha o objeto aberto mais recentemente
+     * @return Referência para encadeamento
+     */
+    EscritorJson& fecharObjeto() {
+        saida << '}';
+        primeiroNivel.pop_back();
+        return *this;
+    }
+
+    /**
+     * @brief Abre um array
+     * @param chave Nome do campo (vazio na raiz ou dentro de arrays)
+     * @return Referência para encadeamento
+     */
+    EscritorJson& abrirArray(const std::string& chave = "") {
+        escreverChave(chave);
+        saida << '[';
+        primeiroNivel.push_back(true);
+        return *this;
+    }
+
+    /**
+     * @brief Fecha o array aberto mais recentemente
+     * @return Referência para encadeamento
+     */
+    EscritorJson& fecharArray() {
+        saida << ']';
+        primeiroNivel.pop_back();
+        return *this;
+    }
+
+    /**
+     * @brief Escreve um campo nome/valor dentro de um objeto
+     * @tparam T String, booleano ou tipo numérico
+     * @param chave Nome do campo
+     * @param v Valor do campo
+     * @return Referência para encadeamento
+     */
+    template<typename T>
+    EscritorJson& campo(const std::string& chave, const T& v) {
+        escreverChave(chave);
+        escreverValor(v);
+        return *this;
+    }
+
+    /**
+     * @brief Escreve um elemento dentro de um array
+     * @tparam T String, booleano ou tipo numérico
+     * @param v Valor do elemento
+     * @return Referência para encadeamento
+     */
+    template<typename T>
+    EscritorJson& valor(const T& v) {
+        separar();
+        escreverValor(v);
+        return *this;
+    }
+
+    /**
+     * @brief Obtém o documento gerado
+     * @return Texto JSON
+     */
+    std::string str() const {
+        return saida.str();
+    }
+
+    /**
+     * @brief Escapa uma string conforme a especificação JSON
+     * @param texto Texto original (UTF-8)
+     * @return Texto com aspas, barras e caracteres de controle escapados
+     */
+    static std::string escapar(const std::string& texto) {
+        std::string resultado;
+        resultado.reserve(texto.size());
+        for (unsigned char c : texto) {
+            switch (c) {
+                case '"':  resultado += "\\\""; break;
+                case '\\': resultado += "\\\\"; break;
+                case '\n': resultado += "\\n"; break;
+                case '\r': resultado += "\\r"; break;
+                case '\t': resultado += "\\t"; break;
+                default:
+                    if (c < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                        resultado += buffer;
+                    } else {
+                        resultado += static_cast<char>(c);
+                    }
+                    break;
+            }
+        }
+        return resultado;
+    }
+};
@@ -0,0 +1,125 @@
+/**
+ * @file Estatistica.hpp
+ * @brief Testes estatísticos para comparar amostras de tempos
+ *
+ * Fornece o teste U de Mann-Whitney (não paramétrico, adequado a tempos
+ * com distribuição assimétrica e outliers), o tamanho de efeito delta de
+ * Cliff e a correção de Holm-Bonferroni para múltiplas comparações. São
+ * usados pelo BenchmarkManager para decidir se a diferença entre duas
+ * configurações é real ou apenas ruído de medição.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Características principais:
+ * - Distribuição exata de U para amostras pequenas sem empates
+ * - Aproximação normal com correção de empates e de continuidade nos demais casos
+ * - Classificação do efeito (Romano et al., 2006): desprezível, pequeno, médio, grande
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+/**
+ * @brief Resultado do teste U de Mann-Whitney bilateral
+ */
+struct ResultadoMannWhitney {
+    double u;           ///< Estatística U da primeira amostra
+    double pValor;      ///< p-valor bilateral
+    bool exato;         ///< true se calculado pela distribuição exata
+};
+
+/**
+ * @brief Intervalo de confiança de um quantil, sem hipótese de distribuição
+ */
+struct IntervaloQuantil {
+    double estimativa;  ///< Quantil da amostra
+    double inferior;    ///< Limite inferior (estatística de ordem)
+    double superior;    ///< Limite superior (estatística de ordem)
+    bool valido;        ///< false se a amostra é pequena demais para a confiança pedida
+
+    /**
+     * @brief Semiamplitude relativa do intervalo
+     * @return (superior - inferior) / (2 * estimativa), ou infinito se inválido
+     */
+    double semiamplitudeRelativa() const;
+};
+
+/**
+ * @brief Calcula a mediana de uma amostra
+ * @param amostra Valores (copiados para ordenação parcial)
+ * @return Mediana, ou NaN se a amostra estiver vazia
+ */
+double mediana(std::vector<double> amostra);
+
+/**
+ * @brief Calcula o coeficiente de variação de uma amostra
+ * @param amostra Valores
+ * @return Desvio padrão amostral (n - 1) dividido pela média, ou NaN com
+ *         menos de dois valores ou média nula
+ */
+double coeficienteVariacao(const std::vector<double>& amostra);
+
+/**
+ * @brief Intervalo de confiança de um quantil por estatísticas de ordem
+ * @param amostra Valores (copiados para ordenação)
+ * @param q Quantil entre 0 e 1 (0,5 para a mediana)
+ * @param confianca Nível de confiança, por exemplo 0,95
+ * @return Estimativa e limites; a mediana usa mediana(), os demais
+ *         quantis o posto mais próximo
+ *
+ * O número de valores abaixo do quantil populacional segue Binomial(n, q),
+ * o que dá os postos dos limites sem supor normalidade dos tempos. Com
+ * poucos valores não há postos que atinjam a confiança e o intervalo é
+ * inválido: a mediana com 95% exige n >= 6 e o p99, n >= 368.
+ *
+ * @complexity O(n log n)
+ */
+IntervaloQuantil intervaloQuantil(std::vector<double> amostra, double q, double confianca);
+
+/**
+ * @brief Teste U de Mann-Whitney bilateral entre duas amostras independentes
+ * @param a Primeira amostra
+ * @param b Segunda amostra
+ * @return Estatística U e p-valor
+ * @throws std::invalid_argument se alguma amostra estiver vazia
+ *
+ * Usa a distribuição exata quando não há empates e ambas as amostras têm
+ * até 20 elementos; caso contrário, a aproximação normal.
+ *
+ * @complexity O((n1 + n2) log(n1 + n2)), ou O(n1² n2²) no caso exato
+ */
+ResultadoMannWhitney testeMannWhitney(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Tamanho de efeito delta de Cliff
+ * @param a Primeira amostra
+ * @param b Segunda amostra
+ * @return (#(a > b) - #(a < b)) / (n1 * n2), entre -1 e 1
+ *
+ * Para tempos, delta negativo indica que a é mais rápida que b.
+ *
+ * @complexity O(n1 * n2)
+ */
+double deltaCliff(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Classifica a magnitude do delta de Cliff
+ * @param delta Valor do delta
+ * @return "desprezivel" (< 0,147), "pequeno" (< 0,33), "medio" (< 0,474) ou "grande"
+ */
+std::string magnitudeEfeito(double delta);
+
+/**
+ * @brief Ajusta p-valores pela correção de Holm-Bonferroni
+ * @param pValores p-valores das comparações de uma mesma família
+ * @return p-valores ajustados, na mesma ordem da entrada
+ *
+ * Controla a taxa de erro da família sem a perda de poder da correção
+ * de Bonferroni simples.
+ */
+std::vector<double> ajustarHolm(const std::vector<double>& pValores);
@@ -0,0 +1,107 @@
+/**
+ * @file GeradorCarga.hpp
+ * @brief Cliente gerador de carga para o modo servidor (--carga)
+ *
+ * Abre várias conexões com um ServidorTabela e envia lotes de operações
+ * com pipelining: cada conexão mantém até `profundidade` lotes em voo,
+ * enviando o próximo assim que um é respondido. Mede a vazão agregada e a
+ * latência de cada lote, do envio à resposta completa, como vista pelo
+ * cliente (inclui a espera na fila do servidor).
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Antes da medição, as chaves pares de [0, chaves) são inseridas por uma
+ * das conexões, de modo que metade das buscas uniformes encontre a chave.
+ */
+
+#pragma once
+
+#include "ConfiguracaoBenchmark.hpp"
+#include "ProtocoloKv.hpp"
+
+#include <cstddef>
+#include <string>
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Parâmetros da carga
+ */
+struct ConfiguracaoCarga {
+    size_t conexoes = 4;                        ///< Conexões (uma thread cada)
+    size_t profundidade = 16;                   ///< Lotes em voo por conexão
+    size_t lote = 64;                           ///< Operações por lote
+    size_t operacoes = 1000000;                 ///< Total de operações medidas
+    MisturaOperacoes mistura{90, 5, 5};         ///< Percentuais de GET, PUT e DEL
+    size_t chaves = 100000;                     ///< Chaves sorteadas uniformemente em [0, chaves)
+    unsigned int semente = 42;                  ///< Semente (somada ao índice da conexão)
+};
+
+/**
+ * @brief Resultado agregado de todas as conexões
+ */
+struct ResultadoCarga {
+    size_t operacoes = 0;           ///< Operações respondidas
+    size_t lotes = 0;               ///< Lotes respondidos
+    double segundos = 0.0;          ///< Duração da fase medida
+    double operacoesPorSegundo = 0.0;
+    double usMedio = 0.0;           ///< Latência média por lote
+    double usP50 = 0.0;             ///< Mediana da latência por lote
+    double usP90 = 0.0;             ///< Percentil 90
+    double usP99 = 0.0;             ///< Percentil 99
+    double usP999 = 0.0;            ///< Percentil 99,9
+    double usMaximo = 0.0;          ///< Maior latência observada
+    size_t buscas = 0;              ///< GET enviados
+    size_t acertos = 0;             ///< GET com a chave presente
+    size_t insercoes = 0;           ///< PUT enviados
+    size_t insercoesNovas = 0;      ///< PUT de chave ausente
+    size_t remocoes = 0;            ///< DEL enviados
+    size_t remocoesEfetivas = 0;    ///< DEL de chave presente
+    size_t erros = 0;               ///< Operações com ResultadoKv::ERRO
+};
+
+/**
+ * @brief Classe GeradorCarga - Mede um servidor por várias conexões com pipelining
+ */
+class GeradorCarga {
+private:
+    EnderecoKv endereco;            ///< Servidor
+    ConfiguracaoCarga config;       ///< Parâmetros
+    ResultadoCarga resultado;       ///< Preenchido por executar()
+
+public:
+    /**
+     * @brief Construtor
+     * @param enderecoServidor Endereço do servidor
+     * @param configuracao Parâmetros da carga
+     * @throws std::invalid_argument se algum parâmetro for zero, o lote
+     *         exceder KV_MAX_OPERACOES ou a mistura não somar 100
+     */
+    GeradorCarga(const EnderecoKv& enderecoServidor, const ConfiguracaoCarga& configuracao);
+
+    /**
+     * @brief Conecta, pré-carrega as chaves pares e executa a fase medida
+     * @throws std::runtime_error se a conexão falhar ou o servidor responder
+     *         fora do protocolo
+     */
+    void executar();
+
+    /**
+     * @brief Imprime vazão, percentis de latência e contagens
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva o resultado em arquivo CSV
+     * @param arquivo Caminho do arquivo de saída
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+
+    /// Resultado da última execução
+    const ResultadoCarga& getResultado() const { return resultado; }
+};
@@ -0,0 +1,103 @@
+/**
+ * @file JuncaoHash.hpp
+ * @brief Junção hash de duas colunas de inteiros, com e sem particionamento radix
+ *
+ * Junta uma coluna de construção e uma de sondagem (por exemplo, dois
+ * datasets do CarregadorDados) pela igualdade das chaves e devolve o número
+ * de correspondências ou os pares de linhas correspondentes.
+ *
+ * - juntarSemParticao(): uma única tabela de sondagem linear com todas as
+ *   linhas da construção, consultada em paralelo. Para colunas grandes, cada
+ *   consulta é uma falta de cache (e, em geral, de TLB).
+ * - juntarParticionado(): as duas colunas são particionadas em paralelo
+ *   pelos bits baixos do hash (radix), em uma ou duas passagens, até que a
+ *   tabela de cada partição caiba em ConfiguracaoJuncao::bytesParticao. As
+ *   partições são então juntadas de forma independente, distribuídas entre
+ *   as threads, cada uma com uma tabela pequena que fica na cache.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * As tabelas seguem o arranjo da TabelaAberta (sondagem linear, fator de
+ * carga de no máximo 0,5), mas cada célula guarda a chave e a linha de
+ * origem, e chaves repetidas na construção ocupam células próprias: a
+ * sondagem percorre o cluster até a célula vazia e emite todas as que
+ * coincidem. As consultas são feitas em lotes, com pré-busca das células.
+ * O hash é um misturador de 64 bits: os bits baixos escolhem a partição e
+ * os seguintes, a célula, para que os dois sejam independentes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Paralelismo e tamanho das partições da junção
+ */
+struct ConfiguracaoJuncao {
+    size_t threads = 1;                 ///< Threads do particionamento e da junção (0 = núcleos disponíveis)
+    size_t bitsRadix = 0;               ///< Bits de partição (0 = escolhidos por bytesParticao)
+    size_t bytesParticao = 256 * 1024;  ///< Tamanho alvo da tabela de cada partição
+};
+
+/**
+ * @brief Par de linhas com a mesma chave
+ */
+struct ParJuncao {
+    uint32_t linhaConstrucao;   ///< Índice na coluna de construção
+    uint32_t linhaSonda;        ///< Índice na coluna de sondagem
+};
+
+/**
+ * @brief Resultado e tempos de uma junção
+ */
+struct ResultadoJuncao {
+    uint64_t correspondencias = 0;  ///< Pares de linhas com a mesma chave
+    std::vector<ParJuncao> pares;   ///< Os pares, em ordem não especificada (só se emitirPares)
+    size_t particoes = 1;           ///< Partições juntadas (1 sem particionamento)
+    size_t passagens = 0;           ///< Passagens de particionamento (0, 1 ou 2)
+    double msParticionamento = 0.0; ///< Particionamento das duas colunas
+    double msJuncao = 0.0;          ///< Construção das tabelas e sondagem
+};
+
+/// Bits de partição por passagem: acima disso, as escritas espalhadas excedem a TLB
+constexpr size_t BITS_POR_PASSAGEM = 10;
+
+/**
+ * @brief Bits de partição para uma coluna de construção
+ * @param linhasConstrucao Linhas da coluna de construção
+ * @param config bitsRadix, se diferente de zero; senão, o menor número de
+ *        bits com a tabela de cada partição em bytesParticao e ao menos uma
+ *        partição por thread
+ * @return Bits de partição, no máximo 2 * BITS_POR_PASSAGEM
+ * @throws std::invalid_argument se bitsRadix passar de 2 * BITS_POR_PASSAGEM
+ *         ou bytesParticao for zero
+ */
+size_t bitsParticao(size_t linhasConstrucao, const ConfiguracaoJuncao& config);
+
+/**
+ * @brief Junção particionada (radix)
+ * @param construcao Coluna cujas partições viram tabelas
+ * @param sonda Coluna consultada nas tabelas
+ * @param emitirPares true: preenche ResultadoJuncao::pares; false: só conta
+ * @param config Threads e tamanho das partições
+ * @throws std::invalid_argument se uma coluna tiver 2^32 - 1 linhas ou mais,
+ *         ou se a configuração for inválida (ver bitsParticao)
+ */
+ResultadoJuncao juntarParticionado(const std::vector<int>& construcao, const std::vector<int>& sonda,
+                                   bool emitirPares, const ConfiguracaoJuncao& config = {});
+
+/**
+ * @brief Junção com uma única tabela, construída numa thread e consultada em paralelo
+ * @param construcao Coluna carregada na tabela
+ * @param sonda Coluna consultada, dividida em partes contíguas entre as threads
+ * @param emitirPares true: preenche ResultadoJuncao::pares; false: só conta
+ * @param config Threads da sondagem (os demais campos são ignorados)
+ * @throws std::invalid_argument se uma coluna tiver 2^32 - 1 linhas ou mais
+ */
+ResultadoJuncao juntarSemParticao(const std::vector<int>& construcao, const std::vector<int>& sonda,
+                                  bool emitirPares, const ConfiguracaoJuncao& config = {});
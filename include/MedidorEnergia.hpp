@@ -0,0 +1,100 @@
+/**
+ * @file MedidorEnergia.hpp
+ * @brief Energia consumida pelas fases do benchmark via Linux RAPL (powercap)
+ *
+ * Lê os contadores de energia acumulada expostos em
+ * /sys/class/powercap/intel-rapl:* (pacote) e nas subzonas "dram" de cada
+ * pacote. A diferença entre duas leituras, corrigida para o retorno do
+ * contador a zero, é a energia gasta no intervalo em todos os pacotes.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Limitações:
+ * - A energia é do pacote inteiro, não do processo: outras cargas da
+ *   máquina entram na medição
+ * - Os contadores são atualizados a cada ~1 ms; fases mais curtas que
+ *   alguns milissegundos dão valores pouco significativos
+ * - Em kernels recentes energy_uj só pode ser lido pelo root; sem
+ *   permissão (ou sem RAPL, como em VMs e fora do x86) o medidor fica
+ *   indisponível e o benchmark segue sem energia
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Energia de um intervalo, em joules
+ */
+struct ConsumoEnergia {
+    double pacote = 0.0;  ///< Domínio package (núcleos, caches e uncore)
+    double dram = 0.0;    ///< Domínio DRAM (0 se a plataforma não o expõe)
+
+    /// Energia total do intervalo
+    double total() const { return pacote + dram; }
+};
+
+/**
+ * @brief Classe MedidorEnergia - Leitura dos contadores RAPL do powercap
+ *
+ * Uso: ler() antes e depois da região medida e consumo(inicio, fim).
+ * As leituras abrem os arquivos do sysfs e devem ficar fora da região
+ * cronometrada.
+ */
+class MedidorEnergia {
+public:
+    /// Valores de energy_uj de cada domínio, na ordem de descoberta
+    using Leitura = std::vector<uint64_t>;
+
+private:
+    /**
+     * @brief Um contador de energia (pacote ou DRAM de um pacote)
+     */
+    struct Dominio {
+        std::string arquivo;   ///< Caminho do energy_uj
+        bool dram;             ///< true para subzona dram
+        uint64_t faixa;        ///< max_energy_range_uj (retorno a zero)
+    };
+
+    std::vector<Dominio> dominios;  ///< Domínios legíveis
+    std::string motivo;             ///< Por que o medidor está indisponível
+
+public:
+    /**
+     * @brief Descobre os domínios de pacote e DRAM
+     * @param raiz Diretório do powercap (parametrizado para testes manuais)
+     *
+     * Não lança exceções: qualquer falha deixa o medidor indisponível, com
+     * o motivo em getMotivoIndisponivel().
+     */
+    explicit MedidorEnergia(const std::string& raiz = "/sys/class/powercap");
+
+    /// Verifica se há pelo menos um domínio de pacote legível
+    bool disponivel() const { return !dominios.empty(); }
+
+    /// Motivo da indisponibilidade (vazio se disponível)
+    const std::string& getMotivoIndisponivel() const { return motivo; }
+
+    /// Descrição dos domínios encontrados, por exemplo "2 pacote(s), 2 DRAM"
+    std::string descricao() const;
+
+    /**
+     * @brief Lê todos os contadores
+     * @return Leitura (vazia se indisponível)
+     * @throws std::runtime_error se um contador deixar de ser legível
+     */
+    Leitura ler() const;
+
+    /**
+     * @brief Energia entre duas leituras
+     * @param inicio Leitura anterior
+     * @param fim Leitura posterior
+     * @return Joules de pacote e DRAM somados sobre todos os pacotes
+     */
+    ConsumoEnergia consumo(const Leitura& inicio, const Leitura& fim) const;
+};
@@ -0,0 +1,101 @@
+/**
+ * @file MetadadosExecucao.hpp
+ * @brief Metadados que identificam uma execução dos benchmarks
+ *
+ * Cada execução registrada no histórico de resultados carrega a revisão
+ * do código, a data, a máquina em que foi feita e o ambiente de hardware,
+ * sistema e compilação, permitindo comparar resultados ao longo do tempo,
+ * entre alterações e entre máquinas. Os CSVs dos modos (varredura,
+ * alocadores, junção etc.) repetem a semente e o ambiente em cada linha.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <string>
+#include <ostream>
+
+#include "EscritorJson.hpp"
+
+/**
+ * @brief Estrutura com a identificação de uma execução
+ */
+struct MetadadosExecucao {
+    std::string revisaoGit;  ///< Revisão git do build (InfoBuild.hpp)
+    std::string dataHora;    ///< Data e hora UTC no formato ISO 8601
+    std::string host;        ///< Nome da máquina
+    std::string modeloCpu;   ///< Modelo do processador (/proc/cpuinfo)
+    unsigned int nucleos;    ///< Threads de hardware disponíveis
+    std::string governador;  ///< Governador de frequência da cpu0 (cpufreq)
+    std::string isa;         ///< Nível dos kernels SIMD em uso (DespachoCpu.hpp)
+    std::string kernel;      ///< Sistema operacional e versão do kernel
+    std::string compilador;  ///< Compilador e versão (InfoBuild.hpp)
+    std::string tipoBuild;   ///< Tipo de build do CMake
+    std::string flags;       ///< Flags de compilação efetivas
+    unsigned int semente = 0; ///< Semente dos geradores da execução
+
+    /// Colunas de identificação anexadas a cada linha dos CSVs dos modos (valores de valoresCsv())
+    static constexpr const char* CABECALHO_CSV =
+        "Semente,Revisao,Data,Host,Cpu,Nucleos,Governador,Isa,Kernel,Compilador,TipoBuild,Flags";
+
+    /**
+     * @brief Valores das colunas de CABECALHO_CSV, separados por vírgula
+     * @return Textos com vírgula ou aspas entre aspas (RFC 4180)
+     */
+    std::string valoresCsv() const {
+        auto texto = [](const std::string& valor) {
+            if (valor.find_first_of(",\"\n") == std::string::npos) {
+                return valor;
+            }
+            std::string citado = "\"";
+            for (char c : valor) {
+                citado += c;
+                if (c == '"') citado += '"';
+            }
+            return citado + "\"";
+        };
+        return std::to_string(semente) + "," + texto(revisaoGit) + "," + texto(dataHora) + "," + texto(host) + "," +
+               texto(modeloCpu) + "," + std::to_string(nucleos) + "," + texto(governador) + "," + texto(isa) + "," +
+               texto(kernel) + "," + texto(compilador) + "," + texto(tipoBuild) + "," + texto(flags);
+    }
+
+    /**
+     * @brief Escreve os metadados como campos do objeto JSON aberto
+     * @param json Escritor posicionado dentro de um objeto
+     */
+    void escreverJson(EscritorJson& json) const {
+        json.campo("revisao", revisaoGit)
+            .campo("data", dataHora)
+            .campo("host", host)
+            .abrirObjeto("ambiente")
+            .campo("cpu", modeloCpu)
+            .campo("nucleos", nucleos)
+            .campo("governador", governador)
+            .campo("isa", isa)
+            .campo("kernel", kernel)
+            .campo("compilador", compilador)
+            .campo("tipoBuild", tipoBuild)
+            .campo("flags", flags)
+            .fecharObjeto();
+    }
+
+    /**
+     * @brief Imprime o ambiente da execução, uma informação por linha
+     * @param saida Fluxo de saída
+     */
+    void imprimir(std::ostream& saida) const;
+};
+
+/**
+ * @brief Coleta os metadados da execução atual
+ * @return Metadados preenchidos
+ *
+ * O nome da máquina vem de gethostname() em sistemas POSIX e da
+ * variável COMPUTERNAME no Windows. Modelo da CPU e governador são lidos
+ * de /proc e /sys no Linux; quando indisponíveis ficam "desconhecido".
+ */
+MetadadosExecucao coletarMetadadosExecucao();
@@ -0,0 +1,137 @@
+/**
+ * @file ModeloSondagem.hpp
+ * @brief Número esperado de sondagens segundo a análise clássica de Knuth
+ *
+ * Fornece as fórmulas de custo esperado de busca em função do fator de
+ * carga α, sob a hipótese de hashing uniforme. O BenchmarkManager as compara
+ * com as sondagens medidas em TabelaAberta::analisarSondagem e
+ * TabelaEncadeada::obterEstatisticas: um desvio grande indica que a
+ * combinação de função hash, tamanho e dataset foge do comportamento
+ * uniforme (clustering, listas desbalanceadas).
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Referência: D. E. Knuth, The Art of Computer Programming, vol. 3, seção 6.4.
+ *
+ * Cada motor declara o seu modelo em MODELO_SONDAGEM (ver MotorTabela.hpp);
+ * motores sem declaração ficam sem valores teóricos.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Modelo teórico de sondagens de um motor
+ */
+enum class ModeloSondagem {
+    NENHUM,          ///< Sem modelo: teóricos zerados e desvios não avaliados
+    ENCADEAMENTO,    ///< Listas encadeadas (busca malsucedida não analisada)
+    SONDAGEM_LINEAR  ///< Endereçamento aberto com sondagem linear
+};
+
+/**
+ * @brief Nome do modelo no CSV
+ * @param modelo Modelo de sondagem
+ * @return "Encadeamento", "Linear" ou "-"
+ */
+inline const char* nomeModeloSondagem(ModeloSondagem modelo) {
+    switch (modelo) {
+        case ModeloSondagem::ENCADEAMENTO: return "Encadeamento";
+        case ModeloSondagem::SONDAGEM_LINEAR: return "Linear";
+        case ModeloSondagem::NENHUM: break;
+    }
+    return "-";
+}
+
+/**
+ * @brief Interpreta o nome gravado por nomeModeloSondagem
+ * @param nome Nome no CSV
+ * @return Modelo correspondente
+ * @throws std::invalid_argument se o nome for desconhecido
+ */
+inline ModeloSondagem lerModeloSondagem(const std::string& nome) {
+    for (auto modelo : {ModeloSondagem::NENHUM, ModeloSondagem::ENCADEAMENTO, ModeloSondagem::SONDAGEM_LINEAR}) {
+        if (nome == nomeModeloSondagem(modelo)) {
+            return modelo;
+        }
+    }
+    throw std::invalid_argument("Modelo de sondagem desconhecido: " + nome);
+}
+
+/**
+ * @brief Sondagens esperadas em busca bem-sucedida com sondagem linear
+ * @param alfa Fator de carga (0 <= α < 1)
+ * @return ½(1 + 1/(1 − α)), ou infinito se α >= 1
+ */
+inline double sondagensTeoricasSucessoLinear(double alfa) {
+    if (alfa >= 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 0.5 * (1.0 + 1.0 / (1.0 - alfa));
+}
+
+/**
+ * @brief Sondagens esperadas em busca malsucedida com sondagem linear
+ * @param alfa Fator de carga (0 <= α < 1)
+ * @return ½(1 + 1/(1 − α)²), ou infinito se α >= 1
+ */
+inline double sondagensTeoricasInsucessoLinear(double alfa) {
+    if (alfa >= 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 0.5 * (1.0 + 1.0 / ((1.0 - alfa) * (1.0 - alfa)));
+}
+
+/**
+ * @brief Nós examinados esperados em busca bem-sucedida com encadeamento
+ * @param alfa Fator de carga (pode ser maior que 1)
+ * @return 1 + α/2
+ */
+inline double sondagensTeoricasSucessoEncadeada(double alfa) {
+    return 1.0 + alfa / 2.0;
+}
+
+/**
+ * @brief Sondagens esperadas em busca bem-sucedida segundo o modelo
+ * @param modelo Modelo do motor
+ * @param alfa Fator de carga
+ * @return Valor teórico, ou 0 sem modelo
+ */
+inline double sondagensTeoricasSucesso(ModeloSondagem modelo, double alfa) {
+    switch (modelo) {
+        case ModeloSondagem::ENCADEAMENTO: return sondagensTeoricasSucessoEncadeada(alfa);
+        case ModeloSondagem::SONDAGEM_LINEAR: return sondagensTeoricasSucessoLinear(alfa);
+        case ModeloSondagem::NENHUM: break;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Sondagens esperadas em busca malsucedida segundo o modelo
+ * @param modelo Modelo do motor
+ * @param alfa Fator de carga
+ * @return Valor teórico, ou 0 quando o modelo não a analisa
+ */
+inline double sondagensTeoricasInsucesso(ModeloSondagem modelo, double alfa) {
+    return modelo == ModeloSondagem::SONDAGEM_LINEAR ? sondagensTeoricasInsucessoLinear(alfa) : 0.0;
+}
+
+/**
+ * @brief Desvio relativo entre valor medido e teórico
+ * @param medido Valor medido
+ * @param teorico Valor esperado (positivo)
+ * @return (medido − teórico) / teórico; positivo quando o medido é pior
+ */
+inline double desvioRelativo(double medido, double teorico) {
+    if (!(teorico > 0.0) || std::isinf(teorico)) {
+        return 0.0;
+    }
+    return (medido - teorico) / teorico;
+}
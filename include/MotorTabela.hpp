@@ -0,0 +1,141 @@
+/**
+ * @file MotorTabela.hpp
+ * @brief Interface exigida de um motor de tabela hash pelo benchmark
+ *
+ * Descreve, com o idioma de detecção do C++17 (std::void_t), as operações
+ * que o BenchmarkManager usa de um motor. O cenário é executado por um
+ * único template sobre o tipo concreto do motor, de modo que as chamadas
+ * dentro das regiões cronometradas são diretas (sem funções virtuais) e
+ * podem ser inlinadas.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Um motor T conforme oferece:
+ * - T::TipoHash com os enumeradores DIVISAO e MULTIPLICACAO
+ * - Construtor T(size_t tamanho)
+ * - inserir(int, TipoHash), que lança std::runtime_error ao recusar a chave
+ * - buscar(int, TipoHash) const, convertível para bool
+ * - remover(int, TipoHash)
+ * - getNumElementos(), getTamanho() e fatorCarga() const
+ *
+ * Capacidades opcionais, detectadas à parte, enriquecem as estatísticas:
+ * - analisarSondagem(TipoHash) const com sondagemMedia e
+ *   sondagemMediaInsucesso (endereçamento aberto)
+ * - obterEstatisticas() const com sondagemMediaSucesso (encadeamento)
+ * - paraCada(f) const, que visita cada chave (exigido pela TabelaDuravel
+ *   e pelas operações de conjunto)
+ * - buscarLote(const int*, size_t, TipoHash, uint8_t*) const, busca de
+ *   várias chaves com pré-busca (usada pelas operações de conjunto)
+ * - static constexpr ModeloSondagem MODELO_SONDAGEM, modelo teórico contra
+ *   o qual as sondagens medidas são comparadas (sem ele, NENHUM)
+ * - static constexpr size_t BYTES_POR_POSICAO e static size_t
+ *   bytesPorChave(): bytes do array principal por posição e bytes
+ *   alocados à parte por chave guardada (exigidos pela deduplicação com
+ *   orçamento de memória)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "ModeloSondagem.hpp"
+
+/**
+ * @brief Verifica se T satisfaz a interface de motor (falso por padrão)
+ */
+template<typename T, typename = void>
+struct EhMotorTabela : std::false_type {};
+
+/**
+ * @brief Especialização escolhida quando todas as expressões são válidas
+ */
+template<typename T>
+struct EhMotorTabela<T, std::void_t<
+    decltype(T::TipoHash::DIVISAO),
+    decltype(T::TipoHash::MULTIPLICACAO),
+    decltype(T(std::declval<size_t>())),
+    decltype(std::declval<T&>().inserir(0, std::declval<typename T::TipoHash>())),
+    decltype(static_cast<bool>(std::declval<const T&>().buscar(0, std::declval<typename T::TipoHash>()))),
+    decltype(std::declval<T&>().remover(0, std::declval<typename T::TipoHash>())),
+    decltype(static_cast<size_t>(std::declval<const T&>().getNumElementos())),
+    decltype(static_cast<size_t>(std::declval<const T&>().getTamanho())),
+    decltype(static_cast<double>(std::declval<const T&>().fatorCarga()))>> : std::true_type {};
+
+/// true se T pode ser medido pelo BenchmarkManager
+template<typename T>
+inline constexpr bool ehMotorTabela = EhMotorTabela<T>::value;
+
+/**
+ * @brief Detecta analisarSondagem(TipoHash) (sondagens de endereçamento aberto)
+ */
+template<typename T, typename = void>
+struct TemAnaliseSondagem : std::false_type {};
+
+template<typename T>
+struct TemAnaliseSondagem<T, std::void_t<
+    decltype(std::declval<const T&>().analisarSondagem(std::declval<typename T::TipoHash>()).sondagemMedia),
+    decltype(std::declval<const T&>().analisarSondagem(std::declval<typename T::TipoHash>()).sondagemMediaInsucesso)>>
+    : std::true_type {};
+
+/**
+ * @brief Modelo de sondagem declarado em T::MODELO_SONDAGEM (NENHUM por padrão)
+ */
+template<typename T, typename = void>
+struct ModeloSondagemMotor : std::integral_constant<ModeloSondagem, ModeloSondagem::NENHUM> {};
+
+template<typename T>
+struct ModeloSondagemMotor<T, std::void_t<decltype(T::MODELO_SONDAGEM)>>
+    : std::integral_constant<ModeloSondagem, T::MODELO_SONDAGEM> {};
+
+/// Modelo de sondagem do motor T
+template<typename T>
+inline constexpr ModeloSondagem modeloSondagemMotor = ModeloSondagemMotor<T>::value;
+
+/**
+ * @brief Detecta obterEstatisticas() (posição média na lista, encadeamento)
+ */
+template<typename T, typename = void>
+struct TemEstatisticasDistribuicao : std::false_type {};
+
+template<typename T>
+struct TemEstatisticasDistribuicao<T, std::void_t<
+    decltype(std::declval<const T&>().obterEstatisticas().sondagemMediaSucesso)>> : std::true_type {};
+
+/**
+ * @brief Detecta BYTES_POR_POSICAO e bytesPorChave() (memória ocupada pelo motor)
+ */
+template<typename T, typename = void>
+struct TemCustoMemoria : std::false_type {};
+
+template<typename T>
+struct TemCustoMemoria<T, std::void_t<
+    decltype(static_cast<size_t>(T::BYTES_POR_POSICAO)),
+    decltype(static_cast<size_t>(T::bytesPorChave()))>> : std::true_type {};
+
+/**
+ * @brief Detecta paraCada(f) (enumeração das chaves, usada em snapshots)
+ */
+template<typename T, typename = void>
+struct TemIteracao : std::false_type {};
+
+template<typename T>
+struct TemIteracao<T, std::void_t<
+    decltype(std::declval<const T&>().paraCada(std::declval<void (*)(int)>()))>> : std::true_type {};
+
+/**
+ * @brief Detecta buscarLote(chaves, n, tipo, encontrados) (busca em lote com pré-busca)
+ */
+template<typename T, typename = void>
+struct TemBuscaLote : std::false_type {};
+
+template<typename T>
+struct TemBuscaLote<T, std::void_t<
+    decltype(std::declval<const T&>().buscarLote(std::declval<const int*>(), size_t{},
+                                                  std::declval<typename T::TipoHash>(),
+                                                  std::declval<uint8_t*>()))>> : std::true_type {};
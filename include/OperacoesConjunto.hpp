@@ -0,0 +1,192 @@
+/**
+ * @file OperacoesConjunto.hpp
+ * @brief União, interseção e diferença entre tabelas, em lote e em paralelo
+ *
+ * Substitui o laço que percorre um vetor chamando buscar() numa tabela por
+ * chave. As chaves consultadas são divididas em partições contíguas, uma
+ * por thread, e cada partição é consultada em blocos com buscarLote() do
+ * motor, que pré-busca as células de várias chaves antes de sondá-las.
+ * Motores sem buscarLote() são consultados chave a chave.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * As operações entre tabelas exigem paraCada() (MotorTabela.hpp) e
+ * produzem um vetor de chaves, na ordem de enumeração das tabelas; uma
+ * tabela nova é obtida com construirTabela(). As buscas concorrentes só
+ * leem as tabelas, que não podem ser alteradas durante a operação.
+ */
+
+#pragma once
+
+#include "MotorTabela.hpp"
+#include "TabelaRedimensionavel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Paralelismo das operações de conjunto
+ */
+struct ConfiguracaoConjunto {
+    size_t threads = 1;         ///< Partições consultadas em paralelo (0 = núcleos disponíveis)
+    size_t bloco = 4096;        ///< Chaves por chamada de buscarLote
+};
+
+/**
+ * @brief Chaves de uma tabela, na ordem de paraCada()
+ */
+template<typename Tabela>
+std::vector<int> chavesDaTabela(const Tabela& tabela) {
+    static_assert(TemIteracao<Tabela>::value, "Tabela deve oferecer paraCada() para as operações de conjunto");
+    std::vector<int> chaves;
+    chaves.reserve(tabela.getNumElementos());
+    tabela.paraCada([&](int chave) { chaves.push_back(chave); });
+    return chaves;
+}
+
+/**
+ * @brief Chaves do vetor cuja presença na tabela é igual a `presentes`
+ * @param chaves Chaves consultadas (duplicatas são mantidas)
+ * @param tabela Tabela consultada
+ * @param tipo Função hash da tabela
+ * @param presentes true: mantém as presentes (interseção); false: as ausentes (diferença)
+ * @param config Threads e tamanho do bloco
+ * @return Chaves selecionadas, na ordem do vetor
+ *
+ * Cada thread consulta uma partição contígua e grava num vetor próprio;
+ * os vetores são concatenados na ordem das partições.
+ */
+template<typename Tabela>
+std::vector<int> filtrarChaves(const std::vector<int>& chaves, const Tabela& tabela, typename Tabela::TipoHash tipo,
+                               bool presentes, const ConfiguracaoConjunto& config = {}) {
+    static_assert(ehMotorTabela<Tabela>, "Tabela deve satisfazer a interface de MotorTabela.hpp");
+
+    size_t threads = config.threads != 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    const size_t bloco = std::max<size_t>(config.bloco, 1);
+    // Partições de ao menos um bloco: abaixo disso, criar a thread custa mais que consultar
+    threads = std::max<size_t>(1, std::min(threads, (chaves.size() + bloco - 1) / bloco));
+
+    auto consultar = [&](size_t inicio, size_t fim, std::vector<int>& saida) {
+        std::vector<uint8_t> encontrados(std::min(bloco, fim - inicio));
+        for (size_t parte = inicio; parte < fim; parte += bloco) {
+            const size_t n = std::min(bloco, fim - parte);
+            if constexpr (TemBuscaLote<Tabela>::value) {
+                tabela.buscarLote(chaves.data() + parte, n, tipo, encontrados.data());
+            } else {
+                for (size_t i = 0; i < n; ++i) {
+                    encontrados[i] = static_cast<bool>(tabela.buscar(chaves[parte + i], tipo));
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if ((encontrados[i] != 0) == presentes) {
+                    saida.push_back(chaves[parte + i]);
+                }
+            }
+        }
+    };
+
+    if (threads == 1) {
+        std::vector<int> resultado;
+        consultar(0, chaves.size(), resultado);
+        return resultado;
+    }
+
+    std::vector<std::vector<int>> parciais(threads);
+    std::vector<std::exception_ptr> erros(threads);
+    std::vector<std::thread> trabalhadores;
+    trabalhadores.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        const size_t inicio = chaves.size() * t / threads;
+        const size_t fim = chaves.size() * (t + 1) / threads;
+        trabalhadores.emplace_back([&, t, inicio, fim] {
+            try {
+                consultar(inicio, fim, parciais[t]);
+            } catch (...) {
+                erros[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& trabalhador : trabalhadores) {
+        trabalhador.join();
+    }
+    for (const auto& erro : erros) {
+        if (erro) {
+            std::rethrow_exception(erro);
+        }
+    }
+
+    size_t total = 0;
+    for (const auto& parcial : parciais) {
+        total += parcial.size();
+    }
+    std::vector<int> resultado;
+    resultado.reserve(total);
+    for (const auto& parcial : parciais) {
+        resultado.insert(resultado.end(), parcial.begin(), parcial.end());
+    }
+    return resultado;
+}
+
+/**
+ * @brief Chaves presentes nas duas tabelas
+ *
+ * Enumera a tabela com menos chaves e consulta a outra.
+ */
+template<typename Tabela>
+std::vector<int> intersecao(const Tabela& a, const Tabela& b, typename Tabela::TipoHash tipo,
+                            const ConfiguracaoConjunto& config = {}) {
+    const bool aMenor = a.getNumElementos() <= b.getNumElementos();
+    return filtrarChaves(chavesDaTabela(aMenor ? a : b), aMenor ? b : a, tipo, true, config);
+}
+
+/**
+ * @brief Chaves de `a` ausentes de `b`
+ */
+template<typename Tabela>
+std::vector<int> diferenca(const Tabela& a, const Tabela& b, typename Tabela::TipoHash tipo,
+                           const ConfiguracaoConjunto& config = {}) {
+    return filtrarChaves(chavesDaTabela(a), b, tipo, false, config);
+}
+
+/**
+ * @brief Chaves presentes em alguma das tabelas, cada uma uma vez
+ *
+ * Todas as chaves de `a` seguidas das de `b` ausentes de `a`.
+ */
+template<typename Tabela>
+std::vector<int> uniao(const Tabela& a, const Tabela& b, typename Tabela::TipoHash tipo,
+                       const ConfiguracaoConjunto& config = {}) {
+    std::vector<int> resultado = chavesDaTabela(a);
+    const std::vector<int> soEmB = filtrarChaves(chavesDaTabela(b), a, tipo, false, config);
+    resultado.insert(resultado.end(), soEmB.begin(), soEmB.end());
+    return resultado;
+}
+
+/**
+ * @brief Constrói uma tabela com as chaves de um resultado
+ * @param chaves Chaves inseridas (duplicatas são ignoradas pelo motor)
+ * @param tipo Função hash da tabela nova
+ * @param fatorCarga Fator de carga alvo; o tamanho é o primo seguinte a n / fatorCarga
+ * @throws std::invalid_argument se o fator de carga não estiver em (0, 1]
+ * @throws std::runtime_error se o motor recusar alguma chave
+ */
+template<typename Tabela>
+Tabela construirTabela(const std::vector<int>& chaves, typename Tabela::TipoHash tipo, double fatorCarga = 0.5) {
+    static_assert(ehMotorTabela<Tabela>, "Tabela deve satisfazer a interface de MotorTabela.hpp");
+    if (!(fatorCarga > 0.0 && fatorCarga <= 1.0)) {
+        throw std::invalid_argument("Fator de carga da tabela construída deve estar em (0, 1]");
+    }
+    Tabela tabela(TabelaRedimensionavel::proximoPrimo(static_cast<size_t>(chaves.size() / fatorCarga) + 1));
+    for (int chave : chaves) {
+        tabela.inserir(chave, tipo);
+    }
+    return tabela;
+}
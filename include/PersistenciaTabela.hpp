@@ -0,0 +1,284 @@
+/**
+ * @file PersistenciaTabela.hpp
+ * @brief Diário de escrita antecipada (WAL) e snapshots para tabelas duráveis
+ *
+ * Permite usar um motor como cache durável: cada mutação efetiva (inserção
+ * de chave nova ou remoção de chave presente) é anexada a um diário, e um
+ * snapshot periódico com todas as chaves torna desnecessários os
+ * segmentos anteriores do diário, que são apagados. Ao abrir o diretório,
+ * a tabela é reconstruída pelo snapshot mais a cauda do diário.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Arquivos no diretório:
+ * - diario.NNNNNNNN: segmentos do diário, reaplicados em ordem; cada
+ *   registro tem BYTES_REGISTRO bytes (operação u8, chave i32 e
+ *   verificação FNV-1a u32, little-endian). Uma cauda incompleta ou com
+ *   verificação inválida (escrita interrompida) é descartada na recuperação
+ * - snapshot: "AHSNAP01", primeiro segmento não coberto u64, quantidade
+ *   u64, chaves i32 e verificação FNV-1a u32 das chaves. Gravado como
+ *   snapshot.tmp e renomeado, de modo que um snapshot interrompido nunca
+ *   substitui o anterior
+ *
+ * Commit em grupo: as mutações acumulam num buffer e são gravadas com uma
+ * única write() + fdatasync() a cada registrosPorSincronizacao mutações.
+ * Uma queda perde no máximo as mutações ainda não sincronizadas; com 1,
+ * nenhuma mutação retornada é perdida. Com 0, cada mutação é entregue ao
+ * SO por uma write() e nunca sincronizada: sobrevive à queda do processo,
+ * mas não à do sistema.
+ *
+ * Snapshot em segundo plano: as chaves são copiadas na thread da tabela
+ * (cópia em memória, sem E/S) e o diário passa a um segmento novo; uma
+ * thread grava o arquivo e apaga os segmentos cobertos enquanto as
+ * mutações seguem no segmento novo.
+ */
+
+#pragma once
+
+#include "MotorTabela.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Mutação registrada no diário
+ */
+enum class OperacaoDiario : uint8_t {
+    INSERIR = 1,
+    REMOVER = 2
+};
+
+/**
+ * @brief Política de sincronização e de snapshots
+ */
+struct ConfiguracaoPersistencia {
+    size_t registrosPorSincronizacao = 64;  ///< fdatasync a cada N mutações (1 = cada uma; 0 = write() a cada uma, sem fdatasync)
+    size_t mutacoesPorSnapshot = 1000000;   ///< Snapshot em segundo plano a cada N mutações (0 = só snapshot())
+};
+
+/**
+ * @brief Contadores de escrita e da última recuperação
+ */
+struct EstatisticasPersistencia {
+    size_t registros = 0;               ///< Mutações anexadas ao diário
+    size_t sincronizacoes = 0;          ///< fdatasync do diário
+    size_t bytesDiario = 0;             ///< Bytes gravados no diário
+    size_t snapshots = 0;               ///< Snapshots concluídos
+    size_t bytesSnapshots = 0;          ///< Bytes gravados em snapshots
+    size_t segmentosApagados = 0;       ///< Segmentos do diário cobertos por snapshots
+    size_t chavesSnapshot = 0;          ///< Chaves lidas do snapshot na recuperação
+    size_t registrosReaplicados = 0;    ///< Registros do diário reaplicados na recuperação
+    size_t bytesDescartados = 0;        ///< Cauda inválida descartada na recuperação
+    double msRecuperacao = 0.0;         ///< Duração da recuperação
+};
+
+/**
+ * @brief Classe PersistenciaTabela - Diário segmentado e snapshots de um diretório
+ *
+ * Independente do motor: recebe chaves e mutações e devolve as mutações na
+ * recuperação. Não é thread-safe; a única concorrência é interna, com a
+ * thread que grava o snapshot.
+ */
+class PersistenciaTabela {
+public:
+    /// Aplica uma mutação recuperada à tabela
+    using Aplicar = std::function<void(OperacaoDiario, int)>;
+
+    /// Bytes de cada registro do diário
+    static constexpr size_t BYTES_REGISTRO = 9;
+
+private:
+    std::string diretorio;                  ///< Diretório dos arquivos
+    ConfiguracaoPersistencia config;        ///< Política de escrita
+    EstatisticasPersistencia estatisticas;  ///< Contadores
+    int descritorDiario = -1;               ///< Segmento atual, aberto para anexar
+    uint64_t segmentoAtual = 0;             ///< Número do segmento atual
+    std::vector<uint8_t> buffer;            ///< Registros ainda não gravados
+    size_t naoSincronizados = 0;            ///< Mutações desde o último fdatasync
+    size_t mutacoesDesdeSnapshot = 0;       ///< Mutações desde o último snapshot iniciado
+
+    std::thread threadSnapshot;             ///< Gravação do snapshot em andamento
+    std::atomic<bool> snapshotConcluido{false}; ///< Sinalizado pela thread ao terminar
+    std::exception_ptr erroSnapshot;        ///< Falha da thread, relançada na thread da tabela
+    size_t bytesSnapshotAtual = 0;          ///< Resultado da thread, lido após o join
+    size_t segmentosApagadosAtual = 0;      ///< Resultado da thread, lido após o join
+
+    std::string caminhoSegmento(uint64_t segmento) const;
+    void abrirSegmento(uint64_t segmento);
+    void gravarBuffer();
+    void gravarSnapshot(std::vector<int> chaves, uint64_t primeiroSegmentoSeguinte);
+    void concluirSnapshot();
+
+public:
+    /**
+     * @brief Associa a persistência ao diretório (criado se ausente)
+     * @param diretorioDados Diretório do diário e do snapshot
+     * @param configuracao Política de sincronização e de snapshots
+     * @throws std::runtime_error fora de sistemas POSIX
+     */
+    PersistenciaTabela(const std::string& diretorioDados, const ConfiguracaoPersistencia& configuracao);
+
+    /**
+     * @brief Aguarda o snapshot em andamento e sincroniza o diário
+     */
+    ~PersistenciaTabela();
+
+    PersistenciaTabela(const PersistenciaTabela&) = delete;
+    PersistenciaTabela& operator=(const PersistenciaTabela&) = delete;
+
+    /**
+     * @brief Reaplica snapshot e diário e abre um segmento novo para escrita
+     * @param aplicar Chamada com cada chave do snapshot (INSERIR) e cada
+     *        registro válido do diário, em ordem
+     * @throws std::runtime_error se o snapshot estiver corrompido ou houver
+     *         falha de E/S
+     */
+    void recuperar(const Aplicar& aplicar);
+
+    /**
+     * @brief Anexa uma mutação ao diário (commit em grupo)
+     * @throws std::runtime_error se a gravação ou um snapshot anterior falhar
+     */
+    void registrar(OperacaoDiario operacao, int chave);
+
+    /**
+     * @brief Grava e sincroniza as mutações pendentes
+     * @throws std::runtime_error se a gravação falhar
+     */
+    void sincronizar();
+
+    /**
+     * @brief Verifica se o snapshot periódico deve começar
+     * @return true se mutacoesPorSnapshot foi atingido e nenhum snapshot está em andamento
+     */
+    bool snapshotDevido();
+
+    /**
+     * @brief Troca de segmento e grava as chaves em segundo plano
+     * @param chaves Todas as chaves da tabela neste instante
+     *
+     * Aguarda um snapshot anterior ainda em andamento.
+     */
+    void iniciarSnapshot(std::vector<int> chaves);
+
+    /**
+     * @brief Aguarda o snapshot em andamento, se houver
+     * @throws std::runtime_error se a gravação do snapshot falhou
+     */
+    void aguardarSnapshot();
+
+    /// Contadores de escrita e da última recuperação
+    const EstatisticasPersistencia& getEstatisticas() const { return estatisticas; }
+
+    /// Diretório dos arquivos
+    const std::string& getDiretorio() const { return diretorio; }
+};
+
+/**
+ * @brief Classe TabelaDuravel - Motor com diário e snapshots
+ * @tparam Tabela Motor conforme MotorTabela.hpp que ofereça paraCada()
+ *
+ * Inserções recusadas pelo motor e operações que não alteram a tabela não
+ * são registradas. O estado reconstruído pela recuperação é o da última
+ * mutação sincronizada.
+ */
+template<typename Tabela>
+class TabelaDuravel {
+    static_assert(ehMotorTabela<Tabela>, "Tabela deve satisfazer a interface de MotorTabela.hpp");
+    static_assert(TemIteracao<Tabela>::value, "Tabela deve oferecer paraCada() para os snapshots");
+
+public:
+    using TipoHash = typename Tabela::TipoHash;
+
+private:
+    Tabela tabela;
+    TipoHash tipo;
+    PersistenciaTabela persistencia;
+
+    void registrarMutacao(OperacaoDiario operacao, int chave) {
+        persistencia.registrar(operacao, chave);
+        if (persistencia.snapshotDevido()) {
+            persistencia.iniciarSnapshot(coletarChaves());
+        }
+    }
+
+    std::vector<int> coletarChaves() const {
+        std::vector<int> chaves;
+        chaves.reserve(tabela.getNumElementos());
+        tabela.paraCada([&](int chave) { chaves.push_back(chave); });
+        return chaves;
+    }
+
+public:
+    /**
+     * @brief Cria o motor e o reconstrói a partir do diretório
+     * @param diretorio Diretório do diário e do snapshot
+     * @param tamanho Posições do motor
+     * @param tipoHash Função hash usada em todas as operações
+     * @param config Política de sincronização e de snapshots
+     * @throws std::runtime_error se a recuperação falhar (inclusive se o
+     *         motor recusar uma chave recuperada por falta de espaço)
+     */
+    TabelaDuravel(const std::string& diretorio, size_t tamanho, TipoHash tipoHash,
+                  const ConfiguracaoPersistencia& config = {})
+        : tabela(tamanho), tipo(tipoHash), persistencia(diretorio, config) {
+        persistencia.recuperar([this](OperacaoDiario operacao, int chave) {
+            if (operacao == OperacaoDiario::INSERIR) {
+                tabela.inserir(chave, tipo);
+            } else {
+                tabela.remover(chave, tipo);
+            }
+        });
+    }
+
+    /**
+     * @brief Insere a chave e registra a mutação se ela era nova
+     * @throws std::runtime_error se o motor recusar a chave ou o diário falhar
+     */
+    void inserir(int chave) {
+        const size_t antes = tabela.getNumElementos();
+        tabela.inserir(chave, tipo);
+        if (tabela.getNumElementos() != antes) {
+            registrarMutacao(OperacaoDiario::INSERIR, chave);
+        }
+    }
+
+    /**
+     * @brief Remove a chave e registra a mutação se ela estava presente
+     * @return true se a chave foi removida
+     */
+    bool remover(int chave) {
+        if (!tabela.remover(chave, tipo)) {
+            return false;
+        }
+        registrarMutacao(OperacaoDiario::REMOVER, chave);
+        return true;
+    }
+
+    /// Verifica se a chave está presente (sem acesso ao disco)
+    bool buscar(int chave) const {
+        return static_cast<bool>(tabela.buscar(chave, tipo));
+    }
+
+    /// Grava e sincroniza as mutações pendentes
+    void sincronizar() { persistencia.sincronizar(); }
+
+    /// Inicia um snapshot em segundo plano fora da periodicidade configurada
+    void snapshot() { persistencia.iniciarSnapshot(coletarChaves()); }
+
+    /// Aguarda o snapshot em andamento
+    void aguardarSnapshot() { persistencia.aguardarSnapshot(); }
+
+    size_t getNumElementos() const { return tabela.getNumElementos(); }
+    const Tabela& getTabela() const { return tabela; }
+    const EstatisticasPersistencia& getEstatisticas() const { return persistencia.getEstatisticas(); }
+};
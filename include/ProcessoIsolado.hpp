@@ -0,0 +1,44 @@
+/**
+ * @file ProcessoIsolado.hpp
+ * @brief Execução de uma tarefa num processo filho criado por fork()
+ *
+ * Milhares de nós da TabelaEncadeada e os caches do alocador deixados por
+ * cenários anteriores afetam os seguintes quando tudo roda no mesmo
+ * processo. Executar cada medição num filho recém-criado parte sempre do
+ * mesmo heap (a cópia do pai, por copy-on-write) e descarta tudo ao fim.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Protocolo do pipe: o filho escreve "OK\n" seguido do texto produzido
+ * pela tarefa, ou "ERRO\n" seguido da mensagem da exceção, e termina com
+ * _exit() sem executar destrutores nem esvaziar buffers herdados do pai.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+/**
+ * @brief Verifica se a plataforma permite isolamento por processo
+ * @return true em sistemas POSIX (fork disponível)
+ */
+bool isolamentoDisponivel();
+
+/**
+ * @brief Executa a tarefa num processo filho e devolve o texto produzido
+ * @param tarefa Função executada no filho; o retorno é enviado pelo pipe
+ * @return Texto produzido pela tarefa
+ * @throws std::runtime_error se o fork falhar, se a tarefa lançar uma
+ *         exceção no filho (com a mesma mensagem) ou se o filho terminar
+ *         de forma anormal (sinal, saída sem resposta)
+ *
+ * Os buffers de std::cout, std::cerr e stdio são esvaziados antes do fork
+ * para que o filho não repita saída pendente. Estado alterado pela tarefa
+ * (geradores, eventos de rastreamento) fica no filho; o que o pai precisar
+ * deve voltar no texto.
+ */
+std::string executarEmProcessoFilho(const std::function<std::string()>& tarefa);
@@ -0,0 +1,157 @@
+/**
+ * @file ProtocoloKv.hpp
+ * @brief Protocolo binário e endereços do modo servidor (--servidor / --carga)
+ *
+ * Uma tabela hospedada pelo ServidorTabela é acessada por lotes de
+ * operações GET (buscar), PUT (inserir) e DEL (remover) sobre chaves int.
+ * Os motores guardam apenas chaves: GET informa presença, e não um valor
+ * associado.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Quadros (inteiros little-endian, sem alinhamento):
+ * - Requisição: comprimento u32 | idLote u32 | quantidade u16 |
+ *   quantidade x (operação u8, chave i32)
+ * - Resposta:   comprimento u32 | idLote u32 | quantidade u16 |
+ *   quantidade x resultado u8
+ *
+ * O comprimento conta os bytes após o próprio campo. Pipelining: o cliente
+ * envia quantos quadros quiser sem aguardar; o servidor responde cada
+ * conexão na ordem das requisições, repetindo o idLote. Um quadro
+ * malformado encerra a conexão.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Operação de um lote
+ */
+enum class OperacaoKv : uint8_t {
+    GET = 1,    ///< buscar: SIM se a chave está presente
+    PUT = 2,    ///< inserir: SIM se a chave era nova
+    DEL = 3     ///< remover: SIM se a chave estava presente
+};
+
+/**
+ * @brief Resultado de cada operação na resposta
+ */
+enum class ResultadoKv : uint8_t {
+    NAO = 0,    ///< Chave ausente (GET, DEL) ou já presente (PUT)
+    SIM = 1,    ///< Chave presente (GET), inserida (PUT) ou removida (DEL)
+    ERRO = 2    ///< Operação desconhecida ou inserção recusada pelo motor
+};
+
+/**
+ * @brief Operação com a chave, como enviada pelo cliente
+ */
+struct ComandoKv {
+    OperacaoKv operacao;
+    int32_t chave;
+};
+
+/// Bytes do campo comprimento
+constexpr size_t KV_BYTES_COMPRIMENTO = 4;
+/// Bytes do cabeçalho completo (comprimento, idLote e quantidade)
+constexpr size_t KV_BYTES_CABECALHO = 10;
+/// Bytes de cada operação na requisição
+constexpr size_t KV_BYTES_OPERACAO = 5;
+/// Maior quantidade de operações num lote
+constexpr size_t KV_MAX_OPERACOES = 65535;
+
+inline void escreverU16(uint8_t* destino, uint16_t valor) {
+    destino[0] = static_cast<uint8_t>(valor);
+    destino[1] = static_cast<uint8_t>(valor >> 8);
+}
+
+inline void escreverU32(uint8_t* destino, uint32_t valor) {
+    for (int i = 0; i < 4; ++i) {
+        destino[i] = static_cast<uint8_t>(valor >> (8 * i));
+    }
+}
+
+inline uint16_t lerU16(const uint8_t* origem) {
+    return static_cast<uint16_t>(origem[0] | origem[1] << 8);
+}
+
+inline uint32_t lerU32(const uint8_t* origem) {
+    return static_cast<uint32_t>(origem[0]) | static_cast<uint32_t>(origem[1]) << 8 |
+           static_cast<uint32_t>(origem[2]) << 16 | static_cast<uint32_t>(origem[3]) << 24;
+}
+
+/**
+ * @brief Tamanho total do quadro no início dos dados
+ * @return Bytes do quadro, ou 0 se os dados ainda não contêm o quadro inteiro
+ */
+inline size_t tamanhoQuadroKv(const uint8_t* dados, size_t disponiveis) {
+    if (disponiveis < KV_BYTES_COMPRIMENTO) {
+        return 0;
+    }
+    const size_t total = KV_BYTES_COMPRIMENTO + lerU32(dados);
+    return disponiveis >= total ? total : 0;
+}
+
+/**
+ * @brief Acrescenta um quadro de requisição ao buffer
+ * @throws std::invalid_argument se o lote estiver vazio ou exceder KV_MAX_OPERACOES
+ */
+void anexarRequisicaoKv(std::vector<uint8_t>& buffer, uint32_t idLote, const ComandoKv* comandos, size_t n);
+
+/**
+ * @brief Acrescenta um quadro de resposta ao buffer
+ */
+void anexarRespostaKv(std::vector<uint8_t>& buffer, uint32_t idLote, const uint8_t* resultados, size_t n);
+
+/**
+ * @brief Endereço de escuta do servidor ou de conexão do cliente
+ *
+ * Formatos: "unix:/caminho/do/socket" ou "tcp:host:porta" (IPv4; o host
+ * padrão do servidor deve ser 127.0.0.1, pois não há autenticação).
+ */
+struct EnderecoKv {
+    enum class Tipo { UNIX, TCP };
+
+    Tipo tipo = Tipo::UNIX;
+    std::string caminho;        ///< Arquivo do socket (UNIX)
+    std::string host;           ///< Endereço IPv4 (TCP)
+    uint16_t porta = 0;         ///< Porta (TCP)
+
+    /**
+     * @brief Interpreta o texto do endereço
+     * @throws std::invalid_argument se o formato for inválido
+     */
+    static EnderecoKv ler(const std::string& texto);
+
+    /// Texto no mesmo formato aceito por ler()
+    std::string texto() const;
+};
+
+/**
+ * @brief Verifica se a plataforma tem o modo servidor
+ * @return true no Linux (epoll)
+ */
+bool servidorKvDisponivel();
+
+/**
+ * @brief Cria o socket de escuta não bloqueante
+ *
+ * Um arquivo de socket UNIX remanescente de execução anterior é removido.
+ *
+ * @return Descritor do socket
+ * @throws std::runtime_error se a criação, o bind ou o listen falhar
+ */
+int abrirSocketEscutaKv(const EnderecoKv& endereco);
+
+/**
+ * @brief Conecta ao servidor (socket bloqueante, TCP_NODELAY no TCP)
+ * @return Descritor do socket conectado
+ * @throws std::runtime_error se a conexão falhar
+ */
+int conectarSocketKv(const EnderecoKv& endereco);
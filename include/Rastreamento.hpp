@@ -0,0 +1,188 @@
+/**
+ * @file Rastreamento.hpp
+ * @brief Camada opcional de rastreamento no formato trace-event do Chrome/Perfetto
+ *
+ * Registra intervalos (spans) e eventos instantâneos com identificador de
+ * thread e grava um arquivo JSON que pode ser aberto em chrome://tracing ou
+ * em ui.perfetto.dev, mostrando onde o tempo de uma execução completa é
+ * gasto (carregamento, inserção, busca, estatísticas, relatórios).
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Custo quando desativado:
+ * - Em tempo de execução (sem --rastreio): uma leitura atômica relaxada
+ *   por escopo; nenhum relógio é lido e nenhuma string é construída
+ * - Em tempo de compilação (ENABLE_TRACING=OFF no CMake): as macros
+ *   RASTREAR_* não geram código algum
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Classe Rastreador - Coletor global de eventos de rastreamento
+ *
+ * Instância única acessada via Rastreador::instancia(). Os eventos são
+ * acumulados em memória (protegidos por mutex) e gravados de uma vez em
+ * salvar(), para não introduzir E/S durante as medições.
+ */
+class Rastreador {
+public:
+    /**
+     * @brief Evento no formato trace-event
+     */
+    struct Evento {
+        const char* nome;       ///< Nome exibido no visualizador
+        const char* categoria;  ///< Categoria para filtragem ("dados", "benchmark", ...)
+        char fase;              ///< 'X' para intervalo completo, 'i' para instantâneo
+        int64_t inicioUs;       ///< Início em microssegundos desde a ativação
+        int64_t duracaoUs;      ///< Duração em microssegundos (intervalos)
+        uint32_t thread;        ///< Identificador sequencial da thread
+        std::string detalhe;    ///< Argumento opcional exibido em "args"
+    };
+
+private:
+    static std::atomic<bool> habilitado;            ///< Se o rastreamento está ativo
+    std::chrono::steady_clock::time_point origem;   ///< Instante da ativação
+    std::vector<Evento> eventos;                    ///< Eventos coletados
+    std::mutex mutexEventos;                        ///< Protege o vetor de eventos
+
+    Rastreador() = default;
+
+public:
+    Rastreador(const Rastreador&) = delete;
+    Rastreador& operator=(const Rastreador&) = delete;
+
+    /**
+     * @brief Obtém a instância global
+     * @return Referência para o rastreador
+     */
+    static Rastreador& instancia();
+
+    /**
+     * @brief Verifica se o rastreamento está ativo
+     * @return true se os eventos estão sendo coletados
+     */
+    static bool ativo() {
+        return habilitado.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Ativa a coleta e define a origem dos tempos
+     */
+    void iniciar();
+
+    /**
+     * @brief Obtém o tempo decorrido desde a ativação
+     * @return Microssegundos desde iniciar()
+     */
+    int64_t agoraUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - origem).count();
+    }
+
+    /**
+     * @brief Identificador sequencial e estável da thread atual
+     * @return 1 para a primeira thread que registrar eventos, 2 para a seguinte...
+     */
+    static uint32_t idThread();
+
+    /**
+     * @brief Registra um evento já preenchido
+     * @param evento Evento a armazenar
+     */
+    void registrar(Evento evento);
+
+    /**
+     * @brief Registra um evento instantâneo na thread atual
+     * @param nome Nome do evento (literal de string)
+     * @param categoria Categoria do evento (literal de string)
+     * @param detalhe Argumento opcional
+     */
+    void instantaneo(const char* nome, const char* categoria, std::string detalhe = "");
+
+    /**
+     * @brief Grava os eventos coletados em formato trace-event JSON
+     * @param arquivo Caminho do arquivo de saída
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvar(const std::string& arquivo);
+};
+
+/**
+ * @brief Classe EscopoRastreado - Registra um intervalo do construtor ao destrutor
+ *
+ * Quando o rastreamento está desativado, o construtor apenas testa
+ * Rastreador::ativo() e o destrutor não faz nada.
+ */
+class EscopoRastreado {
+private:
+    const char* nome;       ///< Nome do intervalo
+    const char* categoria;  ///< Categoria do intervalo
+    std::string detalhe;    ///< Argumento opcional
+    int64_t inicioUs;       ///< Início do intervalo (-1 se inativo)
+
+public:
+    /**
+     * @brief Inicia o intervalo
+     * @param n Nome (literal de string)
+     * @param c Categoria (literal de string)
+     * @param d Argumento opcional
+     */
+    EscopoRastreado(const char* n, const char* c, std::string d = "")
+        : nome(n), categoria(c), detalhe(std::move(d)),
+          inicioUs(Rastreador::ativo() ? Rastreador::instancia().agoraUs() : -1) {}
+
+    /**
+     * @brief Encerra o intervalo e o registra se o rastreamento estava ativo
+     */
+    ~EscopoRastreado() {
+        if (inicioUs >= 0) {
+            Rastreador& r = Rastreador::instancia();
+            r.registrar({nome, categoria, 'X', inicioUs, r.agoraUs() - inicioUs,
+                         Rastreador::idThread(), std::move(detalhe)});
+        }
+    }
+
+    EscopoRastreado(const EscopoRastreado&) = delete;
+    EscopoRastreado& operator=(const EscopoRastreado&) = delete;
+};
+
+#define RASTREAR_CONCAT_INTERNO(a, b) a##b
+#define RASTREAR_CONCAT(a, b) RASTREAR_CONCAT_INTERNO(a, b)
+
+#ifdef ANALISE_HASH_RASTREAMENTO
+
+/// Registra um intervalo até o fim do escopo atual
+#define RASTREAR_ESCOPO(nome, categoria) \
+    EscopoRastreado RASTREAR_CONCAT(escopoRastreado_, __LINE__)(nome, categoria)
+
+/// Registra um intervalo com argumento; a expressão só é avaliada se ativo
+#define RASTREAR_ESCOPO_DETALHE(nome, categoria, detalhe) \
+    EscopoRastreado RASTREAR_CONCAT(escopoRastreado_, __LINE__)( \
+        nome, categoria, Rastreador::ativo() ? std::string(detalhe) : std::string())
+
+/// Registra um evento instantâneo com argumento; a expressão só é avaliada se ativo
+#define RASTREAR_EVENTO(nome, categoria, detalhe) \
+    do { \
+        if (Rastreador::ativo()) { \
+            Rastreador::instancia().instantaneo(nome, categoria, std::string(detalhe)); \
+        } \
+    } while (0)
+
+#else
+
+#define RASTREAR_ESCOPO(nome, categoria) ((void)0)
+#define RASTREAR_ESCOPO_DETALHE(nome, categoria, detalhe) ((void)0)
+#define RASTREAR_EVENTO(nome, categoria, detalhe) ((void)0)
+
+#endif
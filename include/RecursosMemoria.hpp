@@ -0,0 +1,130 @@
+/**
+ * @file RecursosMemoria.hpp
+ * @brief Recursos de memória (std::pmr) usados na comparação de alocadores
+ *
+ * Define dois std::pmr::memory_resource próprios:
+ * - RecursoContador: repassa as requisições a outro recurso e contabiliza
+ *   os bytes obtidos dele; usado como upstream para medir quanto cada
+ *   estratégia de alocação retém do sistema
+ * - RecursoSlab: alocador de blocos de tamanho fixo em slabs contíguos com
+ *   lista livre intrusiva, adequado aos nós da TabelaEncadeada
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Recurso que contabiliza a memória obtida de outro recurso
+ *
+ * Não é thread-safe, como os recursos não sincronizados que observa.
+ */
+class RecursoContador : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;   ///< Recurso que fornece a memória
+    size_t bytesAtuais = 0;                ///< Bytes obtidos e ainda não devolvidos
+    size_t picoBytes = 0;                  ///< Maior valor de bytesAtuais
+    size_t alocacoes = 0;                  ///< Chamadas de alocação repassadas
+
+protected:
+    void* do_allocate(size_t bytes, size_t alinhamento) override;
+    void do_deallocate(void* p, size_t bytes, size_t alinhamento) override;
+    bool do_is_equal(const std::pmr::memory_resource& outro) const noexcept override {
+        return this == &outro;
+    }
+
+public:
+    /**
+     * @brief Construtor
+     * @param origem Recurso observado (padrão: new/delete)
+     */
+    explicit RecursoContador(std::pmr::memory_resource* origem = std::pmr::new_delete_resource())
+        : upstream(origem) {}
+
+    /// Bytes atualmente retidos do recurso observado
+    size_t getBytesAtuais() const { return bytesAtuais; }
+
+    /// Maior quantidade de bytes retida simultaneamente
+    size_t getPicoBytes() const { return picoBytes; }
+
+    /// Número de alocações repassadas ao recurso observado
+    size_t getAlocacoes() const { return alocacoes; }
+};
+
+/**
+ * @brief Alocador de blocos de tamanho fixo em slabs
+ *
+ * Requisições de até tamanhoBloco bytes (com alinhamento compatível) são
+ * servidas de slabs contíguos obtidos do upstream: primeiro da lista livre
+ * de blocos devolvidos, depois avançando no slab atual. Requisições maiores
+ * são repassadas ao upstream. A memória dos slabs só volta ao upstream na
+ * destruição do recurso.
+ *
+ * Diferente de std::pmr::unsynchronized_pool_resource, não há pools por
+ * classe de tamanho nem crescimento geométrico dos blocos: cada slab tem o
+ * mesmo tamanho e o custo por alocação é um teste e uma troca de ponteiro.
+ */
+class RecursoSlab : public std::pmr::memory_resource {
+private:
+    /// Bloco devolvido, encadeado na lista livre
+    struct BlocoLivre {
+        BlocoLivre* proximo;
+    };
+
+    std::pmr::memory_resource* upstream;   ///< Origem dos slabs
+    size_t tamanhoBloco;                   ///< Tamanho de cada bloco (múltiplo do alinhamento)
+    size_t bytesSlab;                      ///< Tamanho de cada slab
+    BlocoLivre* livres = nullptr;          ///< Blocos devolvidos, reutilizados primeiro
+    char* atual = nullptr;                 ///< Próximo bloco nunca usado do slab atual
+    char* fim = nullptr;                   ///< Fim do slab atual
+    std::vector<void*> slabs;              ///< Slabs obtidos do upstream
+
+    /// Alinhamento de todos os blocos
+    static constexpr size_t ALINHAMENTO = alignof(std::max_align_t);
+
+    /**
+     * @brief Verifica se a requisição é servida pelos slabs
+     */
+    bool atendePorSlab(size_t bytes, size_t alinhamento) const {
+        return bytes <= tamanhoBloco && alinhamento <= ALINHAMENTO;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alinhamento) override;
+    void do_deallocate(void* p, size_t bytes, size_t alinhamento) override;
+    bool do_is_equal(const std::pmr::memory_resource& outro) const noexcept override {
+        return this == &outro;
+    }
+
+public:
+    /**
+     * @brief Construtor
+     * @param tamanho Maior requisição servida pelos slabs (ex.: sizeof(No))
+     * @param bytesPorSlab Tamanho de cada slab (padrão: 64 KiB)
+     * @param origem Recurso que fornece os slabs
+     * @throws std::invalid_argument se o slab não comportar ao menos um bloco
+     */
+    explicit RecursoSlab(size_t tamanho, size_t bytesPorSlab = 64 * 1024,
+                         std::pmr::memory_resource* origem = std::pmr::new_delete_resource());
+
+    /**
+     * @brief Devolve todos os slabs ao upstream
+     */
+    ~RecursoSlab() override;
+
+    RecursoSlab(const RecursoSlab&) = delete;
+    RecursoSlab& operator=(const RecursoSlab&) = delete;
+
+    /// Tamanho efetivo de cada bloco
+    size_t getTamanhoBloco() const { return tamanhoBloco; }
+
+    /// Número de slabs obtidos do upstream
+    size_t getNumSlabs() const { return slabs.size(); }
+};
@@ -0,0 +1,70 @@
+/**
+ * @file RegistroMotores.hpp
+ * @brief Motores de tabela hash disponíveis na matriz de benchmarks
+ *
+ * Cada motor é registrado por uma linha em MOTORES_REGISTRADOS, com o nome
+ * usado em [matriz] motores, na seção de dimensionamento do arquivo de
+ * configuração, no CSV e nos relatórios. O tipo registrado deve satisfazer
+ * ehMotorTabela (MotorTabela.hpp); a verificação é feita na compilação.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * A escolha do motor pelo nome acontece uma vez por cenário, fora das
+ * regiões medidas: visitarMotor() chama o visitante com o tipo concreto,
+ * que instancia o template do cenário para ele.
+ */
+
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "MotorTabela.hpp"
+#include "TabelaEncadeada.hpp"
+#include "TabelaAberta.hpp"
+
+/**
+ * @brief Associação entre um nome de motor e o tipo que o implementa
+ * @tparam T Tipo do motor
+ */
+template<typename T>
+struct MotorRegistrado {
+    static_assert(ehMotorTabela<T>, "Motor registrado não satisfaz a interface de MotorTabela.hpp");
+
+    using Tabela = T;   ///< Tipo instanciado pelo cenário
+    const char* nome;   ///< Nome na configuração e nos relatórios
+
+    /// Modelo teórico das sondagens, declarado pelo próprio motor
+    static constexpr ModeloSondagem modelo = modeloSondagemMotor<T>;
+};
+
+/// Motores disponíveis, um por linha
+inline constexpr auto MOTORES_REGISTRADOS = std::make_tuple(
+    MotorRegistrado<TabelaEncadeada>{"Encadeada"},
+    MotorRegistrado<TabelaAberta>{"Aberta"});
+
+/**
+ * @brief Chama o visitante com o motor registrado sob o nome
+ * @param nome Nome do motor
+ * @param visitante Função genérica que recebe const MotorRegistrado<T>&
+ * @return false se nenhum motor tiver esse nome
+ */
+template<typename Visitante>
+bool visitarMotor(const std::string& nome, Visitante&& visitante) {
+    return std::apply([&](const auto&... motor) {
+        return ((nome == motor.nome ? (visitante(motor), true) : false) || ...);
+    }, MOTORES_REGISTRADOS);
+}
+
+/**
+ * @brief Nomes dos motores registrados, na ordem do registro
+ */
+inline std::vector<std::string> nomesMotores() {
+    return std::apply([](const auto&... motor) {
+        return std::vector<std::string>{motor.nome...};
+    }, MOTORES_REGISTRADOS);
+}
@@ -0,0 +1,130 @@
+/**
+ * @file ResultadoTeste.hpp
+ * @brief Resultado de um cenário do benchmark
+ *
+ * Define a estrutura ResultadoTeste, compartilhada entre o BenchmarkManager,
+ * a saída CSV incremental e o histórico de execuções.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+#include "ModeloSondagem.hpp"
+#include "MedidorEnergia.hpp"
+
+/**
+ * @brief Estrutura para armazenar resultados de um teste específico
+ *
+ * Cada instância representa o resultado de um cenário de teste,
+ * incluindo configuração usada e métricas coletadas.
+ *
+ * Esta estrutura é usada para:
+ * - Armazenar resultados temporariamente durante execução
+ * - Gerar relatórios formatados
+ * - Exportar dados para análise posterior (CSV)
+ */
+struct ResultadoTeste {
+    std::string tipoTabela;      ///< "Encadeada" ou "Aberta"
+    size_t tamanhoTabela;        ///< Tamanho da tabela hash utilizada
+    size_t quantidadeDados;      ///< Número de elementos inseridos
+    std::string tipoFuncaoHash;  ///< "Divisao" ou "Multiplicacao"
+    double tempoInsercao;        ///< Tempo de inserção em milissegundos
+    double tempoBusca;           ///< Tempo de busca com caches quentes (regime permanente) em ms
+    double tempoBuscaFria;       ///< Tempo de busca com caches frias (primeiro acesso) em ms
+    size_t colisoes;             ///< Número estimado de colisões
+    double fatorCarga;           ///< Fator de carga (elementos/tamanho)
+    std::string dataset;         ///< Arquivo ou distribuição de origem dos dados
+    std::string mistura;         ///< Rótulo da mistura de operações ("-" se não houver)
+    double tempoMistura;         ///< Tempo da fase mista em ms (0 se não houver)
+    size_t threads;              ///< Threads concorrentes na fase de busca
+    size_t repeticao;            ///< Repetição do cenário (a partir de 1)
+    size_t operacoesInsercao;    ///< Chamadas de inserção medidas
+    size_t operacoesBusca;       ///< Buscas medidas por fase (todas as threads)
+    size_t operacoesMistura;     ///< Operações da fase mista (0 se não houver)
+    double sondagemSucesso;      ///< Sondagens medidas por busca bem-sucedida
+    double sondagemInsucesso;    ///< Sondagens medidas por busca malsucedida (0 na Encadeada)
+    ModeloSondagem modeloSondagem = ModeloSondagem::NENHUM;  ///< Modelo declarado pelo motor
+    bool energiaMedida = false;       ///< true se as fases foram medidas pelo RAPL
+    ConsumoEnergia energiaInsercao;   ///< Energia da inserção
+    ConsumoEnergia energiaBusca;      ///< Energia da busca quente
+    ConsumoEnergia energiaMistura;    ///< Energia da fase mista
+    std::string identificacao;        ///< MetadadosExecucao::valoresCsv() da execução que mediu o cenário
+
+    /**
+     * @brief Identifica o cenário na matriz de benchmarks
+     * @return Chave única por dataset, motor, tamanho, hash, mistura,
+     *         threads e repetição
+     */
+    std::string chaveCenario() const {
+        return chave(dataset, tipoTabela, tamanhoTabela, tipoFuncaoHash, mistura, threads, repeticao);
+    }
+
+    /**
+     * @brief Monta a chave de um cenário antes de executá-lo
+     * @return Mesma chave que chaveCenario() retornaria para o resultado
+     */
+    static std::string chave(const std::string& dataset, const std::string& tabela, size_t tamanho,
+                             const std::string& hash, const std::string& mistura,
+                             size_t threads, size_t repeticao) {
+        return dataset + "|" + tabela + "|" + std::to_string(tamanho) + "|" + hash + "|" +
+               mistura + "|" + std::to_string(threads) + "|" + std::to_string(repeticao);
+    }
+
+    /**
+     * @brief Sondagens esperadas por busca bem-sucedida para o fator de carga
+     * @return ½(1 + 1/(1 − α)) com sondagem linear, 1 + α/2 com
+     *         encadeamento, 0 sem modelo
+     */
+    double sondagemSucessoTeorica() const {
+        return sondagensTeoricasSucesso(modeloSondagem, fatorCarga);
+    }
+
+    /**
+     * @brief Sondagens esperadas por busca malsucedida para o fator de carga
+     * @return ½(1 + 1/(1 − α)²) com sondagem linear, 0 nos demais modelos
+     *         (não analisada)
+     */
+    double sondagemInsucessoTeorica() const {
+        return sondagensTeoricasInsucesso(modeloSondagem, fatorCarga);
+    }
+
+    /**
+     * @brief Converte o tempo de uma fase em nanossegundos por operação
+     * @param ms Tempo da fase em milissegundos
+     * @param operacoes Operações executadas na fase
+     * @return ns/op (0 se a fase não teve operações)
+     *
+     * Com várias threads o tempo é de parede, portanto o valor é o inverso
+     * da vazão agregada e não a latência de uma operação isolada.
+     */
+    static double nsPorOperacao(double ms, size_t operacoes) {
+        return operacoes > 0 ? ms * 1e6 / operacoes : 0.0;
+    }
+
+    /**
+     * @brief Converte o tempo de uma fase em vazão
+     * @param ms Tempo da fase em milissegundos
+     * @param operacoes Operações executadas na fase
+     * @return Milhões de operações por segundo (0 se o tempo for nulo)
+     */
+    static double mopsPorSegundo(double ms, size_t operacoes) {
+        return ms > 0.0 ? operacoes / (ms * 1e3) : 0.0;
+    }
+
+    /**
+     * @brief Converte a energia de uma fase em joules por milhão de operações
+     * @param consumo Energia da fase (pacote + DRAM)
+     * @param operacoes Operações executadas na fase
+     * @return J/Mop (0 se a fase não teve operações)
+     */
+    static double joulesPorMilhao(const ConsumoEnergia& consumo, size_t operacoes) {
+        return operacoes > 0 ? consumo.total() * 1e6 / operacoes : 0.0;
+    }
+};
@@ -0,0 +1,114 @@
+/**
+ * @file SaidaResultados.hpp
+ * @brief Gravação incremental dos resultados em CSV, com retomada
+ *
+ * Define a classe SaidaResultados, que grava cada cenário concluído no CSV
+ * assim que termina (com flush), em vez de esperar o fim da matriz. Se uma
+ * varredura longa for interrompida, os cenários já medidos permanecem no
+ * arquivo e a execução seguinte com --retomar pula esses cenários.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Colunas derivadas por fase (inserção, busca quente, busca fria e fase
+ * mista): ns/op e Mops/s, calculados a partir do tempo e do número de
+ * operações da fase; com --energia, também J por milhão de operações
+ * (pacote + DRAM) da inserção, da busca quente e da fase mista.
+ *
+ * Cada linha termina com as colunas de MetadadosExecucao::CABECALHO_CSV
+ * (semente, revisão, build e ambiente) da execução que mediu o cenário;
+ * ao retomar, as linhas mantidas conservam as da execução original.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <set>
+#include <fstream>
+#include <ostream>
+
+#include "ResultadoTeste.hpp"
+
+/**
+ * @brief Classe SaidaResultados - CSV de resultados gravado cenário a cenário
+ */
+class SaidaResultados {
+private:
+    std::string nomeArquivo;                ///< Caminho do CSV
+    std::ofstream saida;                    ///< Arquivo aberto para anexação
+    std::set<std::string> concluidos;       ///< Chaves dos cenários já gravados
+    std::vector<ResultadoTeste> retomados;  ///< Resultados lidos ao retomar
+
+public:
+    /// Linha de cabeçalho do CSV (sem quebra de linha)
+    static const std::string CABECALHO;
+
+    /**
+     * @brief Abre o CSV para gravação
+     * @param arquivo Caminho do arquivo
+     * @param retomar Se true, mantém os cenários já presentes no arquivo
+     * @throws std::runtime_error se o arquivo não puder ser criado ou, ao
+     *         retomar, tiver cabeçalho de outra versão do programa
+     *
+     * Sem retomar, o arquivo é recriado apenas com o cabeçalho. Ao retomar,
+     * as linhas válidas são mantidas e uma eventual linha incompleta
+     * (gravação interrompida) é descartada antes de continuar.
+     */
+    void abrir(const std::string& arquivo, bool retomar);
+
+    /**
+     * @brief Verifica se um cenário já foi gravado
+     * @param chave Chave retornada por ResultadoTeste::chaveCenario()
+     * @return true se o cenário pode ser pulado
+     */
+    bool concluido(const std::string& chave) const {
+        return concluidos.count(chave) > 0;
+    }
+
+    /**
+     * @brief Obtém os resultados lidos do arquivo ao retomar
+     * @return Resultados na ordem do arquivo
+     */
+    const std::vector<ResultadoTeste>& getRetomados() const {
+        return retomados;
+    }
+
+    /**
+     * @brief Grava um resultado e força a escrita no arquivo
+     * @param resultado Cenário concluído
+     */
+    void registrar(const ResultadoTeste& resultado);
+
+    /**
+     * @brief Fecha o arquivo e informa onde os resultados foram salvos
+     */
+    void fechar();
+
+    /**
+     * @brief Escreve um resultado como linha CSV (com quebra de linha)
+     * @param saida Fluxo de saída
+     * @param resultado Resultado a escrever
+     */
+    static void escreverLinha(std::ostream& saida, const ResultadoTeste& resultado);
+
+    /**
+     * @brief Interpreta uma linha CSV
+     * @param linha Linha sem quebra
+     * @param resultado Resultado preenchido em caso de sucesso; as colunas
+     *        de metadados são guardadas, sem interpretação, em identificacao
+     * @return false se a linha estiver incompleta ou mal formada
+     */
+    static bool lerLinha(const std::string& linha, ResultadoTeste& resultado);
+
+    /**
+     * @brief Lê todos os resultados completos de um CSV
+     * @param arquivo Caminho do arquivo
+     * @return Resultados na ordem do arquivo; linhas incompletas são ignoradas
+     * @throws std::runtime_error se o arquivo não puder ser aberto ou tiver
+     *         cabeçalho de outra versão do programa
+     */
+    static std::vector<ResultadoTeste> lerArquivo(const std::string& arquivo);
+};
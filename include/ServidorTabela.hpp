@@ -0,0 +1,135 @@
+/**
+ * @file ServidorTabela.hpp
+ * @brief Tabela hash servida por socket local com laço de eventos epoll
+ *
+ * Hospeda um motor registrado (RegistroMotores.hpp) como serviço
+ * compartilhado por vários processos, no protocolo de ProtocoloKv.hpp.
+ * Uma única thread atende todas as conexões: o motor não é thread-safe e
+ * a serialização pelo laço dispensa travas.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Laço de eventos (epoll, disparo por nível):
+ * - Socket de escuta: aceita conexões até EAGAIN, todas não bloqueantes
+ * - Conexão legível: lê até EAGAIN, processa cada quadro completo e
+ *   acumula as respostas no buffer de saída, enviado no mesmo ciclo
+ * - Saída pendente: EPOLLOUT até esvaziar; ao alcançar LIMITE_SAIDA a
+ *   conexão deixa de ser lida e os quadros já recebidos esperam a saída
+ *   esvaziar (contrapressão sobre clientes que não leem)
+ * - Fim da entrada (shutdown do cliente): as respostas pendentes são
+ *   enviadas antes de fechar a conexão
+ * - Parada: parar() (eventfd) ou SIGINT/SIGTERM (signalfd)
+ *
+ * O motor é chamado por lote, através de uma única função virtual; as
+ * operações de um lote são despachadas diretamente para o tipo concreto.
+ */
+
+#pragma once
+
+#include "ProtocoloKv.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Contadores do servidor, atualizados pelo laço de eventos
+ */
+struct EstatisticasServidor {
+    size_t conexoesAceitas = 0;     ///< Conexões aceitas desde o início
+    size_t lotes = 0;               ///< Quadros de requisição processados
+    size_t operacoes = 0;           ///< Operações processadas
+    size_t errosProtocolo = 0;      ///< Conexões encerradas por quadro malformado
+};
+
+/**
+ * @brief Classe ServidorTabela - Servidor de uma tabela por epoll
+ */
+class ServidorTabela {
+public:
+    /**
+     * @brief Motor servido: aplica um lote de operações codificadas
+     */
+    class MotorServido {
+    public:
+        virtual ~MotorServido() = default;
+
+        /**
+         * @brief Aplica as operações de um quadro
+         * @param operacoes n operações de KV_BYTES_OPERACAO bytes
+         * @param resultados n bytes de ResultadoKv
+         */
+        virtual void processar(const uint8_t* operacoes, size_t n, uint8_t* resultados) = 0;
+
+        /// Chaves armazenadas
+        virtual size_t getNumElementos() const = 0;
+    };
+
+    /// Bytes pendentes de envio (e de entrada não processada) a partir dos quais a conexão deixa de ser lida
+    static constexpr size_t LIMITE_SAIDA = 4 << 20;
+
+private:
+    struct Conexao;
+
+    EnderecoKv endereco;                    ///< Endereço de escuta
+    std::unique_ptr<MotorServido> motor;    ///< Tabela servida
+    std::string descricaoMotor;             ///< Motor, hash e tamanho (relatório)
+    int descritorEscuta = -1;               ///< Socket de escuta
+    int descritorParada = -1;               ///< eventfd sinalizado por parar()
+    EstatisticasServidor estatisticas;      ///< Contadores do laço
+    std::vector<uint8_t> resultadosLote;    ///< Resultados do lote em processamento
+
+    void aceitarConexoes(int epoll, std::unordered_map<int, Conexao>& conexoes);
+    bool lerConexao(Conexao& conexao);
+    bool processarQuadros(Conexao& conexao);
+    bool enviarSaida(Conexao& conexao);
+
+public:
+    /**
+     * @brief Cria a tabela e o socket de escuta
+     * @param enderecoEscuta Endereço do servidor
+     * @param nomeMotor Motor registrado (ex.: "Aberta")
+     * @param nomeHash "Divisao" ou "Multiplicacao"
+     * @param tamanho Posições da tabela
+     * @throws std::invalid_argument se o motor ou a hash forem desconhecidos
+     * @throws std::runtime_error se o socket não puder ser aberto
+     */
+    ServidorTabela(const EnderecoKv& enderecoEscuta, const std::string& nomeMotor,
+                   const std::string& nomeHash, size_t tamanho);
+
+    /**
+     * @brief Fecha os sockets e remove o arquivo do socket UNIX
+     */
+    ~ServidorTabela();
+
+    ServidorTabela(const ServidorTabela&) = delete;
+    ServidorTabela& operator=(const ServidorTabela&) = delete;
+
+    /**
+     * @brief Atende conexões até parar() ou SIGINT/SIGTERM
+     * @param tratarSinais Bloqueia SIGINT e SIGTERM nesta thread e os recebe
+     *        pelo laço (encerramento limpo no modo de linha de comando)
+     * @throws std::runtime_error se o epoll falhar
+     */
+    void executar(bool tratarSinais = true);
+
+    /**
+     * @brief Encerra executar(); pode ser chamado de outra thread
+     */
+    void parar();
+
+    /// Contadores acumulados
+    const EstatisticasServidor& getEstatisticas() const { return estatisticas; }
+
+    /// Chaves armazenadas na tabela servida
+    size_t getNumElementos() const { return motor->getNumElementos(); }
+
+    /// Motor, hash e tamanho, como em "Aberta/Divisao/1000003"
+    const std::string& getDescricaoMotor() const { return descricaoMotor; }
+};
@@ -24,12 +24,15 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <optional>
 #include <stdexcept>
 #include <iostream>
 #include <cmath>
 
+#include "ModeloSondagem.hpp"
+
 /**
  * @brief Estrutura que representa uma célula da tabela hash
  * 
@@ -161,6 +164,15 @@ public:
         MULTIPLICACAO   ///< Método da multiplicação - melhor distribuição
     };
     
+    /// Modelo teórico das sondagens (ModeloSondagem.hpp)
+    static constexpr ModeloSondagem MODELO_SONDAGEM = ModeloSondagem::SONDAGEM_LINEAR;
+
+    /// Bytes do array principal por posição
+    static constexpr size_t BYTES_POR_POSICAO = sizeof(Celula);
+
+    /// Bytes alocados à parte por chave: nenhum, as chaves ficam nas células
+    static size_t bytesPorChave() { return 0; }
+
     /**
      * @brief Construtor da tabela hash aberta
      * @param tam Tamanho da tabela
@@ -219,6 +231,22 @@ public:
      * @complexity O(1) média, O(n) no pior caso
      */
     bool buscar(int valor, TipoHash tipo) const;
+
+    /// Chaves cujas células iniciais são pré-buscadas juntas em buscarLote
+    static constexpr size_t LOTE_PREBUSCA = 16;
+
+    /**
+     * @brief Busca várias chaves, sobrepondo as faltas de cache entre elas
+     * @param valores Chaves buscadas
+     * @param n Número de chaves
+     * @param tipo Função hash utilizada
+     * @param encontrados Recebe 1 para cada chave presente e 0 para ausente
+     *
+     * A cada LOTE_PREBUSCA chaves, calcula as posições iniciais com o
+     * kernel de hash em lote, pré-busca as células e só então sonda,
+     * quando as linhas já estão a caminho do cache.
+     */
+    void buscarLote(const int* valores, size_t n, TipoHash tipo, uint8_t* encontrados) const;
     
     /**
      * @brief Remove um valor da tabela hash (lazy deletion)
@@ -240,9 +268,10 @@ public:
      * @return Índice na tabela (0 <= índice < tamanho)
      * 
      * Implementa h(k) = k mod m, onde m é o tamanho da tabela.
+     * |k| é calculado em 64 bits: INT_MIN vai para 2^31, como nos kernels em lote.
      */
     size_t calcularHashDivisao(int chave) const {
-        return static_cast<size_t>(std::abs(chave)) % tamanho;
+        return static_cast<size_t>(std::abs(static_cast<int64_t>(chave))) % tamanho;
     }
     
     /**
@@ -255,7 +284,7 @@ public:
      * - c = 0.63274838 (constante conforme especificação do trabalho)
      */
     size_t calcularHashMultiplicacao(int chave) const {
-        double produto = std::abs(chave) * CONSTANTE_MULTIPLICACAO;
+        double produto = std::abs(static_cast<int64_t>(chave)) * CONSTANTE_MULTIPLICACAO;
         double fracao = produto - std::floor(produto);
         return static_cast<size_t>(std::floor(fracao * tamanho));
     }
@@ -339,6 +368,21 @@ public:
         numElementos = 0;
         numRemovidos = 0;
     }
+
+    /**
+     * @brief Visita cada elemento ativo, na ordem das células
+     * @param visitar Função chamada com cada valor
+     *
+     * Usada pela persistência (TabelaDuravel) para gravar snapshots.
+     */
+    template<typename Funcao>
+    void paraCada(Funcao&& visitar) const {
+        for (const auto& celula : tabela) {
+            if (celula.estado == Celula::Estado::OCUPADO) {
+                visitar(celula.valor);
+            }
+        }
+    }
     
     /**
      * @brief Estrutura para estatísticas de sondagem e clustering
@@ -348,7 +392,8 @@ public:
      */
     struct EstatisticasSondagem {
         size_t totalSondagens;      ///< Total de sondagens realizadas em operações
-        double sondagemMedia;       ///< Número médio de sondagens por operação
+        double sondagemMedia;       ///< Número médio de sondagens por busca bem-sucedida
+        double sondagemMediaInsucesso; ///< Número médio de sondagens por busca malsucedida
         size_t maxSondagens;        ///< Máximo de sondagens em uma operação
         size_t clustersDetectados;  ///< Número de clusters contíguos detectados
         size_t maiorCluster;        ///< Tamanho do maior cluster encontrado
@@ -356,14 +401,19 @@ public:
     
     /**
      * @brief Analisa estatísticas de clustering e sondagem
+     * @param tipo Função hash usada na construção da tabela
      * @return Estrutura com as estatísticas coletadas
      * 
      * Percorre a tabela identificando clusters de células ocupadas
-     * e simula operações para calcular estatísticas de sondagem.
+     * e simula operações para calcular estatísticas de sondagem:
+     * - Sucesso: células examinadas até cada elemento a partir da sua
+     *   posição de origem
+     * - Insucesso: células examinadas até a primeira VAZIA, com a posição
+     *   inicial uniforme sobre a tabela
      * 
      * @complexity O(n) onde n é o tamanho da tabela
      */
-    EstatisticasSondagem analisarSondagem() const;
+    EstatisticasSondagem analisarSondagem(TipoHash tipo = TipoHash::DIVISAO) const;
 };
 
 /**
@@ -0,0 +1,195 @@
+/**
+ * @file TabelaCompartilhada.hpp
+ * @brief Tabela de endereçamento aberto em memória compartilhada entre processos
+ *
+ * Vários processos que consultam o mesmo conjunto de chaves podem mapear uma
+ * única tabela em vez de manter cada um sua cópia privada. Um processo
+ * escritor cria o segmento (shm_open com nome, ou memfd anônimo repassado
+ * por herança do descritor) e os leitores o mapeiam somente para leitura.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Layout do segmento (sem ponteiros: cada processo o mapeia em outro
+ * endereço, e tudo é localizado por deslocamentos a partir do início):
+ * - Cabeçalho: "AHSHM001", função hash, número de posições, deslocamento
+ *   das células, sequência do seqlock e contadores atômicos
+ * - Células: uint32 atômicos a partir do deslocamento, alinhados a 64
+ *   bytes; 0 = VAZIA, 1 = REMOVIDA e as demais guardam a chave com o bit
+ *   de sinal invertido (INT_MIN e INT_MIN + 1 ficam reservadas)
+ *
+ * Concorrência (um escritor, muitos leitores, sem bloqueio dos leitores):
+ * - Inserção e remoção alteram uma única célula com um store atômico; o
+ *   leitor vê a célula antes ou depois, nunca um valor parcial
+ * - A compactação, que remove as REMOVIDAS reinserindo as chaves, altera
+ *   muitas células e é protegida por um seqlock: a sequência fica ímpar
+ *   durante a reescrita, e a busca que a encontra ímpar ou alterada ao
+ *   fim é refeita. Os leitores nunca escrevem no segmento nem esperam por
+ *   um lock; o escritor nunca espera pelos leitores
+ * - publicar() incrementa a versão publicada, que os leitores consultam
+ *   para saber se um lote de mutações do escritor foi concluído
+ *
+ * Disponível apenas em sistemas POSIX; criarAnonima() requer Linux.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Classe TabelaCompartilhada - Sondagem linear num segmento compartilhado
+ *
+ * Cada objeto é o mapeamento do segmento num processo: o do escritor
+ * (criar, criarAnonima) permite mutações, os de leitores (abrir,
+ * abrirDescritor) apenas consultas. As funções hash são as da TabelaAberta.
+ */
+class TabelaCompartilhada {
+public:
+    /**
+     * @brief Funções hash, gravadas no cabeçalho pelo escritor
+     */
+    enum class TipoHash : uint32_t {
+        DIVISAO = 0,        ///< h(k) = |k| mod m
+        MULTIPLICACAO = 1   ///< h(k) = floor(m * frac(|k| * c))
+    };
+
+    /// Fator de carga acima do qual a inserção é recusada
+    static constexpr double MAX_FATOR_CARGA = 0.7;
+
+    struct Cabecalho;
+
+private:
+    int descritor = -1;                         ///< shm_open ou memfd
+    void* base = nullptr;                       ///< Início do mapeamento
+    size_t bytes = 0;                           ///< Bytes mapeados
+    bool escritor = false;                      ///< true se mapeado para escrita
+    std::string nome;                           ///< Nome do segmento (vazio = anônimo)
+    Cabecalho* cabecalho = nullptr;             ///< Cabeçalho no início do segmento
+    std::atomic<uint32_t>* celulas = nullptr;   ///< Células após o deslocamento
+    size_t tamanho = 0;                         ///< Número de posições
+    TipoHash tipo = TipoHash::DIVISAO;          ///< Função hash do segmento
+    size_t limiteOcupacao = 0;                  ///< Células não VAZIAS permitidas
+
+    TabelaCompartilhada() = default;
+    static TabelaCompartilhada inicializar(int descritor, const std::string& nome, size_t tamanho, TipoHash tipo);
+    static TabelaCompartilhada mapearLeitura(int descritor, const std::string& nome);
+
+    size_t calcularHash(int chave) const;
+    bool sondar(uint32_t codigo, size_t origem) const;
+    void compactar();
+    void exigirEscritor(const char* operacao) const;
+
+public:
+    /**
+     * @brief Cria um segmento nomeado e o mapeia como escritor
+     * @param nomeSegmento Nome para shm_open ("/" é acrescentado se ausente)
+     * @param tamanhoTabela Número de posições
+     * @param tipoHash Função hash usada por todos os processos
+     * @return Tabela vazia do escritor
+     * @throws std::invalid_argument se o tamanho for zero
+     * @throws std::runtime_error se o nome já existir ou a criação falhar
+     */
+    static TabelaCompartilhada criar(const std::string& nomeSegmento, size_t tamanhoTabela, TipoHash tipoHash);
+
+    /**
+     * @brief Cria um segmento anônimo (memfd) e o mapeia como escritor
+     *
+     * Os leitores recebem o descritor por herança (fork) ou por SCM_RIGHTS
+     * e o mapeiam com abrirDescritor().
+     *
+     * @throws std::runtime_error fora do Linux ou se a criação falhar
+     */
+    static TabelaCompartilhada criarAnonima(size_t tamanhoTabela, TipoHash tipoHash);
+
+    /**
+     * @brief Mapeia um segmento nomeado existente somente para leitura
+     * @throws std::runtime_error se o segmento não existir ou não for uma
+     *         TabelaCompartilhada inicializada
+     */
+    static TabelaCompartilhada abrir(const std::string& nomeSegmento);
+
+    /**
+     * @brief Mapeia somente para leitura o segmento de um descritor
+     * @param descritorSegmento Descritor de criarAnonima() (não é fechado)
+     * @throws std::runtime_error se o descritor não for de uma TabelaCompartilhada
+     */
+    static TabelaCompartilhada abrirDescritor(int descritorSegmento);
+
+    /**
+     * @brief Remove o nome do segmento; os mapeamentos existentes continuam válidos
+     * @return true se o nome existia
+     */
+    static bool removerNome(const std::string& nomeSegmento);
+
+    /**
+     * @brief Desfaz o mapeamento (o segmento nomeado persiste até removerNome)
+     */
+    ~TabelaCompartilhada();
+
+    TabelaCompartilhada(TabelaCompartilhada&& outra) noexcept;
+    TabelaCompartilhada& operator=(TabelaCompartilhada&& outra) noexcept;
+    TabelaCompartilhada(const TabelaCompartilhada&) = delete;
+    TabelaCompartilhada& operator=(const TabelaCompartilhada&) = delete;
+
+    /**
+     * @brief Insere a chave (somente o escritor)
+     * @return true se a chave era nova
+     * @throws std::invalid_argument para INT_MIN e INT_MIN + 1 (reservadas)
+     * @throws std::runtime_error acima de MAX_FATOR_CARGA
+     * @throws std::logic_error num mapeamento de leitor
+     *
+     * Quando as REMOVIDAS levariam a ocupação além do limite, a tabela é
+     * compactada antes, sob o seqlock.
+     */
+    bool inserir(int chave);
+
+    /**
+     * @brief Remove a chave, marcando a célula como REMOVIDA (somente o escritor)
+     * @return true se a chave estava presente
+     * @throws std::logic_error num mapeamento de leitor
+     */
+    bool remover(int chave);
+
+    /**
+     * @brief Verifica se a chave está presente
+     *
+     * No escritor, consulta direta. Nos leitores, a sondagem é refeita se
+     * uma compactação ocorreu durante ela (seqlock).
+     */
+    bool buscar(int chave) const;
+
+    /**
+     * @brief Conclui um lote de mutações, incrementando a versão publicada
+     * @throws std::logic_error num mapeamento de leitor
+     */
+    void publicar();
+
+    /// Número de publicações do escritor
+    uint64_t getVersao() const;
+
+    /// Chaves presentes (lido do cabeçalho)
+    size_t getNumElementos() const;
+
+    /// Células REMOVIDAS aguardando compactação
+    size_t getNumRemovidos() const;
+
+    /// Compactações realizadas pelo escritor
+    uint64_t getCompactacoes() const;
+
+    size_t getTamanho() const { return tamanho; }
+    double fatorCarga() const { return static_cast<double>(getNumElementos()) / tamanho; }
+    TipoHash getTipoHash() const { return tipo; }
+
+    /// Bytes do segmento (cabeçalho e células)
+    size_t getBytesSegmento() const { return bytes; }
+
+    /// Descritor do segmento, para repassar a leitores de criarAnonima()
+    int getDescritor() const { return descritor; }
+
+    bool somenteLeitura() const { return !escritor; }
+};
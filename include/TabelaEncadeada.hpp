@@ -4,16 +4,17 @@
  * 
  * Este arquivo contém a definição completa da classe TabelaEncadeada, que implementa
  * uma tabela hash utilizando encadeamento (chaining) para resolver colisões.
- * A implementação utiliza listas encadeadas com ponteiros inteligentes para
- * garantir segurança de memória e performance otimizada.
+ * Os nós das listas são obtidos de um std::pmr::memory_resource escolhido na
+ * construção, o que permite comparar estratégias de alocação sem alterar o
+ * algoritmo.
  * 
  * @author Gabriel Freitas Souza
  * @author Roberli Schuina Silva
  * @date 2024-10-18
- * @version 1.1
+ * @version 1.2
  * 
  * Características principais:
- * - Utiliza std::unique_ptr para gerenciamento automático de memória
+ * - Nós alocados pelo memory_resource da tabela (padrão: recurso padrão do processo)
  * - Suporta duas funções de hash: divisão e multiplicação
  * - Inserção no início das listas para complexidade O(1)
  * - Verificação de duplicatas antes da inserção
@@ -23,22 +24,27 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
 #include <cmath>
 #include <iostream>
 
+#include "ModeloSondagem.hpp"
+
 /**
  * @brief Estrutura de nó para a lista encadeada
  * 
- * Cada nó armazena um valor inteiro e um ponteiro inteligente para o próximo nó.
- * O uso de std::unique_ptr garante que não haja vazamentos de memória e que
- * a destruição dos nós seja automática quando a tabela for destruída.
+ * Cada nó armazena um valor inteiro e um ponteiro para o próximo nó. Os nós
+ * pertencem à TabelaEncadeada, que os cria e destrói com o seu
+ * memory_resource; um ponteiro simples mantém o nó em 16 bytes.
  */
 struct No {
     int valor;                      ///< Valor armazenado no nó
-    std::unique_ptr<No> proximo;    ///< Ponteiro para o próximo nó da lista
+    No* proximo;                    ///< Próximo nó da lista (nullptr no fim)
     
     /**
      * @brief Construtor do nó
@@ -66,16 +72,40 @@ struct No {
  * - Uso adicional de memória para ponteiros
  * - Possível fragmentação de memória
  * - Pior localidade de cache comparado ao endereçamento aberto
+ * 
+ * As duas últimas dependem do alocador: por isso a tabela recebe um
+ * std::pmr::memory_resource (ver RecursosMemoria.hpp e --alocadores).
  */
 class TabelaEncadeada {
 private:
-    std::vector<std::unique_ptr<No>> tabela;    ///< Array de ponteiros para as listas encadeadas
+    std::vector<No*> tabela;                    ///< Array de ponteiros para as listas encadeadas
     size_t tamanho;                             ///< Tamanho da tabela hash
     size_t numElementos;                        ///< Número total de elementos inseridos
+    std::pmr::memory_resource* recurso;         ///< Origem da memória dos nós
     
     /// Constante para o método da multiplicação conforme especificação do trabalho
     static constexpr double CONSTANTE_MULTIPLICACAO = 0.63274838;
     
+    /**
+     * @brief Cria um nó com a memória do recurso da tabela
+     * @param valor Valor do nó
+     * @param proximo Nó seguinte da lista
+     * @return Nó construído
+     */
+    No* criarNo(int valor, No* proximo) {
+        No* no = new (recurso->allocate(sizeof(No), alignof(No))) No(valor);
+        no->proximo = proximo;
+        return no;
+    }
+
+    /**
+     * @brief Devolve a memória de um nó ao recurso da tabela
+     * @param no Nó a liberar
+     */
+    void liberarNo(No* no) noexcept {
+        recurso->deallocate(no, sizeof(No), alignof(No));
+    }
+
     /**
      * @brief Verifica se um número é primo
      * @param n Número a ser verificado
@@ -110,16 +140,40 @@ public:
         MULTIPLICACAO   ///< Método da multiplicação - melhor distribuição
     };
     
+    /// Modelo teórico das sondagens (ModeloSondagem.hpp)
+    static constexpr ModeloSondagem MODELO_SONDAGEM = ModeloSondagem::ENCADEAMENTO;
+
+    /// Bytes do array principal por posição (ponteiro para a lista)
+    static constexpr size_t BYTES_POR_POSICAO = sizeof(No*);
+
+    /**
+     * @brief Bytes de heap de cada nó alocado pelo recurso padrão (new_delete)
+     * @return Área utilizável do bloco de um No mais uma palavra de
+     *         cabeçalho, medidas uma vez
+     *
+     * Com malloc_usable_size (Linux) ou malloc_size (macOS), o tamanho do
+     * bloco vem do próprio alocador; soma-se a palavra de cabeçalho que o
+     * malloc da glibc guarda antes de cada bloco, o que superestima em 8
+     * bytes alocadores sem cabeçalho por bloco (jemalloc, mimalloc). Sem
+     * essas funções, supõe o malloc da glibc: cabeçalho de 8 bytes e
+     * blocos múltiplos de 16 (32 bytes por nó).
+     */
+    static size_t bytesPorChave();
+
     /**
      * @brief Construtor da tabela hash encadeada
      * @param tam Tamanho da tabela (número de posições)
+     * @param recursoNos Recurso de memória dos nós; deve sobreviver à tabela
      * @throws std::invalid_argument se o tamanho for zero
      * 
      * Inicializa a tabela com o tamanho especificado. Recomenda-se usar
      * números primos como tamanho para melhor distribuição das chaves,
-     * especialmente com o método da divisão.
+     * especialmente com o método da divisão. Sem recurso explícito, os nós
+     * usam std::pmr::get_default_resource() (new/delete, salvo configuração).
      */
-    explicit TabelaEncadeada(size_t tam) : tamanho(tam), numElementos(0) {
+    explicit TabelaEncadeada(size_t tam,
+                             std::pmr::memory_resource* recursoNos = std::pmr::get_default_resource())
+        : tamanho(tam), numElementos(0), recurso(recursoNos) {
         if (tam == 0) {
             throw std::invalid_argument("Tamanho da tabela deve ser maior que zero");
         }
@@ -135,21 +189,38 @@ public:
     }
     
     /**
-     * @brief Destrutor padrão
+     * @brief Destrutor
      * 
-     * O destrutor é automaticamente gerado pelo compilador.
-     * A destruição dos unique_ptr's é automática e libera
-     * toda a memória das listas encadeadas.
+     * Devolve todos os nós ao recurso de memória da tabela.
      */
-    ~TabelaEncadeada() = default;
+    ~TabelaEncadeada() {
+        limpar();
+    }
     
     // Desabilita cópia (custosa e desnecessária para benchmarks)
     TabelaEncadeada(const TabelaEncadeada&) = delete;
     TabelaEncadeada& operator=(const TabelaEncadeada&) = delete;
     
-    // Permite movimentação eficiente
-    TabelaEncadeada(TabelaEncadeada&&) noexcept = default;
-    TabelaEncadeada& operator=(TabelaEncadeada&&) noexcept = default;
+    // Permite movimentação eficiente; a origem fica vazia
+    TabelaEncadeada(TabelaEncadeada&& outra) noexcept
+        : tabela(std::move(outra.tabela)), tamanho(outra.tamanho),
+          numElementos(outra.numElementos), recurso(outra.recurso) {
+        outra.tabela.clear();
+        outra.numElementos = 0;
+    }
+    
+    TabelaEncadeada& operator=(TabelaEncadeada&& outra) noexcept {
+        if (this != &outra) {
+            limpar();
+            tabela = std::move(outra.tabela);
+            tamanho = outra.tamanho;
+            numElementos = outra.numElementos;
+            recurso = outra.recurso;
+            outra.tabela.clear();
+            outra.numElementos = 0;
+        }
+        return *this;
+    }
     
     /**
      * @brief Insere um valor na tabela hash
@@ -179,6 +250,22 @@ public:
      * Complexidade: O(1) média, O(n) no pior caso
      */
     bool buscar(int valor, TipoHash tipo) const;
+
+    /// Chaves pré-buscadas juntas em buscarLote
+    static constexpr size_t LOTE_PREBUSCA = 16;
+
+    /**
+     * @brief Busca várias chaves, sobrepondo as faltas de cache entre elas
+     * @param valores Chaves buscadas
+     * @param n Número de chaves
+     * @param tipo Função hash utilizada
+     * @param encontrados Recebe 1 para cada chave presente e 0 para ausente
+     *
+     * Pré-busca em dois estágios a cada LOTE_PREBUSCA chaves: primeiro as
+     * posições do vetor de listas, depois o primeiro nó de cada lista, e
+     * só então percorre as listas.
+     */
+    void buscarLote(const int* valores, size_t n, TipoHash tipo, uint8_t* encontrados) const;
     
     /**
      * @brief Remove um valor da tabela hash
@@ -199,10 +286,11 @@ public:
      * @return Índice na tabela (0 <= índice < tamanho)
      * 
      * Implementa h(k) = k mod p, onde p é o tamanho da tabela.
+     * |k| é calculado em 64 bits: INT_MIN vai para 2^31, como nos kernels em lote.
      * Funciona melhor quando p é um número primo.
      */
     size_t calcularHashDivisao(int chave) const {
-        return static_cast<size_t>(std::abs(chave)) % tamanho;
+        return static_cast<size_t>(std::abs(static_cast<int64_t>(chave))) % tamanho;
     }
     
     /**
@@ -218,7 +306,7 @@ public:
      * do tamanho da tabela.
      */
     size_t calcularHashMultiplicacao(int chave) const {
-        double produto = std::abs(chave) * CONSTANTE_MULTIPLICACAO;
+        double produto = std::abs(static_cast<int64_t>(chave)) * CONSTANTE_MULTIPLICACAO;
         double fracao = produto - std::floor(produto);
         return static_cast<size_t>(std::floor(fracao * tamanho));
     }
@@ -258,18 +346,45 @@ public:
         return numElementos == 0; 
     }
     
+    /**
+     * @brief Obtém o recurso de memória dos nós
+     * @return Recurso informado na construção
+     */
+    std::pmr::memory_resource* getRecurso() const {
+        return recurso;
+    }
+    
     /**
      * @brief Remove todos os elementos da tabela
      * 
-     * Libera toda a memória das listas encadeadas e redefine
+     * Devolve todos os nós ao recurso de memória e redefine
      * o contador de elementos para zero.
      */
     void limpar() {
         for (auto& lista : tabela) {
-            lista.reset(); // Libera automaticamente a lista encadeada
+            while (lista != nullptr) {
+                No* proximo = lista->proximo;
+                liberarNo(lista);
+                lista = proximo;
+            }
         }
         numElementos = 0;
     }
+
+    /**
+     * @brief Visita cada elemento, lista por lista
+     * @param visitar Função chamada com cada valor
+     *
+     * Usada pela persistência (TabelaDuravel) para gravar snapshots.
+     */
+    template<typename Funcao>
+    void paraCada(Funcao&& visitar) const {
+        for (const No* lista : tabela) {
+            for (; lista != nullptr; lista = lista->proximo) {
+                visitar(lista->valor);
+            }
+        }
+    }
     
     /**
      * @brief Estrutura para estatísticas de distribuição
@@ -282,6 +397,7 @@ public:
         size_t posicoesMaisUtilizada;   ///< Tamanho da maior lista encadeada
         double comprimentoMedio;       ///< Comprimento médio das listas não vazias
         size_t totalColisoes;          ///< Número estimado de colisões ocorridas
+        double sondagemMediaSucesso;   ///< Nós examinados, em média, por busca bem-sucedida
     };
     
     /**
@@ -293,6 +409,8 @@ public:
      * - Número de colisões
      * - Comprimento das listas
      * - Utilização das posições
+     * - Nós examinados por busca bem-sucedida (uma lista de comprimento L
+     *   contribui 1 + 2 + ... + L)
      */
     EstatisticasDistribuicao obterEstatisticas() const;
 };
@@ -0,0 +1,197 @@
+/**
+ * @file TabelaRedimensionavel.hpp
+ * @brief Tabela hash com endereçamento aberto que cresce sob demanda
+ *
+ * A TabelaAberta tem tamanho fixo e recusa inserções acima do limite de
+ * ocupação. Esta classe cresce (dobrando para o próximo primo) quando a
+ * ocupação passa de 0,5, com três estratégias de rehash que distribuem de
+ * forma diferente o custo do crescimento entre as inserções:
+ * - PARADA_TOTAL: a inserção que dispara o crescimento migra tudo
+ * - INCREMENTAL: cada inserção migra uma fatia fixa de posições antigas
+ * - SEGUNDO_PLANO: uma thread migra o arranjo antigo enquanto as inserções
+ *   seguem num arranjo auxiliar, incorporado ao fim da migração
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Características principais:
+ * - Sondagem linear e método da divisão, como na TabelaAberta
+ * - Arranjos obtidos com calloc: a memória zerada do sistema dispensa a
+ *   inicialização explícita, e 0 representa posição vazia
+ * - Somente inserção e busca (o benchmark de crescimento não remove)
+ * - Eventos de rastreamento no início e no fim de cada crescimento
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <thread>
+
+/**
+ * @brief Classe TabelaRedimensionavel - Endereçamento aberto com crescimento
+ *
+ * Não é thread-safe: a única concorrência é interna, entre a thread que
+ * insere e a thread de migração do modo SEGUNDO_PLANO. Durante a migração
+ * o arranjo antigo fica congelado (somente leitura para as duas threads),
+ * o que dispensa travas.
+ */
+class TabelaRedimensionavel {
+public:
+    /**
+     * @brief Estratégias de rehash durante o crescimento
+     */
+    enum class Modo {
+        PARADA_TOTAL,   ///< Migra todos os elementos de uma vez
+        INCREMENTAL,    ///< Migra PASSO_MIGRACAO posições por inserção
+        SEGUNDO_PLANO   ///< Migra em outra thread
+    };
+
+private:
+    /// Libera arranjos obtidos com calloc
+    struct LiberarArranjo {
+        void operator()(uint32_t* p) const { std::free(p); }
+    };
+
+    /**
+     * @brief Arranjo de posições com sondagem linear
+     *
+     * Cada posição guarda a chave codificada (0 = vazia).
+     */
+    struct Arranjo {
+        std::unique_ptr<uint32_t[], LiberarArranjo> posicoes;  ///< Chaves codificadas
+        size_t tamanho = 0;                                     ///< Número de posições
+        size_t elementos = 0;                                   ///< Posições ocupadas
+
+        /// Cria um arranjo vazio com o tamanho dado (sem arranjo se zero)
+        static Arranjo criar(size_t tamanho);
+
+        /// Verifica se a chave codificada está presente
+        bool contem(uint32_t codigo, int chave) const;
+
+        /// Insere a chave codificada (sem verificar duplicata); requer posição vazia
+        void inserir(uint32_t codigo, int chave);
+
+        /// Ocupação atual
+        double ocupacao() const {
+            return tamanho ? static_cast<double>(elementos) / tamanho : 1.0;
+        }
+    };
+
+    Modo modo;                          ///< Estratégia de rehash
+    Arranjo atual;                      ///< Arranjo que recebe as inserções (ou destino da migração)
+    Arranjo antigo;                     ///< Arranjo em migração (vazio fora de uma migração)
+    Arranjo auxiliar;                   ///< Inserções durante a migração em segundo plano
+    size_t indiceMigracao = 0;          ///< Próxima posição de antigo a migrar (incremental)
+    size_t pendentes = 0;               ///< Elementos de antigo ainda não migrados (incremental)
+    std::thread migrador;               ///< Thread da migração em segundo plano
+    std::atomic<bool> migracaoPronta{false}; ///< Sinalizada pela thread ao terminar
+    size_t redimensionamentos = 0;      ///< Crescimentos iniciados
+
+    /// Ocupação acima da qual a tabela cresce
+    static constexpr double MAX_OCUPACAO = 0.5;
+
+    /// Posições do arranjo antigo migradas a cada inserção no modo incremental
+    static constexpr size_t PASSO_MIGRACAO = 8;
+
+    /// Tamanho inicial mínimo
+    static constexpr size_t TAMANHO_MINIMO = 17;
+
+    /// Codifica a chave de modo que nenhuma chave válida vire 0
+    static uint32_t codificar(int chave) {
+        return static_cast<uint32_t>(chave) ^ 0x80000000u;
+    }
+
+    /// Recupera a chave a partir do código armazenado
+    static int decodificar(uint32_t codigo) {
+        return static_cast<int>(codigo ^ 0x80000000u);
+    }
+
+    /// Verifica se há migração em andamento
+    bool migrando() const {
+        return antigo.tamanho > 0;
+    }
+
+    /// Inicia o crescimento conforme o modo
+    void crescer();
+
+    /// Migra até "quantidade" posições do arranjo antigo (incremental)
+    void migrarPasso(size_t quantidade);
+
+    /// Aguarda a thread, incorpora o arranjo auxiliar e encerra a migração
+    void concluirSegundoPlano();
+
+public:
+    /**
+     * @brief Calcula o menor primo maior ou igual a n
+     * @param n Limite inferior
+     * @return Número primo (tamanho de cada arranjo da tabela)
+     */
+    static size_t proximoPrimo(size_t n);
+
+    /**
+     * @brief Construtor
+     * @param modoRehash Estratégia de rehash
+     * @param tamanhoInicial Posições iniciais (arredondado para primo >= 17)
+     */
+    explicit TabelaRedimensionavel(Modo modoRehash, size_t tamanhoInicial = TAMANHO_MINIMO);
+
+    /**
+     * @brief Destrutor; aguarda uma migração em segundo plano em andamento
+     */
+    ~TabelaRedimensionavel();
+
+    TabelaRedimensionavel(const TabelaRedimensionavel&) = delete;
+    TabelaRedimensionavel& operator=(const TabelaRedimensionavel&) = delete;
+
+    /**
+     * @brief Insere uma chave, crescendo a tabela se necessário
+     * @param chave Chave a inserir
+     * @return true se inserida, false se já existia
+     * @throws std::invalid_argument para INT_MIN (reservada para posição vazia)
+     * @throws std::bad_alloc se não houver memória para crescer
+     *
+     * @complexity O(1) amortizada; o pior caso depende do modo
+     */
+    bool inserir(int chave);
+
+    /**
+     * @brief Busca uma chave
+     * @param chave Chave a buscar
+     * @return true se presente
+     */
+    bool buscar(int chave) const;
+
+    /**
+     * @brief Conclui qualquer migração em andamento
+     *
+     * Chamado ao fim de uma carga para que o tempo total inclua toda a
+     * migração pendente.
+     */
+    void finalizarMigracao();
+
+    /// Número de chaves armazenadas
+    size_t getNumElementos() const;
+
+    /// Posições do arranjo principal (destino, se houver migração)
+    size_t getTamanho() const { return atual.tamanho; }
+
+    /// Crescimentos iniciados desde a construção
+    size_t getRedimensionamentos() const { return redimensionamentos; }
+
+    /// Estratégia de rehash
+    Modo getModo() const { return modo; }
+};
+
+/**
+ * @brief Operador de saída para Modo
+ * @param os Stream de saída
+ * @param modo Modo a imprimir
+ * @return Referência para o stream
+ */
+std::ostream& operator<<(std::ostream& os, TabelaRedimensionavel::Modo modo);
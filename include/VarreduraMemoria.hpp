@@ -0,0 +1,144 @@
+/**
+ * @file VarreduraMemoria.hpp
+ * @brief Definição da classe VarreduraMemoria para varreduras de working set
+ *
+ * Os benchmarks principais vão até 50.000 chaves (~400 KB na TabelaAberta),
+ * o que mantém todas as tabelas dentro da LLC. Esta classe gera datasets e
+ * tabelas de tamanhos crescentes em progressão geométrica (de 1K até 1B de
+ * chaves), mede o custo por operação em cada passo e anota em que ponto o
+ * working set de cada tabela ultrapassa L1, L2, LLC e o alcance da TLB.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Características principais:
+ * - Geração de datasets sintéticos com semente configurável
+ * - Medição de ns/inserção e ns/busca por motor e função hash
+ * - Estimativa do working set de cada tabela
+ * - Anotação das fronteiras da hierarquia de memória detectada via sysfs
+ * - Interrupção segura quando o passo não cabe na memória física
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstddef>
+
+#include "ControleCache.hpp"
+
+struct MetadadosExecucao;
+
+/**
+ * @brief Estrutura com o resultado de um passo da varredura
+ */
+struct ResultadoVarredura {
+    std::string tipoTabela;      ///< "Encadeada" ou "Aberta"
+    std::string tipoFuncaoHash;  ///< "Divisao" ou "Multiplicacao"
+    size_t quantidadeChaves;     ///< Chaves geradas no passo
+    size_t tamanhoTabela;        ///< Número de posições da tabela
+    size_t workingSet;           ///< Estimativa de bytes ocupados pela tabela
+    std::string nivelMemoria;    ///< Menor nível que comporta o working set
+    bool excedeTLB;              ///< Se o working set ultrapassa o alcance da TLB
+    double nsInsercao;           ///< Tempo médio por inserção em nanossegundos
+    double nsBusca;              ///< Tempo médio por busca em nanossegundos
+};
+
+/**
+ * @brief Classe VarreduraMemoria - Mede os motores de L1 até a DRAM
+ *
+ * Para cada passo da progressão geométrica:
+ * 1. Gera o dataset com CarregadorDados (chaves entre 1 e INT_MAX)
+ * 2. Dimensiona cada tabela para o número de chaves (TabelaAberta com
+ *    fator de ocupação < 0,5, TabelaEncadeada com fator de carga ~1)
+ * 3. Mede inserção de todas as chaves e busca de uma amostra de chaves
+ *    presentes, convertendo para nanossegundos por operação
+ * 4. Classifica o working set pela topologia detectada
+ */
+class VarreduraMemoria {
+private:
+    TopologiaMemoria topologia;                ///< Hierarquia de memória da máquina
+    std::vector<ResultadoVarredura> resultados; ///< Resultados de todos os passos
+    size_t minChaves;                          ///< Primeiro passo da varredura
+    size_t maxChaves;                          ///< Limite superior da varredura
+    double fatorPasso;                         ///< Razão da progressão geométrica
+    unsigned int seed;                         ///< Semente dos datasets gerados
+
+    /// Tamanho máximo da amostra de buscas por passo
+    static constexpr size_t MAX_AMOSTRA_BUSCA = 1u << 20;
+
+    /// Fração da memória física que um passo pode ocupar
+    static constexpr double FRACAO_MEMORIA = 0.5;
+
+    /**
+     * @brief Mede um motor com as duas funções hash para um dataset
+     * @tparam Tabela TabelaEncadeada ou TabelaAberta
+     * @param nome Nome do motor para o relatório
+     * @param tamanhoTabela Número de posições da tabela
+     * @param bytesPorPosicao Bytes de cada posição do array principal
+     * @param bytesPorChave Bytes adicionais por chave fora do array principal
+     * @param dados Chaves a inserir
+     * @param amostra Chaves a buscar
+     */
+    template<typename Tabela>
+    void medirMotor(const std::string& nome, size_t tamanhoTabela,
+                    size_t bytesPorPosicao, size_t bytesPorChave,
+                    const std::vector<int>& dados, const std::vector<int>& amostra);
+
+public:
+    /**
+     * @brief Calcula o menor primo maior ou igual a n
+     * @param n Limite inferior
+     * @return Número primo
+     */
+    static size_t proximoPrimo(size_t n);
+
+    /**
+     * @brief Construtor da varredura
+     * @param minimo Número de chaves do primeiro passo (padrão: 1.000)
+     * @param maximo Número máximo de chaves (padrão: 1.000.000.000)
+     * @param fator Razão entre passos consecutivos (padrão: 2)
+     * @param semente Semente para geração dos datasets
+     * @throws std::invalid_argument se os parâmetros forem inconsistentes
+     */
+    explicit VarreduraMemoria(size_t minimo = 1000,
+                              size_t maximo = 1000000000,
+                              double fator = 2.0,
+                              unsigned int semente = std::random_device{}());
+
+    /**
+     * @brief Executa todos os passos da varredura
+     *
+     * Interrompe a varredura (sem erro) no primeiro passo cuja estimativa
+     * de memória exceda FRACAO_MEMORIA da memória física.
+     */
+    void executar();
+
+    /**
+     * @brief Imprime o relatório com as fronteiras de memória anotadas
+     *
+     * Cada linha onde o nível de memória muda em relação ao passo anterior
+     * do mesmo motor e hash é marcada com "<- cruza", assim como o primeiro
+     * passo que excede o alcance da TLB.
+     */
+    void imprimirRelatorio() const;
+
+    /**
+     * @brief Salva os resultados em arquivo CSV
+     * @param arquivo Caminho do arquivo de saída
+     * @param metadados Semente e ambiente, repetidos em cada linha
+     * @throws std::runtime_error se não conseguir criar o arquivo
+     */
+    void salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const;
+
+    /**
+     * @brief Obtém a topologia usada nas anotações
+     * @return Referência para a topologia detectada
+     */
+    const TopologiaMemoria& getTopologia() const {
+        return topologia;
+    }
+};
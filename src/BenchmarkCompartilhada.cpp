@@ -0,0 +1,280 @@
+/**
+ * @file BenchmarkCompartilhada.cpp
+ * @brief Implementação do benchmark de leitores entre processos
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "BenchmarkCompartilhada.hpp"
+#include "CarregadorDados.hpp"
+#include "MetadadosExecucao.hpp"
+#include "ProcessoIsolado.hpp"
+#include "Rastreamento.hpp"
+#include "TabelaAberta.hpp"
+#include "TabelaCompartilhada.hpp"
+#include "TabelaRedimensionavel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+/// Tamanho com fator de carga 0,5 para n chaves (o mesmo nos dois arranjos)
+size_t tamanhoPara(size_t n) {
+    return TabelaRedimensionavel::proximoPrimo(2 * n + 1);
+}
+
+/// Percorre as consultas até completar as buscas e devolve "ns acertos"
+template<typename Buscar>
+std::string cronometrarBuscas(const std::vector<int>& consultas, size_t buscas, Buscar&& buscar) {
+    size_t acertos = 0;
+    const auto inicio = Relogio::now();
+    for (size_t i = 0; i < buscas; ++i) {
+        acertos += buscar(consultas[i % consultas.size()]) ? 1 : 0;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+    std::ostringstream resposta;
+    resposta << ns << " " << acertos;
+    return resposta.str();
+}
+
+} // namespace
+
+BenchmarkCompartilhada::BenchmarkCompartilhada(size_t chaves, const std::vector<size_t>& numerosLeitores,
+                                               unsigned int semente)
+    : quantidade(chaves), leitores(numerosLeitores), seed(semente) {
+    if (quantidade == 0 || leitores.empty()) {
+        throw std::invalid_argument("Benchmark compartilhado requer chaves e ao menos um número de leitores");
+    }
+    if (std::find(leitores.begin(), leitores.end(), 0) != leitores.end()) {
+        throw std::invalid_argument("Números de leitores devem ser positivos");
+    }
+}
+
+/**
+ * @brief Executa os leitores em processos filhos, um por thread do pai
+ *
+ * Na compartilhada, a thread principal do pai é o escritor: remove e
+ * reinsere chaves sorteadas, publicando a cada MUTACOES_POR_VERSAO, até
+ * que todos os leitores terminem.
+ */
+void BenchmarkCompartilhada::medir(const std::vector<int>& chaves, const std::vector<int>& consultas,
+                                   size_t numLeitores, bool compartilhada) {
+    RASTREAR_ESCOPO_DETALHE("medirCompartilhada", "compartilhada",
+                            std::string(compartilhada ? "compartilhada " : "privada ") + std::to_string(numLeitores));
+    std::cout << "  " << (compartilhada ? "Compartilhada" : "Privada") << " com " << numLeitores
+              << " leitor(es)..." << std::flush;
+
+    const size_t tamanho = tamanhoPara(chaves.size());
+    std::string nomeSegmento;
+    TabelaCompartilhada* tabela = nullptr;
+    std::unique_ptr<TabelaCompartilhada> segmento;
+    if (compartilhada) {
+#if defined(__unix__) || defined(__APPLE__)
+        nomeSegmento = "/analise_hash_compartilhada_" + std::to_string(::getpid());
+#endif
+        TabelaCompartilhada::removerNome(nomeSegmento);
+        segmento = std::make_unique<TabelaCompartilhada>(
+            TabelaCompartilhada::criar(nomeSegmento, tamanho, TabelaCompartilhada::TipoHash::DIVISAO));
+        tabela = segmento.get();
+        for (int chave : chaves) {
+            tabela->inserir(chave);
+        }
+        tabela->publicar();
+    }
+
+    auto tarefa = [&]() -> std::string {
+        if (compartilhada) {
+            const TabelaCompartilhada leitura = TabelaCompartilhada::abrir(nomeSegmento);
+            return cronometrarBuscas(consultas, BUSCAS_POR_LEITOR, [&](int chave) { return leitura.buscar(chave); });
+        }
+        TabelaAberta privada(tamanho);
+        for (int chave : chaves) {
+            privada.inserir(chave, TabelaAberta::TipoHash::DIVISAO);
+        }
+        return cronometrarBuscas(consultas, BUSCAS_POR_LEITOR, [&](int chave) {
+            return privada.buscar(chave, TabelaAberta::TipoHash::DIVISAO);
+        });
+    };
+
+    std::vector<std::string> respostas(numLeitores);
+    std::vector<std::exception_ptr> erros(numLeitores);
+    std::atomic<size_t> concluidos{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numLeitores; ++i) {
+        threads.emplace_back([&, i] {
+            try {
+                respostas[i] = executarEmProcessoFilho(tarefa);
+            } catch (...) {
+                erros[i] = std::current_exception();
+            }
+            concluidos.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    size_t mutacoes = 0;
+    double segundosEscritor = 0.0;
+    uint64_t versaoInicial = 0;
+    uint64_t compactacoesIniciais = 0;
+    if (compartilhada) {
+        versaoInicial = tabela->getVersao();
+        compactacoesIniciais = tabela->getCompactacoes();
+        std::mt19937 gerador(seed);
+        std::uniform_int_distribution<size_t> indice(0, chaves.size() - 1);
+        const auto inicio = Relogio::now();
+        while (concluidos.load(std::memory_order_acquire) < numLeitores) {
+            for (size_t j = 0; j < MUTACOES_POR_VERSAO; j += 2) {
+                const int chave = chaves[indice(gerador)];
+                tabela->remover(chave);
+                tabela->inserir(chave);
+            }
+            mutacoes += MUTACOES_POR_VERSAO;
+            tabela->publicar();
+        }
+        segundosEscritor = std::chrono::duration<double>(Relogio::now() - inicio).count();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (compartilhada) {
+        TabelaCompartilhada::removerNome(nomeSegmento);
+    }
+    for (const auto& erro : erros) {
+        if (erro) {
+            std::rethrow_exception(erro);
+        }
+    }
+
+    ResultadoCompartilhada resultado{};
+    resultado.compartilhada = compartilhada;
+    resultado.leitores = numLeitores;
+    resultado.buscasPorLeitor = BUSCAS_POR_LEITOR;
+    double somaNs = 0.0;
+    for (const auto& resposta : respostas) {
+        std::istringstream campos(resposta);
+        double ns = 0.0;
+        size_t acertos = 0;
+        campos >> ns >> acertos;
+        somaNs += ns;
+        resultado.mBuscasPorSegundo += BUSCAS_POR_LEITOR / (ns / 1000.0);
+    }
+    resultado.nsPorBusca = somaNs / (numLeitores * BUSCAS_POR_LEITOR);
+    resultado.chaves = chaves.size();
+    if (compartilhada) {
+        resultado.mbTabelas = tabela->getBytesSegmento() / (1024.0 * 1024.0);
+        resultado.mutacoesPorSegundo = segundosEscritor > 0.0 ? mutacoes / segundosEscritor : 0.0;
+        resultado.versoes = static_cast<size_t>(tabela->getVersao() - versaoInicial);
+        resultado.compactacoes = static_cast<size_t>(tabela->getCompactacoes() - compactacoesIniciais);
+    } else {
+        resultado.mbTabelas = numLeitores * tamanho * sizeof(Celula) / (1024.0 * 1024.0);
+    }
+    resultados.push_back(resultado);
+    std::cout << " OK" << std::endl;
+}
+
+void BenchmarkCompartilhada::executar() {
+    if (!isolamentoDisponivel()) {
+        throw std::runtime_error("Benchmark compartilhado requer fork() e memória compartilhada (sistemas POSIX)");
+    }
+
+    // INT_MIN e INT_MIN + 1 são reservados pela TabelaCompartilhada; as chaves ficam em [1, INT_MAX]
+    CarregadorDados carregador(seed, 1, std::numeric_limits<int>::max());
+    auto chaves = carregador.gerarNumerosAleatoriosComRepeticao(quantidade);
+    std::sort(chaves.begin(), chaves.end());
+    chaves.erase(std::unique(chaves.begin(), chaves.end()), chaves.end());
+
+    // Metade das consultas entre as chaves inseridas, metade sorteadas
+    std::vector<int> consultas = carregador.gerarNumerosAleatoriosComRepeticao(quantidade);
+    std::mt19937 gerador(seed + 1);
+    std::uniform_int_distribution<size_t> indice(0, chaves.size() - 1);
+    for (size_t i = 0; i < consultas.size(); i += 2) {
+        consultas[i] = chaves[indice(gerador)];
+    }
+
+    for (size_t numLeitores : leitores) {
+        medir(chaves, consultas, numLeitores, false);
+        medir(chaves, consultas, numLeitores, true);
+    }
+}
+
+void BenchmarkCompartilhada::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de memória compartilhada disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "LEITORES EM PROCESSOS: CÓPIAS PRIVADAS x TABELA COMPARTILHADA (carga 0,5, "
+              << resultados.front().chaves << " chaves)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << std::left
+              << std::setw(16) << "Arranjo"
+              << std::setw(10) << "Leitores"
+              << std::setw(14) << "MB tabelas"
+              << std::setw(14) << "Mbuscas/s"
+              << std::setw(10) << "ns/busca"
+              << std::setw(17) << "Mutações/s"
+              << std::setw(16) << "Publicações"
+              << "Compactações" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    for (const auto& r : resultados) {
+        std::cout << std::left << std::fixed
+                  << std::setw(16) << (r.compartilhada ? "compartilhada" : "privada")
+                  << std::setw(10) << r.leitores
+                  << std::setw(14) << std::setprecision(2) << r.mbTabelas
+                  << std::setw(14) << r.mBuscasPorSegundo
+                  << std::setw(10) << std::setprecision(1) << r.nsPorBusca
+                  << std::setw(15) << std::setprecision(0) << r.mutacoesPorSegundo
+                  << std::setw(14) << r.versoes
+                  << r.compactacoes << std::endl;
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "MB tabelas = soma entre os processos; na compartilhada, o escritor altera a tabela durante as buscas"
+              << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void BenchmarkCompartilhada::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+    saida << "Arranjo,Leitores,Chaves,MBTabelas,BuscasPorLeitor,MBuscasPorSegundo,NsPorBusca,"
+          << "MutacoesPorSegundo,Publicacoes,Compactacoes," << MetadadosExecucao::CABECALHO_CSV << "\n";
+    for (const auto& r : resultados) {
+        saida << (r.compartilhada ? "compartilhada" : "privada") << ","
+              << r.leitores << ","
+              << r.chaves << ","
+              << std::fixed << std::setprecision(4) << r.mbTabelas << ","
+              << r.buscasPorLeitor << ","
+              << r.mBuscasPorSegundo << ","
+              << std::setprecision(2) << r.nsPorBusca << ","
+              << std::setprecision(0) << r.mutacoesPorSegundo << ","
+              << r.versoes << ","
+              << r.compactacoes << "," << identificacao << "\n";
+    }
+    saida.close();
+
+    std::cout << "\nResultados da memória compartilhada salvos em: " << arquivo << std::endl;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file BenchmarkConjuntos.cpp
+ * @brief Implementação do benchmark de operações de conjunto
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "BenchmarkConjuntos.hpp"
+#include "CarregadorDados.hpp"
+#include "MetadadosExecucao.hpp"
+#include "OperacoesConjunto.hpp"
+#include "Rastreamento.hpp"
+#include "RegistroMotores.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+/// Operações na ordem do relatório
+constexpr const char* OPERACOES[] = {"intersecao", "uniao", "diferenca"};
+
+/**
+ * @brief Menor tempo de REPETICOES execuções, em ms
+ * @param executar Função que devolve o número de chaves produzidas
+ * @param chavesResultado Recebe o número de chaves da última execução
+ */
+template<typename Funcao>
+double menorTempo(Funcao&& executar, size_t& chavesResultado) {
+    double melhor = std::numeric_limits<double>::max();
+    for (size_t r = 0; r < BenchmarkConjuntos::REPETICOES; ++r) {
+        const auto inicio = Relogio::now();
+        chavesResultado = executar();
+        melhor = std::min(melhor, std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count());
+    }
+    return melhor;
+}
+
+/// Laço de referência: chama buscar() chave a chave, na ordem do vetor
+template<typename Tabela>
+std::vector<int> filtrarPorLaco(const std::vector<int>& chaves, const Tabela& tabela, typename Tabela::TipoHash tipo,
+                                bool presentes) {
+    std::vector<int> resultado;
+    for (int chave : chaves) {
+        if (static_cast<bool>(tabela.buscar(chave, tipo)) == presentes) {
+            resultado.push_back(chave);
+        }
+    }
+    return resultado;
+}
+
+} // namespace
+
+BenchmarkConjuntos::BenchmarkConjuntos(size_t chaves, size_t threadsParalelo, unsigned int semente)
+    : quantidade(chaves), threads(threadsParalelo), seed(semente) {
+    if (quantidade == 0) {
+        throw std::invalid_argument("Quantidade de chaves das operações de conjunto deve ser positiva");
+    }
+}
+
+/**
+ * @brief std::set_* sobre os vetores ordenados; define os tamanhos esperados
+ */
+void BenchmarkConjuntos::medirStd(const std::vector<int>& a, const std::vector<int>& b,
+                                  std::vector<size_t>& esperados) {
+    std::cout << "  std::set_*..." << std::flush;
+
+    double msOrdenacao = std::numeric_limits<double>::max();
+    std::vector<int> ordenadoA;
+    std::vector<int> ordenadoB;
+    for (size_t r = 0; r < REPETICOES; ++r) {
+        ordenadoA = a;
+        ordenadoB = b;
+        const auto inicio = Relogio::now();
+        std::sort(ordenadoA.begin(), ordenadoA.end());
+        std::sort(ordenadoB.begin(), ordenadoB.end());
+        msOrdenacao = std::min(msOrdenacao, std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count());
+    }
+
+    std::vector<int> saida;
+    saida.reserve(a.size() + b.size());
+    for (const char* operacao : OPERACOES) {
+        const std::string nomeOperacao = operacao;
+        ResultadoConjunto r{};
+        r.motor = "std";
+        r.operacao = nomeOperacao;
+        r.threads = 1;
+        r.chavesEntrada = a.size() + b.size();
+        r.msOrdenacao = msOrdenacao;
+        r.ms = menorTempo([&] {
+            saida.clear();
+            if (nomeOperacao == "intersecao") {
+                std::set_intersection(ordenadoA.begin(), ordenadoA.end(), ordenadoB.begin(), ordenadoB.end(),
+                                      std::back_inserter(saida));
+            } else if (nomeOperacao == "uniao") {
+                std::set_union(ordenadoA.begin(), ordenadoA.end(), ordenadoB.begin(), ordenadoB.end(),
+                               std::back_inserter(saida));
+            } else {
+                std::set_difference(ordenadoA.begin(), ordenadoA.end(), ordenadoB.begin(), ordenadoB.end(),
+                                    std::back_inserter(saida));
+            }
+            return saida.size();
+        }, r.chavesResultado);
+        r.metodo = "std::set_" + std::string(nomeOperacao == "intersecao" ? "intersection"
+                                             : nomeOperacao == "uniao" ? "union" : "difference");
+        r.mChavesPorSegundo = r.chavesEntrada / (r.ms * 1000.0);
+        esperados.push_back(r.chavesResultado);
+        resultados.push_back(r);
+    }
+    std::cout << " OK" << std::endl;
+}
+
+/**
+ * @brief Laço, lote e paralelo para as três operações num motor
+ */
+template<typename Tabela>
+void BenchmarkConjuntos::medirMotor(const char* nome, const std::vector<int>& a, const std::vector<int>& b,
+                                    const std::vector<size_t>& esperados) {
+    RASTREAR_ESCOPO_DETALHE("medirConjuntos", "conjuntos", nome);
+    std::cout << "  " << nome << "..." << std::flush;
+
+    const auto tipo = Tabela::TipoHash::DIVISAO;
+    const Tabela tabelaA = construirTabela<Tabela>(a, tipo);
+    const Tabela tabelaB = construirTabela<Tabela>(b, tipo);
+
+    ConfiguracaoConjunto emLote;
+    ConfiguracaoConjunto paralelo;
+    paralelo.threads = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+    struct Metodo {
+        const char* nome;
+        const ConfiguracaoConjunto* config;  // nullptr = laço de buscar()
+    };
+    std::vector<Metodo> metodos{{"laco", nullptr}, {"lote", &emLote}};
+    if (paralelo.threads > 1) {
+        metodos.push_back({"paralelo", &paralelo});
+    }
+
+    for (size_t o = 0; o < std::size(OPERACOES); ++o) {
+        const std::string operacao = OPERACOES[o];
+        double msLaco = 0.0;
+        for (const Metodo& metodo : metodos) {
+            ResultadoConjunto r{};
+            r.motor = nome;
+            r.operacao = operacao;
+            r.metodo = metodo.nome;
+            r.threads = metodo.config != nullptr ? metodo.config->threads : 1;
+            r.chavesEntrada = a.size() + b.size();
+            r.ms = menorTempo([&]() -> size_t {
+                // Interseção e diferença consultam B com as chaves de A; a união, A com as de B
+                const bool uniaoAB = operacao == "uniao";
+                const std::vector<int>& consultadas = uniaoAB ? b : a;
+                const Tabela& tabela = uniaoAB ? tabelaA : tabelaB;
+                const bool presentes = operacao == "intersecao";
+                std::vector<int> filtradas = metodo.config == nullptr
+                    ? filtrarPorLaco(consultadas, tabela, tipo, presentes)
+                    : filtrarChaves(consultadas, tabela, tipo, presentes, *metodo.config);
+                if (!uniaoAB) {
+                    return filtradas.size();
+                }
+                std::vector<int> resultado;
+                resultado.reserve(a.size() + filtradas.size());
+                resultado.insert(resultado.end(), a.begin(), a.end());
+                resultado.insert(resultado.end(), filtradas.begin(), filtradas.end());
+                return resultado.size();
+            }, r.chavesResultado);
+
+            if (r.chavesResultado != esperados[o]) {
+                throw std::runtime_error(std::string(nome) + " " + operacao + " (" + metodo.nome + "): " +
+                                         std::to_string(r.chavesResultado) + " chaves, esperadas " +
+                                         std::to_string(esperados[o]));
+            }
+            if (metodo.config == nullptr) {
+                msLaco = r.ms;
+            }
+            r.mChavesPorSegundo = r.chavesEntrada / (r.ms * 1000.0);
+            r.aceleracaoLaco = msLaco / r.ms;
+            resultados.push_back(r);
+        }
+    }
+    std::cout << " OK" << std::endl;
+}
+
+void BenchmarkConjuntos::executar() {
+    // Chaves distintas embaralhadas: A = primeiros 2/3, B = últimos 2/3 (metade de cada em comum)
+    CarregadorDados carregador(seed, 1, std::numeric_limits<int>::max());
+    std::vector<int> chaves = carregador.gerarNumerosAleatoriosComRepeticao(quantidade + quantidade / 2);
+    std::sort(chaves.begin(), chaves.end());
+    chaves.erase(std::unique(chaves.begin(), chaves.end()), chaves.end());
+    std::shuffle(chaves.begin(), chaves.end(), std::mt19937(seed));
+    const size_t tamanhoConjunto = chaves.size() * 2 / 3;
+    const std::vector<int> a(chaves.begin(), chaves.begin() + tamanhoConjunto);
+    const std::vector<int> b(chaves.end() - tamanhoConjunto, chaves.end());
+
+    std::vector<size_t> esperados;
+    medirStd(a, b, esperados);
+    std::apply([&](const auto&... motor) {
+        (medirMotor<typename std::decay_t<decltype(motor)>::Tabela>(motor.nome, a, b, esperados), ...);
+    }, MOTORES_REGISTRADOS);
+}
+
+void BenchmarkConjuntos::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de operações de conjunto disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "OPERAÇÕES DE CONJUNTO (" << resultados.front().chavesEntrada / 2
+              << " chaves por conjunto, metade em comum)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << std::left
+              << std::setw(12) << "Motor"
+              << std::setw(14) << "Operação"
+              << std::setw(23) << "Método"
+              << std::setw(9) << "Threads"
+              << std::setw(13) << "Resultado"
+              << std::setw(11) << "ms"
+              << std::setw(13) << "Mchaves/s"
+              << "x laço" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    for (const auto& r : resultados) {
+        std::cout << std::left << std::fixed
+                  << std::setw(12) << r.motor
+                  << std::setw(r.operacao == "intersecao" ? 14 : 13) << (r.operacao == "intersecao" ? "interseção"
+                                                                         : r.operacao == "uniao" ? "união" : "diferença")
+                  << std::setw(r.metodo == "laco" ? 23 : 22) << (r.metodo == "laco" ? "laço buscar()" : r.metodo)
+                  << std::setw(9) << r.threads
+                  << std::setw(13) << r.chavesResultado
+                  << std::setw(11) << std::setprecision(2) << r.ms
+                  << std::setw(13) << r.mChavesPorSegundo;
+        if (r.aceleracaoLaco > 0.0) {
+            std::cout << r.aceleracaoLaco;
+        } else {
+            std::cout << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    const auto ordenacao = std::find_if(resultados.begin(), resultados.end(),
+                                        [](const ResultadoConjunto& r) { return r.motor == "std"; });
+    if (ordenacao != resultados.end()) {
+        std::cout << "std::set_* sobre vetores já ordenados; ordenar os dois conjuntos custa mais "
+                  << std::setprecision(2) << ordenacao->msOrdenacao << " ms" << std::endl;
+    }
+    std::cout << "Tabelas consultadas na ordem dos vetores (união inclui copiar A); Mchaves/s conta os dois conjuntos"
+              << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void BenchmarkConjuntos::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+    saida << "Motor,Operacao,Metodo,Threads,ChavesEntrada,ChavesResultado,Ms,MChavesPorSegundo,"
+          << "AceleracaoLaco,MsOrdenacao," << MetadadosExecucao::CABECALHO_CSV << "\n";
+    for (const auto& r : resultados) {
+        saida << r.motor << ","
+              << r.operacao << ","
+              << r.metodo << ","
+              << r.threads << ","
+              << r.chavesEntrada << ","
+              << r.chavesResultado << ","
+              << std::fixed << std::setprecision(3) << r.ms << ","
+              << r.mChavesPorSegundo << ","
+              << r.aceleracaoLaco << ","
+              << r.msOrdenacao << "," << identificacao << "\n";
+    }
+    saida.close();
+
+    std::cout << "\nResultados das operações de conjunto salvos em: " << arquivo << std::endl;
+}
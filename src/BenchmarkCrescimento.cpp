@@ -0,0 +1,191 @@
+/**
+ * @file BenchmarkCrescimento.cpp
+ * @brief Implementação do benchmark de latência durante o crescimento
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "BenchmarkCrescimento.hpp"
+#include "CarregadorDados.hpp"
+#include "MetadadosExecucao.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Percentil pelo método do posto mais próximo
+ * @param ordenadas Amostra em ordem crescente (não vazia)
+ * @param q Fração entre 0 e 1
+ */
+double percentilOrdenado(const std::vector<double>& ordenadas, double q) {
+    const size_t posto = static_cast<size_t>(std::ceil(q * ordenadas.size()));
+    return ordenadas[std::max<size_t>(posto, 1) - 1];
+}
+
+} // namespace
+
+BenchmarkCrescimento::BenchmarkCrescimento(size_t chaves, unsigned int semente)
+    : quantidade(chaves), seed(semente) {
+    if (quantidade == 0) {
+        throw std::invalid_argument("Quantidade de chaves do benchmark de crescimento deve ser positiva");
+    }
+}
+
+/**
+ * @brief Cronometra cada inserção a partir da tabela vazia
+ *
+ * O vetor de latências é alocado antes para que nenhuma alocação dele caia
+ * dentro das regiões medidas. O tempo total inclui finalizarMigracao(), de
+ * modo que os modos que adiam trabalho não ganhem vazão por deixá-lo
+ * pendente.
+ */
+void BenchmarkCrescimento::medirModo(TabelaRedimensionavel::Modo modo, const std::vector<int>& chaves) {
+    std::ostringstream detalhe;
+    detalhe << modo << " " << chaves.size();
+    RASTREAR_ESCOPO_DETALHE("medirCrescimento", "crescimento", detalhe.str());
+
+    using Relogio = std::chrono::high_resolution_clock;
+    std::vector<double> latencias(chaves.size());
+    TabelaRedimensionavel tabela(modo);
+
+    const auto inicio = Relogio::now();
+    for (size_t i = 0; i < chaves.size(); ++i) {
+        const auto antes = Relogio::now();
+        tabela.inserir(chaves[i]);
+        const auto depois = Relogio::now();
+        latencias[i] = std::chrono::duration<double, std::nano>(depois - antes).count();
+    }
+    tabela.finalizarMigracao();
+    const auto fim = Relogio::now();
+
+    for (int chave : chaves) {
+        if (!tabela.buscar(chave)) {
+            throw std::runtime_error("Chave perdida no crescimento (" + detalhe.str() + "): "
+                                     + std::to_string(chave));
+        }
+    }
+
+    ResultadoCrescimento resultado{};
+    resultado.modo = modo;
+    resultado.quantidadeChaves = chaves.size();
+    resultado.tamanhoFinal = tabela.getTamanho();
+    resultado.redimensionamentos = tabela.getRedimensionamentos();
+    resultado.nsMedio = std::accumulate(latencias.begin(), latencias.end(), 0.0) / latencias.size();
+    resultado.pausasLongas = static_cast<size_t>(std::count_if(latencias.begin(), latencias.end(),
+        [](double ns) { return ns > LIMIAR_PAUSA_NS; }));
+
+    std::sort(latencias.begin(), latencias.end());
+    resultado.nsP50 = percentilOrdenado(latencias, 0.50);
+    resultado.nsP99 = percentilOrdenado(latencias, 0.99);
+    resultado.nsP999 = percentilOrdenado(latencias, 0.999);
+    resultado.nsMaximo = latencias.back();
+
+    resultado.tempoTotalMs = std::chrono::duration<double, std::milli>(fim - inicio).count();
+    resultado.mopsPorSegundo = resultado.tempoTotalMs > 0.0
+        ? chaves.size() / (resultado.tempoTotalMs * 1000.0)
+        : 0.0;
+    resultados.push_back(resultado);
+}
+
+void BenchmarkCrescimento::executar() {
+    // INT_MIN é reservado pela tabela; as chaves ficam em [1, INT_MAX]
+    CarregadorDados carregador(seed, 1, std::numeric_limits<int>::max());
+    const auto chaves = carregador.gerarNumerosAleatoriosComRepeticao(quantidade);
+
+    for (auto modo : {TabelaRedimensionavel::Modo::PARADA_TOTAL,
+                      TabelaRedimensionavel::Modo::INCREMENTAL,
+                      TabelaRedimensionavel::Modo::SEGUNDO_PLANO}) {
+        std::cout << "  Crescimento " << modo << " com " << quantidade << " chaves..." << std::flush;
+        medirModo(modo, chaves);
+        std::cout << " OK" << std::endl;
+    }
+}
+
+void BenchmarkCrescimento::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de crescimento disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "LATÊNCIA DE INSERÇÃO DURANTE O CRESCIMENTO (" << resultados.front().quantidadeChaves
+              << " chaves a partir da tabela vazia)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+
+    std::cout << std::left
+              << std::setw(14) << "Modo"
+              << std::setw(8) << "Cresc."
+              << std::setw(12) << "Média ns"
+              << std::setw(10) << "p50 ns"
+              << std::setw(10) << "p99 ns"
+              << std::setw(12) << "p99,9 ns"
+              << std::setw(16) << "Pausa máx µs"
+              << std::setw(10) << "Pausas"
+              << std::setw(12) << "Total ms"
+              << "Mops/s" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+
+    for (const auto& r : resultados) {
+        std::ostringstream modo;
+        modo << r.modo;
+        std::cout << std::left << std::fixed
+                  << std::setw(14) << modo.str()
+                  << std::setw(8) << r.redimensionamentos
+                  << std::setw(11) << std::setprecision(1) << r.nsMedio
+                  << std::setw(10) << std::setprecision(0) << r.nsP50
+                  << std::setw(10) << r.nsP99
+                  << std::setw(12) << r.nsP999
+                  << std::setw(14) << std::setprecision(1) << r.nsMaximo / 1000.0
+                  << std::setw(10) << r.pausasLongas
+                  << std::setw(12) << std::setprecision(1) << r.tempoTotalMs
+                  << std::setprecision(2) << r.mopsPorSegundo << std::endl;
+    }
+
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Pausas = inserções acima de " << std::setprecision(0) << LIMIAR_PAUSA_NS / 1000.0
+              << " µs; Total inclui a conclusão da migração pendente" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void BenchmarkCrescimento::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream arq(arquivo);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+
+    arq << "Modo,QuantidadeChaves,TamanhoFinal,Redimensionamentos,NsMedio,NsP50,NsP99,NsP999,"
+        << "NsMaximo,PausasLongas,TempoTotalMs,MopsPorSegundo," << MetadadosExecucao::CABECALHO_CSV << "\n";
+
+    for (const auto& r : resultados) {
+        arq << r.modo << ","
+            << r.quantidadeChaves << ","
+            << r.tamanhoFinal << ","
+            << r.redimensionamentos << ","
+            << std::fixed << std::setprecision(2) << r.nsMedio << ","
+            << r.nsP50 << ","
+            << r.nsP99 << ","
+            << r.nsP999 << ","
+            << r.nsMaximo << ","
+            << r.pausasLongas << ","
+            << std::setprecision(3) << r.tempoTotalMs << ","
+            << std::setprecision(4) << r.mopsPorSegundo << "," << identificacao << "\n";
+    }
+
+    arq.close();
+    std::cout << "\nResultados do crescimento salvos em: " << arquivo << std::endl;
+}
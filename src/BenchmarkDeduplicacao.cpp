@@ -0,0 +1,287 @@
+/**
+ * @file BenchmarkDeduplicacao.cpp
+ * @brief Implementação do benchmark de deduplicação em disco
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "BenchmarkDeduplicacao.hpp"
+#include "CarregadorDados.hpp"
+#include "ControleCache.hpp"
+#include "DeduplicacaoExterna.hpp"
+#include "MetadadosExecucao.hpp"
+#include "Rastreamento.hpp"
+#include "RegistroMotores.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+/// Bytes por chave do unordered_set (nó com cabeçalho do alocador e balde) mais o vetor carregado
+constexpr uint64_t BYTES_POR_CHAVE_UNORDERED_SET = 52;
+
+/**
+ * @brief Zera o pico de memória residente do processo
+ * @return false se o sistema não permitir (só Linux, por /proc/self/clear_refs)
+ */
+bool reiniciarPicoMemoria() {
+#if defined(__linux__)
+    std::ofstream limpar("/proc/self/clear_refs");
+    limpar << "5";
+    limpar.close();
+    return static_cast<bool>(limpar);
+#else
+    return false;
+#endif
+}
+
+/// Pico de memória residente (VmHWM) em MiB; 0 se indisponível
+double picoMemoriaMb() {
+    std::ifstream status("/proc/self/status");
+    std::string campo;
+    while (status >> campo) {
+        if (campo == "VmHWM:") {
+            double kb = 0.0;
+            status >> kb;
+            return kb / 1024.0;
+        }
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Grava um dataset de chaves sorteadas em [1, distintas], bloco a bloco
+ */
+void gerarDataset(const std::string& caminho, uint64_t chaves, uint64_t distintas, unsigned int semente) {
+    std::ofstream saida(caminho, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + caminho);
+    }
+    std::mt19937 gerador(semente);
+    std::uniform_int_distribution<int> distribuicao(1, static_cast<int>(distintas));
+    std::string texto = std::to_string(chaves) + "\n";
+    char numero[16];
+    for (uint64_t i = 0; i < chaves; ++i) {
+        const auto fim = std::to_chars(numero, numero + sizeof(numero), distribuicao(gerador)).ptr;
+        texto.append(numero, fim);
+        texto += '\n';
+        if (texto.size() >= (1 << 20)) {
+            saida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+            texto.clear();
+        }
+    }
+    saida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+    saida.close();
+    if (!saida) {
+        throw std::runtime_error("Erro ao gravar arquivo: " + caminho);
+    }
+}
+
+} // namespace
+
+BenchmarkDeduplicacao::BenchmarkDeduplicacao(const std::string& dataset, uint64_t chaves, uint64_t distintas,
+                                             size_t memoria, const std::string& diretorioTrabalho,
+                                             const std::string& saidaUnicas, unsigned int semente)
+    : arquivo(dataset), chavesGeradas(chaves), distintasGeradas(distintas), bytesMemoria(memoria),
+      diretorio(diretorioTrabalho), arquivoUnicos(saidaUnicas), seed(semente), mbArquivo(0.0) {
+    if (arquivo.empty() && (chavesGeradas == 0 || distintasGeradas == 0 || distintasGeradas > INT_MAX)) {
+        throw std::invalid_argument("Dataset gerado requer chaves e distintas em [1, INT_MAX]");
+    }
+}
+
+/**
+ * @brief CarregadorDados::analisarDataset: o dataset e um unordered_set em memória
+ */
+void BenchmarkDeduplicacao::medirUnorderedSet(const std::string& dataset) {
+    RASTREAR_ESCOPO_DETALHE("medirDeduplicacao", "deduplicacao", "unordered_set");
+    std::cout << "  unordered_set (analisarDataset)..." << std::flush;
+
+    const bool picoMedido = reiniciarPicoMemoria();
+    const auto inicio = Relogio::now();
+    CarregadorDados carregador;
+    const CarregadorDados::InfoDataset info = carregador.analisarDataset(dataset);
+    const double ms = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+
+    MedicaoDeduplicacao r{};
+    r.metodo = "unordered_set";
+    r.chaves = info.quantidade;
+    r.unicas = info.quantidade - info.numDuplicatas;
+    r.particoes = 1;
+    r.msDeduplicacao = ms;
+    r.ms = ms;
+    r.mChavesPorSegundo = r.chaves / (ms * 1000.0);
+    r.mbPicoMemoria = picoMedido ? picoMemoriaMb() : 0.0;
+    resultados.push_back(r);
+    std::cout << " OK" << std::endl;
+}
+
+/**
+ * @brief deduplicarArquivo com um motor, dentro do orçamento
+ */
+template<typename Tabela>
+void BenchmarkDeduplicacao::medirMotor(const char* nome, const std::string& dataset, bool gravarUnicas) {
+    RASTREAR_ESCOPO_DETALHE("medirDeduplicacao", "deduplicacao", nome);
+    std::cout << "  " << nome << "..." << std::flush;
+
+    ConfiguracaoDeduplicacao config;
+    config.bytesMemoria = bytesMemoria;
+    config.diretorio = diretorio;
+    config.arquivoUnicos = gravarUnicas ? arquivoUnicos : std::string();
+
+    const bool picoMedido = reiniciarPicoMemoria();
+    const auto inicio = Relogio::now();
+    const ResultadoDeduplicacao resultado = deduplicarArquivo<Tabela>(dataset, Tabela::TipoHash::DIVISAO, config);
+    const double ms = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+
+    MedicaoDeduplicacao r{};
+    r.metodo = nome;
+    r.chaves = resultado.chaves;
+    r.unicas = resultado.unicas;
+    r.particoes = resultado.particoes;
+    r.niveis = resultado.niveis;
+    r.mbDerramados = resultado.bytesDerramados / (1024.0 * 1024.0);
+    r.msParticionamento = resultado.msParticionamento;
+    r.msDeduplicacao = resultado.msDeduplicacao;
+    r.ms = ms;
+    r.mChavesPorSegundo = r.chaves / (ms * 1000.0);
+    r.mbPicoMemoria = picoMedido ? picoMemoriaMb() : 0.0;
+    if (!resultados.empty() && r.unicas != resultados.front().unicas) {
+        throw std::runtime_error(std::string(nome) + ": " + std::to_string(r.unicas) + " distintas, esperadas " +
+                                 std::to_string(resultados.front().unicas) + " (" + resultados.front().metodo + ")");
+    }
+    resultados.push_back(r);
+    std::cout << " OK" << std::endl;
+}
+
+void BenchmarkDeduplicacao::executar() {
+    const fs::path base = diretorio.empty() ? fs::temp_directory_path() : fs::path(diretorio);
+    std::string dataset = arquivo;
+    if (dataset.empty()) {
+        fs::create_directories(base);
+        dataset = (base / "analise_hash_dedup_dataset.txt").string();
+        std::cout << "  Gerando " << chavesGeradas << " chaves em [1, " << distintasGeradas << "] em "
+                  << dataset << "..." << std::flush;
+        gerarDataset(dataset, chavesGeradas, distintasGeradas, seed);
+        std::cout << " OK" << std::endl;
+    }
+    mbArquivo = fs::file_size(dataset) / (1024.0 * 1024.0);
+
+    try {
+        // Motores antes do unordered_set: os nós liberados por ele continuariam
+        // no heap do processo e inflariam o pico medido dos motores
+        bool primeiro = true;
+        std::apply([&](const auto&... motor) {
+            ((medirMotor<typename std::decay_t<decltype(motor)>::Tabela>(motor.nome, dataset, primeiro),
+              primeiro = false), ...);
+        }, MOTORES_REGISTRADOS);
+
+        // O unordered_set só é medido quando cabe com folga na RAM
+        const uint64_t declaradas = LeitorDataset(dataset).getQuantidadeDeclarada();
+        const size_t memoriaFisica = detectarTopologiaMemoria().memoriaFisica;
+        if (memoriaFisica == 0 || declaradas * BYTES_POR_CHAVE_UNORDERED_SET < memoriaFisica / 2) {
+            medirUnorderedSet(dataset);
+        } else {
+            std::cout << "  unordered_set ignorado: ~" << declaradas * BYTES_POR_CHAVE_UNORDERED_SET / (1024 * 1024)
+                      << " MiB estimados excedem metade da RAM" << std::endl;
+        }
+    } catch (...) {
+        if (arquivo.empty()) {
+            fs::remove(dataset);
+        }
+        throw;
+    }
+    if (arquivo.empty()) {
+        fs::remove(dataset);
+    }
+}
+
+void BenchmarkDeduplicacao::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de deduplicação disponível." << std::endl;
+        return;
+    }
+
+    const MedicaoDeduplicacao& primeira = resultados.front();
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "CONTAGEM DE DISTINTAS: " << primeira.chaves << " chaves, " << primeira.unicas << " distintas ("
+              << std::fixed << std::setprecision(1) << mbArquivo << " MiB; orçamento dos motores: "
+              << bytesMemoria / (1024 * 1024) << " MiB)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << std::left
+              << std::setw(15) << "Método"
+              << std::setw(12) << "Partições"
+              << std::setw(9) << "Níveis"
+              << std::setw(15) << "MiB derrame"
+              << std::setw(12) << "Part. ms"
+              << std::setw(12) << "Dedup ms"
+              << std::setw(12) << "Total ms"
+              << std::setw(12) << "Mchaves/s"
+              << "Pico RSS MiB" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    for (const auto& r : resultados) {
+        std::cout << std::left << std::fixed
+                  << std::setw(14) << r.metodo
+                  << std::setw(10) << r.particoes
+                  << std::setw(8) << r.niveis
+                  << std::setw(15) << std::setprecision(1) << r.mbDerramados
+                  << std::setw(12) << std::setprecision(2) << r.msParticionamento
+                  << std::setw(12) << r.msDeduplicacao
+                  << std::setw(12) << r.ms
+                  << std::setw(12) << r.mChavesPorSegundo;
+        if (r.mbPicoMemoria > 0.0) {
+            std::cout << std::setprecision(1) << r.mbPicoMemoria;
+        } else {
+            std::cout << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Pico RSS inclui o processo inteiro; o unordered_set mantém o dataset e todas as chaves em memória"
+              << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void BenchmarkDeduplicacao::salvarResultados(const std::string& arquivoCsv,
+                                             const MetadadosExecucao& metadados) const {
+    std::ofstream saida(arquivoCsv);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivoCsv);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+    saida << "Metodo,Chaves,Unicas,BytesMemoria,Particoes,Niveis,MBDerramados,MsParticionamento,MsDeduplicacao,"
+          << "Ms,MChavesPorSegundo,MBPicoMemoria," << MetadadosExecucao::CABECALHO_CSV << "\n";
+    for (const auto& r : resultados) {
+        saida << r.metodo << ","
+              << r.chaves << ","
+              << r.unicas << ","
+              << (r.metodo == "unordered_set" ? 0 : bytesMemoria) << ","
+              << r.particoes << ","
+              << r.niveis << ","
+              << std::fixed << std::setprecision(3) << r.mbDerramados << ","
+              << r.msParticionamento << ","
+              << r.msDeduplicacao << ","
+              << r.ms << ","
+              << r.mChavesPorSegundo << ","
+              << r.mbPicoMemoria << "," << identificacao << "\n";
+    }
+    saida.close();
+
+    std::cout << "\nResultados da deduplicação salvos em: " << arquivoCsv << std::endl;
+}
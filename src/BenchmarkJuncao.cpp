@@ -0,0 +1,203 @@
+/**
+ * @file BenchmarkJuncao.cpp
+ * @brief Implementação do benchmark de junção hash
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "BenchmarkJuncao.hpp"
+#include "CarregadorDados.hpp"
+#include "ControleCache.hpp"
+#include "JuncaoHash.hpp"
+#include "MetadadosExecucao.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+} // namespace
+
+BenchmarkJuncao::BenchmarkJuncao(size_t construcao, size_t sonda, size_t threadsParalelo, unsigned int semente)
+    : linhasConstrucao(construcao), linhasSonda(sonda), threads(threadsParalelo), seed(semente) {
+    if (linhasConstrucao == 0 || linhasSonda == 0) {
+        throw std::invalid_argument("Colunas da junção devem ter ao menos uma linha");
+    }
+}
+
+BenchmarkJuncao::BenchmarkJuncao(const std::string& construcao, const std::string& sonda, size_t threadsParalelo)
+    : linhasConstrucao(0), linhasSonda(0), arquivoConstrucao(construcao), arquivoSonda(sonda),
+      threads(threadsParalelo), seed(0) {
+    if (arquivoConstrucao.empty() || arquivoSonda.empty()) {
+        throw std::invalid_argument("Junção requer os datasets de construção e de sondagem");
+    }
+}
+
+/**
+ * @brief Uma medição: menor tempo de REPETICOES execuções de um método
+ */
+void BenchmarkJuncao::medir(const std::vector<int>& construcao, const std::vector<int>& sonda, bool particionada,
+                            bool pares, size_t numThreads, size_t bytesParticao) {
+    RASTREAR_ESCOPO_DETALHE("medirJuncao", "juncao",
+                            std::string(particionada ? "particionada " : "sem particao ") + std::to_string(numThreads));
+    std::cout << "  " << (particionada ? "Particionada" : "Sem partição") << ", "
+              << (pares ? "pares" : "contagem") << ", " << numThreads << " thread(s)..." << std::flush;
+
+    ConfiguracaoJuncao config;
+    config.threads = numThreads;
+    config.bytesParticao = bytesParticao;
+
+    MedicaoJuncao medicao{};
+    medicao.particionada = particionada;
+    medicao.pares = pares;
+    medicao.threads = numThreads;
+    medicao.linhasConstrucao = construcao.size();
+    medicao.linhasSonda = sonda.size();
+    medicao.ms = std::numeric_limits<double>::max();
+    for (size_t r = 0; r < REPETICOES; ++r) {
+        const auto inicio = Relogio::now();
+        const ResultadoJuncao resultado = particionada ? juntarParticionado(construcao, sonda, pares, config)
+                                                       : juntarSemParticao(construcao, sonda, pares, config);
+        const double ms = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+        if (pares && resultado.pares.size() != resultado.correspondencias) {
+            throw std::runtime_error("Junção emitiu " + std::to_string(resultado.pares.size()) + " pares para " +
+                                     std::to_string(resultado.correspondencias) + " correspondências");
+        }
+        if (ms < medicao.ms) {
+            medicao.ms = ms;
+            medicao.msParticionamento = resultado.msParticionamento;
+            medicao.msJuncao = resultado.msJuncao;
+        }
+        medicao.particoes = resultado.particoes;
+        medicao.passagens = resultado.passagens;
+        medicao.correspondencias = resultado.correspondencias;
+    }
+    if (!resultados.empty() && medicao.correspondencias != resultados.front().correspondencias) {
+        throw std::runtime_error("Junção " + std::string(particionada ? "particionada" : "sem partição") + ": " +
+                                 std::to_string(medicao.correspondencias) + " correspondências, esperadas " +
+                                 std::to_string(resultados.front().correspondencias));
+    }
+
+    medicao.mTuplasPorSegundo = (medicao.linhasConstrucao + medicao.linhasSonda) / (medicao.ms * 1000.0);
+    const auto referencia = std::find_if(resultados.begin(), resultados.end(), [&](const MedicaoJuncao& m) {
+        return !m.particionada && m.pares == pares && m.threads == numThreads;
+    });
+    medicao.aceleracao = particionada && referencia != resultados.end() ? referencia->ms / medicao.ms : 1.0;
+    resultados.push_back(medicao);
+    std::cout << " OK" << std::endl;
+}
+
+void BenchmarkJuncao::executar() {
+    std::vector<int> construcao;
+    std::vector<int> sonda;
+    if (!arquivoConstrucao.empty()) {
+        CarregadorDados carregador;
+        construcao = carregador.carregarDeArquivo(arquivoConstrucao);
+        sonda = carregador.carregarDeArquivo(arquivoSonda);
+        if (construcao.empty() || sonda.empty()) {
+            throw std::runtime_error("Datasets da junção não podem ser vazios");
+        }
+    } else {
+        const int maximo = static_cast<int>(std::min<size_t>(std::max<size_t>(2 * linhasConstrucao, 2),
+                                                             std::numeric_limits<int>::max()));
+        construcao = CarregadorDados(seed, 1, maximo).gerarNumerosAleatoriosComRepeticao(linhasConstrucao);
+        sonda = CarregadorDados(seed + 1, 1, maximo).gerarNumerosAleatoriosComRepeticao(linhasSonda);
+    }
+
+    const size_t bytesParticao = std::max<size_t>(detectarTopologiaMemoria().l2 / 2, 16 * 1024);
+    const size_t paralelo = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> numerosThreads{1};
+    if (paralelo > 1) {
+        numerosThreads.push_back(paralelo);
+    }
+
+    for (bool pares : {false, true}) {
+        for (size_t numThreads : numerosThreads) {
+            medir(construcao, sonda, false, pares, numThreads, bytesParticao);
+            medir(construcao, sonda, true, pares, numThreads, bytesParticao);
+        }
+    }
+}
+
+void BenchmarkJuncao::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de junção disponível." << std::endl;
+        return;
+    }
+
+    const MedicaoJuncao& primeira = resultados.front();
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "JUNÇÃO HASH: PARTICIONADA (RADIX) x TABELA ÚNICA (" << primeira.linhasConstrucao
+              << " linhas de construção, " << primeira.linhasSonda << " de sondagem)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << std::left
+              << std::setw(15) << "Método"
+              << std::setw(10) << "Saída"
+              << std::setw(9) << "Threads"
+              << std::setw(12) << "Partições"
+              << std::setw(10) << "Passagens"
+              << std::setw(11) << "Part. ms"
+              << std::setw(13) << "Junção ms"
+              << std::setw(11) << "Total ms"
+              << std::setw(12) << "Mtuplas/s"
+              << "x tabela única" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    for (const auto& r : resultados) {
+        std::cout << std::left << std::fixed
+                  << std::setw(r.particionada ? 14 : 15) << (r.particionada ? "particionada" : "tabela única")
+                  << std::setw(9) << (r.pares ? "pares" : "contagem")
+                  << std::setw(9) << r.threads
+                  << std::setw(10) << r.particoes
+                  << std::setw(10) << r.passagens
+                  << std::setw(11) << std::setprecision(2) << r.msParticionamento
+                  << std::setw(11) << r.msJuncao
+                  << std::setw(11) << r.ms
+                  << std::setw(12) << r.mTuplasPorSegundo
+                  << r.aceleracao << std::endl;
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Correspondências: " << primeira.correspondencias
+              << "; Mtuplas/s conta as linhas das duas colunas; partições de até metade da L2" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void BenchmarkJuncao::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream saida(arquivo);
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+    saida << "Metodo,Saida,Threads,LinhasConstrucao,LinhasSonda,Particoes,Passagens,Correspondencias,"
+          << "MsParticionamento,MsJuncao,Ms,MTuplasPorSegundo,Aceleracao,"
+          << MetadadosExecucao::CABECALHO_CSV << "\n";
+    for (const auto& r : resultados) {
+        saida << (r.particionada ? "particionada" : "tabela_unica") << ","
+              << (r.pares ? "pares" : "contagem") << ","
+              << r.threads << ","
+              << r.linhasConstrucao << ","
+              << r.linhasSonda << ","
+              << r.particoes << ","
+              << r.passagens << ","
+              << r.correspondencias << ","
+              << std::fixed << std::setprecision(3) << r.msParticionamento << ","
+              << r.msJuncao << ","
+              << r.ms << ","
+              << r.mTuplasPorSegundo << ","
+              << r.aceleracao << "," << identificacao << "\n";
+    }
+    saida.close();
+
+    std::cout << "\nResultados da junção salvos em: " << arquivo << std::endl;
+}
@@ -0,0 +1,351 @@
+/**
+ * @file BenchmarkPersistencia.cpp
+ * @brief Implementação do benchmark de persistência
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "BenchmarkPersistencia.hpp"
+#include "CarregadorDados.hpp"
+#include "MetadadosExecucao.hpp"
+#include "PersistenciaTabela.hpp"
+#include "Rastreamento.hpp"
+#include "TabelaAberta.hpp"
+#include "TabelaRedimensionavel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+/**
+ * @brief Percentil pelo método do posto mais próximo
+ * @param ordenadas Amostra em ordem crescente (não vazia)
+ * @param q Fração entre 0 e 1
+ */
+double percentilOrdenado(const std::vector<double>& ordenadas, double q) {
+    const size_t posto = static_cast<size_t>(std::ceil(q * ordenadas.size()));
+    return ordenadas[std::max<size_t>(posto, 1) - 1];
+}
+
+/// Soma dos tamanhos dos arquivos do diretório, em MB
+double megabytesDiretorio(const fs::path& diretorio) {
+    uintmax_t total = 0;
+    for (const auto& entrada : fs::directory_iterator(diretorio)) {
+        if (entrada.is_regular_file()) total += entrada.file_size();
+    }
+    return total / (1024.0 * 1024.0);
+}
+
+/// Tamanho da TabelaAberta com fator de carga 0,5 para n chaves
+size_t tamanhoPara(size_t n) {
+    return TabelaRedimensionavel::proximoPrimo(2 * n + 1);
+}
+
+/// Preenche o resultado a partir das latências individuais e do tempo total
+ResultadoCustoPersistencia resumirLatencias(std::vector<double>& latencias, double nsTotal) {
+    ResultadoCustoPersistencia resultado{};
+    resultado.operacoes = latencias.size();
+    resultado.nsMedio = nsTotal / latencias.size();
+    std::sort(latencias.begin(), latencias.end());
+    resultado.nsP50 = percentilOrdenado(latencias, 0.50);
+    resultado.nsP99 = percentilOrdenado(latencias, 0.99);
+    resultado.nsMaximo = latencias.back();
+    return resultado;
+}
+
+} // namespace
+
+BenchmarkPersistencia::BenchmarkPersistencia(const std::vector<size_t>& chaves,
+                                             const std::vector<size_t>& lotesSincronizacao,
+                                             const std::string& diretorioTrabalho, unsigned int semente)
+    : quantidades(chaves), lotes(lotesSincronizacao), diretorio(diretorioTrabalho), seed(semente) {
+    if (quantidades.empty() || lotes.empty()) {
+        throw std::invalid_argument("Listas de chaves e de lotes da persistência não podem ser vazias");
+    }
+    if (std::find(quantidades.begin(), quantidades.end(), 0) != quantidades.end()) {
+        throw std::invalid_argument("Quantidades de chaves da persistência devem ser positivas");
+    }
+}
+
+/**
+ * @brief Cronometra cada inserção sem diário e com cada tamanho de lote
+ *
+ * O tempo total de cada lote inclui a sincronização final, de modo que o
+ * lote 0 (sem fdatasync) não ganhe vazão deixando dados fora do disco.
+ * Snapshots ficam desativados para medir só o diário.
+ */
+void BenchmarkPersistencia::medirCusto(const std::vector<int>& chaves) {
+    RASTREAR_ESCOPO_DETALHE("medirCustoPersistencia", "persistencia", std::to_string(chaves.size()));
+
+    // Páginas do vetor tocadas antes, para que as faltas de página não caiam na referência
+    std::vector<double> latencias(chaves.size());
+    latencias.clear();
+
+    {
+        TabelaAberta tabela(tamanhoPara(chaves.size()));
+        const auto inicio = Relogio::now();
+        for (int chave : chaves) {
+            const auto antes = Relogio::now();
+            tabela.inserir(chave, TabelaAberta::TipoHash::DIVISAO);
+            latencias.push_back(std::chrono::duration<double, std::nano>(Relogio::now() - antes).count());
+        }
+        const double nsTotal = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+        ResultadoCustoPersistencia referencia = resumirLatencias(latencias, nsTotal);
+        referencia.comDiario = false;
+        referencia.razaoSemDiario = 1.0;
+        custos.push_back(referencia);
+    }
+    const double nsReferencia = custos.back().nsMedio;
+
+    for (size_t lote : lotes) {
+        std::cout << "  Diário com lote " << lote << "..." << std::flush;
+        const fs::path caminho = fs::path(diretorio) / ("custo_lote_" + std::to_string(lote));
+        fs::remove_all(caminho);
+
+        ConfiguracaoPersistencia config;
+        config.registrosPorSincronizacao = lote;
+        config.mutacoesPorSnapshot = 0;
+
+        latencias.clear();
+        EstatisticasPersistencia estatisticas;
+        double nsTotal = 0.0;
+        {
+            TabelaDuravel<TabelaAberta> tabela(caminho.string(), tamanhoPara(chaves.size()),
+                                               TabelaAberta::TipoHash::DIVISAO, config);
+            const auto inicio = Relogio::now();
+            const auto limite = inicio + std::chrono::duration<double>(ORCAMENTO_SEGUNDOS);
+            for (int chave : chaves) {
+                const auto antes = Relogio::now();
+                tabela.inserir(chave);
+                const auto depois = Relogio::now();
+                latencias.push_back(std::chrono::duration<double, std::nano>(depois - antes).count());
+                if (depois > limite) break;
+            }
+            tabela.sincronizar();
+            nsTotal = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+            estatisticas = tabela.getEstatisticas();
+        }
+        fs::remove_all(caminho);
+
+        ResultadoCustoPersistencia resultado = resumirLatencias(latencias, nsTotal);
+        resultado.comDiario = true;
+        resultado.lote = lote;
+        resultado.sincronizacoes = estatisticas.sincronizacoes;
+        resultado.mbDiario = estatisticas.bytesDiario / (1024.0 * 1024.0);
+        resultado.razaoSemDiario = resultado.nsMedio / nsReferencia;
+        custos.push_back(resultado);
+        std::cout << " OK" << std::endl;
+    }
+}
+
+/**
+ * @brief Recupera a mesma tabela só do diário e, depois, de um snapshot
+ *
+ * O diário é preenchido sem fdatasync por mutação (só o final), o que não
+ * altera o que a recuperação lê.
+ */
+void BenchmarkPersistencia::medirRecuperacao(size_t quantidade) {
+    RASTREAR_ESCOPO_DETALHE("medirRecuperacao", "persistencia", std::to_string(quantidade));
+    std::cout << "  Recuperação de " << quantidade << " chaves..." << std::flush;
+
+    CarregadorDados carregador(seed, 1, std::numeric_limits<int>::max());
+    const auto chaves = carregador.gerarNumerosAleatoriosComRepeticao(quantidade);
+    const fs::path caminho = fs::path(diretorio) / ("recuperacao_" + std::to_string(quantidade));
+    fs::remove_all(caminho);
+
+    ConfiguracaoPersistencia config;
+    config.registrosPorSincronizacao = 0;
+    config.mutacoesPorSnapshot = 0;
+    const size_t tamanho = tamanhoPara(quantidade);
+    const auto tipo = TabelaAberta::TipoHash::DIVISAO;
+
+    size_t esperado = 0;
+    {
+        TabelaDuravel<TabelaAberta> tabela(caminho.string(), tamanho, tipo, config);
+        for (int chave : chaves) {
+            tabela.inserir(chave);
+        }
+        tabela.sincronizar();
+        esperado = tabela.getNumElementos();
+    }
+
+    auto conferir = [&](const TabelaDuravel<TabelaAberta>& tabela, const char* origem) {
+        if (tabela.getNumElementos() != esperado || !tabela.buscar(chaves.front()) || !tabela.buscar(chaves.back())) {
+            throw std::runtime_error(std::string("Recuperação pelo ") + origem + " não reproduziu a tabela ("
+                                     + std::to_string(tabela.getNumElementos()) + " de "
+                                     + std::to_string(esperado) + " chaves)");
+        }
+    };
+
+    ResultadoRecuperacao doDiario{};
+    doDiario.chaves = esperado;
+    doDiario.deSnapshot = false;
+    doDiario.mbLidos = megabytesDiretorio(caminho);
+
+    ResultadoRecuperacao doSnapshot{};
+    doSnapshot.chaves = esperado;
+    doSnapshot.deSnapshot = true;
+    {
+        TabelaDuravel<TabelaAberta> tabela(caminho.string(), tamanho, tipo, config);
+        conferir(tabela, "diário");
+        doDiario.msRecuperacao = tabela.getEstatisticas().msRecuperacao;
+
+        const auto inicio = Relogio::now();
+        tabela.snapshot();
+        tabela.aguardarSnapshot();
+        doSnapshot.msGravacao = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+    }
+    doSnapshot.mbLidos = megabytesDiretorio(caminho);
+    {
+        TabelaDuravel<TabelaAberta> tabela(caminho.string(), tamanho, tipo, config);
+        conferir(tabela, "snapshot");
+        doSnapshot.msRecuperacao = tabela.getEstatisticas().msRecuperacao;
+    }
+    fs::remove_all(caminho);
+
+    for (ResultadoRecuperacao* r : {&doDiario, &doSnapshot}) {
+        r->mChavesPorSegundo = r->msRecuperacao > 0.0 ? r->chaves / (r->msRecuperacao * 1000.0) : 0.0;
+        recuperacoes.push_back(*r);
+    }
+    std::cout << " OK" << std::endl;
+}
+
+void BenchmarkPersistencia::executar() {
+    fs::create_directories(diretorio);
+
+    // INT_MIN é reservado pela tabela; as chaves ficam em [1, INT_MAX]
+    CarregadorDados carregador(seed, 1, std::numeric_limits<int>::max());
+    medirCusto(carregador.gerarNumerosAleatoriosComRepeticao(OPERACOES_CUSTO));
+
+    for (size_t quantidade : quantidades) {
+        medirRecuperacao(quantidade);
+    }
+
+    // Remove o diretório de trabalho apenas se ele ficou vazio
+    std::error_code erro;
+    fs::remove(diretorio, erro);
+}
+
+void BenchmarkPersistencia::imprimirRelatorio() const {
+    if (custos.empty()) {
+        std::cout << "Nenhum resultado de persistência disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "CUSTO DO DIÁRIO POR INSERÇÃO (TabelaAberta, carga 0,5, em " << diretorio << ")" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+
+    std::cout << std::left
+              << std::setw(16) << "Lote fsync"
+              << std::setw(13) << "Inserções"
+              << std::setw(12) << "Média ns"
+              << std::setw(10) << "p50 ns"
+              << std::setw(12) << "p99 ns"
+              << std::setw(15) << "Máx µs"
+              << std::setw(12) << "fsyncs"
+              << std::setw(12) << "MB diário"
+              << "x sem diário" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+
+    for (const auto& r : custos) {
+        const std::string lote = !r.comDiario ? "sem diário" : r.lote == 0 ? "SO" : std::to_string(r.lote);
+        std::cout << std::left << std::fixed
+                  << std::setw(r.comDiario ? 16 : 17) << lote
+                  << std::setw(11) << r.operacoes
+                  << std::setw(11) << std::setprecision(1) << r.nsMedio
+                  << std::setw(10) << std::setprecision(0) << r.nsP50
+                  << std::setw(12) << r.nsP99
+                  << std::setw(13) << std::setprecision(1) << r.nsMaximo / 1000.0
+                  << std::setw(12) << r.sincronizacoes
+                  << std::setw(12) << std::setprecision(2) << r.mbDiario
+                  << std::setprecision(2) << r.razaoSemDiario << std::endl;
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Lote = mutações por fdatasync (SO = write() a cada mutação, sem fdatasync); Média inclui a sincronização final"
+              << std::endl;
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "TEMPO DE RECUPERAÇÃO POR NÚMERO DE CHAVES" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << std::left
+              << std::setw(12) << "Chaves"
+              << std::setw(12) << "Origem"
+              << std::setw(12) << "MB lidos"
+              << std::setw(21) << "Gravação ms"
+              << std::setw(21) << "Recuperação ms"
+              << "Mchaves/s" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    for (const auto& r : recuperacoes) {
+        std::cout << std::left << std::fixed
+                  << std::setw(12) << r.chaves
+                  << std::setw(r.deSnapshot ? 12 : 13) << (r.deSnapshot ? "snapshot" : "diário")
+                  << std::setw(12) << std::setprecision(2) << r.mbLidos
+                  << std::setw(19) << std::setprecision(1) << r.msGravacao
+                  << std::setw(19) << r.msRecuperacao
+                  << std::setprecision(2) << r.mChavesPorSegundo << std::endl;
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Gravação = snapshot em segundo plano até o rename durável; arquivos lidos do cache de páginas"
+              << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void BenchmarkPersistencia::salvarResultados(const std::string& arquivoCusto,
+                                             const std::string& arquivoRecuperacao,
+                                             const MetadadosExecucao& metadados) const {
+    std::ofstream custo(arquivoCusto);
+    if (!custo.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivoCusto);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+    custo << "ComDiario,LoteSincronizacao,Operacoes,NsMedio,NsP50,NsP99,NsMaximo,Sincronizacoes,"
+          << "MBDiario,RazaoSemDiario," << MetadadosExecucao::CABECALHO_CSV << "\n";
+    for (const auto& r : custos) {
+        custo << (r.comDiario ? 1 : 0) << ","
+              << r.lote << ","
+              << r.operacoes << ","
+              << std::fixed << std::setprecision(2) << r.nsMedio << ","
+              << r.nsP50 << ","
+              << r.nsP99 << ","
+              << r.nsMaximo << ","
+              << r.sincronizacoes << ","
+              << std::setprecision(4) << r.mbDiario << ","
+              << r.razaoSemDiario << "," << identificacao << "\n";
+    }
+    custo.close();
+
+    std::ofstream recuperacao(arquivoRecuperacao);
+    if (!recuperacao.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivoRecuperacao);
+    }
+    recuperacao << "Chaves,Origem,MBLidos,MsGravacao,MsRecuperacao,MChavesPorSegundo,"
+                << MetadadosExecucao::CABECALHO_CSV << "\n";
+    for (const auto& r : recuperacoes) {
+        recuperacao << r.chaves << ","
+                    << (r.deSnapshot ? "snapshot" : "diario") << ","
+                    << std::fixed << std::setprecision(4) << r.mbLidos << ","
+                    << std::setprecision(3) << r.msGravacao << ","
+                    << r.msRecuperacao << ","
+                    << std::setprecision(4) << r.mChavesPorSegundo << "," << identificacao << "\n";
+    }
+    recuperacao.close();
+
+    std::cout << "\nResultados da persistência salvos em: " << arquivoCusto << " e " << arquivoRecuperacao
+              << std::endl;
+}
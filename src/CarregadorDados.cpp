@@ -13,6 +13,9 @@
  */
 
 #include "CarregadorDados.hpp"
+#include "DespachoCpu.hpp"
+#include "Rastreamento.hpp"
+#include <charconv>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -36,68 +39,138 @@
  * @complexity O(n) onde n é o número de linhas no arquivo
  */
 std::vector<int> CarregadorDados::carregarDeArquivo(const std::string& nomeArquivo) {
+    RASTREAR_ESCOPO_DETALHE("carregarDeArquivo", "dados", nomeArquivo);
+
     if (!arquivoExiste(nomeArquivo)) {
         throw std::runtime_error("Arquivo não encontrado: " + nomeArquivo);
     }
     
-    std::ifstream arquivo(nomeArquivo);
+    // Pré-aloca a quantidade declarada e lê tudo de uma vez; as linhas são
+    // separadas pelo kernel vetorial localizarQuebra no LeitorDataset
+    LeitorDataset leitor(nomeArquivo);
+    std::vector<int> numeros(leitor.getQuantidadeDeclarada());
+    numeros.resize(leitor.ler(numeros.data(), numeros.size()));
+    
+    if (numeros.empty()) {
+        throw std::runtime_error("Nenhum número válido foi encontrado no arquivo");
+    }
     
+    return numeros;
+}
+
+namespace {
+
+/// Remove espaços, tabulações e CR/LF das pontas, como CarregadorDados::trim
+std::string_view aparar(std::string_view linha) {
+    const size_t inicio = linha.find_first_not_of(" \t\n\r");
+    if (inicio == std::string_view::npos) {
+        return {};
+    }
+    const size_t fim = linha.find_last_not_of(" \t\n\r");
+    return linha.substr(inicio, fim - inicio + 1);
+}
+
+} // namespace
+
+LeitorDataset::LeitorDataset(const std::string& nome, size_t bytesBloco)
+    : nomeArquivo(nome), buffer(std::max<size_t>(bytesBloco, 1)), inicio(0), fim(0), fimArquivo(false),
+      quantidadeDeclarada(0), numerosLidos(0), linhaAtual(1) {
+    if (!std::filesystem::is_regular_file(nomeArquivo)) {
+        throw std::runtime_error("Arquivo não encontrado: " + nomeArquivo);
+    }
+    arquivo.open(nomeArquivo, std::ios::binary);
     if (!arquivo.is_open()) {
         throw std::runtime_error("Erro ao abrir arquivo: " + nomeArquivo);
     }
     
-    std::vector<int> numeros;
-    std::string linha;
-    
     // Lê primeira linha contendo a quantidade esperada
-    if (!std::getline(arquivo, linha)) {
+    std::string_view linha;
+    if (!proximaLinha(linha)) {
         throw std::runtime_error("Arquivo vazio ou formato inválido: " + nomeArquivo);
     }
     
-    linha = trim(linha);
-    size_t quantidadeEsperada = 0;
-    
     try {
-        quantidadeEsperada = std::stoull(linha);
+        quantidadeDeclarada = std::stoull(std::string(aparar(linha)));
     } catch (const std::exception& e) {
         throw std::runtime_error("Formato inválido na primeira linha: " + nomeArquivo);
     }
     
-    if (quantidadeEsperada == 0) {
+    if (quantidadeDeclarada == 0) {
         throw std::runtime_error("Quantidade de números não pode ser zero");
     }
-    
-    // Pré-aloca memória para melhor performance
-    numeros.reserve(quantidadeEsperada);
-    size_t linhaAtual = 1;
-    size_t numerosLidos = 0;
-    
-    // Processa o restante do arquivo
-    while (std::getline(arquivo, linha) && numerosLidos < quantidadeEsperada) {
+}
+
+/**
+ * @brief Próxima linha sem o '\n', como std::getline; false no fim do arquivo
+ *
+ * A linha aponta para o buffer e vale até a chamada seguinte. Quando o
+ * buffer termina no meio de uma linha, o trecho restante é movido para o
+ * início e o bloco seguinte é lido depois dele; uma linha maior que o
+ * buffer o amplia.
+ */
+bool LeitorDataset::proximaLinha(std::string_view& linha) {
+    const auto localizarQuebra = kernelsSimd().localizarQuebra;
+    size_t verificados = inicio;
+    while (true) {
+        const char* quebra = localizarQuebra(buffer.data() + verificados, buffer.data() + fim);
+        if (quebra != buffer.data() + fim) {
+            linha = std::string_view(buffer.data() + inicio, static_cast<size_t>(quebra - (buffer.data() + inicio)));
+            inicio = static_cast<size_t>(quebra - buffer.data()) + 1;
+            return true;
+        }
+        if (fimArquivo) {
+            // Última linha sem '\n'
+            if (inicio == fim) {
+                return false;
+            }
+            linha = std::string_view(buffer.data() + inicio, fim - inicio);
+            inicio = fim;
+            return true;
+        }
+        
+        std::copy(buffer.begin() + inicio, buffer.begin() + fim, buffer.begin());
+        fim -= inicio;
+        inicio = 0;
+        verificados = fim;
+        if (fim == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        arquivo.read(buffer.data() + fim, static_cast<std::streamsize>(buffer.size() - fim));
+        const size_t lidos = static_cast<size_t>(arquivo.gcount());
+        fim += lidos;
+        fimArquivo = lidos == 0 || arquivo.eof();
+    }
+}
+
+size_t LeitorDataset::ler(int* destino, size_t maximo) {
+    size_t entregues = 0;
+    std::string_view linha;
+    while (entregues < maximo && numerosLidos < quantidadeDeclarada && proximaLinha(linha)) {
         linhaAtual++;
-        linha = trim(linha);
+        linha = aparar(linha);
         
         if (linha.empty()) {
             continue; // Ignora linhas vazias
         }
         
-        try {
-            int numero = std::stoi(linha);
-            numeros.push_back(numero);
-            numerosLidos++;
-        } catch (const std::exception& e) {
-            std::cerr << "Aviso: Linha " << linhaAtual 
-                     << " inválida (\"" << linha << "\"), ignorando...\n";
+        // Caminho rápido para decimais simples; os demais casos (sinal '+',
+        // estouro, texto) seguem por std::stoi, com o mesmo aviso de antes
+        int numero = 0;
+        const auto [fimNumero, erro] = std::from_chars(linha.data(), linha.data() + linha.size(), numero);
+        static_cast<void>(fimNumero);
+        if (erro != std::errc()) {
+            try {
+                numero = std::stoi(std::string(linha));
+            } catch (const std::exception& e) {
+                std::cerr << "Aviso: Linha " << linhaAtual 
+                         << " inválida (\"" << linha << "\"), ignorando...\n";
+                continue;
+            }
         }
+        destino[entregues++] = numero;
+        numerosLidos++;
     }
-    
-    arquivo.close();
-    
-    if (numeros.empty()) {
-        throw std::runtime_error("Nenhum número válido foi encontrado no arquivo");
-    }
-    
-    return numeros;
+    return entregues;
 }
 
 /**
@@ -113,6 +186,8 @@ std::vector<int> CarregadorDados::carregarDeArquivo(const std::string& nomeArqui
  * @complexity O(n) amortizada
  */
 std::vector<int> CarregadorDados::gerarNumerosAleatorios(size_t quantidade) {
+    RASTREAR_ESCOPO_DETALHE("gerarNumerosAleatorios", "dados", std::to_string(quantidade));
+
     if (quantidade == 0) {
         throw std::invalid_argument("Quantidade deve ser maior que zero");
     }
@@ -150,6 +225,8 @@ std::vector<int> CarregadorDados::gerarNumerosAleatorios(size_t quantidade) {
  * @complexity O(n) linear
  */
 std::vector<int> CarregadorDados::gerarNumerosAleatoriosComRepeticao(size_t quantidade) {
+    RASTREAR_ESCOPO_DETALHE("gerarNumerosAleatoriosComRepeticao", "dados", std::to_string(quantidade));
+
     if (quantidade == 0) {
         throw std::invalid_argument("Quantidade deve ser maior que zero");
     }
@@ -179,6 +256,8 @@ std::vector<int> CarregadorDados::gerarNumerosAleatoriosComRepeticao(size_t quan
  */
 bool CarregadorDados::salvarEmArquivo(const std::vector<int>& numeros, 
                                    const std::string& nomeArquivo) {
+    RASTREAR_ESCOPO_DETALHE("salvarEmArquivo", "dados", nomeArquivo);
+
     if (numeros.empty()) {
         std::cerr << "Erro: Vetor vazio, não há dados para salvar.\n";
         return false;
@@ -291,6 +370,8 @@ void CarregadorDados::exibirEstatisticas(const std::string& nomeArquivo) const {
  * @complexity O(n)
  */
 CarregadorDados::InfoDataset CarregadorDados::analisarDataset(const std::string& nomeArquivo) {
+    RASTREAR_ESCOPO_DETALHE("analisarDataset", "dados", nomeArquivo);
+
     InfoDataset info;
     info.nomeArquivo = nomeArquivo;
     
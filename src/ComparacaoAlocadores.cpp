@@ -0,0 +1,340 @@
+/**
+ * @file ComparacaoAlocadores.cpp
+ * @brief Implementação da comparação de alocadores da TabelaEncadeada
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ComparacaoAlocadores.hpp"
+#include "RecursosMemoria.hpp"
+#include "TabelaEncadeada.hpp"
+#include "CarregadorDados.hpp"
+#include "VarreduraMemoria.hpp"
+#include "Estatistica.hpp"
+#include "Rastreamento.hpp"
+#include "MetadadosExecucao.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define ANALISE_HASH_MALLINFO2
+#endif
+
+namespace {
+
+/**
+ * @brief Bytes do heap em uso segundo o malloc
+ * @return uordblks de mallinfo2, ou 0 se indisponível
+ *
+ * Inclui cabeçalhos e preenchimento de alinhamento de cada bloco.
+ */
+size_t bytesHeapEmUso() {
+#ifdef ANALISE_HASH_MALLINFO2
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Cria o recurso de memória de um alocador
+ * @param alocador Nome do alocador
+ * @param upstream Recurso contador que fornece a memória
+ * @return Recurso criado, ou nullptr para new_delete (recurso global)
+ */
+std::unique_ptr<std::pmr::memory_resource> criarRecurso(const std::string& alocador,
+                                                        RecursoContador& upstream) {
+    if (alocador == "monotonic") {
+        return std::make_unique<std::pmr::monotonic_buffer_resource>(&upstream);
+    }
+    if (alocador == "pool") {
+        return std::make_unique<std::pmr::unsynchronized_pool_resource>(&upstream);
+    }
+    if (alocador == "slab") {
+        return std::make_unique<RecursoSlab>(sizeof(No), 64 * 1024, &upstream);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Mede o tempo de uma função em nanossegundos
+ */
+template<typename Func>
+double medirNs(Func&& func) {
+    auto inicio = std::chrono::high_resolution_clock::now();
+    func();
+    auto fim = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(fim - inicio).count();
+}
+
+/**
+ * @brief Acrescenta a destino as chaves de origem ainda não vistas
+ * @param origem Chaves candidatas, na ordem em que são consideradas
+ * @param quantidade Tamanho máximo de destino
+ * @param vistas Chaves já presentes em destino
+ * @param destino Chaves distintas
+ */
+void acrescentarDistintas(const std::vector<int>& origem, size_t quantidade,
+                          std::unordered_set<int>& vistas, std::vector<int>& destino) {
+    for (size_t i = 0; i < origem.size() && destino.size() < quantidade; ++i) {
+        if (vistas.insert(origem[i]).second) {
+            destino.push_back(origem[i]);
+        }
+    }
+}
+
+} // namespace
+
+const std::vector<std::string>& ComparacaoAlocadores::alocadores() {
+    static const std::vector<std::string> nomes = {"new_delete", "monotonic", "pool", "slab"};
+    return nomes;
+}
+
+ComparacaoAlocadores::ComparacaoAlocadores(std::vector<size_t> chaves, unsigned int semente)
+    : quantidades(std::move(chaves)), seed(semente) {
+    if (quantidades.empty()) {
+        throw std::invalid_argument("Nenhuma quantidade de chaves para comparar alocadores");
+    }
+    for (size_t n : quantidades) {
+        if (n < 2 || n > static_cast<size_t>(std::numeric_limits<int>::max() / 2)) {
+            throw std::invalid_argument("Quantidade de chaves inválida: " + std::to_string(n));
+        }
+    }
+}
+
+/**
+ * @brief Executa o roteiro completo REPETICOES vezes com o alocador
+ *
+ * Tabela e recurso são criados fora das regiões medidas; a destruição
+ * mede a devolução dos nós e a liberação do próprio recurso (que, no
+ * monotonic, no pool e no slab, devolve os blocos grandes ao upstream).
+ */
+void ComparacaoAlocadores::medirAlocador(const std::string& alocador, const std::vector<int>& dados,
+                                         const std::vector<int>& amostra, const std::vector<int>& removidas,
+                                         const std::vector<int>& novas) {
+    RASTREAR_ESCOPO_DETALHE("medirAlocador", "alocadores", alocador + " " + std::to_string(dados.size()));
+    const auto tipo = TabelaEncadeada::TipoHash::DIVISAO;
+    const size_t tamanhoTabela = VarreduraMemoria::proximoPrimo(dados.size());
+
+    std::vector<double> insercao, busca, rotatividade, destruicao;
+    ResultadoAlocador resultado{};
+    resultado.alocador = alocador;
+    resultado.quantidadeChaves = dados.size();
+    resultado.tamanhoTabela = tamanhoTabela;
+
+    for (size_t repeticao = 0; repeticao < REPETICOES; ++repeticao) {
+        RecursoContador contador;
+        auto recursoProprio = criarRecurso(alocador, contador);
+        std::pmr::memory_resource* recurso = recursoProprio
+            ? recursoProprio.get()
+            : std::pmr::new_delete_resource();
+
+        auto tabela = std::make_unique<TabelaEncadeada>(tamanhoTabela, recurso);
+        const size_t heapInicial = bytesHeapEmUso();
+
+        insercao.push_back(medirNs([&]() {
+            for (int valor : dados) {
+                tabela->inserir(valor, tipo);
+            }
+        }) / dados.size());
+
+        size_t acertos = 0;
+        busca.push_back(medirNs([&]() {
+            for (int valor : amostra) {
+                acertos += tabela->buscar(valor, tipo) ? 1 : 0;
+            }
+        }) / amostra.size());
+        static volatile size_t sumidouro = 0;
+        sumidouro = sumidouro + acertos;
+
+        // Remoções e inserções intercaladas: a memória liberada pode ser reutilizada
+        rotatividade.push_back(medirNs([&]() {
+            for (size_t i = 0; i < novas.size(); ++i) {
+                tabela->remover(removidas[i], tipo);
+                tabela->inserir(novas[i], tipo);
+            }
+        }) / (2 * novas.size()));
+
+        resultado.bytesNos = tabela->getNumElementos() * sizeof(No);
+        if (recursoProprio) {
+            resultado.bytesRetidos = contador.getBytesAtuais();
+            resultado.memoriaMedida = true;
+        } else {
+#ifdef ANALISE_HASH_MALLINFO2
+            const size_t heapFinal = bytesHeapEmUso();
+            resultado.bytesRetidos = heapFinal > heapInicial ? heapFinal - heapInicial : 0;
+            resultado.memoriaMedida = true;
+#else
+            static_cast<void>(heapInicial);
+            resultado.bytesRetidos = resultado.bytesNos;
+            resultado.memoriaMedida = false;
+#endif
+        }
+
+        const size_t nos = tabela->getNumElementos();
+        destruicao.push_back(medirNs([&]() {
+            tabela.reset();
+            recursoProprio.reset();
+        }) / nos);
+    }
+
+    resultado.nsInsercao = mediana(insercao);
+    resultado.nsBusca = mediana(busca);
+    resultado.nsRotatividade = mediana(rotatividade);
+    resultado.nsDestruicao = mediana(destruicao);
+    resultado.fragmentacao = resultado.bytesRetidos > resultado.bytesNos
+        ? 1.0 - static_cast<double>(resultado.bytesNos) / resultado.bytesRetidos
+        : 0.0;
+    resultados.push_back(resultado);
+}
+
+/**
+ * @brief Gera os dados de cada quantidade e mede todos os alocadores
+ *
+ * As chaves iniciais ficam em [1, INT_MAX/2] e as da rotatividade em
+ * (INT_MAX/2, INT_MAX]. A rotatividade remove chaves distintas de dados e
+ * insere chaves distintas fora dele, de modo que cada operação libera ou
+ * cria exatamente um nó.
+ */
+void ComparacaoAlocadores::executar() {
+    constexpr int META = std::numeric_limits<int>::max() / 2;
+    std::mt19937 geradorAmostra(seed);
+
+    for (size_t n : quantidades) {
+        std::cout << "  Alocadores com " << n << " chaves..." << std::flush;
+
+        CarregadorDados carregador(seed, 1, META);
+        CarregadorDados carregadorNovas(seed + 1, META + 1, std::numeric_limits<int>::max());
+        auto dados = carregador.gerarNumerosAleatoriosComRepeticao(n);
+
+        std::unordered_set<int> vistas;
+        std::vector<int> removidas;
+        removidas.reserve(n / 2);
+        acrescentarDistintas(dados, n / 2, vistas, removidas);
+        vistas.clear();
+        std::vector<int> novas;
+        novas.reserve(removidas.size());
+        while (novas.size() < removidas.size()) {
+            acrescentarDistintas(carregadorNovas.gerarNumerosAleatoriosComRepeticao(removidas.size() - novas.size()),
+                                 removidas.size(), vistas, novas);
+        }
+
+        const size_t tamAmostra = std::min(n, MAX_AMOSTRA_BUSCA);
+        std::uniform_int_distribution<size_t> posicao(0, n - 1);
+        std::vector<int> amostra;
+        amostra.reserve(tamAmostra);
+        for (size_t i = 0; i < tamAmostra; ++i) {
+            amostra.push_back(dados[posicao(geradorAmostra)]);
+        }
+
+        for (const auto& alocador : alocadores()) {
+            medirAlocador(alocador, dados, amostra, removidas, novas);
+        }
+        std::cout << " OK" << std::endl;
+    }
+}
+
+void ComparacaoAlocadores::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de alocadores disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "ALOCADORES DA TABELA ENCADEADA (mediana de " << REPETICOES
+              << " execuções; razão em relação a new_delete)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+
+    std::cout << std::left
+              << std::setw(12) << "Alocador"
+              << std::setw(10) << "Chaves"
+              << std::setw(16) << "ns/ins"
+              << std::setw(16) << "ns/busca"
+              << std::setw(16) << "ns/rotat."
+              << std::setw(16) << "ns/destr."
+              << std::setw(10) << "Retido"
+              << "Fragm." << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+
+    auto celula = [](double valor, double referencia) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << valor;
+        if (referencia > 0.0) {
+            oss << " (" << std::setprecision(2) << valor / referencia << "x)";
+        }
+        return oss.str();
+    };
+
+    const ResultadoAlocador* referencia = nullptr;
+    bool estimada = false;
+    for (const auto& r : resultados) {
+        if (r.alocador == alocadores().front()) {
+            referencia = &r;
+        }
+        const bool ehReferencia = referencia == &r;
+        std::ostringstream retido;
+        retido << std::fixed << std::setprecision(1) << r.bytesRetidos / (1024.0 * 1024.0) << "M";
+
+        std::cout << std::left
+                  << std::setw(12) << r.alocador
+                  << std::setw(10) << r.quantidadeChaves
+                  << std::setw(16) << celula(r.nsInsercao, ehReferencia ? 0.0 : referencia->nsInsercao)
+                  << std::setw(16) << celula(r.nsBusca, ehReferencia ? 0.0 : referencia->nsBusca)
+                  << std::setw(16) << celula(r.nsRotatividade, ehReferencia ? 0.0 : referencia->nsRotatividade)
+                  << std::setw(16) << celula(r.nsDestruicao, ehReferencia ? 0.0 : referencia->nsDestruicao)
+                  << std::setw(10) << retido.str()
+                  << std::fixed << std::setprecision(1) << r.fragmentacao * 100.0 << "%"
+                  << (r.memoriaMedida ? "" : " *") << std::endl;
+        estimada = estimada || !r.memoriaMedida;
+    }
+
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Fragm. = fração da memória retida sem nós vivos após a rotatividade" << std::endl;
+    if (estimada) {
+        std::cout << "* malloc sem mallinfo2: memória retida estimada pelo tamanho dos nós" << std::endl;
+    }
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void ComparacaoAlocadores::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream arq(arquivo);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+
+    arq << "Alocador,QuantidadeChaves,TamanhoTabela,NsInsercao,NsBusca,NsRotatividade,NsDestruicao,"
+        << "BytesNos,BytesRetidos,Fragmentacao,MemoriaMedida," << MetadadosExecucao::CABECALHO_CSV << "\n";
+
+    for (const auto& r : resultados) {
+        arq << r.alocador << ","
+            << r.quantidadeChaves << ","
+            << r.tamanhoTabela << ","
+            << std::fixed << std::setprecision(2) << r.nsInsercao << ","
+            << std::setprecision(2) << r.nsBusca << ","
+            << std::setprecision(2) << r.nsRotatividade << ","
+            << std::setprecision(2) << r.nsDestruicao << ","
+            << r.bytesNos << ","
+            << r.bytesRetidos << ","
+            << std::setprecision(4) << r.fragmentacao << ","
+            << (r.memoriaMedida ? 1 : 0) << "," << identificacao << "\n";
+    }
+
+    arq.close();
+    std::cout << "\nResultados dos alocadores salvos em: " << arquivo << std::endl;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file ComparacaoExecucoes.cpp
+ * @brief Implementação da comparação entre dois CSVs de resultados
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ComparacaoExecucoes.hpp"
+#include "SaidaResultados.hpp"
+#include "Estatistica.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/// Fases comparadas: nome, tempo e operações de cada resultado
+struct FaseComparada {
+    const char* nome;
+    double ResultadoTeste::*tempo;
+    size_t ResultadoTeste::*operacoes;
+};
+
+constexpr std::array<FaseComparada, 3> FASES = {{
+    {"insercao", &ResultadoTeste::tempoInsercao, &ResultadoTeste::operacoesInsercao},
+    {"busca", &ResultadoTeste::tempoBusca, &ResultadoTeste::operacoesBusca},
+    {"mistura", &ResultadoTeste::tempoMistura, &ResultadoTeste::operacoesMistura},
+}};
+
+/**
+ * @brief Agrupa as repetições de cada configuração
+ * @return Chave da configuração (repetição 0) para os resultados, na ordem do arquivo
+ */
+std::map<std::string, std::vector<const ResultadoTeste*>> agrupar(const std::vector<ResultadoTeste>& resultados,
+                                                                  std::vector<std::string>& ordem) {
+    std::map<std::string, std::vector<const ResultadoTeste*>> grupos;
+    for (const auto& r : resultados) {
+        const std::string chave = ResultadoTeste::chave(r.dataset, r.tipoTabela, r.tamanhoTabela,
+                                                        r.tipoFuncaoHash, r.mistura, r.threads, 0);
+        auto& grupo = grupos[chave];
+        if (grupo.empty()) {
+            ordem.push_back(chave);
+        }
+        grupo.push_back(&r);
+    }
+    return grupos;
+}
+
+/**
+ * @brief ns/op de uma fase em cada repetição (vazio se a fase não foi executada)
+ */
+std::vector<double> nsPorOperacao(const std::vector<const ResultadoTeste*>& grupo, const FaseComparada& fase) {
+    std::vector<double> amostra;
+    for (const ResultadoTeste* r : grupo) {
+        if (r->*fase.operacoes > 0) {
+            amostra.push_back(ResultadoTeste::nsPorOperacao(r->*fase.tempo, r->*fase.operacoes));
+        }
+    }
+    return amostra;
+}
+
+} // namespace
+
+ComparacaoExecucoes::ComparacaoExecucoes(const std::string& base, const std::string& novo,
+                                         const std::string& rotuloA, const std::string& rotuloB,
+                                         double nivelSignificancia)
+    : arquivoBase(base), arquivoNovo(novo), rotuloBase(rotuloA), rotuloNovo(rotuloB),
+      alfa(nivelSignificancia) {}
+
+/**
+ * @brief Pareia as configurações pela chave sem repetição
+ *
+ * Os p-valores de todas as linhas formam uma família única para a
+ * correção de Holm, como nas comparações do BenchmarkManager.
+ */
+void ComparacaoExecucoes::executar() {
+    const auto resultadosBase = SaidaResultados::lerArquivo(arquivoBase);
+    const auto resultadosNovos = SaidaResultados::lerArquivo(arquivoNovo);
+
+    std::vector<std::string> ordemBase, ordemNova;
+    const auto gruposBase = agrupar(resultadosBase, ordemBase);
+    const auto gruposNovos = agrupar(resultadosNovos, ordemNova);
+
+    diferencas.clear();
+    somenteEmUm = 0;
+    std::vector<double> pValores;
+    std::vector<size_t> comTeste;
+    for (const auto& chave : ordemBase) {
+        const auto nova = gruposNovos.find(chave);
+        if (nova == gruposNovos.end()) {
+            ++somenteEmUm;
+            continue;
+        }
+        const auto& grupoBase = gruposBase.at(chave);
+        const ResultadoTeste& referencia = *grupoBase.front();
+        for (const auto& fase : FASES) {
+            const auto amostraBase = nsPorOperacao(grupoBase, fase);
+            const auto amostraNova = nsPorOperacao(nova->second, fase);
+            if (amostraBase.empty() || amostraNova.empty()) {
+                continue;
+            }
+
+            DiferencaExecucoes diferenca{referencia.dataset, referencia.tipoTabela, referencia.tamanhoTabela,
+                                         referencia.tipoFuncaoHash, referencia.mistura, referencia.threads,
+                                         fase.nome, amostraBase.size(), amostraNova.size(),
+                                         mediana(amostraBase), mediana(amostraNova), 0.0,
+                                         std::numeric_limits<double>::quiet_NaN(), false};
+            diferenca.razao = diferenca.nsBase > 0.0 ? diferenca.nsNova / diferenca.nsBase
+                                                     : std::numeric_limits<double>::quiet_NaN();
+            if (amostraBase.size() >= 2 && amostraNova.size() >= 2) {
+                pValores.push_back(testeMannWhitney(amostraBase, amostraNova).pValor);
+                comTeste.push_back(diferencas.size());
+            }
+            diferencas.push_back(diferenca);
+        }
+    }
+    for (const auto& chave : ordemNova) {
+        somenteEmUm += gruposBase.count(chave) == 0;
+    }
+
+    if (diferencas.empty()) {
+        throw std::runtime_error("Nenhuma configuração em comum entre " + arquivoBase + " e " + arquivoNovo);
+    }
+
+    const std::vector<double> ajustados = ajustarHolm(pValores);
+    for (size_t i = 0; i < comTeste.size(); ++i) {
+        auto& diferenca = diferencas[comTeste[i]];
+        diferenca.pValor = ajustados[i];
+        diferenca.significativa = ajustados[i] < alfa;
+    }
+}
+
+void ComparacaoExecucoes::imprimirRelatorio() const {
+    if (diferencas.empty()) {
+        std::cout << "Nenhuma comparação disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(124, '=') << std::endl;
+    std::cout << "COMPARAÇÃO ENTRE EXECUÇÕES: " << rotuloNovo << " / " << rotuloBase
+              << " (mediana de ns/op; razão < 1 = " << rotuloNovo << " mais rápido)" << std::endl;
+    std::cout << "Base: " << arquivoBase << "\nNova: " << arquivoNovo << std::endl;
+    std::cout << std::string(124, '=') << std::endl;
+
+    std::cout << std::left
+              << std::setw(20) << "Dataset"
+              << std::setw(10) << "Tipo"
+              << std::setw(8)  << "Tam.Tab"
+              << std::setw(14) << "Hash"
+              << std::setw(12) << "Mistura"
+              << std::setw(4)  << "Thr"
+              << std::setw(11) << "Métrica"
+              << std::setw(12) << "Base ns/op"
+              << std::setw(12) << "Nova ns/op"
+              << std::setw(9)  << "Razão"
+              << std::setw(10) << "p(Holm)"
+              << "Signif." << std::endl;
+    std::cout << std::string(124, '-') << std::endl;
+
+    std::map<std::string, std::pair<double, size_t>> somaLogRazoes;
+    size_t maisRapidas = 0;
+    size_t maisLentas = 0;
+    for (const auto& d : diferencas) {
+        const std::string dataset = d.dataset.substr(d.dataset.find_last_of('/') + 1);
+        std::cout << std::left << std::fixed
+                  << std::setw(20) << dataset.substr(0, 19)
+                  << std::setw(10) << d.tipoTabela
+                  << std::setw(8)  << d.tamanhoTabela
+                  << std::setw(14) << d.tipoFuncaoHash
+                  << std::setw(12) << d.mistura
+                  << std::setw(4)  << d.threads
+                  << std::setw(10) << d.metrica
+                  << std::setw(12) << std::setprecision(2) << d.nsBase
+                  << std::setw(12) << d.nsNova
+                  << std::setw(8)  << std::setprecision(3) << d.razao;
+        if (std::isnan(d.pValor)) {
+            std::cout << std::setw(10) << "-" << "-";
+        } else {
+            std::cout << std::setw(10) << std::setprecision(4) << d.pValor << (d.significativa ? "sim" : "não");
+        }
+        std::cout << std::endl;
+
+        if (d.razao > 0.0) {
+            auto& soma = somaLogRazoes[d.metrica];
+            soma.first += std::log(d.razao);
+            ++soma.second;
+        }
+        if (d.significativa) {
+            (d.razao < 1.0 ? maisRapidas : maisLentas) += 1;
+        }
+    }
+
+    std::cout << std::string(124, '-') << std::endl;
+    std::cout << "Média geométrica das razões:";
+    for (const char* metrica : {"insercao", "busca", "mistura"}) {
+        const auto soma = somaLogRazoes.find(metrica);
+        if (soma != somaLogRazoes.end()) {
+            std::cout << "  " << metrica << " " << std::setprecision(3)
+                      << std::exp(soma->second.first / soma->second.second);
+        }
+    }
+    std::cout << std::endl;
+    std::cout << "Diferenças significativas (alfa " << std::setprecision(2) << alfa << "): "
+              << maisRapidas << " mais rápida(s) e " << maisLentas << " mais lenta(s) em " << rotuloNovo;
+    if (somenteEmUm > 0) {
+        std::cout << "; " << somenteEmUm << " configuração(ões) em apenas um arquivo";
+    }
+    std::cout << std::endl;
+    std::cout << std::string(124, '=') << std::endl;
+}
+
+void ComparacaoExecucoes::salvarResultados(const std::string& arquivo) const {
+    std::ofstream arq(arquivo);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+
+    arq << "Dataset,TipoTabela,TamanhoTabela,FuncaoHash,Mistura,Threads,Metrica,"
+        << "RepeticoesBase,RepeticoesNova,NsBase,NsNova,Razao,PValorHolm,Significativa\n";
+    for (const auto& d : diferencas) {
+        arq << d.dataset << ","
+            << d.tipoTabela << ","
+            << d.tamanhoTabela << ","
+            << d.tipoFuncaoHash << ","
+            << d.mistura << ","
+            << d.threads << ","
+            << d.metrica << ","
+            << d.repeticoesBase << ","
+            << d.repeticoesNova << ","
+            << std::fixed << std::setprecision(3) << d.nsBase << ","
+            << d.nsNova << ","
+            << std::setprecision(4) << d.razao << ",";
+        if (!std::isnan(d.pValor)) {
+            arq << std::setprecision(6) << d.pValor;
+        }
+        arq << "," << (d.significativa ? "sim" : "nao") << "\n";
+    }
+
+    arq.close();
+    std::cout << "\nComparação entre execuções salva em: " << arquivo << std::endl;
+}
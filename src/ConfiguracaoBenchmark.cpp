@@ -0,0 +1,394 @@
+/**
+ * @file ConfiguracaoBenchmark.cpp
+ * @brief Implementação da leitura e validação da matriz de benchmarks
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ConfiguracaoBenchmark.hpp"
+#include "RegistroMotores.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief Remove espaços em branco do início e fim de uma string
+ * @param str String a ser processada
+ * @return String sem espaços nas extremidades
+ */
+std::string trim(const std::string& str) {
+    size_t inicio = str.find_first_not_of(" \t\n\r");
+    if (inicio == std::string::npos) return "";
+
+    size_t fim = str.find_last_not_of(" \t\n\r");
+    return str.substr(inicio, fim - inicio + 1);
+}
+
+/**
+ * @brief Divide uma lista separada por vírgulas
+ * @param valor Texto da lista
+ * @return Itens sem espaços nas extremidades (itens vazios são ignorados)
+ */
+std::vector<std::string> dividirLista(const std::string& valor) {
+    std::vector<std::string> itens;
+    std::stringstream ss(valor);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) {
+            itens.push_back(item);
+        }
+    }
+    return itens;
+}
+
+std::vector<size_t> lerInteiros(const std::string& valor) {
+    std::vector<size_t> numeros;
+    for (const auto& item : dividirLista(valor)) {
+        size_t pos = 0;
+        long long numero = std::stoll(item, &pos);
+        if (pos != item.size() || numero <= 0) {
+            throw std::invalid_argument(item);
+        }
+        numeros.push_back(static_cast<size_t>(numero));
+    }
+    return numeros;
+}
+
+std::vector<double> lerReais(const std::string& valor) {
+    std::vector<double> numeros;
+    for (const auto& item : dividirLista(valor)) {
+        size_t pos = 0;
+        double numero = std::stod(item, &pos);
+        if (pos != item.size() || numero <= 0.0) {
+            throw std::invalid_argument(item);
+        }
+        numeros.push_back(numero);
+    }
+    return numeros;
+}
+
+size_t lerInteiro(const std::string& valor) {
+    auto numeros = lerInteiros(valor);
+    if (numeros.size() != 1) {
+        throw std::invalid_argument(valor);
+    }
+    return numeros.front();
+}
+
+unsigned int lerSemente(const std::string& valor) {
+    size_t pos = 0;
+    unsigned long long numero = std::stoull(valor, &pos);
+    if (pos != valor.size() || numero > std::numeric_limits<unsigned int>::max()) {
+        throw std::invalid_argument(valor);
+    }
+    return static_cast<unsigned int>(numero);
+}
+
+bool lerBooleano(const std::string& valor) {
+    if (valor == "sim" || valor == "true" || valor == "1") return true;
+    if (valor == "nao" || valor == "não" || valor == "false" || valor == "0") return false;
+    throw std::invalid_argument(valor);
+}
+
+/**
+ * @brief Interpreta "uniforme:100000"
+ */
+DistribuicaoDados lerDistribuicao(const std::string& item) {
+    size_t sep = item.find(':');
+    if (sep == std::string::npos) {
+        throw std::invalid_argument(item);
+    }
+    DistribuicaoDados dist;
+    dist.tipo = trim(item.substr(0, sep));
+    dist.quantidade = lerInteiro(item.substr(sep + 1));
+    return dist;
+}
+
+} // namespace
+
+MisturaOperacoes MisturaOperacoes::ler(const std::string& item) {
+    MisturaOperacoes mistura{0, 0, 0};
+    std::stringstream ss(item);
+    std::string parte;
+    while (std::getline(ss, parte, '/')) {
+        size_t sep = parte.find(':');
+        if (sep == std::string::npos) {
+            throw std::invalid_argument(item);
+        }
+        std::string operacao = trim(parte.substr(0, sep));
+        unsigned percentual = static_cast<unsigned>(std::stoul(trim(parte.substr(sep + 1))));
+        if (operacao == "busca") mistura.busca = percentual;
+        else if (operacao == "insercao") mistura.insercao = percentual;
+        else if (operacao == "remocao") mistura.remocao = percentual;
+        else throw std::invalid_argument(item);
+    }
+    return mistura;
+}
+
+ConfiguracaoBenchmark ConfiguracaoBenchmark::padrao() {
+    ConfiguracaoBenchmark config;
+    config.motores = {"Encadeada", "Aberta"};
+    config.hashes = {"Divisao", "Multiplicacao"};
+
+    // Tamanhos de tabela encadeada (números primos)
+    config.dimensionamento["Encadeada"].tamanhos = {29, 97, 251, 499, 911};
+
+    // Número primo suficientemente grande para todos os datasets testados
+    config.dimensionamento["Aberta"].tamanhos = {50009};
+
+    // Lista de arquivos de dataset conforme especificação do Trabalho 2
+    config.arquivos = {
+        "data/numeros_aleatorios_100.txt",
+        "data/numeros_aleatorios_500.txt",
+        "data/numeros_aleatorios_1000.txt",
+        "data/numeros_aleatorios_5000.txt",
+        "data/numeros_aleatorios_10000.txt",
+        "data/numeros_aleatorios_50000.txt"
+    };
+    config.quantidadeBuscas = 1000;
+    return config;
+}
+
+/**
+ * @brief Lê o arquivo linha a linha
+ *
+ * Cada chave conhecida tem um tratador por seção; chaves ou seções
+ * desconhecidas são erro, para que erros de digitação não passem
+ * silenciosamente para uma varredura longa.
+ */
+ConfiguracaoBenchmark ConfiguracaoBenchmark::carregarArquivo(const std::string& nomeArquivo) {
+    std::ifstream arquivo(nomeArquivo);
+    if (!arquivo.is_open()) {
+        throw std::runtime_error("Erro ao abrir configuração: " + nomeArquivo);
+    }
+
+    // Valores padrão de [matriz] e [saida]; listas começam vazias
+    ConfiguracaoBenchmark config;
+    config.motores = {"Encadeada", "Aberta"};
+    config.hashes = {"Divisao", "Multiplicacao"};
+
+    using Tratador = std::function<void(const std::string&)>;
+    std::map<std::string, std::map<std::string, Tratador>> tratadores = {
+        {"matriz", {
+            {"motores", [&](const std::string& v) { config.motores = dividirLista(v); }},
+            {"hashes", [&](const std::string& v) { config.hashes = dividirLista(v); }},
+            {"repeticoes", [&](const std::string& v) { config.repeticoes = lerInteiro(v); }},
+            {"threads", [&](const std::string& v) { config.threads = lerInteiros(v); }},
+            {"semente", [&](const std::string& v) { config.semente = lerSemente(v); }},
+        }},
+        {"dados", {
+            {"arquivos", [&](const std::string& v) { config.arquivos = dividirLista(v); }},
+            {"distribuicoes", [&](const std::string& v) {
+                config.distribuicoes.clear();
+                for (const auto& item : dividirLista(v)) config.distribuicoes.push_back(lerDistribuicao(item));
+            }},
+            {"buscas", [&](const std::string& v) { config.quantidadeBuscas = lerInteiro(v); }},
+        }},
+        {"operacoes", {
+            {"misturas", [&](const std::string& v) {
+                config.misturas.clear();
+                for (const auto& item : dividirLista(v)) config.misturas.push_back(MisturaOperacoes::ler(item));
+            }},
+            {"quantidade", [&](const std::string& v) { config.operacoesMistura = lerInteiro(v); }},
+        }},
+        {"comparacao", {
+            {"alfa", [&](const std::string& v) { config.alfa = std::stod(v); }},
+            {"toleranciaSondagem", [&](const std::string& v) { config.toleranciaSondagem = std::stod(v); }},
+        }},
+        {"estabilidade", {
+            {"ativa", [&](const std::string& v) { config.estabilidade.ativo = lerBooleano(v); }},
+            {"precisao", [&](const std::string& v) { config.estabilidade.precisao = std::stod(v); }},
+            {"precisaoP99", [&](const std::string& v) { config.estabilidade.precisaoP99 = std::stod(v); }},
+            {"confianca", [&](const std::string& v) { config.estabilidade.confianca = std::stod(v); }},
+            {"minimo", [&](const std::string& v) { config.estabilidade.minimo = lerInteiro(v); }},
+            {"maximo", [&](const std::string& v) { config.estabilidade.maximo = lerInteiro(v); }},
+            {"orcamento", [&](const std::string& v) { config.estabilidade.orcamentoSegundos = std::stod(v); }},
+        }},
+        {"saida", {
+            {"csv", [&](const std::string& v) { config.arquivoCsv = v; }},
+            {"comparacoes", [&](const std::string& v) { config.arquivoComparacoes = v; }},
+            {"historico", [&](const std::string& v) { config.arquivoHistorico = v; }},
+            {"rastreio", [&](const std::string& v) { config.arquivoRastreio = v; }},
+            {"console", [&](const std::string& v) { config.console = lerBooleano(v); }},
+        }},
+    };
+
+    // Uma seção de dimensionamento por motor registrado
+    for (const auto& motor : nomesMotores()) {
+        tratadores[motor] = {
+            {"tamanhos", [&config, motor](const std::string& v) { config.dimensionamento[motor].tamanhos = lerInteiros(v); }},
+            {"fatoresCarga", [&config, motor](const std::string& v) { config.dimensionamento[motor].fatoresCarga = lerReais(v); }},
+        };
+    }
+
+    std::string linha;
+    std::string secao;
+    size_t numeroLinha = 0;
+
+    while (std::getline(arquivo, linha)) {
+        ++numeroLinha;
+        linha = trim(linha);
+        const std::string local = nomeArquivo + ":" + std::to_string(numeroLinha);
+
+        if (linha.empty() || linha[0] == '#' || linha[0] == ';') {
+            continue;
+        }
+
+        if (linha.front() == '[') {
+            if (linha.back() != ']') {
+                throw std::runtime_error(local + ": seção mal formada: " + linha);
+            }
+            secao = trim(linha.substr(1, linha.size() - 2));
+            if (tratadores.find(secao) == tratadores.end()) {
+                throw std::runtime_error(local + ": seção desconhecida: [" + secao + "]");
+            }
+            continue;
+        }
+
+        size_t igual = linha.find('=');
+        if (igual == std::string::npos) {
+            throw std::runtime_error(local + ": esperado 'chave = valor'");
+        }
+        if (secao.empty()) {
+            throw std::runtime_error(local + ": chave fora de seção");
+        }
+
+        std::string chave = trim(linha.substr(0, igual));
+        std::string valor = trim(linha.substr(igual + 1));
+
+        const auto& chavesSecao = tratadores.at(secao);
+        auto tratador = chavesSecao.find(chave);
+        if (tratador == chavesSecao.end()) {
+            throw std::runtime_error(local + ": chave desconhecida em [" + secao + "]: " + chave);
+        }
+
+        try {
+            tratador->second(valor);
+        } catch (const std::exception&) {
+            throw std::runtime_error(local + ": valor inválido para " + chave + ": " + valor);
+        }
+    }
+
+    config.validar();
+    return config;
+}
+
+void ConfiguracaoBenchmark::validar() const {
+    if (motores.empty()) {
+        throw std::runtime_error("Configuração sem motores");
+    }
+    for (const auto& motor : motores) {
+        const auto registrados = nomesMotores();
+        if (std::find(registrados.begin(), registrados.end(), motor) == registrados.end()) {
+            std::string lista;
+            for (const auto& nome : registrados) {
+                lista += (lista.empty() ? "" : ", ") + nome;
+            }
+            throw std::runtime_error("Motor desconhecido: " + motor + " (registrados: " + lista + ")");
+        }
+        auto it = dimensionamento.find(motor);
+        if (it == dimensionamento.end() ||
+            (it->second.tamanhos.empty() && it->second.fatoresCarga.empty())) {
+            throw std::runtime_error("Motor " + motor + " sem tamanhos nem fatoresCarga");
+        }
+    }
+    if (hashes.empty()) {
+        throw std::runtime_error("Configuração sem funções hash");
+    }
+    for (const auto& hash : hashes) {
+        if (hash != "Divisao" && hash != "Multiplicacao") {
+            throw std::runtime_error("Função hash desconhecida: " + hash);
+        }
+    }
+    if (arquivos.empty() && distribuicoes.empty()) {
+        throw std::runtime_error("Configuração sem datasets (arquivos ou distribuicoes)");
+    }
+    for (const auto& dist : distribuicoes) {
+        if (dist.tipo != "uniforme" && dist.tipo != "sequencial") {
+            throw std::runtime_error("Distribuição desconhecida: " + dist.tipo);
+        }
+    }
+    for (const auto& mistura : misturas) {
+        if (mistura.busca + mistura.insercao + mistura.remocao != 100) {
+            throw std::runtime_error("Mistura " + mistura.rotulo() + " não soma 100%");
+        }
+    }
+    if (!(alfa > 0.0 && alfa < 1.0)) {
+        throw std::runtime_error("alfa deve estar entre 0 e 1");
+    }
+    if (!(toleranciaSondagem > 0.0)) {
+        throw std::runtime_error("toleranciaSondagem deve ser positiva");
+    }
+    if (repeticoes == 0 || quantidadeBuscas == 0 || threads.empty()) {
+        throw std::runtime_error("repeticoes, buscas e threads devem ser positivos");
+    }
+    if (estabilidade.ativo) {
+        if (!(estabilidade.precisao > 0.0) || estabilidade.precisaoP99 < 0.0) {
+            throw std::runtime_error("precisao deve ser positiva e precisaoP99 não negativa");
+        }
+        if (!(estabilidade.confianca > 0.0 && estabilidade.confianca < 1.0)) {
+            throw std::runtime_error("confianca deve estar entre 0 e 1");
+        }
+        if (estabilidade.minimo == 0 || estabilidade.maximo < estabilidade.minimo) {
+            throw std::runtime_error("minimo deve ser positivo e maximo >= minimo");
+        }
+        if (!(estabilidade.orcamentoSegundos > 0.0)) {
+            throw std::runtime_error("orcamento deve ser positivo");
+        }
+    }
+}
+
+void ConfiguracaoBenchmark::escreverJson(EscritorJson& json) const {
+    json.abrirArray("motores");
+    for (const auto& motor : motores) {
+        json.abrirObjeto().campo("nome", motor);
+        auto it = dimensionamento.find(motor);
+        if (it != dimensionamento.end()) {
+            json.abrirArray("tamanhos");
+            for (size_t tamanho : it->second.tamanhos) json.valor(tamanho);
+            json.fecharArray().abrirArray("fatoresCarga");
+            for (double fator : it->second.fatoresCarga) json.valor(fator);
+            json.fecharArray();
+        }
+        json.fecharObjeto();
+    }
+    json.fecharArray().abrirArray("hashes");
+    for (const auto& hash : hashes) json.valor(hash);
+    json.fecharArray().abrirArray("arquivos");
+    for (const auto& arquivo : arquivos) json.valor(arquivo);
+    json.fecharArray().abrirArray("distribuicoes");
+    for (const auto& dist : distribuicoes) json.valor(dist.rotulo());
+    json.fecharArray().abrirArray("misturas");
+    for (const auto& mistura : misturas) json.valor(mistura.rotulo());
+    json.fecharArray().abrirArray("threads");
+    for (size_t t : threads) json.valor(t);
+    json.fecharArray();
+    if (semente) {
+        json.campo("semente", *semente);
+    }
+    json.campo("quantidadeBuscas", quantidadeBuscas)
+        .campo("operacoesMistura", operacoesMistura)
+        .campo("repeticoes", repeticoes)
+        .campo("alfa", alfa)
+        .campo("toleranciaSondagem", toleranciaSondagem);
+    if (estabilidade.ativo) {
+        json.abrirObjeto("estabilidade")
+            .campo("precisao", estabilidade.precisao)
+            .campo("precisaoP99", estabilidade.precisaoP99)
+            .campo("confianca", estabilidade.confianca)
+            .campo("minimo", estabilidade.minimo)
+            .campo("maximo", estabilidade.maximo)
+            .campo("orcamentoSegundos", estabilidade.orcamentoSegundos)
+            .fecharObjeto();
+    }
+}
@@ -0,0 +1,206 @@
+/**
+ * @file ControleCache.cpp
+ * @brief Implementação da detecção da topologia de memória e da classe EvictorCache
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ControleCache.hpp"
+#include <fstream>
+#include <string>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+/// Valores usados quando não é possível detectar a topologia
+constexpr size_t L1D_PADRAO = 32u * 1024u;
+constexpr size_t L2_PADRAO = 1024u * 1024u;
+constexpr size_t LLC_PADRAO = 32u * 1024u * 1024u;
+constexpr size_t PAGINA_PADRAO = 4096u;
+constexpr size_t ENTRADAS_TLB_PADRAO = 1536u;
+
+/**
+ * @brief Lê a primeira linha de um arquivo do sysfs
+ * @param caminho Caminho do arquivo
+ * @return Conteúdo da linha ou string vazia se indisponível
+ */
+std::string lerLinha(const std::string& caminho) {
+    std::ifstream arquivo(caminho);
+    std::string linha;
+    if (arquivo.is_open()) {
+        std::getline(arquivo, linha);
+    }
+    return linha;
+}
+
+/**
+ * @brief Converte tamanhos no formato do sysfs ("48K", "2M") para bytes
+ * @param texto Texto lido do sysfs
+ * @return Tamanho em bytes ou 0 se inválido
+ */
+size_t converterTamanho(const std::string& texto) {
+    try {
+        size_t pos = 0;
+        size_t valor = std::stoull(texto, &pos);
+        if (pos < texto.size()) {
+            switch (texto[pos]) {
+                case 'K': valor *= 1024u; break;
+                case 'M': valor *= 1024u * 1024u; break;
+                case 'G': valor *= 1024u * 1024u * 1024u; break;
+                default: break;
+            }
+        }
+        return valor;
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Detecta a hierarquia percorrendo os índices de cache da CPU 0
+ *
+ * Caches de instrução são ignoradas. O nível de cada índice define se ele
+ * é L1d, L2 ou LLC (maior nível encontrado). O número de entradas da TLB
+ * é lido de /proc/cpuinfo quando disponível (processadores AMD).
+ *
+ * @return Estrutura com a topologia detectada
+ */
+TopologiaMemoria detectarTopologiaMemoria() {
+    TopologiaMemoria topo{};
+    int maiorNivel = 0;
+    const std::string base = "/sys/devices/system/cpu/cpu0/cache/index";
+
+    for (int i = 0; i < 16; ++i) {
+        const std::string dir = base + std::to_string(i) + "/";
+        std::string tipo = lerLinha(dir + "type");
+        if (tipo.empty()) {
+            break; // Não há mais índices
+        }
+        if (tipo == "Instruction") {
+            continue;
+        }
+
+        size_t tamanho = converterTamanho(lerLinha(dir + "size"));
+        int nivel = 0;
+        try {
+            nivel = std::stoi(lerLinha(dir + "level"));
+        } catch (const std::exception&) {
+            continue;
+        }
+
+        if (nivel == 1) topo.l1d = tamanho;
+        if (nivel == 2) topo.l2 = tamanho;
+        if (nivel >= maiorNivel) {
+            maiorNivel = nivel;
+            topo.llc = tamanho;
+        }
+    }
+
+    if (topo.l1d == 0) topo.l1d = L1D_PADRAO;
+    if (topo.l2 == 0) topo.l2 = L2_PADRAO;
+    if (topo.llc == 0) topo.llc = LLC_PADRAO;
+
+    topo.tamanhoPagina = PAGINA_PADRAO;
+#if defined(__unix__) || defined(__APPLE__)
+    long pagina = sysconf(_SC_PAGESIZE);
+    if (pagina > 0) {
+        topo.tamanhoPagina = static_cast<size_t>(pagina);
+    }
+    long paginas = sysconf(_SC_PHYS_PAGES);
+    if (paginas > 0) {
+        topo.memoriaFisica = static_cast<size_t>(paginas) * topo.tamanhoPagina;
+    }
+#endif
+
+    // Formato do /proc/cpuinfo em AMD: "TLB size	: 3072 4K pages"
+    topo.entradasTLB = ENTRADAS_TLB_PADRAO;
+    topo.tlbEstimada = true;
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string linha;
+    while (std::getline(cpuinfo, linha)) {
+        if (linha.rfind("TLB size", 0) == 0) {
+            size_t doisPontos = linha.find(':');
+            if (doisPontos != std::string::npos) {
+                try {
+                    topo.entradasTLB = std::stoull(linha.substr(doisPontos + 1));
+                    topo.tlbEstimada = false;
+                } catch (const std::exception&) {}
+            }
+            break;
+        }
+    }
+
+    return topo;
+}
+
+/**
+ * @brief Retorna a LLC detectada por detectarTopologiaMemoria()
+ * @return Tamanho da LLC em bytes
+ */
+size_t detectarTamanhoLLC() {
+    return detectarTopologiaMemoria().llc;
+}
+
+void EvictorCache::LiberarBuffer::operator()(unsigned char* p) const {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapeado) {
+        munmap(p, bytes);
+        return;
+    }
+#endif
+    delete[] p;
+}
+
+/**
+ * @brief Aloca o buffer de evicção
+ *
+ * O buffer é tocado uma vez na construção para que as páginas já estejam
+ * mapeadas e a primeira evicção não pague page faults. Se o mapeamento
+ * compartilhado falhar, usa o heap (o isolamento só fica mais lento).
+ *
+ * @param bytes Tamanho desejado (0 = FATOR_BUFFER x LLC)
+ */
+EvictorCache::EvictorCache(size_t bytes) {
+    if (bytes == 0) {
+        bytes = static_cast<size_t>(detectarTamanhoLLC() * FATOR_BUFFER);
+    }
+    tamanho = bytes;
+#if defined(__unix__) || defined(__APPLE__)
+    void* mapa = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapa != MAP_FAILED) {
+        buffer = std::unique_ptr<unsigned char[], LiberarBuffer>(
+            static_cast<unsigned char*>(mapa), LiberarBuffer{bytes, true});
+    }
+#endif
+    if (!buffer) {
+        buffer = std::unique_ptr<unsigned char[], LiberarBuffer>(new unsigned char[bytes], LiberarBuffer{bytes, false});
+    }
+    std::fill(buffer.get(), buffer.get() + bytes, static_cast<unsigned char>(1));
+}
+
+/**
+ * @brief Varre o buffer linha a linha com leitura e escrita
+ *
+ * @complexity O(b) onde b é o tamanho do buffer
+ */
+void EvictorCache::evictar() {
+    unsigned long long soma = 0;
+    for (size_t i = 0; i < tamanho; i += TAMANHO_LINHA) {
+        soma += buffer[i];
+        ++buffer[i];
+    }
+
+    // Sumidouro volátil impede que o laço seja eliminado pelo otimizador
+    static volatile unsigned long long sumidouro = 0;
+    sumidouro = sumidouro + soma;
+}
@@ -0,0 +1,369 @@
+/**
+ * @file DeduplicacaoExterna.cpp
+ * @brief Implementação do particionamento em disco e da deduplicação por partição
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "DeduplicacaoExterna.hpp"
+#include "CarregadorDados.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+/// Memória mínima: buffers de 256 partições, bloco de leitura e saída
+constexpr size_t BYTES_MEMORIA_MINIMO = 16 * 1024 * 1024;
+/// Reservado para o bloco de leitura e a saída durante a deduplicação de uma partição
+constexpr size_t BYTES_RESERVADOS = 1024 * 1024;
+/// Níveis possíveis antes de esgotar os 64 bits do hash
+constexpr size_t NIVEIS_MAXIMOS = 64 / BITS_POR_NIVEL;
+/// Largura do campo da quantidade no dataset de únicas, reescrito ao fim
+constexpr size_t LARGURA_QUANTIDADE = 20;
+
+/// Misturador de 64 bits (finalizador do MurmurHash3); cada nível usa 8 bits dele
+inline uint64_t hashDerrame(int chave) {
+    uint64_t h = static_cast<uint32_t>(chave);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Arquivo binário de uma partição (int32 na ordem nativa), gravado por um buffer
+ */
+class ArquivoDerrame {
+private:
+    std::string caminho;
+    std::ofstream saida;
+    std::vector<int> buffer;
+    size_t usados = 0;
+    uint64_t chaves = 0;
+
+    void descarregar() {
+        saida.write(reinterpret_cast<const char*>(buffer.data()),
+                    static_cast<std::streamsize>(usados * sizeof(int)));
+        if (!saida) {
+            throw std::runtime_error("Erro ao gravar derrame: " + caminho);
+        }
+        usados = 0;
+    }
+
+public:
+    ArquivoDerrame(std::string destino, size_t chavesBuffer)
+        : caminho(std::move(destino)), saida(caminho, std::ios::binary | std::ios::trunc),
+          buffer(std::max<size_t>(chavesBuffer, 1)) {
+        if (!saida.is_open()) {
+            throw std::runtime_error("Erro ao criar derrame: " + caminho);
+        }
+    }
+
+    void escrever(int chave) {
+        buffer[usados++] = chave;
+        ++chaves;
+        if (usados == buffer.size()) {
+            descarregar();
+        }
+    }
+
+    void fechar() {
+        descarregar();
+        saida.close();
+        if (!saida) {
+            throw std::runtime_error("Erro ao fechar derrame: " + caminho);
+        }
+        std::vector<int>().swap(buffer);
+    }
+
+    const std::string& getCaminho() const { return caminho; }
+    uint64_t getChaves() const { return chaves; }
+};
+
+/**
+ * @brief Partição gravada em disco, à espera de divisão ou deduplicação
+ */
+struct Particao {
+    std::string caminho;    ///< Derrame com as chaves
+    uint64_t chaves;        ///< Chaves no derrame
+    size_t nivel;           ///< Níveis de particionamento que a produziram
+    bool semProgresso;      ///< true se a divisão que a produziu não separou nenhuma chave
+};
+
+/// Menor potência de 2 (de 2 a 256) que deixa as partições em 3/4 do limite
+size_t fanoutPara(uint64_t chaves, uint64_t limite) {
+    const uint64_t alvo = std::max<uint64_t>(limite * 3 / 4, 1);
+    const uint64_t partes = (chaves + alvo - 1) / alvo;
+    size_t fanout = 2;
+    while (fanout < partes && fanout < (size_t{1} << BITS_POR_NIVEL)) {
+        fanout <<= 1;
+    }
+    return fanout;
+}
+
+/**
+ * @brief Divide as chaves de `ler` entre fanout derrames pelos bits do nível
+ * @param ler Preenche um bloco e devolve quantas chaves leu (0 no fim)
+ * @param aoLer Chamada com cada bloco lido (estatísticas do dataset)
+ * @return Partições não vazias; os derrames vazios são apagados
+ */
+template<typename Ler, typename AoLer>
+std::vector<Particao> distribuir(Ler&& ler, AoLer&& aoLer, size_t nivel, size_t fanout, const fs::path& diretorio,
+                                 size_t& contadorArquivos, size_t chavesBuffer) {
+    std::vector<ArquivoDerrame> derrames;
+    derrames.reserve(fanout);
+    for (size_t i = 0; i < fanout; ++i) {
+        derrames.emplace_back((diretorio / ("derrame_" + std::to_string(contadorArquivos++) + ".bin")).string(),
+                              chavesBuffer);
+    }
+
+    const size_t deslocamento = (nivel - 1) * BITS_POR_NIVEL;
+    const uint64_t mascara = fanout - 1;
+    std::vector<int> bloco(CHAVES_BLOCO_DERRAME);
+    for (size_t n = ler(bloco.data(), bloco.size()); n > 0; n = ler(bloco.data(), bloco.size())) {
+        aoLer(bloco.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            derrames[(hashDerrame(bloco[i]) >> deslocamento) & mascara].escrever(bloco[i]);
+        }
+    }
+
+    std::vector<Particao> particoes;
+    for (auto& derrame : derrames) {
+        derrame.fechar();
+        if (derrame.getChaves() == 0) {
+            fs::remove(derrame.getCaminho());
+        } else {
+            particoes.push_back(Particao{derrame.getCaminho(), derrame.getChaves(), nivel, false});
+        }
+    }
+    return particoes;
+}
+
+/**
+ * @brief Leitor em blocos de um derrame
+ */
+class LeitorDerrame {
+private:
+    std::string caminho;
+    std::ifstream entrada;
+    uint64_t restantes;
+
+public:
+    explicit LeitorDerrame(const Particao& particao)
+        : caminho(particao.caminho), entrada(caminho, std::ios::binary), restantes(particao.chaves) {
+        if (!entrada.is_open()) {
+            throw std::runtime_error("Erro ao abrir derrame: " + caminho);
+        }
+    }
+
+    size_t operator()(int* destino, size_t maximo) {
+        const size_t pedidas = static_cast<size_t>(std::min<uint64_t>(maximo, restantes));
+        if (pedidas == 0) {
+            return 0;
+        }
+        entrada.read(reinterpret_cast<char*>(destino), static_cast<std::streamsize>(pedidas * sizeof(int)));
+        if (static_cast<size_t>(entrada.gcount()) != pedidas * sizeof(int)) {
+            throw std::runtime_error("Derrame truncado: " + caminho);
+        }
+        restantes -= pedidas;
+        return pedidas;
+    }
+};
+
+/**
+ * @brief Dataset de saída com as chaves únicas
+ *
+ * A quantidade só é conhecida ao fim: a primeira linha é reservada com
+ * espaços e reescrita por fechar() (o CarregadorDados ignora os espaços).
+ */
+class SaidaUnicas {
+private:
+    std::string caminho;
+    std::ofstream saida;
+    std::string texto;
+
+    void descarregar() {
+        saida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+        if (!saida) {
+            throw std::runtime_error("Erro ao gravar chaves únicas: " + caminho);
+        }
+        texto.clear();
+    }
+
+public:
+    explicit SaidaUnicas(std::string destino) : caminho(std::move(destino)) {
+        if (caminho.empty()) {
+            return;
+        }
+        saida.open(caminho, std::ios::binary | std::ios::trunc);
+        if (!saida.is_open()) {
+            throw std::runtime_error("Erro ao criar arquivo: " + caminho);
+        }
+        texto.assign(LARGURA_QUANTIDADE, ' ');
+        texto += '\n';
+    }
+
+    void escrever(const std::vector<int>& unicas) {
+        if (caminho.empty()) {
+            return;
+        }
+        char numero[16];
+        for (int chave : unicas) {
+            const auto fim = std::to_chars(numero, numero + sizeof(numero), chave).ptr;
+            texto.append(numero, fim);
+            texto += '\n';
+            if (texto.size() >= BYTES_RESERVADOS / 2) {
+                descarregar();
+            }
+        }
+    }
+
+    void fechar(uint64_t total) {
+        if (caminho.empty()) {
+            return;
+        }
+        descarregar();
+        const std::string quantidade = std::to_string(total);
+        saida.seekp(static_cast<std::streamoff>(LARGURA_QUANTIDADE - quantidade.size()));
+        saida.write(quantidade.data(), static_cast<std::streamsize>(quantidade.size()));
+        saida.close();
+        if (!saida) {
+            throw std::runtime_error("Erro ao gravar chaves únicas: " + caminho);
+        }
+    }
+};
+
+/// Apaga o subdiretório dos derrames ao sair do escopo, também em caso de erro
+struct DiretorioTemporario {
+    fs::path caminho;
+    ~DiretorioTemporario() {
+        std::error_code erro;
+        fs::remove_all(caminho, erro);
+    }
+};
+
+} // namespace
+
+ResultadoDeduplicacao deduplicarExterno(const std::string& arquivo, const ConfiguracaoDeduplicacao& config,
+                                        const TabelaDeduplicacao& tabela) {
+    RASTREAR_ESCOPO_DETALHE("deduplicarExterno", "deduplicacao", arquivo);
+    if (config.bytesMemoria < BYTES_MEMORIA_MINIMO) {
+        throw std::invalid_argument("Orçamento de memória da deduplicação deve ter ao menos 16 MiB");
+    }
+    const uint64_t limite = config.chavesPorParticao != 0
+        ? config.chavesPorParticao
+        : std::max<uint64_t>((config.bytesMemoria - BYTES_RESERVADOS) / std::max<size_t>(tabela.bytesPorChave, 1), 1);
+    // Buffers de gravação de um nível com 256 partições: metade do orçamento
+    const size_t chavesBuffer = std::min<size_t>(config.bytesMemoria / 2 / (size_t{1} << BITS_POR_NIVEL) / sizeof(int),
+                                                 BYTES_RESERVADOS / sizeof(int));
+
+    ResultadoDeduplicacao resultado;
+    resultado.minimo = std::numeric_limits<int>::max();
+    resultado.maximo = std::numeric_limits<int>::min();
+    long double soma = 0.0L;
+    auto registrar = [&](const int* chaves, size_t n) {
+        long long somaBloco = 0;
+        for (size_t i = 0; i < n; ++i) {
+            resultado.minimo = std::min(resultado.minimo, chaves[i]);
+            resultado.maximo = std::max(resultado.maximo, chaves[i]);
+            somaBloco += chaves[i];
+        }
+        soma += somaBloco;
+        resultado.chaves += n;
+    };
+
+    LeitorDataset leitor(arquivo, std::min(LeitorDataset::BYTES_BLOCO_PADRAO, BYTES_RESERVADOS / 2));
+    auto lerDataset = [&](int* destino, size_t maximo) { return leitor.ler(destino, maximo); };
+    SaidaUnicas saida(config.arquivoUnicos);
+    std::vector<int> unicas;
+
+    // Uma partição (ou o dataset inteiro) numa tabela; as únicas vão para a saída
+    auto deduplicar = [&](auto&& ler, uint64_t chaves, auto&& aoLer) {
+        const auto inicio = Relogio::now();
+        tabela.iniciar(static_cast<size_t>(std::min(chaves, limite)));
+        std::vector<int> bloco(CHAVES_BLOCO_DERRAME);
+        for (size_t n = ler(bloco.data(), bloco.size()); n > 0; n = ler(bloco.data(), bloco.size())) {
+            aoLer(bloco.data(), n);
+            tabela.inserir(bloco.data(), n);
+        }
+        tabela.extrair(unicas);
+        saida.escrever(unicas);
+        resultado.unicas += unicas.size();
+        resultado.particoes++;
+        resultado.msDeduplicacao += std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+    };
+
+    if (leitor.getQuantidadeDeclarada() <= limite) {
+        // Cabe no orçamento: sem derrames
+        deduplicar(lerDataset, leitor.getQuantidadeDeclarada(), registrar);
+        resultado.maiorParticao = resultado.chaves;
+    } else {
+        DiretorioTemporario derrames;
+        const fs::path base = config.diretorio.empty() ? fs::temp_directory_path() : fs::path(config.diretorio);
+        derrames.caminho = base / ("analise_hash_dedup_" +
+                                   std::to_string(Relogio::now().time_since_epoch().count()));
+        fs::create_directories(derrames.caminho);
+        size_t contadorArquivos = 0;
+
+        auto inicio = Relogio::now();
+        std::vector<Particao> pendentes = distribuir(lerDataset, registrar, 1,
+                                                     fanoutPara(leitor.getQuantidadeDeclarada(), limite),
+                                                     derrames.caminho, contadorArquivos, chavesBuffer);
+        for (Particao& particao : pendentes) {
+            particao.semProgresso = particao.chaves == resultado.chaves;
+        }
+        resultado.bytesDerramados += resultado.chaves * sizeof(int);
+        resultado.niveis = 1;
+        resultado.msParticionamento += std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+
+        auto ignorar = [](const int*, size_t) {};
+        while (!pendentes.empty()) {
+            const Particao particao = pendentes.back();
+            pendentes.pop_back();
+            {
+                LeitorDerrame lerDerrame(particao);
+                if (particao.chaves <= limite || particao.semProgresso || particao.nivel >= NIVEIS_MAXIMOS) {
+                    deduplicar(lerDerrame, particao.chaves, ignorar);
+                    resultado.maiorParticao = std::max(resultado.maiorParticao, particao.chaves);
+                } else {
+                    inicio = Relogio::now();
+                    std::vector<Particao> filhas = distribuir(lerDerrame, ignorar, particao.nivel + 1,
+                                                              fanoutPara(particao.chaves, limite), derrames.caminho,
+                                                              contadorArquivos, chavesBuffer);
+                    for (Particao& filha : filhas) {
+                        filha.semProgresso = filha.chaves == particao.chaves;
+                        pendentes.push_back(filha);
+                    }
+                    resultado.bytesDerramados += particao.chaves * sizeof(int);
+                    resultado.niveis = std::max(resultado.niveis, particao.nivel + 1);
+                    resultado.msParticionamento +=
+                        std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+                }
+            }
+            // Apagada assim que lida: o disco guarda no máximo um nível por vez
+            fs::remove(particao.caminho);
+        }
+    }
+
+    if (resultado.chaves == 0) {
+        throw std::runtime_error("Nenhum número válido foi encontrado no arquivo");
+    }
+    saida.fechar(resultado.unicas);
+    resultado.media = static_cast<double>(soma / resultado.chaves);
+    return resultado;
+}
@@ -0,0 +1,446 @@
+/**
+ * @file DespachoCpu.cpp
+ * @brief Detecção da CPU e kernels escalares e vetoriais
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "DespachoCpu.hpp"
+#include "TabelaAberta.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ANALISE_HASH_DESPACHO_X86
+// _mm512_undefined_* dispara -Wmaybe-uninitialized espúrio no GCC 12 (PR 105593)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#endif
+
+// Os kernels vetoriais leem as células como pares de int (valor, estado)
+static_assert(std::is_standard_layout<Celula>::value && sizeof(Celula) == 2 * sizeof(int) &&
+              offsetof(Celula, valor) == 0 && offsetof(Celula, estado) == sizeof(int),
+              "Celula deve ser o par (valor, estado) de int");
+static_assert(std::is_same<std::underlying_type_t<Celula::Estado>, int>::value,
+              "Celula::Estado deve ter int como tipo subjacente");
+
+namespace {
+
+constexpr int OCUPADO = static_cast<int>(Celula::Estado::OCUPADO);
+
+// ---------------------------------------------------------------------------
+// Kernels escalares (referência e caudas das versões vetoriais)
+// ---------------------------------------------------------------------------
+
+size_t sondarCelulasEscalar(const Celula* celulas, size_t inicio, size_t fim, int valor, bool paraInsercao) {
+    for (size_t i = inicio; i < fim; ++i) {
+        const Celula& celula = celulas[i];
+        if (celula.estado == Celula::Estado::OCUPADO) {
+            if (celula.valor == valor) {
+                return i;
+            }
+        } else if (paraInsercao || celula.estado == Celula::Estado::VAZIO) {
+            return i;
+        }
+    }
+    return fim;
+}
+
+void hashDivisaoLoteEscalar(const int* chaves, size_t n, size_t tamanho, size_t* indices) {
+    for (size_t i = 0; i < n; ++i) {
+        indices[i] = static_cast<size_t>(std::abs(static_cast<int64_t>(chaves[i]))) % tamanho;
+    }
+}
+
+void hashMultiplicacaoLoteEscalar(const int* chaves, size_t n, size_t tamanho, double constante,
+                                  size_t* indices) {
+    for (size_t i = 0; i < n; ++i) {
+        double produto = std::abs(static_cast<int64_t>(chaves[i])) * constante;
+        double fracao = produto - std::floor(produto);
+        indices[i] = static_cast<size_t>(std::floor(fracao * tamanho));
+    }
+}
+
+const char* localizarQuebraEscalar(const char* inicio, const char* fim) {
+    return std::find(inicio, fim, '\n');
+}
+
+#ifdef ANALISE_HASH_DESPACHO_X86
+
+static_assert(sizeof(size_t) == sizeof(long long), "Kernels gravam índices de 64 bits");
+
+/**
+ * @brief Células que encerram a sondagem num bloco comparado int a int
+ * @param iguais Bit por int igual ao padrão (valor, OCUPADO)
+ * @param vazios Bit por int igual a zero
+ * @param validos Bits de valor das células do bloco (posições pares)
+ * @return Bit na posição do valor de cada célula que encerra a sondagem
+ */
+inline unsigned celulasParada(unsigned iguais, unsigned vazios, bool paraInsercao, unsigned validos) {
+    // Bit par: valor igual; bit ímpar: estado OCUPADO (iguais) ou VAZIO (vazios)
+    const unsigned parada = paraInsercao
+        ? iguais | ~(iguais >> 1)
+        : (iguais & (iguais >> 1)) | (vazios >> 1);
+    return parada & validos;
+}
+
+/// Padrão de 64 bits de uma célula OCUPADA com o valor
+inline long long padraoOcupado(int valor) {
+    return static_cast<long long>(static_cast<unsigned long long>(OCUPADO) << 32 |
+                                  static_cast<unsigned int>(valor));
+}
+
+// ---------------------------------------------------------------------------
+// SSE2: 2 células, 16 bytes ou 2 chaves por iteração. Sem arredondamento
+// vetorial, o piso de valores não negativos abaixo de 2^31 é a conversão
+// truncada para int32.
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+size_t sondarCelulasSse2(const Celula* celulas, size_t inicio, size_t fim, int valor, bool paraInsercao) {
+    const __m128i padrao = _mm_set1_epi64x(padraoOcupado(valor));
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = inicio;
+    for (; i + 2 <= fim; i += 2) {
+        const __m128i bloco = _mm_loadu_si128(reinterpret_cast<const __m128i*>(celulas + i));
+        const unsigned iguais = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(bloco, padrao)));
+        const unsigned vazios = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(bloco, zero)));
+        const unsigned parada = celulasParada(iguais, vazios, paraInsercao, 0x5u);
+        if (parada != 0) {
+            return i + __builtin_ctz(parada) / 2;
+        }
+    }
+    return sondarCelulasEscalar(celulas, i, fim, valor, paraInsercao);
+}
+
+__attribute__((target("sse2")))
+inline __m128d pisoSse2(__m128d x) {
+    return _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+}
+
+__attribute__((target("sse2")))
+inline void gravarIndicesSse2(size_t* destino, __m128d x) {
+    const __m128i indices = _mm_unpacklo_epi32(_mm_cvttpd_epi32(x), _mm_setzero_si128());
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destino), indices);
+}
+
+__attribute__((target("sse2")))
+void hashDivisaoLoteSse2(const int* chaves, size_t n, size_t tamanho, size_t* indices) {
+    // |INT_MIN| / 1 = 2^31 não cabe no piso por int32
+    if (tamanho > INT_MAX || tamanho < 2) {
+        hashDivisaoLoteEscalar(chaves, n, tamanho, indices);
+        return;
+    }
+    // |k| <= 2^31 e m >= 2: |k| / m < 2^31, e o quociente arredondado nunca alcança o inteiro seguinte
+    const __m128d m = _mm_set1_pd(static_cast<double>(tamanho));
+    const __m128d sinal = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chaves + i));
+        const __m128d x = _mm_andnot_pd(sinal, _mm_cvtepi32_pd(k));
+        const __m128d q = pisoSse2(_mm_div_pd(x, m));
+        gravarIndicesSse2(indices + i, _mm_sub_pd(x, _mm_mul_pd(q, m)));
+    }
+    hashDivisaoLoteEscalar(chaves + i, n - i, tamanho, indices + i);
+}
+
+__attribute__((target("sse2")))
+void hashMultiplicacaoLoteSse2(const int* chaves, size_t n, size_t tamanho, double constante,
+                               size_t* indices) {
+    if (tamanho > INT_MAX || constante < 0.0 || constante >= 1.0) {
+        hashMultiplicacaoLoteEscalar(chaves, n, tamanho, constante, indices);
+        return;
+    }
+    const __m128d m = _mm_set1_pd(static_cast<double>(tamanho));
+    const __m128d c = _mm_set1_pd(constante);
+    const __m128d sinal = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128i k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chaves + i));
+        const __m128d produto = _mm_mul_pd(_mm_andnot_pd(sinal, _mm_cvtepi32_pd(k)), c);
+        const __m128d fracao = _mm_sub_pd(produto, pisoSse2(produto));
+        gravarIndicesSse2(indices + i, _mm_mul_pd(fracao, m));
+    }
+    hashMultiplicacaoLoteEscalar(chaves + i, n - i, tamanho, constante, indices + i);
+}
+
+__attribute__((target("sse2")))
+const char* localizarQuebraSse2(const char* inicio, const char* fim) {
+    const __m128i quebra = _mm_set1_epi8('\n');
+    const char* p = inicio;
+    for (; fim - p >= 16; p += 16) {
+        const __m128i bloco = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const unsigned iguais = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bloco, quebra)));
+        if (iguais != 0) {
+            return p + __builtin_ctz(iguais);
+        }
+    }
+    return localizarQuebraEscalar(p, fim);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2: 4 células, 32 bytes ou 4 chaves por iteração. O atributo não
+// habilita FMA, de modo que produto e subtração arredondam como na versão
+// escalar.
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+size_t sondarCelulasAvx2(const Celula* celulas, size_t inicio, size_t fim, int valor, bool paraInsercao) {
+    const __m256i padrao = _mm256_set1_epi64x(padraoOcupado(valor));
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = inicio;
+    for (; i + 4 <= fim; i += 4) {
+        const __m256i bloco = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(celulas + i));
+        const unsigned iguais = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bloco, padrao)));
+        const unsigned vazios = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bloco, zero)));
+        const unsigned parada = celulasParada(iguais, vazios, paraInsercao, 0x55u);
+        if (parada != 0) {
+            return i + __builtin_ctz(parada) / 2;
+        }
+    }
+    return sondarCelulasSse2(celulas, i, fim, valor, paraInsercao);
+}
+
+__attribute__((target("avx2")))
+inline void gravarIndicesAvx2(size_t* destino, __m256d x) {
+    const __m256i indices = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(x));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destino), indices);
+}
+
+__attribute__((target("avx2")))
+void hashDivisaoLoteAvx2(const int* chaves, size_t n, size_t tamanho, size_t* indices) {
+    if (tamanho > INT_MAX) {
+        hashDivisaoLoteEscalar(chaves, n, tamanho, indices);
+        return;
+    }
+    const __m256d m = _mm256_set1_pd(static_cast<double>(tamanho));
+    const __m256d sinal = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chaves + i));
+        const __m256d x = _mm256_andnot_pd(sinal, _mm256_cvtepi32_pd(k));
+        const __m256d q = _mm256_floor_pd(_mm256_div_pd(x, m));
+        gravarIndicesAvx2(indices + i, _mm256_sub_pd(x, _mm256_mul_pd(q, m)));
+    }
+    hashDivisaoLoteSse2(chaves + i, n - i, tamanho, indices + i);
+}
+
+__attribute__((target("avx2")))
+void hashMultiplicacaoLoteAvx2(const int* chaves, size_t n, size_t tamanho, double constante,
+                               size_t* indices) {
+    if (tamanho > INT_MAX) {
+        hashMultiplicacaoLoteEscalar(chaves, n, tamanho, constante, indices);
+        return;
+    }
+    const __m256d m = _mm256_set1_pd(static_cast<double>(tamanho));
+    const __m256d c = _mm256_set1_pd(constante);
+    const __m256d sinal = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chaves + i));
+        const __m256d produto = _mm256_mul_pd(_mm256_andnot_pd(sinal, _mm256_cvtepi32_pd(k)), c);
+        const __m256d fracao = _mm256_sub_pd(produto, _mm256_floor_pd(produto));
+        gravarIndicesAvx2(indices + i, _mm256_floor_pd(_mm256_mul_pd(fracao, m)));
+    }
+    hashMultiplicacaoLoteEscalar(chaves + i, n - i, tamanho, constante, indices + i);
+}
+
+__attribute__((target("avx2")))
+const char* localizarQuebraAvx2(const char* inicio, const char* fim) {
+    const __m256i quebra = _mm256_set1_epi8('\n');
+    const char* p = inicio;
+    for (; fim - p >= 32; p += 32) {
+        const __m256i bloco = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const unsigned iguais = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bloco, quebra)));
+        if (iguais != 0) {
+            return p + __builtin_ctz(iguais);
+        }
+    }
+    return localizarQuebraSse2(p, fim);
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512: 8 células, 64 bytes ou 8 chaves por iteração. AVX-512F implica
+// FMA; o produto usa a forma com arredondamento explícito, que o compilador
+// não funde com a subtração seguinte.
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx512f,avx512bw")))
+size_t sondarCelulasAvx512(const Celula* celulas, size_t inicio, size_t fim, int valor, bool paraInsercao) {
+    const __m512i padrao = _mm512_set1_epi64(padraoOcupado(valor));
+    const __m512i zero = _mm512_setzero_si512();
+    size_t i = inicio;
+    for (; i + 8 <= fim; i += 8) {
+        const __m512i bloco = _mm512_loadu_si512(celulas + i);
+        const unsigned iguais = _mm512_cmpeq_epi32_mask(bloco, padrao);
+        const unsigned vazios = _mm512_cmpeq_epi32_mask(bloco, zero);
+        const unsigned parada = celulasParada(iguais, vazios, paraInsercao, 0x5555u);
+        if (parada != 0) {
+            return i + __builtin_ctz(parada) / 2;
+        }
+    }
+    return sondarCelulasAvx2(celulas, i, fim, valor, paraInsercao);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline __m512d pisoAvx512(__m512d x) {
+    return _mm512_roundscale_pd(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline void gravarIndicesAvx512(size_t* destino, __m512d x) {
+    _mm512_storeu_si512(destino, _mm512_cvtepi32_epi64(_mm512_cvttpd_epi32(x)));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void hashDivisaoLoteAvx512(const int* chaves, size_t n, size_t tamanho, size_t* indices) {
+    if (tamanho > INT_MAX) {
+        hashDivisaoLoteEscalar(chaves, n, tamanho, indices);
+        return;
+    }
+    const __m512d m = _mm512_set1_pd(static_cast<double>(tamanho));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chaves + i));
+        const __m512d x = _mm512_abs_pd(_mm512_cvtepi32_pd(k));
+        const __m512d q = pisoAvx512(_mm512_div_pd(x, m));
+        // q * m é inteiro exato: uma eventual fusão com a subtração não muda o resto
+        gravarIndicesAvx512(indices + i, _mm512_sub_pd(x, _mm512_mul_pd(q, m)));
+    }
+    hashDivisaoLoteAvx2(chaves + i, n - i, tamanho, indices + i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void hashMultiplicacaoLoteAvx512(const int* chaves, size_t n, size_t tamanho, double constante,
+                                 size_t* indices) {
+    if (tamanho > INT_MAX) {
+        hashMultiplicacaoLoteEscalar(chaves, n, tamanho, constante, indices);
+        return;
+    }
+    const __m512d m = _mm512_set1_pd(static_cast<double>(tamanho));
+    const __m512d c = _mm512_set1_pd(constante);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chaves + i));
+        const __m512d x = _mm512_abs_pd(_mm512_cvtepi32_pd(k));
+        const __m512d produto = _mm512_mul_round_pd(x, c, _MM_FROUND_CUR_DIRECTION);
+        const __m512d fracao = _mm512_sub_pd(produto, pisoAvx512(produto));
+        gravarIndicesAvx512(indices + i, pisoAvx512(_mm512_mul_pd(fracao, m)));
+    }
+    hashMultiplicacaoLoteAvx2(chaves + i, n - i, tamanho, constante, indices + i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+const char* localizarQuebraAvx512(const char* inicio, const char* fim) {
+    const __m512i quebra = _mm512_set1_epi8('\n');
+    const char* p = inicio;
+    for (; fim - p >= 64; p += 64) {
+        const __m512i bloco = _mm512_loadu_si512(p);
+        const unsigned long long iguais = _mm512_cmpeq_epi8_mask(bloco, quebra);
+        if (iguais != 0) {
+            return p + __builtin_ctzll(iguais);
+        }
+    }
+    return localizarQuebraAvx2(p, fim);
+}
+
+#endif // ANALISE_HASH_DESPACHO_X86
+
+/**
+ * @brief Kernels de um nível (o chamador garante o suporte da CPU)
+ */
+KernelsSimd kernelsPara(NivelIsa nivel) {
+    switch (nivel) {
+#ifdef ANALISE_HASH_DESPACHO_X86
+        case NivelIsa::AVX512:
+            return {nivel, sondarCelulasAvx512, hashDivisaoLoteAvx512, hashMultiplicacaoLoteAvx512,
+                    localizarQuebraAvx512};
+        case NivelIsa::AVX2:
+            return {nivel, sondarCelulasAvx2, hashDivisaoLoteAvx2, hashMultiplicacaoLoteAvx2,
+                    localizarQuebraAvx2};
+        case NivelIsa::SSE2:
+            return {nivel, sondarCelulasSse2, hashDivisaoLoteSse2, hashMultiplicacaoLoteSse2,
+                    localizarQuebraSse2};
+#endif
+        default:
+            return {NivelIsa::ESCALAR, sondarCelulasEscalar, hashDivisaoLoteEscalar,
+                    hashMultiplicacaoLoteEscalar, localizarQuebraEscalar};
+    }
+}
+
+/**
+ * @brief Consulta a CPU; __builtin_cpu_supports também verifica se o
+ *        sistema operacional salva os registradores AVX (XGETBV)
+ */
+NivelIsa detectarIsa() {
+#ifdef ANALISE_HASH_DESPACHO_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return NivelIsa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return NivelIsa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return NivelIsa::SSE2;
+    }
+#endif
+    return NivelIsa::ESCALAR;
+}
+
+KernelsSimd& kernelsAtivos() {
+    static KernelsSimd ativos = kernelsPara(isaDetectada());
+    return ativos;
+}
+
+} // namespace
+
+const char* nomeIsa(NivelIsa nivel) {
+    switch (nivel) {
+        case NivelIsa::SSE2:
+            return "sse2";
+        case NivelIsa::AVX2:
+            return "avx2";
+        case NivelIsa::AVX512:
+            return "avx512";
+        default:
+            return "escalar";
+    }
+}
+
+NivelIsa isaPorNome(const std::string& nome) {
+    for (NivelIsa nivel : {NivelIsa::ESCALAR, NivelIsa::SSE2, NivelIsa::AVX2, NivelIsa::AVX512}) {
+        if (nome == nomeIsa(nivel)) {
+            return nivel;
+        }
+    }
+    throw std::invalid_argument("ISA desconhecida: " + nome + " (use escalar, sse2, avx2 ou avx512)");
+}
+
+NivelIsa isaDetectada() {
+    static const NivelIsa detectada = detectarIsa();
+    return detectada;
+}
+
+const KernelsSimd& kernelsSimd() {
+    return kernelsAtivos();
+}
+
+void selecionarIsa(NivelIsa nivel) {
+    if (nivel > isaDetectada()) {
+        throw std::runtime_error(std::string("ISA ") + nomeIsa(nivel) + " não suportada por esta CPU (máxima: " +
+                                 nomeIsa(isaDetectada()) + ")");
+    }
+    kernelsAtivos() = kernelsPara(nivel);
+}
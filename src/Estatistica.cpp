@@ -0,0 +1,263 @@
+/**
+ * @file Estatistica.cpp
+ * @brief Implementação dos testes estatísticos
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "Estatistica.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+/// Maior amostra para a qual a distribuição exata de U é calculada
+constexpr size_t MAX_AMOSTRA_EXATA = 20;
+
+/**
+ * @brief Distribuição exata de U sob a hipótese nula
+ * @param n1 Tamanho da primeira amostra
+ * @param n2 Tamanho da segunda amostra
+ * @return Contagem de arranjos para cada valor de U (0..n1*n2)
+ *
+ * Recorrência clássica: o maior elemento vem da primeira amostra (e
+ * supera os j elementos da segunda) ou da segunda.
+ */
+std::vector<double> distribuicaoU(size_t n1, size_t n2) {
+    // contagens[i][j][u] para i elementos da primeira e j da segunda
+    std::vector<std::vector<std::vector<double>>> contagens(
+        n1 + 1, std::vector<std::vector<double>>(n2 + 1));
+
+    for (size_t i = 0; i <= n1; ++i) {
+        for (size_t j = 0; j <= n2; ++j) {
+            auto& atual = contagens[i][j];
+            atual.assign(i * j + 1, 0.0);
+            if (i == 0 || j == 0) {
+                atual[0] = 1.0;
+                continue;
+            }
+            const auto& semA = contagens[i - 1][j];
+            const auto& semB = contagens[i][j - 1];
+            for (size_t u = 0; u < semA.size(); ++u) {
+                atual[u + j] += semA[u];
+            }
+            for (size_t u = 0; u < semB.size(); ++u) {
+                atual[u] += semB[u];
+            }
+        }
+    }
+    return contagens[n1][n2];
+}
+
+} // namespace
+
+double mediana(std::vector<double> amostra) {
+    if (amostra.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const size_t meio = amostra.size() / 2;
+    std::nth_element(amostra.begin(), amostra.begin() + meio, amostra.end());
+    double valor = amostra[meio];
+    if (amostra.size() % 2 == 0) {
+        double anterior = *std::max_element(amostra.begin(), amostra.begin() + meio);
+        valor = (valor + anterior) / 2.0;
+    }
+    return valor;
+}
+
+double coeficienteVariacao(const std::vector<double>& amostra) {
+    if (amostra.size() < 2) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double media = std::accumulate(amostra.begin(), amostra.end(), 0.0) / amostra.size();
+    if (media == 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double somaQuadrados = 0.0;
+    for (double valor : amostra) {
+        somaQuadrados += (valor - media) * (valor - media);
+    }
+    return std::sqrt(somaQuadrados / (amostra.size() - 1)) / media;
+}
+
+double IntervaloQuantil::semiamplitudeRelativa() const {
+    if (!valido || estimativa <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return (superior - inferior) / (2.0 * estimativa);
+}
+
+/**
+ * @brief Escolhe os postos l e u com P(l <= B < u) >= confiança
+ *
+ * B ~ Binomial(n, q) conta os valores abaixo do quantil. O limite inferior
+ * é x(l) com l o maior posto tal que P(B < l) <= (1 - confiança) / 2, e o
+ * superior x(u) com u o menor posto tal que P(B >= u) <= (1 - confiança) / 2.
+ * A distribuição acumulada é somada em escala logarítmica para não
+ * perder precisão com n grande.
+ */
+IntervaloQuantil intervaloQuantil(std::vector<double> amostra, double q, double confianca) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    IntervaloQuantil intervalo{nan, nan, nan, false};
+    if (amostra.empty()) {
+        return intervalo;
+    }
+    std::sort(amostra.begin(), amostra.end());
+    const size_t n = amostra.size();
+    if (q == 0.5) {
+        intervalo.estimativa = mediana(amostra);
+    } else {
+        const size_t posto = static_cast<size_t>(std::ceil(q * n));
+        intervalo.estimativa = amostra[std::min(std::max<size_t>(posto, 1), n) - 1];
+    }
+    if (!(q > 0.0 && q < 1.0)) {
+        return intervalo;
+    }
+
+    const double cauda = (1.0 - confianca) / 2.0;
+    const double logQ = std::log(q);
+    const double logComplemento = std::log1p(-q);
+
+    // acumulada[k] = P(B <= k)
+    std::vector<double> acumulada(n + 1);
+    double soma = 0.0;
+    for (size_t k = 0; k <= n; ++k) {
+        const double logProbabilidade = std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0)
+                                      + k * logQ + (n - k) * logComplemento;
+        soma += std::exp(logProbabilidade);
+        acumulada[k] = soma;
+    }
+
+    // Postos de 1 a n; P(B < l) = acumulada[l - 1]
+    size_t inferior = 0;
+    for (size_t l = 1; l <= n && acumulada[l - 1] <= cauda; ++l) {
+        inferior = l;
+    }
+    size_t superior = 0;
+    for (size_t u = n; u >= 1 && 1.0 - acumulada[u - 1] <= cauda; --u) {
+        superior = u;
+    }
+    if (inferior == 0 || superior == 0) {
+        return intervalo;
+    }
+
+    intervalo.inferior = amostra[inferior - 1];
+    intervalo.superior = amostra[superior - 1];
+    intervalo.valido = true;
+    return intervalo;
+}
+
+/**
+ * @brief Calcula U pelos postos médios da amostra combinada
+ *
+ * Empates recebem o posto médio do grupo; a soma de (t³ - t) dos grupos
+ * entra na correção da variância da aproximação normal.
+ */
+ResultadoMannWhitney testeMannWhitney(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty()) {
+        throw std::invalid_argument("Mann-Whitney exige amostras não vazias");
+    }
+
+    const size_t n1 = a.size();
+    const size_t n2 = b.size();
+    const size_t n = n1 + n2;
+
+    // Amostra combinada: (valor, pertence à primeira amostra)
+    std::vector<std::pair<double, bool>> combinada;
+    combinada.reserve(n);
+    for (double valor : a) combinada.emplace_back(valor, true);
+    for (double valor : b) combinada.emplace_back(valor, false);
+    std::sort(combinada.begin(), combinada.end(),
+              [](const auto& x, const auto& y) { return x.first < y.first; });
+
+    double somaPostosA = 0.0;
+    double correcaoEmpates = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && combinada[j].first == combinada[i].first) {
+            ++j;
+        }
+        const double postoMedio = (i + 1 + j) / 2.0;  // Postos i+1..j
+        for (size_t k = i; k < j; ++k) {
+            if (combinada[k].second) somaPostosA += postoMedio;
+        }
+        const double t = static_cast<double>(j - i);
+        correcaoEmpates += t * t * t - t;
+        i = j;
+    }
+
+    ResultadoMannWhitney resultado;
+    resultado.u = somaPostosA - n1 * (n1 + 1) / 2.0;
+    resultado.exato = false;
+
+    if (correcaoEmpates == 0.0 && n1 <= MAX_AMOSTRA_EXATA && n2 <= MAX_AMOSTRA_EXATA) {
+        const auto contagens = distribuicaoU(n1, n2);
+        const double total = std::accumulate(contagens.begin(), contagens.end(), 0.0);
+        const size_t u = static_cast<size_t>(std::llround(resultado.u));
+        const double caudaInferior = std::accumulate(contagens.begin(), contagens.begin() + u + 1, 0.0);
+        const double caudaSuperior = std::accumulate(contagens.begin() + u, contagens.end(), 0.0);
+        resultado.pValor = std::min(1.0, 2.0 * std::min(caudaInferior, caudaSuperior) / total);
+        resultado.exato = true;
+        return resultado;
+    }
+
+    const double media = n1 * n2 / 2.0;
+    const double variancia = n1 * n2 / 12.0 *
+        ((n + 1) - correcaoEmpates / (static_cast<double>(n) * (n - 1)));
+    if (variancia <= 0.0) {
+        resultado.pValor = 1.0; // Todos os valores iguais
+        return resultado;
+    }
+
+    const double z = std::max(0.0, std::abs(resultado.u - media) - 0.5) / std::sqrt(variancia);
+    resultado.pValor = std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    return resultado;
+}
+
+double deltaCliff(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty()) {
+        return 0.0;
+    }
+    long long saldo = 0;
+    for (double x : a) {
+        for (double y : b) {
+            saldo += (x > y) - (x < y);
+        }
+    }
+    return static_cast<double>(saldo) / (static_cast<double>(a.size()) * b.size());
+}
+
+std::string magnitudeEfeito(double delta) {
+    const double absoluto = std::abs(delta);
+    if (absoluto < 0.147) return "desprezivel";
+    if (absoluto < 0.33) return "pequeno";
+    if (absoluto < 0.474) return "medio";
+    return "grande";
+}
+
+/**
+ * @brief Multiplica o k-ésimo menor p-valor por (m - k) e impõe monotonicidade
+ */
+std::vector<double> ajustarHolm(const std::vector<double>& pValores) {
+    const size_t m = pValores.size();
+    std::vector<size_t> ordem(m);
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::sort(ordem.begin(), ordem.end(),
+              [&](size_t x, size_t y) { return pValores[x] < pValores[y]; });
+
+    std::vector<double> ajustados(m);
+    double maximo = 0.0;
+    for (size_t k = 0; k < m; ++k) {
+        const double ajustado = std::min(1.0, pValores[ordem[k]] * static_cast<double>(m - k));
+        maximo = std::max(maximo, ajustado);
+        ajustados[ordem[k]] = maximo;
+    }
+    return ajustados;
+}
@@ -0,0 +1,458 @@
+/**
+ * @file GeradorCarga.cpp
+ * @brief Implementação do gerador de carga do modo servidor
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "GeradorCarga.hpp"
+#include "MetadadosExecucao.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define ANALISE_HASH_SERVIDOR_KV
+#endif
+
+namespace {
+
+using Relogio = std::chrono::steady_clock;
+
+/**
+ * @brief Percentil pelo método do posto mais próximo
+ * @param ordenadas Amostra em ordem crescente (não vazia)
+ * @param q Fração entre 0 e 1
+ */
+double percentilOrdenado(const std::vector<double>& ordenadas, double q) {
+    const size_t posto = static_cast<size_t>(std::ceil(q * ordenadas.size()));
+    return ordenadas[std::max<size_t>(posto, 1) - 1];
+}
+
+/**
+ * @brief Contagens e latências de uma conexão
+ */
+struct MedicaoConexao {
+    ResultadoCarga contagem;
+    std::vector<double> latenciasUs;
+};
+
+/**
+ * @brief Acumula o resultado de cada operação de um lote respondido
+ */
+void contabilizar(const std::vector<OperacaoKv>& operacoes, const uint8_t* resultados, ResultadoCarga& contagem) {
+    for (size_t i = 0; i < operacoes.size(); ++i) {
+        const auto resultado = static_cast<ResultadoKv>(resultados[i]);
+        if (resultado == ResultadoKv::ERRO) {
+            ++contagem.erros;
+        }
+        const bool sim = resultado == ResultadoKv::SIM;
+        switch (operacoes[i]) {
+            case OperacaoKv::GET: ++contagem.buscas; contagem.acertos += sim; break;
+            case OperacaoKv::PUT: ++contagem.insercoes; contagem.insercoesNovas += sim; break;
+            case OperacaoKv::DEL: ++contagem.remocoes; contagem.remocoesEfetivas += sim; break;
+        }
+    }
+}
+
+/**
+ * @brief Valida o cabeçalho de uma resposta contra o lote esperado
+ * @throws std::runtime_error se a resposta estiver fora de ordem ou malformada
+ */
+void validarResposta(const uint8_t* quadro, size_t tamanho, uint32_t idEsperado, size_t nEsperado) {
+    if (tamanho < KV_BYTES_CABECALHO || lerU32(quadro + 4) != idEsperado ||
+        lerU16(quadro + 8) != nEsperado || tamanho != KV_BYTES_CABECALHO + nEsperado) {
+        throw std::runtime_error("Resposta inesperada do servidor para o lote " + std::to_string(idEsperado));
+    }
+}
+
+} // namespace
+
+GeradorCarga::GeradorCarga(const EnderecoKv& enderecoServidor, const ConfiguracaoCarga& configuracao)
+    : endereco(enderecoServidor), config(configuracao) {
+    if (config.conexoes == 0 || config.profundidade == 0 || config.lote == 0 ||
+        config.operacoes == 0 || config.chaves == 0) {
+        throw std::invalid_argument("Parâmetros da carga devem ser positivos");
+    }
+    if (config.lote > KV_MAX_OPERACOES) {
+        throw std::invalid_argument("Lote da carga excede " + std::to_string(KV_MAX_OPERACOES) + " operações");
+    }
+    if (config.chaves > static_cast<size_t>(INT32_MAX)) {
+        throw std::invalid_argument("Quantidade de chaves da carga excede o intervalo de int32");
+    }
+    const MisturaOperacoes& m = config.mistura;
+    if (m.busca + m.insercao + m.remocao != 100) {
+        throw std::invalid_argument("Mistura da carga deve somar 100: " + m.rotulo());
+    }
+}
+
+#ifdef ANALISE_HASH_SERVIDOR_KV
+
+namespace {
+
+std::runtime_error erroSistema(const std::string& contexto) {
+    return std::runtime_error(contexto + ": " + std::strerror(errno));
+}
+
+/// Fecha o socket ao sair do escopo
+struct SocketCliente {
+    int descritor = -1;
+    SocketCliente() = default;
+    SocketCliente(SocketCliente&& outro) noexcept : descritor(outro.descritor) { outro.descritor = -1; }
+    SocketCliente(const SocketCliente&) = delete;
+    ~SocketCliente() { if (descritor >= 0) ::close(descritor); }
+};
+
+/// Envia o buffer inteiro por um socket bloqueante
+void enviarTudo(int descritor, const std::vector<uint8_t>& buffer) {
+    size_t enviados = 0;
+    while (enviados < buffer.size()) {
+        const ssize_t n = ::send(descritor, buffer.data() + enviados, buffer.size() - enviados, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw erroSistema("Falha ao enviar ao servidor");
+        enviados += static_cast<size_t>(n);
+    }
+}
+
+/// Recebe exatamente n bytes de um socket bloqueante
+void receberTudo(int descritor, uint8_t* destino, size_t n) {
+    size_t recebidos = 0;
+    while (recebidos < n) {
+        const ssize_t lidos = ::recv(descritor, destino + recebidos, n - recebidos, 0);
+        if (lidos < 0 && errno == EINTR) continue;
+        if (lidos < 0) throw erroSistema("Falha ao receber do servidor");
+        if (lidos == 0) throw std::runtime_error("Servidor encerrou a conexão");
+        recebidos += static_cast<size_t>(lidos);
+    }
+}
+
+/**
+ * @brief Insere as chaves pares de [0, chaves), um lote por vez (não medido)
+ */
+void preCarregar(int descritor, size_t chaves, size_t lote) {
+    RASTREAR_ESCOPO("preCarregar", "carga");
+    std::vector<ComandoKv> comandos;
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> resposta;
+    uint32_t idLote = 0;
+    for (size_t chave = 0; chave < chaves;) {
+        comandos.clear();
+        for (; chave < chaves && comandos.size() < lote; chave += 2) {
+            comandos.push_back({OperacaoKv::PUT, static_cast<int32_t>(chave)});
+        }
+        buffer.clear();
+        anexarRequisicaoKv(buffer, idLote, comandos.data(), comandos.size());
+        enviarTudo(descritor, buffer);
+
+        resposta.resize(KV_BYTES_CABECALHO + comandos.size());
+        receberTudo(descritor, resposta.data(), resposta.size());
+        validarResposta(resposta.data(), KV_BYTES_COMPRIMENTO + lerU32(resposta.data()), idLote, comandos.size());
+        ++idLote;
+    }
+}
+
+/**
+ * @brief Fase medida de uma conexão não bloqueante
+ *
+ * Mantém até `profundidade` lotes em voo numa janela circular indexada pelo
+ * idLote; as respostas chegam na ordem dos envios. poll() espera por
+ * leitura e, enquanto houver bytes não enviados, também por escrita, de
+ * modo que o cliente nunca bloqueia enviando enquanto o servidor espera
+ * que ele leia.
+ */
+void executarConexao(int descritor, const ConfiguracaoCarga& config, size_t operacoes, unsigned int semente,
+                     MedicaoConexao& medicao) {
+    RASTREAR_ESCOPO_DETALHE("conexaoCarga", "carga", std::to_string(operacoes));
+
+    struct LoteEmVoo {
+        std::vector<OperacaoKv> operacoes;
+        Relogio::time_point inicio;
+    };
+    std::vector<LoteEmVoo> janela(config.profundidade);
+
+    std::mt19937 gerador(semente);
+    std::uniform_int_distribution<int32_t> sorteioChave(0, static_cast<int32_t>(config.chaves - 1));
+    std::uniform_int_distribution<unsigned> sorteioOperacao(0, 99);
+    const unsigned limiteBusca = config.mistura.busca;
+    const unsigned limiteInsercao = limiteBusca + config.mistura.insercao;
+
+    const size_t totalLotes = (operacoes + config.lote - 1) / config.lote;
+    medicao.latenciasUs.reserve(totalLotes);
+
+    std::vector<ComandoKv> comandos(config.lote);
+    std::vector<uint8_t> saida;
+    std::vector<uint8_t> entrada;
+    size_t enviados = 0;
+    size_t consumidos = 0;
+    size_t lotesEnviados = 0;
+    size_t lotesRecebidos = 0;
+    size_t operacoesGeradas = 0;
+
+    while (lotesRecebidos < totalLotes) {
+        // Completa a janela
+        while (lotesEnviados < totalLotes && lotesEnviados - lotesRecebidos < config.profundidade) {
+            const size_t n = std::min(config.lote, operacoes - operacoesGeradas);
+            LoteEmVoo& voo = janela[lotesEnviados % config.profundidade];
+            voo.operacoes.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                const unsigned sorteio = sorteioOperacao(gerador);
+                const OperacaoKv operacao = sorteio < limiteBusca ? OperacaoKv::GET
+                                          : sorteio < limiteInsercao ? OperacaoKv::PUT
+                                          : OperacaoKv::DEL;
+                comandos[i] = {operacao, sorteioChave(gerador)};
+                voo.operacoes[i] = operacao;
+            }
+            voo.inicio = Relogio::now();
+            anexarRequisicaoKv(saida, static_cast<uint32_t>(lotesEnviados), comandos.data(), n);
+            operacoesGeradas += n;
+            ++lotesEnviados;
+        }
+
+        pollfd evento{};
+        evento.fd = descritor;
+        evento.events = static_cast<short>(POLLIN | (enviados < saida.size() ? POLLOUT : 0));
+        if (::poll(&evento, 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            throw erroSistema("Falha no poll");
+        }
+
+        if (evento.revents & POLLOUT) {
+            while (enviados < saida.size()) {
+                const ssize_t n = ::send(descritor, saida.data() + enviados, saida.size() - enviados, MSG_NOSIGNAL);
+                if (n > 0) { enviados += static_cast<size_t>(n); continue; }
+                if (n < 0 && errno == EINTR) continue;
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+                throw erroSistema("Falha ao enviar ao servidor");
+            }
+            if (enviados == saida.size()) {
+                saida.clear();
+                enviados = 0;
+            }
+        }
+
+        if (evento.revents & (POLLIN | POLLHUP | POLLERR)) {
+            constexpr size_t BLOCO = 64 * 1024;
+            for (;;) {
+                const size_t anterior = entrada.size();
+                entrada.resize(anterior + BLOCO);
+                const ssize_t n = ::recv(descritor, entrada.data() + anterior, BLOCO, 0);
+                entrada.resize(anterior + (n > 0 ? static_cast<size_t>(n) : 0));
+                if (n > 0) continue;
+                if (n == 0) throw std::runtime_error("Servidor encerrou a conexão");
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                throw erroSistema("Falha ao receber do servidor");
+            }
+
+            const auto agora = Relogio::now();
+            for (;;) {
+                const size_t tamanho = tamanhoQuadroKv(entrada.data() + consumidos, entrada.size() - consumidos);
+                if (tamanho == 0) {
+                    break;
+                }
+                if (lotesRecebidos == lotesEnviados) {
+                    throw std::runtime_error("Resposta do servidor sem lote correspondente");
+                }
+                const LoteEmVoo& voo = janela[lotesRecebidos % config.profundidade];
+                const uint8_t* quadro = entrada.data() + consumidos;
+                validarResposta(quadro, tamanho, static_cast<uint32_t>(lotesRecebidos), voo.operacoes.size());
+                contabilizar(voo.operacoes, quadro + KV_BYTES_CABECALHO, medicao.contagem);
+                medicao.latenciasUs.push_back(std::chrono::duration<double, std::micro>(agora - voo.inicio).count());
+                medicao.contagem.operacoes += voo.operacoes.size();
+                ++medicao.contagem.lotes;
+                ++lotesRecebidos;
+                consumidos += tamanho;
+            }
+            entrada.erase(entrada.begin(), entrada.begin() + static_cast<std::ptrdiff_t>(consumidos));
+            consumidos = 0;
+        }
+    }
+}
+
+} // namespace
+
+void GeradorCarga::executar() {
+    RASTREAR_ESCOPO_DETALHE("carga", "carga", endereco.texto());
+
+    std::vector<SocketCliente> sockets(config.conexoes);
+    for (auto& socket : sockets) {
+        socket.descritor = conectarSocketKv(endereco);
+    }
+    preCarregar(sockets.front().descritor, config.chaves, config.lote);
+    for (const auto& socket : sockets) {
+        const int flags = ::fcntl(socket.descritor, F_GETFL, 0);
+        if (flags < 0 || ::fcntl(socket.descritor, F_SETFL, flags | O_NONBLOCK) != 0) {
+            throw erroSistema("Falha ao tornar o socket não bloqueante");
+        }
+    }
+
+    std::vector<MedicaoConexao> medicoes(config.conexoes);
+    std::vector<std::exception_ptr> erros(config.conexoes);
+    std::vector<std::thread> threads;
+    threads.reserve(config.conexoes);
+
+    const auto inicio = Relogio::now();
+    for (size_t c = 0; c < config.conexoes; ++c) {
+        // As primeiras conexões recebem o resto da divisão
+        const size_t operacoes = config.operacoes / config.conexoes + (c < config.operacoes % config.conexoes ? 1 : 0);
+        threads.emplace_back([&, c, operacoes] {
+            try {
+                if (operacoes > 0) {
+                    executarConexao(sockets[c].descritor, config, operacoes,
+                                    config.semente + static_cast<unsigned int>(c), medicoes[c]);
+                }
+            } catch (...) {
+                erros[c] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto fim = Relogio::now();
+    for (const auto& erro : erros) {
+        if (erro) std::rethrow_exception(erro);
+    }
+
+    resultado = ResultadoCarga{};
+    std::vector<double> latencias;
+    for (const auto& medicao : medicoes) {
+        const ResultadoCarga& c = medicao.contagem;
+        resultado.operacoes += c.operacoes;
+        resultado.lotes += c.lotes;
+        resultado.buscas += c.buscas;
+        resultado.acertos += c.acertos;
+        resultado.insercoes += c.insercoes;
+        resultado.insercoesNovas += c.insercoesNovas;
+        resultado.remocoes += c.remocoes;
+        resultado.remocoesEfetivas += c.remocoesEfetivas;
+        resultado.erros += c.erros;
+        latencias.insert(latencias.end(), medicao.latenciasUs.begin(), medicao.latenciasUs.end());
+    }
+    resultado.segundos = std::chrono::duration<double>(fim - inicio).count();
+    resultado.operacoesPorSegundo = resultado.operacoes / resultado.segundos;
+
+    std::sort(latencias.begin(), latencias.end());
+    double soma = 0.0;
+    for (double l : latencias) soma += l;
+    resultado.usMedio = soma / latencias.size();
+    resultado.usP50 = percentilOrdenado(latencias, 0.50);
+    resultado.usP90 = percentilOrdenado(latencias, 0.90);
+    resultado.usP99 = percentilOrdenado(latencias, 0.99);
+    resultado.usP999 = percentilOrdenado(latencias, 0.999);
+    resultado.usMaximo = latencias.back();
+}
+
+#else
+
+void GeradorCarga::executar() {
+    throw std::runtime_error("Modo servidor disponível apenas no Linux (epoll)");
+}
+
+#endif
+
+void GeradorCarga::imprimirRelatorio() const {
+    if (resultado.lotes == 0) {
+        std::cout << "Nenhum resultado de carga disponível." << std::endl;
+        return;
+    }
+    const ResultadoCarga& r = resultado;
+    auto taxa = [](size_t parte, size_t total) { return total ? 100.0 * parte / total : 0.0; };
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "CARGA EM " << endereco.texto() << " (" << config.conexoes << " conexões, "
+              << config.profundidade << " lotes em voo, " << config.lote << " operações/lote, "
+              << config.mistura.rotulo() << ")" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+
+    std::cout << std::left
+              << std::setw(13) << "Operações"
+              << std::setw(10) << "Lotes"
+              << std::setw(10) << "Tempo s"
+              << std::setw(14) << "Kops/s"
+              << std::setw(12) << "Média µs"
+              << std::setw(10) << "p50 µs"
+              << std::setw(10) << "p90 µs"
+              << std::setw(10) << "p99 µs"
+              << std::setw(12) << "p99,9 µs"
+              << "Máx µs" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << std::left << std::fixed
+              << std::setw(11) << r.operacoes
+              << std::setw(10) << r.lotes
+              << std::setw(10) << std::setprecision(3) << r.segundos
+              << std::setw(14) << std::setprecision(1) << r.operacoesPorSegundo / 1000.0
+              << std::setw(11) << r.usMedio
+              << std::setw(10) << r.usP50
+              << std::setw(10) << r.usP90
+              << std::setw(10) << r.usP99
+              << std::setw(12) << r.usP999
+              << r.usMaximo << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << std::setprecision(1)
+              << "GET: " << r.buscas << " (" << taxa(r.acertos, r.buscas) << "% presentes)  "
+              << "PUT: " << r.insercoes << " (" << taxa(r.insercoesNovas, r.insercoes) << "% novas)  "
+              << "DEL: " << r.remocoes << " (" << taxa(r.remocoesEfetivas, r.remocoes) << "% efetivas)  "
+              << "Erros: " << r.erros << std::endl;
+    std::cout << "Latência por lote, do envio à resposta completa (inclui a fila do pipelining)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+}
+
+void GeradorCarga::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream arq(arquivo);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+
+    arq << "Endereco,Conexoes,Profundidade,Lote,Mistura,Chaves,Operacoes,Lotes,Segundos,OperacoesPorSegundo,"
+        << "UsMedio,UsP50,UsP90,UsP99,UsP999,UsMaximo,Buscas,Acertos,Insercoes,InsercoesNovas,"
+        << "Remocoes,RemocoesEfetivas,Erros," << MetadadosExecucao::CABECALHO_CSV << "\n";
+
+    const ResultadoCarga& r = resultado;
+    arq << endereco.texto() << ","
+        << config.conexoes << ","
+        << config.profundidade << ","
+        << config.lote << ","
+        << config.mistura.rotulo() << ","
+        << config.chaves << ","
+        << r.operacoes << ","
+        << r.lotes << ","
+        << std::fixed << std::setprecision(4) << r.segundos << ","
+        << std::setprecision(1) << r.operacoesPorSegundo << ","
+        << std::setprecision(2) << r.usMedio << ","
+        << r.usP50 << ","
+        << r.usP90 << ","
+        << r.usP99 << ","
+        << r.usP999 << ","
+        << r.usMaximo << ","
+        << r.buscas << ","
+        << r.acertos << ","
+        << r.insercoes << ","
+        << r.insercoesNovas << ","
+        << r.remocoes << ","
+        << r.remocoesEfetivas << ","
+        << r.erros << "," << identificacao << "\n";
+
+    arq.close();
+    std::cout << "\nResultados da carga salvos em: " << arquivo << std::endl;
+}
@@ -0,0 +1,383 @@
+/**
+ * @file JuncaoHash.cpp
+ * @brief Implementação da junção hash particionada e sem particionamento
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "JuncaoHash.hpp"
+#include "DespachoCpu.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Relogio = std::chrono::high_resolution_clock;
+
+/// Linha das células vazias; por isso as colunas têm menos de 2^32 - 1 linhas
+constexpr uint32_t LINHA_VAZIA = std::numeric_limits<uint32_t>::max();
+
+/// Consultas cujas células são pré-buscadas antes de sondar
+constexpr size_t LOTE_SONDAGEM = 16;
+
+/// Chave e linha de origem: elemento das colunas particionadas e célula das tabelas
+struct Tupla {
+    int32_t chave;
+    uint32_t linha;
+};
+
+/// Misturador de 64 bits (finalizador do MurmurHash3): todos os bits dependem da chave
+inline uint64_t hashJuncao(int chave) {
+    uint64_t h = static_cast<uint32_t>(chave);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+size_t threadsEfetivas(size_t threads) {
+    return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+void validarLinhas(const std::vector<int>& construcao, const std::vector<int>& sonda) {
+    if (construcao.size() >= LINHA_VAZIA || sonda.size() >= LINHA_VAZIA) {
+        throw std::invalid_argument("Colunas da junção devem ter menos de 2^32 - 1 linhas");
+    }
+}
+
+/**
+ * @brief Executa funcao(t) para t em [0, threads), cada uma numa thread
+ *
+ * A primeira exceção de uma thread é relançada depois de todas terminarem.
+ */
+template<typename Funcao>
+void executarEmThreads(size_t threads, Funcao&& funcao) {
+    if (threads == 1) {
+        funcao(size_t{0});
+        return;
+    }
+    std::vector<std::exception_ptr> erros(threads);
+    std::vector<std::thread> trabalhadores;
+    trabalhadores.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        trabalhadores.emplace_back([&, t] {
+            try {
+                funcao(t);
+            } catch (...) {
+                erros[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& trabalhador : trabalhadores) {
+        trabalhador.join();
+    }
+    for (const auto& erro : erros) {
+        if (erro) {
+            std::rethrow_exception(erro);
+        }
+    }
+}
+
+/**
+ * @brief Primeira passagem: distribui a coluna pelos `bits` baixos do hash
+ * @param destino Recebe as tuplas agrupadas por partição
+ * @param inicios Recebe o início de cada partição em destino (e o total ao fim)
+ *
+ * Cada thread conta as partições da sua parte contígua da coluna; a soma
+ * de prefixos dá a cada thread uma faixa própria dentro de cada partição,
+ * e a distribuição é feita sem sincronização. A ordem das linhas dentro de
+ * uma partição segue a da coluna.
+ */
+void particionarColuna(const std::vector<int>& coluna, size_t bits, size_t threads, std::vector<Tupla>& destino,
+                       std::vector<size_t>& inicios) {
+    const size_t particoes = size_t{1} << bits;
+    const uint64_t mascara = particoes - 1;
+    const size_t n = coluna.size();
+    destino.resize(n);
+
+    std::vector<std::vector<size_t>> cursores(threads, std::vector<size_t>(particoes, 0));
+    executarEmThreads(threads, [&](size_t t) {
+        std::vector<size_t>& contagem = cursores[t];
+        for (size_t i = n * t / threads; i < n * (t + 1) / threads; ++i) {
+            ++contagem[hashJuncao(coluna[i]) & mascara];
+        }
+    });
+
+    inicios.assign(particoes + 1, n);
+    size_t posicao = 0;
+    for (size_t p = 0; p < particoes; ++p) {
+        inicios[p] = posicao;
+        for (size_t t = 0; t < threads; ++t) {
+            const size_t contagem = cursores[t][p];
+            cursores[t][p] = posicao;
+            posicao += contagem;
+        }
+    }
+
+    executarEmThreads(threads, [&](size_t t) {
+        std::vector<size_t>& cursor = cursores[t];
+        for (size_t i = n * t / threads; i < n * (t + 1) / threads; ++i) {
+            const int chave = coluna[i];
+            destino[cursor[hashJuncao(chave) & mascara]++] = Tupla{chave, static_cast<uint32_t>(i)};
+        }
+    });
+}
+
+/**
+ * @brief Segunda passagem: divide cada partição pelos `bits` seguintes do hash
+ * @param deslocamento Bits já usados pela primeira passagem
+ *
+ * As partições da primeira passagem são distribuídas entre as threads, e
+ * cada uma é dividida dentro da sua própria faixa, de modo que a partição
+ * final p1 * 2^bits + p2 ocupa posições contíguas.
+ */
+void subparticionar(const std::vector<Tupla>& origem, const std::vector<size_t>& iniciosOrigem, size_t deslocamento,
+                    size_t bits, size_t threads, std::vector<Tupla>& destino, std::vector<size_t>& inicios) {
+    const size_t particoesOrigem = iniciosOrigem.size() - 1;
+    const size_t subparticoes = size_t{1} << bits;
+    const uint64_t mascara = subparticoes - 1;
+    destino.resize(origem.size());
+    inicios.assign(particoesOrigem * subparticoes + 1, origem.size());
+
+    std::atomic<size_t> proxima{0};
+    executarEmThreads(threads, [&](size_t) {
+        std::vector<size_t> cursor(subparticoes);
+        for (size_t q = proxima.fetch_add(1); q < particoesOrigem; q = proxima.fetch_add(1)) {
+            std::fill(cursor.begin(), cursor.end(), 0);
+            for (size_t i = iniciosOrigem[q]; i < iniciosOrigem[q + 1]; ++i) {
+                ++cursor[(hashJuncao(origem[i].chave) >> deslocamento) & mascara];
+            }
+            size_t posicao = iniciosOrigem[q];
+            for (size_t s = 0; s < subparticoes; ++s) {
+                inicios[q * subparticoes + s] = posicao;
+                const size_t contagem = cursor[s];
+                cursor[s] = posicao;
+                posicao += contagem;
+            }
+            for (size_t i = iniciosOrigem[q]; i < iniciosOrigem[q + 1]; ++i) {
+                destino[cursor[(hashJuncao(origem[i].chave) >> deslocamento) & mascara]++] = origem[i];
+            }
+        }
+    });
+}
+
+/**
+ * @brief Tabela de sondagem linear com a linha de origem em cada célula
+ *
+ * Capacidade potência de 2 com fator de carga de no máximo 0,5. Os `bits`
+ * baixos do hash, que escolheram a partição, são descartados ao escolher a
+ * célula. Reutilizada entre as partições de uma thread.
+ */
+class TabelaJuncao {
+private:
+    std::vector<Tupla> celulas;
+    uint64_t mascara = 0;
+    size_t deslocamento = 0;
+
+    size_t posicao(int chave) const {
+        return static_cast<size_t>((hashJuncao(chave) >> deslocamento) & mascara);
+    }
+
+public:
+    /**
+     * @brief Carrega n tuplas, obtidas por tupla(i)
+     * @param bitsDescartados Bits de partição do hash
+     */
+    template<typename Acesso>
+    void construir(size_t n, Acesso&& tupla, size_t bitsDescartados) {
+        size_t capacidade = LOTE_SONDAGEM;
+        while (capacidade < 2 * n) {
+            capacidade <<= 1;
+        }
+        celulas.assign(capacidade, Tupla{0, LINHA_VAZIA});
+        mascara = capacidade - 1;
+        deslocamento = bitsDescartados;
+        for (size_t i = 0; i < n; ++i) {
+            const Tupla t = tupla(i);
+            size_t j = posicao(t.chave);
+            while (celulas[j].linha != LINHA_VAZIA) {
+                j = (j + 1) & mascara;
+            }
+            celulas[j] = t;
+        }
+    }
+
+    /**
+     * @brief Consulta n tuplas em lotes e chama emitir(linhaConstrucao, linhaSonda) a cada correspondência
+     */
+    template<typename Acesso, typename Emitir>
+    void sondarLote(size_t n, Acesso&& tupla, Emitir&& emitir) const {
+        size_t posicoes[LOTE_SONDAGEM];
+        for (size_t inicio = 0; inicio < n; inicio += LOTE_SONDAGEM) {
+            const size_t quantidade = std::min(LOTE_SONDAGEM, n - inicio);
+            for (size_t i = 0; i < quantidade; ++i) {
+                posicoes[i] = posicao(tupla(inicio + i).chave);
+                preBuscarLinha(&celulas[posicoes[i]]);
+            }
+            for (size_t i = 0; i < quantidade; ++i) {
+                const Tupla consulta = tupla(inicio + i);
+                for (size_t j = posicoes[i]; celulas[j].linha != LINHA_VAZIA; j = (j + 1) & mascara) {
+                    if (celulas[j].chave == consulta.chave) {
+                        emitir(celulas[j].linha, consulta.linha);
+                    }
+                }
+            }
+        }
+    }
+};
+
+/// Contagem e pares de uma thread
+struct ParcialJuncao {
+    uint64_t correspondencias = 0;
+    std::vector<ParJuncao> pares;
+};
+
+/// Soma as contagens e concatena os pares das threads
+void reunir(std::vector<ParcialJuncao>& parciais, bool emitirPares, ResultadoJuncao& resultado) {
+    size_t totalPares = 0;
+    for (const auto& parcial : parciais) {
+        resultado.correspondencias += parcial.correspondencias;
+        totalPares += parcial.pares.size();
+    }
+    if (!emitirPares) {
+        return;
+    }
+    resultado.pares.reserve(totalPares);
+    for (auto& parcial : parciais) {
+        resultado.pares.insert(resultado.pares.end(), parcial.pares.begin(), parcial.pares.end());
+        std::vector<ParJuncao>().swap(parcial.pares);
+    }
+}
+
+} // namespace
+
+size_t bitsParticao(size_t linhasConstrucao, const ConfiguracaoJuncao& config) {
+    if (config.bytesParticao == 0) {
+        throw std::invalid_argument("Tamanho das partições da junção deve ser positivo");
+    }
+    if (config.bitsRadix > 2 * BITS_POR_PASSAGEM) {
+        throw std::invalid_argument("Junção aceita no máximo " + std::to_string(2 * BITS_POR_PASSAGEM) +
+                                    " bits de partição");
+    }
+    if (config.bitsRadix != 0) {
+        return config.bitsRadix;
+    }
+    // Tabela de cada partição: duas células de 8 bytes por linha (carga 0,5)
+    const size_t bytesTabela = 2 * sizeof(Tupla) * linhasConstrucao;
+    const size_t threads = threadsEfetivas(config.threads);
+    size_t bits = 0;
+    while (bits < 2 * BITS_POR_PASSAGEM &&
+           ((bytesTabela >> bits) > config.bytesParticao || (size_t{1} << bits) < threads)) {
+        ++bits;
+    }
+    return bits;
+}
+
+ResultadoJuncao juntarParticionado(const std::vector<int>& construcao, const std::vector<int>& sonda,
+                                   bool emitirPares, const ConfiguracaoJuncao& config) {
+    validarLinhas(construcao, sonda);
+    const size_t threads = threadsEfetivas(config.threads);
+    const size_t bits = bitsParticao(construcao.size(), config);
+    RASTREAR_ESCOPO_DETALHE("juntarParticionado", "juncao", std::to_string(bits) + " bits");
+
+    ResultadoJuncao resultado;
+    resultado.particoes = size_t{1} << bits;
+    resultado.passagens = bits > BITS_POR_PASSAGEM ? 2 : 1;
+
+    // Partições finais; com duas passagens, a primeira usa metade dos bits (arredondada para cima)
+    std::vector<Tupla> construcaoParticionada;
+    std::vector<Tupla> sondaParticionada;
+    std::vector<size_t> iniciosConstrucao;
+    std::vector<size_t> iniciosSonda;
+    const auto inicioParticionamento = Relogio::now();
+    if (resultado.passagens == 1) {
+        particionarColuna(construcao, bits, threads, construcaoParticionada, iniciosConstrucao);
+        particionarColuna(sonda, bits, threads, sondaParticionada, iniciosSonda);
+    } else {
+        const size_t bitsPrimeira = (bits + 1) / 2;
+        std::vector<Tupla> intermediaria;
+        std::vector<size_t> iniciosIntermediaria;
+        particionarColuna(construcao, bitsPrimeira, threads, intermediaria, iniciosIntermediaria);
+        subparticionar(intermediaria, iniciosIntermediaria, bitsPrimeira, bits - bitsPrimeira, threads,
+                       construcaoParticionada, iniciosConstrucao);
+        particionarColuna(sonda, bitsPrimeira, threads, intermediaria, iniciosIntermediaria);
+        subparticionar(intermediaria, iniciosIntermediaria, bitsPrimeira, bits - bitsPrimeira, threads,
+                       sondaParticionada, iniciosSonda);
+    }
+    resultado.msParticionamento =
+        std::chrono::duration<double, std::milli>(Relogio::now() - inicioParticionamento).count();
+
+    // Cada thread toma a próxima partição livre, constrói a tabela dela e a sonda
+    std::vector<ParcialJuncao> parciais(threads);
+    std::atomic<size_t> proxima{0};
+    const auto inicioJuncao = Relogio::now();
+    executarEmThreads(threads, [&](size_t t) {
+        ParcialJuncao& parcial = parciais[t];
+        auto emitir = [&](uint32_t linhaConstrucao, uint32_t linhaSonda) {
+            ++parcial.correspondencias;
+            if (emitirPares) {
+                parcial.pares.push_back(ParJuncao{linhaConstrucao, linhaSonda});
+            }
+        };
+        TabelaJuncao tabela;
+        for (size_t p = proxima.fetch_add(1); p < resultado.particoes; p = proxima.fetch_add(1)) {
+            const Tupla* tuplasConstrucao = construcaoParticionada.data() + iniciosConstrucao[p];
+            const Tupla* tuplasSonda = sondaParticionada.data() + iniciosSonda[p];
+            const size_t linhasConstrucao = iniciosConstrucao[p + 1] - iniciosConstrucao[p];
+            const size_t linhasSonda = iniciosSonda[p + 1] - iniciosSonda[p];
+            if (linhasConstrucao == 0 || linhasSonda == 0) {
+                continue;
+            }
+            tabela.construir(linhasConstrucao, [&](size_t i) { return tuplasConstrucao[i]; }, bits);
+            tabela.sondarLote(linhasSonda, [&](size_t i) { return tuplasSonda[i]; }, emitir);
+        }
+    });
+    reunir(parciais, emitirPares, resultado);
+    resultado.msJuncao = std::chrono::duration<double, std::milli>(Relogio::now() - inicioJuncao).count();
+    return resultado;
+}
+
+ResultadoJuncao juntarSemParticao(const std::vector<int>& construcao, const std::vector<int>& sonda,
+                                  bool emitirPares, const ConfiguracaoJuncao& config) {
+    validarLinhas(construcao, sonda);
+    const size_t threads = threadsEfetivas(config.threads);
+    RASTREAR_ESCOPO_DETALHE("juntarSemParticao", "juncao", std::to_string(construcao.size()));
+
+    ResultadoJuncao resultado;
+    const auto inicio = Relogio::now();
+    TabelaJuncao tabela;
+    tabela.construir(construcao.size(), [&](size_t i) {
+        return Tupla{construcao[i], static_cast<uint32_t>(i)};
+    }, 0);
+
+    std::vector<ParcialJuncao> parciais(threads);
+    const size_t n = sonda.size();
+    executarEmThreads(threads, [&](size_t t) {
+        ParcialJuncao& parcial = parciais[t];
+        const size_t primeira = n * t / threads;
+        tabela.sondarLote(n * (t + 1) / threads - primeira, [&](size_t i) {
+            return Tupla{sonda[primeira + i], static_cast<uint32_t>(primeira + i)};
+        }, [&](uint32_t linhaConstrucao, uint32_t linhaSonda) {
+            ++parcial.correspondencias;
+            if (emitirPares) {
+                parcial.pares.push_back(ParJuncao{linhaConstrucao, linhaSonda});
+            }
+        });
+    });
+    reunir(parciais, emitirPares, resultado);
+    resultado.msJuncao = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+    return resultado;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file MedidorEnergia.cpp
+ * @brief Implementação da leitura dos contadores RAPL
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "MedidorEnergia.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+
+/**
+ * @brief Lê um arquivo do sysfs de uma linha só
+ * @param caminho Arquivo a ler
+ * @param conteudo Primeira linha, sem a quebra
+ * @return false se o arquivo não puder ser lido
+ */
+bool lerLinhaSysfs(const std::filesystem::path& caminho, std::string& conteudo) {
+    std::ifstream arquivo(caminho);
+    return arquivo.is_open() && static_cast<bool>(std::getline(arquivo, conteudo));
+}
+
+/**
+ * @brief Lê um contador inteiro do sysfs
+ * @return false se o arquivo não puder ser lido ou não for numérico
+ */
+bool lerContador(const std::filesystem::path& caminho, uint64_t& valor) {
+    std::string conteudo;
+    if (!lerLinhaSysfs(caminho, conteudo)) {
+        return false;
+    }
+    try {
+        valor = std::stoull(conteudo);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Percorre intel-rapl:N (pacotes) e intel-rapl:N:M com nome "dram"
+ *
+ * As demais subzonas (core, uncore) são partes do pacote e somá-las
+ * contaria a mesma energia duas vezes. O zone "psys" (plataforma) também
+ * fica de fora, pois já inclui pacote e DRAM.
+ */
+MedidorEnergia::MedidorEnergia(const std::string& raiz) {
+    namespace fs = std::filesystem;
+    std::error_code erro;
+    if (!fs::is_directory(raiz, erro)) {
+        motivo = raiz + " não existe (kernel sem powercap ou plataforma sem RAPL)";
+        return;
+    }
+
+    std::vector<fs::path> zonas;
+    for (const auto& entrada : fs::directory_iterator(raiz, erro)) {
+        const std::string nome = entrada.path().filename().string();
+        if (nome.rfind("intel-rapl:", 0) == 0) {
+            zonas.push_back(entrada.path());
+        }
+    }
+    std::sort(zonas.begin(), zonas.end());
+
+    bool semPermissao = false;
+    for (const auto& zona : zonas) {
+        std::string nome;
+        if (!lerLinhaSysfs(zona / "name", nome)) {
+            continue;
+        }
+        // intel-rapl:N tem um ':'; as subzonas intel-rapl:N:M têm dois
+        const std::string identificador = zona.filename().string();
+        const bool subzona = std::count(identificador.begin(), identificador.end(), ':') > 1;
+        const bool pacote = !subzona && nome.rfind("package", 0) == 0;
+        const bool dram = subzona && nome == "dram";
+        if (!pacote && !dram) {
+            continue;
+        }
+
+        Dominio dominio{(zona / "energy_uj").string(), dram, 0};
+        uint64_t valor = 0;
+        if (!lerContador(dominio.arquivo, valor)) {
+            semPermissao = true;
+            continue;
+        }
+        if (!lerContador(zona / "max_energy_range_uj", dominio.faixa)) {
+            dominio.faixa = 0;
+        }
+        dominios.push_back(dominio);
+    }
+
+    const bool temPacote = std::any_of(dominios.begin(), dominios.end(),
+                                       [](const Dominio& d) { return !d.dram; });
+    if (!temPacote) {
+        dominios.clear();
+        motivo = semPermissao
+            ? "sem permissão para ler energy_uj em " + raiz + " (requer root ou ajuste de permissão)"
+            : "nenhum domínio RAPL de pacote em " + raiz;
+    }
+}
+
+std::string MedidorEnergia::descricao() const {
+    const auto drams = std::count_if(dominios.begin(), dominios.end(),
+                                     [](const Dominio& d) { return d.dram; });
+    const auto pacotes = static_cast<long>(dominios.size()) - drams;
+    return std::to_string(pacotes) + " pacote(s), " + std::to_string(drams) + " DRAM";
+}
+
+MedidorEnergia::Leitura MedidorEnergia::ler() const {
+    Leitura leitura;
+    leitura.reserve(dominios.size());
+    for (const auto& dominio : dominios) {
+        uint64_t valor = 0;
+        if (!lerContador(dominio.arquivo, valor)) {
+            throw std::runtime_error("Falha ao ler contador de energia: " + dominio.arquivo);
+        }
+        leitura.push_back(valor);
+    }
+    return leitura;
+}
+
+ConsumoEnergia MedidorEnergia::consumo(const Leitura& inicio, const Leitura& fim) const {
+    ConsumoEnergia consumo;
+    const size_t n = std::min({dominios.size(), inicio.size(), fim.size()});
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t microjoules = fim[i] - inicio[i];
+        if (fim[i] < inicio[i]) {
+            // O contador voltou a zero ao atingir max_energy_range_uj
+            microjoules = dominios[i].faixa > inicio[i] ? dominios[i].faixa - inicio[i] + fim[i] : 0;
+        }
+        (dominios[i].dram ? consumo.dram : consumo.pacote) += microjoules * 1e-6;
+    }
+    return consumo;
+}
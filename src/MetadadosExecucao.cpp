@@ -0,0 +1,130 @@
+/**
+ * @file MetadadosExecucao.cpp
+ * @brief Implementação da coleta de metadados de execução
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "MetadadosExecucao.hpp"
+#include "DespachoCpu.hpp"
+#include "InfoBuild.hpp"
+
+#include <ctime>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/utsname.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Obtém o nome da máquina
+ * @return Nome da máquina ou "desconhecido"
+ */
+std::string obterHost() {
+#if defined(__unix__) || defined(__APPLE__)
+    char nome[256] = {};
+    if (gethostname(nome, sizeof(nome) - 1) == 0 && nome[0] != '\0') {
+        return nome;
+    }
+#else
+    if (const char* nome = std::getenv("COMPUTERNAME")) {
+        return nome;
+    }
+#endif
+    return "desconhecido";
+}
+
+/**
+ * @brief Formata o instante atual em UTC (ISO 8601)
+ * @return Texto como "2024-10-18T14:03:00Z"
+ */
+std::string obterDataHoraUTC() {
+    std::time_t agora = std::time(nullptr);
+    char buffer[32] = {};
+    if (const std::tm* utc = std::gmtime(&agora)) {
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", utc);
+    }
+    return buffer;
+}
+
+/**
+ * @brief Lê o modelo do processador
+ * @return Campo "model name" do /proc/cpuinfo ou "desconhecido"
+ */
+std::string obterModeloCpu() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string linha;
+    while (std::getline(cpuinfo, linha)) {
+        if (linha.rfind("model name", 0) == 0) {
+            size_t inicio = linha.find_first_not_of(" \t", linha.find(':') + 1);
+            if (inicio != std::string::npos) {
+                return linha.substr(inicio);
+            }
+        }
+    }
+    return "desconhecido";
+}
+
+/**
+ * @brief Lê o governador de frequência da cpu0
+ * @return Governador (ex.: "performance") ou "desconhecido" sem cpufreq
+ */
+std::string obterGovernador() {
+    std::ifstream arquivo("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    std::string governador;
+    if (arquivo.is_open()) {
+        std::getline(arquivo, governador);
+    }
+    return governador.empty() ? "desconhecido" : governador;
+}
+
+/**
+ * @brief Obtém o sistema operacional e a versão do kernel
+ * @return Texto como "Linux 6.1.0" ou "desconhecido"
+ */
+std::string obterKernel() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct utsname sistema;
+    if (uname(&sistema) == 0) {
+        return std::string(sistema.sysname) + " " + sistema.release;
+    }
+#endif
+    return "desconhecido";
+}
+
+} // namespace
+
+void MetadadosExecucao::imprimir(std::ostream& saida) const {
+    saida << "Revisão: " << revisaoGit << " (" << tipoBuild << ", " << compilador << ")\n"
+          << "Flags: " << flags << "\n"
+          << "CPU: " << modeloCpu << " | " << nucleos << " núcleo(s) | governador: " << governador
+          << " | ISA: " << isa << "\n"
+          << "Sistema: " << kernel << " | host: " << host << std::endl;
+}
+
+MetadadosExecucao coletarMetadadosExecucao() {
+    MetadadosExecucao metadados;
+    metadados.revisaoGit = ANALISE_HASH_REVISAO_GIT;
+    metadados.dataHora = obterDataHoraUTC();
+    metadados.host = obterHost();
+    metadados.modeloCpu = obterModeloCpu();
+    metadados.nucleos = std::thread::hardware_concurrency();
+    metadados.governador = obterGovernador();
+    metadados.isa = nomeIsa(kernelsSimd().nivel);
+    if (kernelsSimd().nivel != isaDetectada()) {
+        metadados.isa += std::string(" (detectada: ") + nomeIsa(isaDetectada()) + ")";
+    }
+    metadados.kernel = obterKernel();
+    metadados.compilador = ANALISE_HASH_COMPILADOR;
+    metadados.tipoBuild = ANALISE_HASH_TIPO_BUILD;
+    metadados.flags = ANALISE_HASH_FLAGS;
+    return metadados;
+}
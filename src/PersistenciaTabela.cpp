@@ -0,0 +1,432 @@
+/**
+ * @file PersistenciaTabela.cpp
+ * @brief Implementação do diário segmentado, dos snapshots e da recuperação
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "PersistenciaTabela.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define ANALISE_HASH_PERSISTENCIA
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char MAGICO_SNAPSHOT[8] = {'A', 'H', 'S', 'N', 'A', 'P', '0', '1'};
+constexpr size_t BYTES_CABECALHO_SNAPSHOT = 24;
+constexpr const char* PREFIXO_SEGMENTO = "diario.";
+constexpr size_t DIGITOS_SEGMENTO = 8;
+/// Buffer acima do qual os registros são gravados mesmo sem sincronizar
+constexpr size_t LIMITE_BUFFER = 64 * 1024;
+
+/// FNV-1a de 32 bits, continuando de um valor anterior
+uint32_t fnv1a(const uint8_t* dados, size_t n, uint32_t hash = 2166136261u) {
+    for (size_t i = 0; i < n; ++i) {
+        hash = (hash ^ dados[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void escreverU32(uint8_t* destino, uint32_t valor) {
+    for (int i = 0; i < 4; ++i) destino[i] = static_cast<uint8_t>(valor >> (8 * i));
+}
+
+void escreverU64(uint8_t* destino, uint64_t valor) {
+    for (int i = 0; i < 8; ++i) destino[i] = static_cast<uint8_t>(valor >> (8 * i));
+}
+
+uint32_t lerU32(const uint8_t* origem) {
+    uint32_t valor = 0;
+    for (int i = 0; i < 4; ++i) valor |= static_cast<uint32_t>(origem[i]) << (8 * i);
+    return valor;
+}
+
+uint64_t lerU64(const uint8_t* origem) {
+    uint64_t valor = 0;
+    for (int i = 0; i < 8; ++i) valor |= static_cast<uint64_t>(origem[i]) << (8 * i);
+    return valor;
+}
+
+/// Número do segmento a partir do nome "diario.NNNNNNNN" (false se não for um segmento)
+bool numeroSegmento(const std::string& nome, uint64_t& numero) {
+    const size_t prefixo = std::strlen(PREFIXO_SEGMENTO);
+    if (nome.size() != prefixo + DIGITOS_SEGMENTO || nome.compare(0, prefixo, PREFIXO_SEGMENTO) != 0) {
+        return false;
+    }
+    numero = 0;
+    for (size_t i = prefixo; i < nome.size(); ++i) {
+        if (nome[i] < '0' || nome[i] > '9') return false;
+        numero = numero * 10 + static_cast<uint64_t>(nome[i] - '0');
+    }
+    return true;
+}
+
+/// Lê o arquivo inteiro
+std::vector<uint8_t> lerArquivo(const fs::path& caminho) {
+    std::vector<uint8_t> dados(fs::file_size(caminho));
+    std::FILE* arquivo = std::fopen(caminho.string().c_str(), "rb");
+    if (arquivo == nullptr) {
+        throw std::runtime_error("Erro ao abrir arquivo: " + caminho.string());
+    }
+    const size_t lidos = dados.empty() ? 0 : std::fread(dados.data(), 1, dados.size(), arquivo);
+    std::fclose(arquivo);
+    if (lidos != dados.size()) {
+        throw std::runtime_error("Erro ao ler arquivo: " + caminho.string());
+    }
+    return dados;
+}
+
+#ifdef ANALISE_HASH_PERSISTENCIA
+
+std::runtime_error erroSistema(const std::string& contexto) {
+    return std::runtime_error(contexto + ": " + std::strerror(errno));
+}
+
+/// Grava todos os bytes, repetindo em escritas parciais
+void gravarTudo(int descritor, const uint8_t* dados, size_t n, const std::string& contexto) {
+    while (n > 0) {
+        const ssize_t gravados = ::write(descritor, dados, n);
+        if (gravados < 0) {
+            if (errno == EINTR) continue;
+            throw erroSistema(contexto);
+        }
+        dados += gravados;
+        n -= static_cast<size_t>(gravados);
+    }
+}
+
+/// Sincroniza apenas os dados (e o tamanho) do arquivo
+void sincronizarDados(int descritor, const std::string& contexto) {
+#if defined(__APPLE__)
+    const int resultado = ::fsync(descritor);
+#else
+    const int resultado = ::fdatasync(descritor);
+#endif
+    if (resultado != 0) {
+        throw erroSistema(contexto);
+    }
+}
+
+/// Torna duráveis criações, renomeações e remoções de arquivos no diretório
+void sincronizarDiretorio(const std::string& diretorio) {
+    const int descritor = ::open(diretorio.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descritor < 0) {
+        throw erroSistema("Erro ao abrir diretório " + diretorio);
+    }
+    const int resultado = ::fsync(descritor);
+    ::close(descritor);
+    if (resultado != 0) {
+        throw erroSistema("Erro ao sincronizar diretório " + diretorio);
+    }
+}
+
+#endif
+
+} // namespace
+
+PersistenciaTabela::PersistenciaTabela(const std::string& diretorioDados, const ConfiguracaoPersistencia& configuracao)
+    : diretorio(diretorioDados), config(configuracao) {
+#ifndef ANALISE_HASH_PERSISTENCIA
+    throw std::runtime_error("Persistência disponível apenas em sistemas POSIX");
+#endif
+    fs::create_directories(diretorio);
+    buffer.reserve(LIMITE_BUFFER + BYTES_REGISTRO);
+}
+
+std::string PersistenciaTabela::caminhoSegmento(uint64_t segmento) const {
+    std::ostringstream nome;
+    nome << PREFIXO_SEGMENTO << std::setw(DIGITOS_SEGMENTO) << std::setfill('0') << segmento;
+    return (fs::path(diretorio) / nome.str()).string();
+}
+
+#ifdef ANALISE_HASH_PERSISTENCIA
+
+PersistenciaTabela::~PersistenciaTabela() {
+    try {
+        aguardarSnapshot();
+        sincronizar();
+    } catch (const std::exception& e) {
+        std::cerr << "Aviso: persistência em " << diretorio << " não finalizada: " << e.what() << std::endl;
+    }
+    if (threadSnapshot.joinable()) {
+        threadSnapshot.join();
+    }
+    if (descritorDiario >= 0) {
+        ::close(descritorDiario);
+    }
+}
+
+void PersistenciaTabela::abrirSegmento(uint64_t segmento) {
+    const std::string caminho = caminhoSegmento(segmento);
+    const int descritor = ::open(caminho.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, 0644);
+    if (descritor < 0) {
+        throw erroSistema("Erro ao criar segmento do diário " + caminho);
+    }
+    if (descritorDiario >= 0) {
+        ::close(descritorDiario);
+    }
+    descritorDiario = descritor;
+    segmentoAtual = segmento;
+    sincronizarDiretorio(diretorio);
+}
+
+void PersistenciaTabela::gravarBuffer() {
+    if (buffer.empty()) {
+        return;
+    }
+    gravarTudo(descritorDiario, buffer.data(), buffer.size(), "Erro ao gravar o diário");
+    estatisticas.bytesDiario += buffer.size();
+    buffer.clear();
+}
+
+void PersistenciaTabela::recuperar(const Aplicar& aplicar) {
+    RASTREAR_ESCOPO_DETALHE("recuperar", "persistencia", diretorio);
+    const auto inicio = std::chrono::steady_clock::now();
+
+    // Snapshot interrompido antes do rename: o anterior continua valendo
+    fs::remove(fs::path(diretorio) / "snapshot.tmp");
+
+    uint64_t primeiroSegmento = 0;
+    const fs::path caminhoSnapshot = fs::path(diretorio) / "snapshot";
+    if (fs::exists(caminhoSnapshot)) {
+        const std::vector<uint8_t> dados = lerArquivo(caminhoSnapshot);
+        const uint64_t quantidade = dados.size() >= BYTES_CABECALHO_SNAPSHOT ? lerU64(dados.data() + 16) : 0;
+        if (dados.size() < BYTES_CABECALHO_SNAPSHOT + 4 ||
+            std::memcmp(dados.data(), MAGICO_SNAPSHOT, sizeof(MAGICO_SNAPSHOT)) != 0 ||
+            (dados.size() - BYTES_CABECALHO_SNAPSHOT - 4) / 4 != quantidade ||
+            (dados.size() - BYTES_CABECALHO_SNAPSHOT - 4) % 4 != 0) {
+            throw std::runtime_error("Snapshot inválido: " + caminhoSnapshot.string());
+        }
+        const uint8_t* chaves = dados.data() + BYTES_CABECALHO_SNAPSHOT;
+        if (fnv1a(chaves, quantidade * 4) != lerU32(chaves + quantidade * 4)) {
+            throw std::runtime_error("Verificação do snapshot não confere: " + caminhoSnapshot.string());
+        }
+        primeiroSegmento = lerU64(dados.data() + 8);
+        for (uint64_t i = 0; i < quantidade; ++i) {
+            aplicar(OperacaoDiario::INSERIR, static_cast<int32_t>(lerU32(chaves + 4 * i)));
+        }
+        estatisticas.chavesSnapshot = quantidade;
+    }
+
+    std::vector<uint64_t> segmentos;
+    for (const auto& entrada : fs::directory_iterator(diretorio)) {
+        uint64_t numero = 0;
+        if (entrada.is_regular_file() && numeroSegmento(entrada.path().filename().string(), numero)) {
+            segmentos.push_back(numero);
+        }
+    }
+    std::sort(segmentos.begin(), segmentos.end());
+
+    uint64_t proximoSegmento = primeiroSegmento;
+    for (uint64_t segmento : segmentos) {
+        const std::string caminho = caminhoSegmento(segmento);
+        if (segmento < primeiroSegmento) {
+            // Coberto pelo snapshot; sobrou de uma queda antes da limpeza
+            fs::remove(caminho);
+            continue;
+        }
+        const std::vector<uint8_t> dados = lerArquivo(caminho);
+        size_t validos = 0;
+        for (; validos + BYTES_REGISTRO <= dados.size(); validos += BYTES_REGISTRO) {
+            const uint8_t* registro = dados.data() + validos;
+            const uint8_t operacao = registro[0];
+            if ((operacao != static_cast<uint8_t>(OperacaoDiario::INSERIR) &&
+                 operacao != static_cast<uint8_t>(OperacaoDiario::REMOVER)) ||
+                fnv1a(registro, 5) != lerU32(registro + 5)) {
+                break;
+            }
+            aplicar(static_cast<OperacaoDiario>(operacao), static_cast<int32_t>(lerU32(registro + 1)));
+            ++estatisticas.registrosReaplicados;
+        }
+        if (validos < dados.size()) {
+            // Escrita interrompida: os registros seguintes nunca foram confirmados
+            fs::resize_file(caminho, validos);
+            estatisticas.bytesDescartados += dados.size() - validos;
+        }
+        proximoSegmento = segmento + 1;
+    }
+
+    abrirSegmento(proximoSegmento);
+    estatisticas.msRecuperacao =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+void PersistenciaTabela::registrar(OperacaoDiario operacao, int chave) {
+    if (descritorDiario < 0) {
+        throw std::logic_error("PersistenciaTabela::recuperar() deve preceder registrar()");
+    }
+    const size_t inicio = buffer.size();
+    buffer.resize(inicio + BYTES_REGISTRO);
+    uint8_t* registro = buffer.data() + inicio;
+    registro[0] = static_cast<uint8_t>(operacao);
+    escreverU32(registro + 1, static_cast<uint32_t>(chave));
+    escreverU32(registro + 5, fnv1a(registro, 5));
+    ++estatisticas.registros;
+    ++naoSincronizados;
+    ++mutacoesDesdeSnapshot;
+
+    if (config.registrosPorSincronizacao > 0 && naoSincronizados >= config.registrosPorSincronizacao) {
+        sincronizar();
+    } else if (config.registrosPorSincronizacao == 0 || buffer.size() >= LIMITE_BUFFER) {
+        // Sem fdatasync, cada registro vai logo ao SO: sobrevive à queda do processo
+        gravarBuffer();
+    }
+}
+
+void PersistenciaTabela::sincronizar() {
+    if (descritorDiario < 0) {
+        return;
+    }
+    gravarBuffer();
+    if (naoSincronizados > 0) {
+        sincronizarDados(descritorDiario, "Erro ao sincronizar o diário");
+        ++estatisticas.sincronizacoes;
+        naoSincronizados = 0;
+    }
+}
+
+bool PersistenciaTabela::snapshotDevido() {
+    if (threadSnapshot.joinable()) {
+        if (!snapshotConcluido.load(std::memory_order_acquire)) {
+            return false;
+        }
+        concluirSnapshot();
+    }
+    return config.mutacoesPorSnapshot > 0 && mutacoesDesdeSnapshot >= config.mutacoesPorSnapshot;
+}
+
+void PersistenciaTabela::iniciarSnapshot(std::vector<int> chaves) {
+    aguardarSnapshot();
+
+    // O segmento atual fica completo e durável; as mutações seguintes vão
+    // para um segmento que o snapshot não cobre
+    sincronizar();
+    abrirSegmento(segmentoAtual + 1);
+    mutacoesDesdeSnapshot = 0;
+
+    snapshotConcluido.store(false, std::memory_order_relaxed);
+    threadSnapshot = std::thread([this, chaves = std::move(chaves), seguinte = segmentoAtual]() mutable {
+        try {
+            gravarSnapshot(std::move(chaves), seguinte);
+        } catch (...) {
+            erroSnapshot = std::current_exception();
+        }
+        snapshotConcluido.store(true, std::memory_order_release);
+    });
+}
+
+void PersistenciaTabela::gravarSnapshot(std::vector<int> chaves, uint64_t primeiroSegmentoSeguinte) {
+    RASTREAR_ESCOPO_DETALHE("snapshot", "persistencia", std::to_string(chaves.size()));
+
+    const std::string temporario = (fs::path(diretorio) / "snapshot.tmp").string();
+    const int descritor = ::open(temporario.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (descritor < 0) {
+        throw erroSistema("Erro ao criar " + temporario);
+    }
+    try {
+        uint8_t cabecalho[BYTES_CABECALHO_SNAPSHOT];
+        std::memcpy(cabecalho, MAGICO_SNAPSHOT, sizeof(MAGICO_SNAPSHOT));
+        escreverU64(cabecalho + 8, primeiroSegmentoSeguinte);
+        escreverU64(cabecalho + 16, chaves.size());
+        gravarTudo(descritor, cabecalho, sizeof(cabecalho), "Erro ao gravar snapshot");
+
+        // Codifica em blocos para não duplicar o vetor de chaves na memória
+        constexpr size_t CHAVES_POR_BLOCO = 16384;
+        std::vector<uint8_t> bloco(CHAVES_POR_BLOCO * 4);
+        uint32_t verificacao = 2166136261u;
+        for (size_t i = 0; i < chaves.size(); i += CHAVES_POR_BLOCO) {
+            const size_t n = std::min(CHAVES_POR_BLOCO, chaves.size() - i);
+            for (size_t j = 0; j < n; ++j) {
+                escreverU32(bloco.data() + 4 * j, static_cast<uint32_t>(chaves[i + j]));
+            }
+            verificacao = fnv1a(bloco.data(), n * 4, verificacao);
+            gravarTudo(descritor, bloco.data(), n * 4, "Erro ao gravar snapshot");
+        }
+        uint8_t rodape[4];
+        escreverU32(rodape, verificacao);
+        gravarTudo(descritor, rodape, sizeof(rodape), "Erro ao gravar snapshot");
+        sincronizarDados(descritor, "Erro ao sincronizar snapshot");
+    } catch (...) {
+        ::close(descritor);
+        throw;
+    }
+    ::close(descritor);
+
+    fs::rename(temporario, fs::path(diretorio) / "snapshot");
+    sincronizarDiretorio(diretorio);
+    bytesSnapshotAtual = BYTES_CABECALHO_SNAPSHOT + chaves.size() * 4 + 4;
+
+    // Só depois do rename durável os segmentos cobertos podem sumir
+    segmentosApagadosAtual = 0;
+    for (const auto& entrada : fs::directory_iterator(diretorio)) {
+        uint64_t numero = 0;
+        if (numeroSegmento(entrada.path().filename().string(), numero) && numero < primeiroSegmentoSeguinte) {
+            fs::remove(entrada.path());
+            ++segmentosApagadosAtual;
+        }
+    }
+}
+
+void PersistenciaTabela::concluirSnapshot() {
+    threadSnapshot.join();
+    if (erroSnapshot) {
+        std::exception_ptr erro = erroSnapshot;
+        erroSnapshot = nullptr;
+        std::rethrow_exception(erro);
+    }
+    ++estatisticas.snapshots;
+    estatisticas.bytesSnapshots += bytesSnapshotAtual;
+    estatisticas.segmentosApagados += segmentosApagadosAtual;
+}
+
+void PersistenciaTabela::aguardarSnapshot() {
+    if (threadSnapshot.joinable()) {
+        concluirSnapshot();
+    }
+}
+
+#else
+
+PersistenciaTabela::~PersistenciaTabela() = default;
+
+void PersistenciaTabela::recuperar(const Aplicar&) {
+    throw std::runtime_error("Persistência disponível apenas em sistemas POSIX");
+}
+
+void PersistenciaTabela::registrar(OperacaoDiario, int) {
+    throw std::runtime_error("Persistência disponível apenas em sistemas POSIX");
+}
+
+void PersistenciaTabela::sincronizar() {}
+
+bool PersistenciaTabela::snapshotDevido() {
+    return false;
+}
+
+void PersistenciaTabela::iniciarSnapshot(std::vector<int>) {
+    throw std::runtime_error("Persistência disponível apenas em sistemas POSIX");
+}
+
+void PersistenciaTabela::aguardarSnapshot() {}
+
+#endif
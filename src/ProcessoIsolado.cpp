@@ -0,0 +1,152 @@
+/**
+ * @file ProcessoIsolado.cpp
+ * @brief Implementação da execução em processo filho
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ProcessoIsolado.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define ANALISE_HASH_FORK
+#endif
+
+#ifdef ANALISE_HASH_FORK
+
+namespace {
+
+/**
+ * @brief Escreve todo o texto no descritor, repetindo escritas parciais
+ * @return false se a escrita falhar (pai fechou o pipe)
+ */
+bool escreverTudo(int descritor, const std::string& texto) {
+    size_t enviados = 0;
+    while (enviados < texto.size()) {
+        const ssize_t n = ::write(descritor, texto.data() + enviados, texto.size() - enviados);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        enviados += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Lê o descritor até o fim do arquivo
+ * @throws std::runtime_error se a leitura falhar
+ */
+std::string lerTudo(int descritor) {
+    std::string texto;
+    char buffer[4096];
+    for (;;) {
+        const ssize_t n = ::read(descritor, buffer, sizeof(buffer));
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Falha ao ler do processo filho: ") + std::strerror(errno));
+        }
+        texto.append(buffer, static_cast<size_t>(n));
+    }
+    return texto;
+}
+
+} // namespace
+
+bool isolamentoDisponivel() {
+    return true;
+}
+
+std::string executarEmProcessoFilho(const std::function<std::string()>& tarefa) {
+    int descritores[2];
+    if (::pipe(descritores) != 0) {
+        throw std::runtime_error(std::string("Falha ao criar pipe: ") + std::strerror(errno));
+    }
+
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    const pid_t filho = ::fork();
+    if (filho < 0) {
+        const int erro = errno;
+        ::close(descritores[0]);
+        ::close(descritores[1]);
+        throw std::runtime_error(std::string("Falha no fork: ") + std::strerror(erro));
+    }
+
+    if (filho == 0) {
+        ::close(descritores[0]);
+        std::string resposta;
+        int codigo = 0;
+        try {
+            resposta = "OK\n" + tarefa();
+        } catch (const std::exception& e) {
+            resposta = std::string("ERRO\n") + e.what();
+            codigo = 1;
+        } catch (...) {
+            resposta = "ERRO\nexceção desconhecida";
+            codigo = 1;
+        }
+        if (!escreverTudo(descritores[1], resposta)) {
+            codigo = 2;
+        }
+        ::close(descritores[1]);
+        ::_exit(codigo);
+    }
+
+    ::close(descritores[1]);
+    std::string resposta;
+    try {
+        resposta = lerTudo(descritores[0]);
+    } catch (...) {
+        ::close(descritores[0]);
+        ::waitpid(filho, nullptr, 0);
+        throw;
+    }
+    ::close(descritores[0]);
+
+    int status = 0;
+    while (::waitpid(filho, &status, 0) < 0) {
+        if (errno != EINTR) {
+            throw std::runtime_error(std::string("Falha ao aguardar processo filho: ") + std::strerror(errno));
+        }
+    }
+
+    if (WIFSIGNALED(status)) {
+        throw std::runtime_error("Processo filho terminou pelo sinal " + std::to_string(WTERMSIG(status)) +
+                                 " (" + strsignal(WTERMSIG(status)) + ")");
+    }
+    if (resposta.rfind("OK\n", 0) == 0) {
+        return resposta.substr(3);
+    }
+    if (resposta.rfind("ERRO\n", 0) == 0) {
+        throw std::runtime_error(resposta.substr(5));
+    }
+    throw std::runtime_error("Processo filho terminou sem resposta (código " +
+                             std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1) + ")");
+}
+
+#else
+
+bool isolamentoDisponivel() {
+    return false;
+}
+
+std::string executarEmProcessoFilho(const std::function<std::string()>&) {
+    throw std::runtime_error("Isolamento por processo requer fork() (sistemas POSIX)");
+}
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file ProtocoloKv.cpp
+ * @brief Quadros do protocolo, endereços e sockets do modo servidor
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ProtocoloKv.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define ANALISE_HASH_SERVIDOR_KV
+#endif
+
+void anexarRequisicaoKv(std::vector<uint8_t>& buffer, uint32_t idLote, const ComandoKv* comandos, size_t n) {
+    if (n == 0 || n > KV_MAX_OPERACOES) {
+        throw std::invalid_argument("Lote deve ter entre 1 e " + std::to_string(KV_MAX_OPERACOES) + " operações");
+    }
+    const size_t inicio = buffer.size();
+    buffer.resize(inicio + KV_BYTES_CABECALHO + n * KV_BYTES_OPERACAO);
+    uint8_t* destino = buffer.data() + inicio;
+    escreverU32(destino, static_cast<uint32_t>(KV_BYTES_CABECALHO - KV_BYTES_COMPRIMENTO + n * KV_BYTES_OPERACAO));
+    escreverU32(destino + 4, idLote);
+    escreverU16(destino + 8, static_cast<uint16_t>(n));
+    destino += KV_BYTES_CABECALHO;
+    for (size_t i = 0; i < n; ++i, destino += KV_BYTES_OPERACAO) {
+        destino[0] = static_cast<uint8_t>(comandos[i].operacao);
+        escreverU32(destino + 1, static_cast<uint32_t>(comandos[i].chave));
+    }
+}
+
+void anexarRespostaKv(std::vector<uint8_t>& buffer, uint32_t idLote, const uint8_t* resultados, size_t n) {
+    const size_t inicio = buffer.size();
+    buffer.resize(inicio + KV_BYTES_CABECALHO + n);
+    uint8_t* destino = buffer.data() + inicio;
+    escreverU32(destino, static_cast<uint32_t>(KV_BYTES_CABECALHO - KV_BYTES_COMPRIMENTO + n));
+    escreverU32(destino + 4, idLote);
+    escreverU16(destino + 8, static_cast<uint16_t>(n));
+    std::memcpy(destino + KV_BYTES_CABECALHO, resultados, n);
+}
+
+EnderecoKv EnderecoKv::ler(const std::string& texto) {
+    EnderecoKv endereco;
+    if (texto.rfind("unix:", 0) == 0) {
+        endereco.tipo = Tipo::UNIX;
+        endereco.caminho = texto.substr(5);
+        if (endereco.caminho.empty()) {
+            throw std::invalid_argument("Caminho vazio em " + texto);
+        }
+        return endereco;
+    }
+    if (texto.rfind("tcp:", 0) == 0) {
+        const size_t separador = texto.rfind(':');
+        if (separador <= 4) {
+            throw std::invalid_argument("Esperado tcp:host:porta em " + texto);
+        }
+        endereco.tipo = Tipo::TCP;
+        endereco.host = texto.substr(4, separador - 4);
+        size_t pos = 0;
+        const std::string porta = texto.substr(separador + 1);
+        const unsigned long numero = std::stoul(porta, &pos);
+        if (pos != porta.size() || numero == 0 || numero > 65535) {
+            throw std::invalid_argument("Porta inválida em " + texto);
+        }
+        endereco.porta = static_cast<uint16_t>(numero);
+        return endereco;
+    }
+    throw std::invalid_argument("Endereço deve começar com unix: ou tcp: (" + texto + ")");
+}
+
+std::string EnderecoKv::texto() const {
+    return tipo == Tipo::UNIX ? "unix:" + caminho : "tcp:" + host + ":" + std::to_string(porta);
+}
+
+#ifdef ANALISE_HASH_SERVIDOR_KV
+
+namespace {
+
+/// Erro de sistema com a descrição do errno atual
+std::runtime_error erroSistema(const std::string& contexto) {
+    return std::runtime_error(contexto + ": " + std::strerror(errno));
+}
+
+sockaddr_un enderecoUnix(const EnderecoKv& endereco) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (endereco.caminho.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Caminho do socket longo demais: " + endereco.caminho);
+    }
+    std::memcpy(addr.sun_path, endereco.caminho.c_str(), endereco.caminho.size() + 1);
+    return addr;
+}
+
+sockaddr_in enderecoTcp(const EnderecoKv& endereco) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(endereco.porta);
+    const std::string host = endereco.host == "localhost" ? "127.0.0.1" : endereco.host;
+    if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        throw std::invalid_argument("Host IPv4 inválido: " + endereco.host);
+    }
+    return addr;
+}
+
+} // namespace
+
+bool servidorKvDisponivel() {
+    return true;
+}
+
+int abrirSocketEscutaKv(const EnderecoKv& endereco) {
+    const int familia = endereco.tipo == EnderecoKv::Tipo::UNIX ? AF_UNIX : AF_INET;
+    const int descritor = ::socket(familia, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (descritor < 0) {
+        throw erroSistema("Falha ao criar socket");
+    }
+
+    int resultado = 0;
+    if (endereco.tipo == EnderecoKv::Tipo::UNIX) {
+        const sockaddr_un addr = enderecoUnix(endereco);
+        struct stat info {};
+        if (::stat(endereco.caminho.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+            ::unlink(endereco.caminho.c_str());
+        }
+        resultado = ::bind(descritor, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    } else {
+        const int sim = 1;
+        ::setsockopt(descritor, SOL_SOCKET, SO_REUSEADDR, &sim, sizeof(sim));
+        const sockaddr_in addr = enderecoTcp(endereco);
+        resultado = ::bind(descritor, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    }
+    if (resultado != 0 || ::listen(descritor, SOMAXCONN) != 0) {
+        const auto erro = erroSistema("Falha ao escutar em " + endereco.texto());
+        ::close(descritor);
+        throw erro;
+    }
+    return descritor;
+}
+
+int conectarSocketKv(const EnderecoKv& endereco) {
+    const int familia = endereco.tipo == EnderecoKv::Tipo::UNIX ? AF_UNIX : AF_INET;
+    const int descritor = ::socket(familia, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descritor < 0) {
+        throw erroSistema("Falha ao criar socket");
+    }
+
+    int resultado = 0;
+    if (endereco.tipo == EnderecoKv::Tipo::UNIX) {
+        const sockaddr_un addr = enderecoUnix(endereco);
+        resultado = ::connect(descritor, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    } else {
+        const sockaddr_in addr = enderecoTcp(endereco);
+        resultado = ::connect(descritor, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+        if (resultado == 0) {
+            // Lotes pequenos seguem imediatamente, sem o atraso de Nagle
+            const int sim = 1;
+            ::setsockopt(descritor, IPPROTO_TCP, TCP_NODELAY, &sim, sizeof(sim));
+        }
+    }
+    if (resultado != 0) {
+        const auto erro = erroSistema("Falha ao conectar em " + endereco.texto());
+        ::close(descritor);
+        throw erro;
+    }
+    return descritor;
+}
+
+#else
+
+bool servidorKvDisponivel() {
+    return false;
+}
+
+int abrirSocketEscutaKv(const EnderecoKv&) {
+    throw std::runtime_error("Modo servidor disponível apenas no Linux (epoll)");
+}
+
+int conectarSocketKv(const EnderecoKv&) {
+    throw std::runtime_error("Modo servidor disponível apenas no Linux (epoll)");
+}
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file Rastreamento.cpp
+ * @brief Implementação do coletor de eventos trace-event
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "Rastreamento.hpp"
+#include "EscritorJson.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <iostream>
+
+std::atomic<bool> Rastreador::habilitado{false};
+
+Rastreador& Rastreador::instancia() {
+    static Rastreador rastreador;
+    return rastreador;
+}
+
+void Rastreador::iniciar() {
+    std::lock_guard<std::mutex> trava(mutexEventos);
+    origem = std::chrono::steady_clock::now();
+    eventos.clear();
+    eventos.reserve(4096);
+    habilitado.store(true, std::memory_order_relaxed);
+}
+
+uint32_t Rastreador::idThread() {
+    static std::atomic<uint32_t> proximo{1};
+    thread_local uint32_t id = proximo.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void Rastreador::registrar(Evento evento) {
+    std::lock_guard<std::mutex> trava(mutexEventos);
+    eventos.push_back(std::move(evento));
+}
+
+void Rastreador::instantaneo(const char* nome, const char* categoria, std::string detalhe) {
+    registrar({nome, categoria, 'i', agoraUs(), 0, idThread(), std::move(detalhe)});
+}
+
+/**
+ * @brief Grava o arquivo no formato JSON Object do trace-event
+ *
+ * Eventos instantâneos usam escopo de thread ("s":"t"). Todos os eventos
+ * pertencem ao mesmo processo (pid 1).
+ */
+void Rastreador::salvar(const std::string& arquivo) {
+    std::lock_guard<std::mutex> trava(mutexEventos);
+
+    EscritorJson json;
+    json.abrirObjeto().abrirArray("traceEvents");
+
+    // Metadado com o nome do processo exibido no visualizador
+    json.abrirObjeto()
+        .campo("name", "process_name").campo("ph", "M").campo("pid", 1).campo("tid", 0)
+        .abrirObjeto("args").campo("name", "analise_hash").fecharObjeto()
+        .fecharObjeto();
+
+    for (const auto& e : eventos) {
+        json.abrirObjeto()
+            .campo("name", e.nome)
+            .campo("cat", e.categoria)
+            .campo("ph", std::string(1, e.fase))
+            .campo("ts", e.inicioUs)
+            .campo("pid", 1)
+            .campo("tid", e.thread);
+        if (e.fase == 'X') {
+            json.campo("dur", e.duracaoUs);
+        } else {
+            json.campo("s", "t");
+        }
+        if (!e.detalhe.empty()) {
+            json.abrirObjeto("args").campo("detalhe", e.detalhe).fecharObjeto();
+        }
+        json.fecharObjeto();
+    }
+
+    json.fecharArray().campo("displayTimeUnit", "ms").fecharObjeto();
+
+    std::ofstream arq(arquivo);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    arq << json.str() << "\n";
+    arq.close();
+
+    std::cout << "Rastreamento salvo em: " << arquivo
+              << " (" << eventos.size() << " eventos)" << std::endl;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file RecursosMemoria.cpp
+ * @brief Implementação dos recursos de memória da comparação de alocadores
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "RecursosMemoria.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+void* RecursoContador::do_allocate(size_t bytes, size_t alinhamento) {
+    void* p = upstream->allocate(bytes, alinhamento);
+    bytesAtuais += bytes;
+    picoBytes = std::max(picoBytes, bytesAtuais);
+    ++alocacoes;
+    return p;
+}
+
+void RecursoContador::do_deallocate(void* p, size_t bytes, size_t alinhamento) {
+    upstream->deallocate(p, bytes, alinhamento);
+    bytesAtuais -= bytes;
+}
+
+RecursoSlab::RecursoSlab(size_t tamanho, size_t bytesPorSlab, std::pmr::memory_resource* origem)
+    : upstream(origem),
+      // O bloco precisa comportar o ponteiro da lista livre e manter o alinhamento
+      tamanhoBloco((std::max(tamanho, sizeof(BlocoLivre)) + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO),
+      bytesSlab(bytesPorSlab) {
+    if (bytesSlab < tamanhoBloco) {
+        throw std::invalid_argument("Slab menor que um bloco");
+    }
+}
+
+RecursoSlab::~RecursoSlab() {
+    for (void* slab : slabs) {
+        upstream->deallocate(slab, bytesSlab, ALINHAMENTO);
+    }
+}
+
+/**
+ * @brief Lista livre primeiro (reuso, boa para a cache), depois o slab atual
+ */
+void* RecursoSlab::do_allocate(size_t bytes, size_t alinhamento) {
+    if (!atendePorSlab(bytes, alinhamento)) {
+        return upstream->allocate(bytes, alinhamento);
+    }
+
+    if (livres != nullptr) {
+        BlocoLivre* bloco = livres;
+        livres = bloco->proximo;
+        return bloco;
+    }
+
+    if (static_cast<size_t>(fim - atual) < tamanhoBloco) {
+        // Reserva antes de alocar para não perder o slab se o push_back falhar
+        slabs.reserve(slabs.size() + 1);
+        atual = static_cast<char*>(upstream->allocate(bytesSlab, ALINHAMENTO));
+        fim = atual + bytesSlab;
+        slabs.push_back(atual);
+    }
+
+    void* bloco = atual;
+    atual += tamanhoBloco;
+    return bloco;
+}
+
+void RecursoSlab::do_deallocate(void* p, size_t bytes, size_t alinhamento) {
+    if (!atendePorSlab(bytes, alinhamento)) {
+        upstream->deallocate(p, bytes, alinhamento);
+        return;
+    }
+    auto* bloco = static_cast<BlocoLivre*>(p);
+    bloco->proximo = livres;
+    livres = bloco;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file SaidaResultados.cpp
+ * @brief Implementação da gravação incremental de resultados
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "SaidaResultados.hpp"
+#include "MetadadosExecucao.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <filesystem>
+
+namespace {
+
+/// Colunas medidas e derivadas (14 medidas/identificação + 3 contagens + 8
+/// derivadas + 2 sondagens medidas com as respectivas teóricas + modelo de
+/// sondagem + indicador de energia, 6 energias por fase e domínio e 3 J/Mop
+/// derivados)
+constexpr size_t COLUNAS_MEDIDAS = 40;
+
+/// Número de colunas do CSV: as medidas mais as 12 de MetadadosExecucao::CABECALHO_CSV
+constexpr size_t NUMERO_COLUNAS = COLUNAS_MEDIDAS + 12;
+
+/**
+ * @brief Divide uma linha CSV em campos, com aspas RFC 4180
+ * @param linha Linha sem quebra
+ * @param inicios Recebe a posição em linha onde começa cada campo
+ * @return Campos sem as aspas externas e com "" convertido em "
+ */
+std::vector<std::string> dividirCampos(const std::string& linha, std::vector<size_t>& inicios) {
+    std::vector<std::string> campos(1);
+    inicios.assign(1, 0);
+    bool citado = false;
+    for (size_t i = 0; i < linha.size(); ++i) {
+        const char c = linha[i];
+        if (citado) {
+            if (c != '"') {
+                campos.back() += c;
+            } else if (i + 1 < linha.size() && linha[i + 1] == '"') {
+                campos.back() += '"';
+                ++i;
+            } else {
+                citado = false;
+            }
+        } else if (c == '"') {
+            citado = true;
+        } else if (c == ',') {
+            campos.emplace_back();
+            inicios.push_back(i + 1);
+        } else {
+            campos.back() += c;
+        }
+    }
+    return campos;
+}
+
+} // namespace
+
+const std::string SaidaResultados::CABECALHO = std::string(
+    "TipoTabela,TamanhoTabela,QuantidadeDados,FuncaoHash,"
+    "TempoInsercao(ms),TempoBusca(ms),TempoBuscaFria(ms),Colisoes,FatorCarga,"
+    "Dataset,Mistura,TempoMistura(ms),Threads,Repeticao,"
+    "OpsInsercao,OpsBusca,OpsMistura,"
+    "NsInsercao,MopsInsercao,NsBusca,MopsBusca,NsBuscaFria,MopsBuscaFria,NsMistura,MopsMistura,"
+    "SondagemSucesso,SondagemSucessoTeorica,SondagemInsucesso,SondagemInsucessoTeorica,ModeloSondagem,"
+    "EnergiaMedida,JPacoteInsercao,JDramInsercao,JPacoteBusca,JDramBusca,JPacoteMistura,JDramMistura,"
+    "JPorMopInsercao,JPorMopBusca,JPorMopMistura,") + MetadadosExecucao::CABECALHO_CSV;
+
+void SaidaResultados::escreverLinha(std::ostream& saida, const ResultadoTeste& resultado) {
+    using R = ResultadoTeste;
+    saida << resultado.tipoTabela << ","
+          << resultado.tamanhoTabela << ","
+          << resultado.quantidadeDados << ","
+          << resultado.tipoFuncaoHash << ","
+          << std::fixed << std::setprecision(3) << resultado.tempoInsercao << ","
+          << std::setprecision(3) << resultado.tempoBusca << ","
+          << std::setprecision(3) << resultado.tempoBuscaFria << ","
+          << resultado.colisoes << ","
+          << std::setprecision(4) << resultado.fatorCarga << ","
+          << resultado.dataset << ","
+          << resultado.mistura << ","
+          << std::setprecision(3) << resultado.tempoMistura << ","
+          << resultado.threads << ","
+          << resultado.repeticao << ","
+          << resultado.operacoesInsercao << ","
+          << resultado.operacoesBusca << ","
+          << resultado.operacoesMistura << ","
+          << std::setprecision(2) << R::nsPorOperacao(resultado.tempoInsercao, resultado.operacoesInsercao) << ","
+          << std::setprecision(3) << R::mopsPorSegundo(resultado.tempoInsercao, resultado.operacoesInsercao) << ","
+          << std::setprecision(2) << R::nsPorOperacao(resultado.tempoBusca, resultado.operacoesBusca) << ","
+          << std::setprecision(3) << R::mopsPorSegundo(resultado.tempoBusca, resultado.operacoesBusca) << ","
+          << std::setprecision(2) << R::nsPorOperacao(resultado.tempoBuscaFria, resultado.operacoesBusca) << ","
+          << std::setprecision(3) << R::mopsPorSegundo(resultado.tempoBuscaFria, resultado.operacoesBusca) << ","
+          << std::setprecision(2) << R::nsPorOperacao(resultado.tempoMistura, resultado.operacoesMistura) << ","
+          << std::setprecision(3) << R::mopsPorSegundo(resultado.tempoMistura, resultado.operacoesMistura) << ","
+          << std::setprecision(4) << resultado.sondagemSucesso << ","
+          << resultado.sondagemSucessoTeorica() << ","
+          << resultado.sondagemInsucesso << ","
+          << resultado.sondagemInsucessoTeorica() << ","
+          << nomeModeloSondagem(resultado.modeloSondagem) << ","
+          << (resultado.energiaMedida ? 1 : 0) << ","
+          << std::setprecision(6) << resultado.energiaInsercao.pacote << ","
+          << resultado.energiaInsercao.dram << ","
+          << resultado.energiaBusca.pacote << ","
+          << resultado.energiaBusca.dram << ","
+          << resultado.energiaMistura.pacote << ","
+          << resultado.energiaMistura.dram << ","
+          << std::setprecision(4) << R::joulesPorMilhao(resultado.energiaInsercao, resultado.operacoesInsercao) << ","
+          << R::joulesPorMilhao(resultado.energiaBusca, resultado.operacoesBusca) << ","
+          << R::joulesPorMilhao(resultado.energiaMistura, resultado.operacoesMistura) << ",";
+    if (resultado.identificacao.empty()) {
+        saida << MetadadosExecucao{}.valoresCsv() << "\n";
+    } else {
+        saida << resultado.identificacao << "\n";
+    }
+}
+
+/**
+ * @brief Lê as colunas medidas; as derivadas são recalculadas ao escrever
+ *
+ * As colunas de metadados são copiadas como estão, com as aspas, para que
+ * a regravação ao retomar reproduza o texto original.
+ */
+bool SaidaResultados::lerLinha(const std::string& linha, ResultadoTeste& resultado) {
+    std::vector<size_t> inicios;
+    const std::vector<std::string> campos = dividirCampos(linha, inicios);
+    if (campos.size() != NUMERO_COLUNAS) {
+        return false;
+    }
+
+    try {
+        resultado.tipoTabela = campos[0];
+        resultado.tamanhoTabela = std::stoull(campos[1]);
+        resultado.quantidadeDados = std::stoull(campos[2]);
+        resultado.tipoFuncaoHash = campos[3];
+        resultado.tempoInsercao = std::stod(campos[4]);
+        resultado.tempoBusca = std::stod(campos[5]);
+        resultado.tempoBuscaFria = std::stod(campos[6]);
+        resultado.colisoes = std::stoull(campos[7]);
+        resultado.fatorCarga = std::stod(campos[8]);
+        resultado.dataset = campos[9];
+        resultado.mistura = campos[10];
+        resultado.tempoMistura = std::stod(campos[11]);
+        resultado.threads = std::stoull(campos[12]);
+        resultado.repeticao = std::stoull(campos[13]);
+        resultado.operacoesInsercao = std::stoull(campos[14]);
+        resultado.operacoesBusca = std::stoull(campos[15]);
+        resultado.operacoesMistura = std::stoull(campos[16]);
+        resultado.sondagemSucesso = std::stod(campos[25]);
+        resultado.sondagemInsucesso = std::stod(campos[27]);
+        resultado.modeloSondagem = lerModeloSondagem(campos[29]);
+        resultado.energiaMedida = campos[30] == "1";
+        resultado.energiaInsercao = {std::stod(campos[31]), std::stod(campos[32])};
+        resultado.energiaBusca = {std::stod(campos[33]), std::stod(campos[34])};
+        resultado.energiaMistura = {std::stod(campos[35]), std::stod(campos[36])};
+        std::stod(campos[COLUNAS_MEDIDAS - 1]);
+        std::stoul(campos[COLUNAS_MEDIDAS]);   // Semente
+        resultado.identificacao = linha.substr(inicios[COLUNAS_MEDIDAS]);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Ao retomar, regrava o arquivo só com as linhas válidas
+ *
+ * A regravação usa um arquivo temporário renomeado sobre o original, de
+ * modo que uma falha durante a própria retomada não perde resultados.
+ */
+void SaidaResultados::abrir(const std::string& arquivo, bool retomar) {
+    nomeArquivo = arquivo;
+    concluidos.clear();
+    retomados.clear();
+
+    if (retomar && std::filesystem::exists(arquivo)) {
+        std::ifstream entrada(arquivo);
+        std::string linha;
+        std::getline(entrada, linha);
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        if (linha != CABECALHO) {
+            throw std::runtime_error("Não é possível retomar " + arquivo +
+                                     ": cabeçalho de outra versão do programa");
+        }
+
+        size_t descartadas = 0;
+        while (std::getline(entrada, linha)) {
+            // Sem quebra de linha final, a gravação foi interrompida no meio
+            const bool completa = !entrada.eof();
+            if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+            ResultadoTeste resultado;
+            if (!completa || !lerLinha(linha, resultado)) {
+                ++descartadas;
+                continue;
+            }
+            if (concluidos.insert(resultado.chaveCenario()).second) {
+                retomados.push_back(resultado);
+            }
+        }
+        entrada.close();
+
+        const std::string temporario = arquivo + ".tmp";
+        {
+            std::ofstream regravado(temporario);
+            if (!regravado.is_open()) {
+                throw std::runtime_error("Erro ao criar arquivo: " + temporario);
+            }
+            regravado << CABECALHO << "\n";
+            for (const auto& resultado : retomados) {
+                escreverLinha(regravado, resultado);
+            }
+        }
+        std::filesystem::rename(temporario, arquivo);
+
+        std::cout << "Retomando " << arquivo << ": " << retomados.size() << " cenário(s) concluído(s)";
+        if (descartadas > 0) {
+            std::cout << ", " << descartadas << " linha(s) incompleta(s) descartada(s)";
+        }
+        std::cout << std::endl;
+
+        saida.open(arquivo, std::ios::app);
+    } else {
+        saida.open(arquivo, std::ios::trunc);
+        if (saida.is_open()) {
+            saida << CABECALHO << "\n";
+            saida.flush();
+        }
+    }
+
+    if (!saida.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+}
+
+void SaidaResultados::registrar(const ResultadoTeste& resultado) {
+    if (!saida.is_open()) {
+        return;
+    }
+    escreverLinha(saida, resultado);
+    saida.flush();
+    concluidos.insert(resultado.chaveCenario());
+}
+
+void SaidaResultados::fechar() {
+    if (saida.is_open()) {
+        saida.close();
+        std::cout << "\nResultados salvos em: " << nomeArquivo << std::endl;
+    }
+}
+
+std::vector<ResultadoTeste> SaidaResultados::lerArquivo(const std::string& arquivo) {
+    std::ifstream entrada(arquivo);
+    if (!entrada.is_open()) {
+        throw std::runtime_error("Erro ao abrir resultados: " + arquivo);
+    }
+    std::string linha;
+    std::getline(entrada, linha);
+    if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+    if (linha != CABECALHO) {
+        throw std::runtime_error("Cabeçalho de outra versão do programa em " + arquivo);
+    }
+
+    std::vector<ResultadoTeste> resultados;
+    while (std::getline(entrada, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        ResultadoTeste resultado;
+        if (lerLinha(linha, resultado)) {
+            resultados.push_back(resultado);
+        }
+    }
+    return resultados;
+}
@@ -0,0 +1,408 @@
+/**
+ * @file ServidorTabela.cpp
+ * @brief Implementação do servidor de tabela por epoll
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "ServidorTabela.hpp"
+#include "RegistroMotores.hpp"
+#include "Rastreamento.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__linux__)
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define ANALISE_HASH_SERVIDOR_KV
+#endif
+
+namespace {
+
+#ifdef ANALISE_HASH_SERVIDOR_KV
+std::runtime_error erroSistema(const std::string& contexto) {
+    return std::runtime_error(contexto + ": " + std::strerror(errno));
+}
+#endif
+
+/**
+ * @brief Motor concreto: as operações do lote chamam o tipo diretamente
+ */
+template<typename Tabela>
+class MotorServidoTipo : public ServidorTabela::MotorServido {
+private:
+    Tabela tabela;
+    typename Tabela::TipoHash tipo;
+
+public:
+    MotorServidoTipo(size_t tamanho, typename Tabela::TipoHash tipoHash) : tabela(tamanho), tipo(tipoHash) {}
+
+    void processar(const uint8_t* operacoes, size_t n, uint8_t* resultados) override {
+        for (size_t i = 0; i < n; ++i, operacoes += KV_BYTES_OPERACAO) {
+            const int chave = static_cast<int32_t>(lerU32(operacoes + 1));
+            ResultadoKv resultado = ResultadoKv::ERRO;
+            switch (static_cast<OperacaoKv>(operacoes[0])) {
+                case OperacaoKv::GET:
+                    resultado = tabela.buscar(chave, tipo) ? ResultadoKv::SIM : ResultadoKv::NAO;
+                    break;
+                case OperacaoKv::PUT: {
+                    // Os motores não informam se a chave era nova; a contagem sim
+                    const size_t antes = tabela.getNumElementos();
+                    try {
+                        tabela.inserir(chave, tipo);
+                        resultado = tabela.getNumElementos() > antes ? ResultadoKv::SIM : ResultadoKv::NAO;
+                    } catch (const std::runtime_error&) {
+                        resultado = ResultadoKv::ERRO;  // Fator de carga acima do limite do motor
+                    }
+                    break;
+                }
+                case OperacaoKv::DEL:
+                    resultado = tabela.remover(chave, tipo) ? ResultadoKv::SIM : ResultadoKv::NAO;
+                    break;
+            }
+            resultados[i] = static_cast<uint8_t>(resultado);
+        }
+    }
+
+    size_t getNumElementos() const override {
+        return tabela.getNumElementos();
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Estado de uma conexão: bytes recebidos ainda não processados e
+ *        respostas ainda não enviadas
+ */
+struct ServidorTabela::Conexao {
+    int descritor = -1;
+    std::vector<uint8_t> entrada;
+    std::vector<uint8_t> saida;
+    size_t enviados = 0;            ///< Prefixo de saida já enviado
+    uint32_t eventos = 0;           ///< Eventos registrados no epoll
+    bool fimEntrada = false;        ///< Cliente fechou a escrita (shutdown ou close)
+
+    /// Bytes de resposta ainda não enviados
+    size_t pendentes() const { return saida.size() - enviados; }
+};
+
+ServidorTabela::ServidorTabela(const EnderecoKv& enderecoEscuta, const std::string& nomeMotor,
+                               const std::string& nomeHash, size_t tamanho)
+    : endereco(enderecoEscuta) {
+    if (nomeHash != "Divisao" && nomeHash != "Multiplicacao") {
+        throw std::invalid_argument("Função hash desconhecida: " + nomeHash + " (use Divisao ou Multiplicacao)");
+    }
+    const bool multiplicacao = nomeHash == "Multiplicacao";
+    const bool encontrado = visitarMotor(nomeMotor, [&](const auto& registrado) {
+        using Tabela = typename std::decay_t<decltype(registrado)>::Tabela;
+        motor = std::make_unique<MotorServidoTipo<Tabela>>(
+            tamanho, multiplicacao ? Tabela::TipoHash::MULTIPLICACAO : Tabela::TipoHash::DIVISAO);
+    });
+    if (!encontrado) {
+        throw std::invalid_argument("Motor desconhecido: " + nomeMotor);
+    }
+    descricaoMotor = nomeMotor + "/" + nomeHash + "/" + std::to_string(tamanho);
+    descritorEscuta = abrirSocketEscutaKv(endereco);
+#ifdef ANALISE_HASH_SERVIDOR_KV
+    // Criado aqui para que parar() funcione mesmo antes de executar()
+    descritorParada = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (descritorParada < 0) {
+        const auto erro = erroSistema("Falha ao criar eventfd");
+        ::close(descritorEscuta);
+        throw erro;
+    }
+#endif
+}
+
+#ifdef ANALISE_HASH_SERVIDOR_KV
+
+namespace {
+
+/// Registra ou altera os eventos de um descritor no epoll
+void registrarEventos(int epoll, int operacao, int descritor, uint32_t eventos) {
+    epoll_event evento{};
+    evento.events = eventos;
+    evento.data.fd = descritor;
+    if (::epoll_ctl(epoll, operacao, descritor, &evento) != 0) {
+        throw erroSistema("Falha no epoll_ctl");
+    }
+}
+
+} // namespace
+
+ServidorTabela::~ServidorTabela() {
+    if (descritorEscuta >= 0) {
+        ::close(descritorEscuta);
+        if (endereco.tipo == EnderecoKv::Tipo::UNIX) {
+            ::unlink(endereco.caminho.c_str());
+        }
+    }
+    if (descritorParada >= 0) {
+        ::close(descritorParada);
+    }
+}
+
+void ServidorTabela::aceitarConexoes(int epoll, std::unordered_map<int, Conexao>& conexoes) {
+    for (;;) {
+        const int descritor = ::accept4(descritorEscuta, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (descritor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            throw erroSistema("Falha ao aceitar conexão");
+        }
+        Conexao& conexao = conexoes[descritor];
+        conexao.descritor = descritor;
+        conexao.eventos = EPOLLIN;
+        registrarEventos(epoll, EPOLL_CTL_ADD, descritor, conexao.eventos);
+        ++estatisticas.conexoesAceitas;
+    }
+}
+
+/**
+ * @brief Lê o que estiver disponível, até LIMITE_SAIDA bytes não processados
+ * @return false se houve erro; o fim da entrada marca fimEntrada
+ *
+ * O restante fica no socket: com disparo por nível, o epoll volta a
+ * indicar a conexão legível no próximo ciclo.
+ */
+bool ServidorTabela::lerConexao(Conexao& conexao) {
+    constexpr size_t BLOCO = 64 * 1024;
+    while (conexao.entrada.size() < LIMITE_SAIDA) {
+        const size_t tamanhoAnterior = conexao.entrada.size();
+        conexao.entrada.resize(tamanhoAnterior + BLOCO);
+        const ssize_t n = ::recv(conexao.descritor, conexao.entrada.data() + tamanhoAnterior, BLOCO, 0);
+        conexao.entrada.resize(tamanhoAnterior + (n > 0 ? static_cast<size_t>(n) : 0));
+        if (n > 0) continue;
+        if (n == 0) {
+            conexao.fimEntrada = true;
+            return true;
+        }
+        if (errno == EINTR) continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    return true;
+}
+
+/**
+ * @brief Processa os quadros completos da entrada, em ordem, até a saída
+ *        pendente alcançar LIMITE_SAIDA
+ * @return false se algum quadro for malformado
+ */
+bool ServidorTabela::processarQuadros(Conexao& conexao) {
+    size_t consumidos = 0;
+    while (conexao.pendentes() < LIMITE_SAIDA) {
+        const uint8_t* quadro = conexao.entrada.data() + consumidos;
+        const size_t disponiveis = conexao.entrada.size() - consumidos;
+        if (disponiveis >= KV_BYTES_COMPRIMENTO &&
+            lerU32(quadro) > KV_BYTES_CABECALHO - KV_BYTES_COMPRIMENTO + KV_MAX_OPERACOES * KV_BYTES_OPERACAO) {
+            return false;  // Comprimento impossível: não espera o resto
+        }
+        const size_t tamanho = tamanhoQuadroKv(quadro, disponiveis);
+        if (tamanho == 0) {
+            break;
+        }
+        if (tamanho < KV_BYTES_CABECALHO) {
+            return false;
+        }
+        const uint32_t idLote = lerU32(quadro + 4);
+        const size_t n = lerU16(quadro + 8);
+        if (tamanho != KV_BYTES_CABECALHO + n * KV_BYTES_OPERACAO) {
+            return false;
+        }
+
+        resultadosLote.resize(n);
+        motor->processar(quadro + KV_BYTES_CABECALHO, n, resultadosLote.data());
+        anexarRespostaKv(conexao.saida, idLote, resultadosLote.data(), n);
+        consumidos += tamanho;
+        ++estatisticas.lotes;
+        estatisticas.operacoes += n;
+    }
+    conexao.entrada.erase(conexao.entrada.begin(), conexao.entrada.begin() + static_cast<std::ptrdiff_t>(consumidos));
+    return true;
+}
+
+/**
+ * @brief Envia o quanto o socket aceitar da saída pendente
+ * @return false se a conexão falhou
+ */
+bool ServidorTabela::enviarSaida(Conexao& conexao) {
+    while (conexao.enviados < conexao.saida.size()) {
+        const ssize_t n = ::send(conexao.descritor, conexao.saida.data() + conexao.enviados,
+                                 conexao.saida.size() - conexao.enviados, MSG_NOSIGNAL);
+        if (n > 0) {
+            conexao.enviados += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    if (conexao.enviados == conexao.saida.size()) {
+        conexao.saida.clear();
+        conexao.enviados = 0;
+    }
+    return true;
+}
+
+void ServidorTabela::executar(bool tratarSinais) {
+    RASTREAR_ESCOPO_DETALHE("servidor", "servidor", descricaoMotor);
+
+    struct Descritor {
+        int valor;
+        ~Descritor() { if (valor >= 0) ::close(valor); }
+    };
+
+    const Descritor epoll{::epoll_create1(EPOLL_CLOEXEC)};
+    if (epoll.valor < 0) {
+        throw erroSistema("Falha ao criar epoll");
+    }
+    registrarEventos(epoll.valor, EPOLL_CTL_ADD, descritorEscuta, EPOLLIN);
+    registrarEventos(epoll.valor, EPOLL_CTL_ADD, descritorParada, EPOLLIN);
+
+    // SIGINT/SIGTERM chegam como eventos, e não interrompem o laço no meio de um lote
+    sigset_t sinais, mascaraAnterior;
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGINT);
+    sigaddset(&sinais, SIGTERM);
+    Descritor descritorSinais{-1};
+    if (tratarSinais) {
+        ::pthread_sigmask(SIG_BLOCK, &sinais, &mascaraAnterior);
+        descritorSinais.valor = ::signalfd(-1, &sinais, SFD_NONBLOCK | SFD_CLOEXEC);
+        if (descritorSinais.valor < 0) {
+            ::pthread_sigmask(SIG_SETMASK, &mascaraAnterior, nullptr);
+            throw erroSistema("Falha ao criar signalfd");
+        }
+        registrarEventos(epoll.valor, EPOLL_CTL_ADD, descritorSinais.valor, EPOLLIN);
+    }
+
+    std::unordered_map<int, Conexao> conexoes;
+    auto fechar = [&](int descritor) {
+        ::epoll_ctl(epoll.valor, EPOLL_CTL_DEL, descritor, nullptr);
+        ::close(descritor);
+        conexoes.erase(descritor);
+    };
+
+    auto encerrar = [&] {
+        for (const auto& [descritor, conexao] : conexoes) {
+            ::close(descritor);
+        }
+        conexoes.clear();
+        if (tratarSinais) {
+            ::pthread_sigmask(SIG_SETMASK, &mascaraAnterior, nullptr);
+        }
+    };
+
+    std::vector<epoll_event> eventos(256);
+    bool executando = true;
+    try {
+        while (executando) {
+            const int prontos = ::epoll_wait(epoll.valor, eventos.data(), static_cast<int>(eventos.size()), -1);
+            if (prontos < 0) {
+                if (errno == EINTR) continue;
+                throw erroSistema("Falha no epoll_wait");
+            }
+
+            for (int i = 0; i < prontos; ++i) {
+                const int descritor = eventos[i].data.fd;
+                const uint32_t ocorridos = eventos[i].events;
+                if (descritor == descritorEscuta) {
+                    aceitarConexoes(epoll.valor, conexoes);
+                    continue;
+                }
+                if (descritor == descritorSinais.valor) {
+                    // Consome o sinal: pendente, ele encerraria o processo ao restaurar a máscara
+                    signalfd_siginfo info;
+                    while (::read(descritorSinais.valor, &info, sizeof(info)) > 0) {
+                    }
+                    executando = false;
+                    continue;
+                }
+                if (descritor == descritorParada) {
+                    executando = false;
+                    continue;
+                }
+
+                const auto encontrada = conexoes.find(descritor);
+                if (encontrada == conexoes.end()) {
+                    continue;  // Fechada por um evento anterior do mesmo ciclo
+                }
+                Conexao& conexao = encontrada->second;
+
+                bool ativa = true;
+                if ((ocorridos & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !conexao.fimEntrada &&
+                    conexao.pendentes() < LIMITE_SAIDA) {
+                    ativa = lerConexao(conexao);
+                }
+                // Quadros retidos pelo limite da saída são processados à medida que ela esvazia
+                while (ativa) {
+                    if (!processarQuadros(conexao)) {
+                        ++estatisticas.errosProtocolo;
+                        ativa = false;
+                        break;
+                    }
+                    const bool retidos = conexao.pendentes() >= LIMITE_SAIDA;
+                    if (conexao.pendentes() > 0) {
+                        ativa = enviarSaida(conexao);
+                    }
+                    if (!retidos || conexao.pendentes() > 0) {
+                        break;
+                    }
+                }
+                // Cliente fechou a escrita: envia as respostas restantes antes de fechar
+                if (!ativa || (conexao.fimEntrada && conexao.pendentes() == 0)) {
+                    fechar(descritor);
+                    continue;
+                }
+
+                // Escrita pendente: espera EPOLLOUT; saída acumulada demais ou fim da entrada: para de ler
+                const size_t pendentes = conexao.pendentes();
+                const uint32_t desejados = (pendentes > 0 ? EPOLLOUT : 0u) |
+                                           (pendentes < LIMITE_SAIDA && !conexao.fimEntrada ? EPOLLIN : 0u);
+                if (desejados != conexao.eventos) {
+                    conexao.eventos = desejados;
+                    registrarEventos(epoll.valor, EPOLL_CTL_MOD, descritor, desejados);
+                }
+            }
+        }
+    } catch (...) {
+        encerrar();
+        throw;
+    }
+    encerrar();
+
+    // Consome o pedido de parada para que o servidor possa ser executado de novo
+    uint64_t contador = 0;
+    while (::read(descritorParada, &contador, sizeof(contador)) > 0) {
+    }
+}
+
+void ServidorTabela::parar() {
+    if (descritorParada >= 0) {
+        const uint64_t um = 1;
+        while (::write(descritorParada, &um, sizeof(um)) < 0 && errno == EINTR) {
+        }
+    }
+}
+
+#else
+
+ServidorTabela::~ServidorTabela() = default;
+
+void ServidorTabela::executar(bool) {
+    throw std::runtime_error("Modo servidor disponível apenas no Linux (epoll)");
+}
+
+void ServidorTabela::parar() {}
+
+#endif
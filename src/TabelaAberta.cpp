@@ -13,6 +13,8 @@
  */
 
 #include "TabelaAberta.hpp"
+#include "DespachoCpu.hpp"
+#include "Rastreamento.hpp"
 #include <algorithm>
 
 /**
@@ -25,6 +27,10 @@
  * - Inserção: Procura célula VAZIA ou REMOVIDA
  * - Busca: Para em célula VAZIA (não existe) ou encontra o valor
  * 
+ * A varredura é feita pelo kernel sondarCelulas (DespachoCpu.hpp), que
+ * compara várias células por instrução, em duas faixas: do índice inicial
+ * ao fim da tabela e, no contorno, do início até o índice inicial.
+ * 
  * @param indiceInicial Índice calculado pela função hash
  * @param valor Valor sendo manipulado
  * @param paraInsercao Flag indicando o tipo de operação
@@ -33,40 +39,22 @@
  * @complexity O(1) média, O(n) no pior caso devido ao clustering
  */
 size_t TabelaAberta::sondagemLinear(size_t indiceInicial, int valor, bool paraInsercao) const {
-    size_t tentativas = 0;
-    size_t indice = indiceInicial;
-    
-    // Continua sondagem até encontrar posição adequada ou esgotar tentativas
-    while (tentativas < tamanho) {
-        const Celula& celula = tabela[indice];
-        
-        if (paraInsercao) {
-            // Para inserção: aceita posições VAZIA ou REMOVIDA
-            if (celula.disponivelParaInsercao()) {
-                return indice;
-            }
-            // Verifica duplicata: se célula ocupada contém o mesmo valor
-            if (celula.estado == Celula::Estado::OCUPADO && celula.valor == valor) {
-                return indice; // Retorna posição para tratamento de duplicata
-            }
-        } else {
-            // Para busca: para em célula VAZIA (elemento não existe)
-            if (celula.estado == Celula::Estado::VAZIO) {
-                return tamanho; // Indica que não foi encontrado
-            }
-            // Se encontrou o valor em célula ocupada
-            if (celula.estado == Celula::Estado::OCUPADO && celula.valor == valor) {
-                return indice; // Valor encontrado
-            }
-            // Continua se for REMOVIDO - pode existir mais adiante
+    const auto sondar = kernelsSimd().sondarCelulas;
+    const Celula* celulas = tabela.data();
+
+    size_t indice = sondar(celulas, indiceInicial, tamanho, valor, paraInsercao);
+    if (indice == tamanho) {
+        indice = sondar(celulas, 0, indiceInicial, valor, paraInsercao);
+        if (indice == indiceInicial) {
+            return tamanho; // Tabela inteira percorrida sem posição adequada
         }
-        
-        // Avança para próxima posição (sondagem linear)
-        indice = (indice + 1) % tamanho;
-        ++tentativas;
     }
-    
-    return tamanho; // Indica que não encontrou posição válida
+
+    // Na busca, a célula VAZIA indica que o elemento não existe
+    if (!paraInsercao && celulas[indice].estado == Celula::Estado::VAZIO) {
+        return tamanho;
+    }
+    return indice;
 }
 
 /**
@@ -87,6 +75,8 @@ size_t TabelaAberta::sondagemLinear(size_t indiceInicial, int valor, bool paraIn
 void TabelaAberta::inserir(int valor, TipoHash tipo) {
     // Verificação de integridade: evita performance ruim
     if (precisaRehash()) {
+        RASTREAR_EVENTO("rehashNecessario", "tabela",
+                        "ocupacao=" + std::to_string(fatorOcupacao()) + " tamanho=" + std::to_string(tamanho));
         throw std::runtime_error("Fator de carga muito alto - rehash necessário");
     }
     
@@ -100,6 +90,7 @@ void TabelaAberta::inserir(int valor, TipoHash tipo) {
     
     // Verifica se conseguiu encontrar posição
     if (indice >= tamanho) {
+        RASTREAR_EVENTO("tabelaCheia", "tabela", "tamanho=" + std::to_string(tamanho));
         throw std::runtime_error("Tabela cheia - não foi possível inserir");
     }
     
@@ -112,6 +103,11 @@ void TabelaAberta::inserir(int valor, TipoHash tipo) {
     
     // Ajusta contadores baseado no estado anterior da célula
     if (celula.estado == Celula::Estado::REMOVIDO) {
+        // A célula removida pode anteceder o próprio valor na sequência de
+        // sondagem: antes de reutilizá-la, confirma que ele não está adiante
+        if (sondagemLinear(indice, valor, false) < tamanho) {
+            return; // Valor já existe após a célula removida
+        }
         // Reutilizando posição removida
         --numRemovidos;
     }
@@ -149,6 +145,25 @@ bool TabelaAberta::buscar(int valor, TipoHash tipo) const {
     return indice < tamanho;
 }
 
+void TabelaAberta::buscarLote(const int* valores, size_t n, TipoHash tipo, uint8_t* encontrados) const {
+    const KernelsSimd& kernels = kernelsSimd();
+    size_t origens[LOTE_PREBUSCA];
+    for (size_t inicio = 0; inicio < n; inicio += LOTE_PREBUSCA) {
+        const size_t quantidade = std::min(LOTE_PREBUSCA, n - inicio);
+        if (tipo == TipoHash::DIVISAO) {
+            kernels.hashDivisaoLote(valores + inicio, quantidade, tamanho, origens);
+        } else {
+            kernels.hashMultiplicacaoLote(valores + inicio, quantidade, tamanho, CONSTANTE_MULTIPLICACAO, origens);
+        }
+        for (size_t i = 0; i < quantidade; ++i) {
+            preBuscarLinha(&tabela[origens[i]]);
+        }
+        for (size_t i = 0; i < quantidade; ++i) {
+            encontrados[inicio + i] = sondagemLinear(origens[i], valores[inicio + i], false) < tamanho;
+        }
+    }
+}
+
 /**
  * @brief Implementação do método de remoção com lazy deletion
  * 
@@ -201,64 +216,91 @@ std::optional<int> TabelaAberta::remover(int valor, TipoHash tipo) {
  * 
  * Esta função realiza uma análise completa do estado da tabela:
  * 1. Simula operações de busca para calcular sondagens
- * 2. Identifica clusters contíguos de células ocupadas
- * 3. Calcula estatísticas de distribuição
+ * 2. Calcula as sondagens de buscas malsucedidas
+ * 3. Identifica clusters contíguos de células ocupadas
+ * 4. Calcula estatísticas de distribuição
  * 
  * Clustering primário é um problema comum na sondagem linear onde
  * elementos tendem a se agrupar, causando longas seqüências de sondações.
  * 
+ * @param tipo Função hash que define a posição de origem de cada elemento
  * @return Estrutura com estatísticas detalhadas
  * 
  * @complexity O(n) onde n é o tamanho da tabela
  */
-TabelaAberta::EstatisticasSondagem TabelaAberta::analisarSondagem() const {
+TabelaAberta::EstatisticasSondagem TabelaAberta::analisarSondagem(TipoHash tipo) const {
     EstatisticasSondagem stats;
     stats.totalSondagens = 0;
     stats.sondagemMedia = 0.0;
+    stats.sondagemMediaInsucesso = 1.0; // Tabela vazia: a primeira célula já é VAZIA
     stats.maxSondagens = 0;
     stats.clustersDetectados = 0;
     stats.maiorCluster = 0;
     
     // Se tabela vazia, retorna estatísticas zeradas
-    if (numElementos == 0) {
+    if (numElementos == 0 && numRemovidos == 0) {
         return stats;
     }
     
-    // Simula operações de busca para calcular sondagens
-    size_t totalSondagens = 0;
-    size_t operacoesRealizadas = 0;
-    
-    // Para cada elemento ocupado, calcula quantas sondagens seriam necessárias
+    // Posição e valor de cada elemento ocupado
+    std::vector<size_t> posicoes;
+    std::vector<int> valores;
+    posicoes.reserve(numElementos);
+    valores.reserve(numElementos);
     for (size_t i = 0; i < tamanho; ++i) {
         if (tabela[i].estado == Celula::Estado::OCUPADO) {
-            int valor = tabela[i].valor;
-            
-            // Simula busca para calcular número de sondagens
-            size_t indiceOriginal = calcularHashDivisao(valor);
-            size_t sondagens = 1;
-            size_t indice = indiceOriginal;
-            
-            // Conta sondagens até encontrar a posição atual
-            while (indice != i) {
-                indice = (indice + 1) % tamanho;
-                ++sondagens;
-                
-                // Proteção contra loop infinito
-                if (sondagens > tamanho) break;
-            }
-            
-            totalSondagens += sondagens;
-            stats.maxSondagens = std::max(stats.maxSondagens, sondagens);
-            ++operacoesRealizadas;
+            posicoes.push_back(i);
+            valores.push_back(tabela[i].valor);
         }
     }
     
+    // Posições de origem calculadas em lote pelo kernel vetorial
+    std::vector<size_t> origens(valores.size());
+    if (tipo == TipoHash::DIVISAO) {
+        kernelsSimd().hashDivisaoLote(valores.data(), valores.size(), tamanho, origens.data());
+    } else {
+        kernelsSimd().hashMultiplicacaoLote(valores.data(), valores.size(), tamanho,
+                                            CONSTANTE_MULTIPLICACAO, origens.data());
+    }
+    
+    // A busca de um elemento examina as células da origem até a sua posição,
+    // dando a volta na tabela quando a posição fica antes da origem
+    size_t totalSondagens = 0;
+    size_t operacoesRealizadas = 0;
+    for (size_t j = 0; j < posicoes.size(); ++j) {
+        size_t sondagens = (posicoes[j] + tamanho - origens[j]) % tamanho + 1;
+        totalSondagens += sondagens;
+        stats.maxSondagens = std::max(stats.maxSondagens, sondagens);
+        ++operacoesRealizadas;
+    }
+    
     // Calcula média de sondagens
     if (operacoesRealizadas > 0) {
         stats.sondagemMedia = static_cast<double>(totalSondagens) / operacoesRealizadas;
     }
     stats.totalSondagens = totalSondagens;
     
+    // Busca malsucedida: a partir de cada posição, examina células até a
+    // primeira VAZIA. Percorrendo de trás para frente, a distância de i é
+    // 1 (VAZIA) ou 1 + distância de i+1; duas voltas cobrem o contorno.
+    if (numElementos + numRemovidos < tamanho) {
+        std::vector<size_t> distancia(tamanho, 0);
+        size_t proxima = 0;
+        for (size_t volta = 0; volta < 2; ++volta) {
+            for (size_t i = tamanho; i-- > 0;) {
+                proxima = tabela[i].estado == Celula::Estado::VAZIO ? 1 : proxima + 1;
+                distancia[i] = proxima;
+            }
+        }
+        size_t somaInsucesso = 0;
+        for (size_t d : distancia) {
+            somaInsucesso += d;
+        }
+        stats.sondagemMediaInsucesso = static_cast<double>(somaInsucesso) / tamanho;
+    } else {
+        stats.sondagemMediaInsucesso = static_cast<double>(tamanho); // Sem células VAZIAS
+    }
+    
     // Análise de clustering
     bool emCluster = false;
     size_t tamanhoClusterAtual = 0;
@@ -0,0 +1,518 @@
+/**
+ * @file TabelaCompartilhada.cpp
+ * @brief Implementação da tabela em memória compartilhada (segmento, seqlock e sondagem)
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "TabelaCompartilhada.hpp"
+#include "Rastreamento.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ANALISE_HASH_MEMORIA_COMPARTILHADA
+#endif
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "atômicos do segmento precisam ser livres de lock para funcionar entre processos");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "célula deve ocupar 4 bytes");
+
+/**
+ * @brief Cabeçalho no deslocamento 0 do segmento
+ *
+ * Os campos fixos são gravados antes de `pronto`; a sequência e os
+ * contadores mutáveis ficam em linhas de cache próprias, para que as
+ * escritas do escritor não invalidem a linha lida em toda busca.
+ */
+struct TabelaCompartilhada::Cabecalho {
+    char magico[8];                             ///< "AHSHM001"
+    uint32_t tipoHash;                          ///< TipoHash do segmento
+    uint32_t reservado;
+    uint64_t tamanho;                           ///< Número de posições
+    uint64_t deslocamentoCelulas;               ///< Início das células, em bytes
+    uint64_t bytesSegmento;                     ///< Tamanho total do segmento
+    std::atomic<uint32_t> pronto;               ///< 1 após a inicialização (release)
+    alignas(64) std::atomic<uint64_t> sequencia;    ///< Seqlock: ímpar durante a compactação
+    alignas(64) std::atomic<uint64_t> numElementos; ///< Chaves presentes
+    std::atomic<uint64_t> numRemovidos;             ///< Células REMOVIDAS
+    std::atomic<uint64_t> versao;                   ///< Publicações do escritor
+    std::atomic<uint64_t> compactacoes;             ///< Compactações realizadas
+};
+
+namespace {
+
+constexpr char MAGICO_SEGMENTO[8] = {'A', 'H', 'S', 'H', 'M', '0', '0', '1'};
+constexpr uint32_t CELULA_VAZIA = 0;
+constexpr uint32_t CELULA_REMOVIDA = 1;
+constexpr size_t ALINHAMENTO_CELULAS = 64;
+
+/// Constante do método da multiplicação (a mesma da TabelaAberta)
+constexpr double CONSTANTE_MULTIPLICACAO = 0.63274838;
+
+/// Código armazenado: bit de sinal invertido, de modo que 0 e 1 correspondem a INT_MIN e INT_MIN + 1
+uint32_t codificar(int chave) {
+    return static_cast<uint32_t>(chave) ^ 0x80000000u;
+}
+
+size_t deslocamentoCelulas() {
+    return (sizeof(TabelaCompartilhada::Cabecalho) + ALINHAMENTO_CELULAS - 1) / ALINHAMENTO_CELULAS *
+           ALINHAMENTO_CELULAS;
+}
+
+/// Nome aceito por shm_open: começa com uma única barra
+std::string nomePosix(const std::string& nome) {
+    if (nome.empty() || nome == "/") {
+        throw std::invalid_argument("Nome do segmento compartilhado não pode ser vazio");
+    }
+    return nome[0] == '/' ? nome : "/" + nome;
+}
+
+[[noreturn]] void falhar(const std::string& operacao) {
+    throw std::runtime_error(operacao + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+#ifdef ANALISE_HASH_MEMORIA_COMPARTILHADA
+
+TabelaCompartilhada TabelaCompartilhada::inicializar(int fd, const std::string& nomeSegmento,
+                                                     size_t tamanhoTabela, TipoHash tipoHash) {
+    TabelaCompartilhada tabela;
+    tabela.descritor = fd;
+    tabela.nome = nomeSegmento;
+    tabela.escritor = true;
+    tabela.bytes = deslocamentoCelulas() + tamanhoTabela * sizeof(uint32_t);
+
+    // ftruncate preenche com zeros: todas as células começam VAZIAS
+    if (::ftruncate(fd, static_cast<off_t>(tabela.bytes)) != 0) {
+        falhar("Erro ao dimensionar o segmento compartilhado");
+    }
+    tabela.base = ::mmap(nullptr, tabela.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (tabela.base == MAP_FAILED) {
+        tabela.base = nullptr;
+        falhar("Erro ao mapear o segmento compartilhado");
+    }
+
+    auto* cabecalho = new (tabela.base) Cabecalho{};
+    std::memcpy(cabecalho->magico, MAGICO_SEGMENTO, sizeof(MAGICO_SEGMENTO));
+    cabecalho->tipoHash = static_cast<uint32_t>(tipoHash);
+    cabecalho->tamanho = tamanhoTabela;
+    cabecalho->deslocamentoCelulas = deslocamentoCelulas();
+    cabecalho->bytesSegmento = tabela.bytes;
+    cabecalho->pronto.store(1, std::memory_order_release);
+
+    tabela.cabecalho = cabecalho;
+    tabela.celulas = reinterpret_cast<std::atomic<uint32_t>*>(static_cast<char*>(tabela.base) +
+                                                              cabecalho->deslocamentoCelulas);
+    tabela.tamanho = tamanhoTabela;
+    tabela.tipo = tipoHash;
+    tabela.limiteOcupacao = static_cast<size_t>(MAX_FATOR_CARGA * tamanhoTabela);
+    return tabela;
+}
+
+TabelaCompartilhada TabelaCompartilhada::mapearLeitura(int fd, const std::string& nomeSegmento) {
+    TabelaCompartilhada tabela;
+    tabela.descritor = fd;
+    tabela.nome = nomeSegmento;
+
+    struct stat informacoes {};
+    if (::fstat(fd, &informacoes) != 0) {
+        falhar("Erro ao consultar o segmento compartilhado");
+    }
+    tabela.bytes = static_cast<size_t>(informacoes.st_size);
+    if (tabela.bytes < sizeof(Cabecalho)) {
+        throw std::runtime_error("Segmento compartilhado sem cabeçalho de tabela");
+    }
+    tabela.base = ::mmap(nullptr, tabela.bytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (tabela.base == MAP_FAILED) {
+        tabela.base = nullptr;
+        falhar("Erro ao mapear o segmento compartilhado");
+    }
+
+    const auto* cabecalho = static_cast<const Cabecalho*>(tabela.base);
+    if (std::memcmp(cabecalho->magico, MAGICO_SEGMENTO, sizeof(MAGICO_SEGMENTO)) != 0 ||
+        cabecalho->pronto.load(std::memory_order_acquire) != 1) {
+        throw std::runtime_error("Segmento compartilhado não é uma tabela inicializada");
+    }
+    if (cabecalho->bytesSegmento != tabela.bytes || cabecalho->tamanho == 0 ||
+        cabecalho->deslocamentoCelulas + cabecalho->tamanho * sizeof(uint32_t) > tabela.bytes ||
+        cabecalho->tipoHash > static_cast<uint32_t>(TipoHash::MULTIPLICACAO)) {
+        throw std::runtime_error("Cabeçalho do segmento compartilhado inconsistente");
+    }
+
+    // Somente leitura: os atômicos são apenas carregados, nunca escritos
+    tabela.cabecalho = const_cast<Cabecalho*>(cabecalho);
+    tabela.celulas = reinterpret_cast<std::atomic<uint32_t>*>(static_cast<char*>(tabela.base) +
+                                                              cabecalho->deslocamentoCelulas);
+    tabela.tamanho = cabecalho->tamanho;
+    tabela.tipo = static_cast<TipoHash>(cabecalho->tipoHash);
+    return tabela;
+}
+
+TabelaCompartilhada TabelaCompartilhada::criar(const std::string& nomeSegmento, size_t tamanhoTabela,
+                                               TipoHash tipoHash) {
+    if (tamanhoTabela == 0) {
+        throw std::invalid_argument("Tamanho da tabela deve ser maior que zero");
+    }
+    const std::string nomeCompleto = nomePosix(nomeSegmento);
+    const int fd = ::shm_open(nomeCompleto.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        falhar("Erro ao criar o segmento " + nomeCompleto);
+    }
+    try {
+        return inicializar(fd, nomeCompleto, tamanhoTabela, tipoHash);
+    } catch (...) {
+        // O objeto parcial já fechou o descritor; o nome criado aqui é removido
+        ::shm_unlink(nomeCompleto.c_str());
+        throw;
+    }
+}
+
+TabelaCompartilhada TabelaCompartilhada::criarAnonima(size_t tamanhoTabela, TipoHash tipoHash) {
+    if (tamanhoTabela == 0) {
+        throw std::invalid_argument("Tamanho da tabela deve ser maior que zero");
+    }
+#if defined(__linux__)
+    const int fd = ::memfd_create("analise_hash_tabela", MFD_CLOEXEC);
+    if (fd < 0) {
+        falhar("Erro ao criar o segmento anônimo");
+    }
+    return inicializar(fd, "", tamanhoTabela, tipoHash);
+#else
+    (void)tipoHash;
+    throw std::runtime_error("Segmento anônimo (memfd) disponível apenas no Linux");
+#endif
+}
+
+TabelaCompartilhada TabelaCompartilhada::abrir(const std::string& nomeSegmento) {
+    const std::string nomeCompleto = nomePosix(nomeSegmento);
+    const int fd = ::shm_open(nomeCompleto.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        falhar("Erro ao abrir o segmento " + nomeCompleto);
+    }
+    return mapearLeitura(fd, nomeCompleto);
+}
+
+TabelaCompartilhada TabelaCompartilhada::abrirDescritor(int descritorSegmento) {
+    // Descritor próprio: o do chamador continua sob a responsabilidade dele
+    const int fd = ::fcntl(descritorSegmento, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) {
+        falhar("Erro ao duplicar o descritor do segmento");
+    }
+    return mapearLeitura(fd, "");
+}
+
+bool TabelaCompartilhada::removerNome(const std::string& nomeSegmento) {
+    const std::string nomeCompleto = nomePosix(nomeSegmento);
+    if (::shm_unlink(nomeCompleto.c_str()) == 0) {
+        return true;
+    }
+    if (errno == ENOENT) {
+        return false;
+    }
+    falhar("Erro ao remover o segmento " + nomeCompleto);
+}
+
+TabelaCompartilhada::~TabelaCompartilhada() {
+    if (base != nullptr) {
+        ::munmap(base, bytes);
+    }
+    if (descritor >= 0) {
+        ::close(descritor);
+    }
+}
+
+#else
+
+TabelaCompartilhada TabelaCompartilhada::inicializar(int, const std::string&, size_t, TipoHash) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+TabelaCompartilhada TabelaCompartilhada::mapearLeitura(int, const std::string&) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+TabelaCompartilhada TabelaCompartilhada::criar(const std::string&, size_t, TipoHash) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+TabelaCompartilhada TabelaCompartilhada::criarAnonima(size_t, TipoHash) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+TabelaCompartilhada TabelaCompartilhada::abrir(const std::string&) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+TabelaCompartilhada TabelaCompartilhada::abrirDescritor(int) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+bool TabelaCompartilhada::removerNome(const std::string&) {
+    throw std::runtime_error("Memória compartilhada disponível apenas em sistemas POSIX");
+}
+
+TabelaCompartilhada::~TabelaCompartilhada() = default;
+
+#endif
+
+TabelaCompartilhada::TabelaCompartilhada(TabelaCompartilhada&& outra) noexcept
+    : descritor(std::exchange(outra.descritor, -1)),
+      base(std::exchange(outra.base, nullptr)),
+      bytes(std::exchange(outra.bytes, 0)),
+      escritor(outra.escritor),
+      nome(std::move(outra.nome)),
+      cabecalho(std::exchange(outra.cabecalho, nullptr)),
+      celulas(std::exchange(outra.celulas, nullptr)),
+      tamanho(std::exchange(outra.tamanho, 0)),
+      tipo(outra.tipo),
+      limiteOcupacao(outra.limiteOcupacao) {}
+
+TabelaCompartilhada& TabelaCompartilhada::operator=(TabelaCompartilhada&& outra) noexcept {
+    if (this != &outra) {
+        TabelaCompartilhada anterior(std::move(*this));
+        descritor = std::exchange(outra.descritor, -1);
+        base = std::exchange(outra.base, nullptr);
+        bytes = std::exchange(outra.bytes, 0);
+        escritor = outra.escritor;
+        nome = std::move(outra.nome);
+        cabecalho = std::exchange(outra.cabecalho, nullptr);
+        celulas = std::exchange(outra.celulas, nullptr);
+        tamanho = std::exchange(outra.tamanho, 0);
+        tipo = outra.tipo;
+        limiteOcupacao = outra.limiteOcupacao;
+    }
+    return *this;
+}
+
+size_t TabelaCompartilhada::calcularHash(int chave) const {
+    if (tipo == TipoHash::DIVISAO) {
+        return static_cast<size_t>(std::abs(static_cast<int64_t>(chave))) % tamanho;
+    }
+    const double produto = std::abs(static_cast<int64_t>(chave)) * CONSTANTE_MULTIPLICACAO;
+    const double fracao = produto - std::floor(produto);
+    return static_cast<size_t>(std::floor(fracao * tamanho));
+}
+
+/**
+ * @brief Sondagem linear a partir da origem até a chave ou uma célula VAZIA
+ *
+ * Limitada a uma volta na tabela: durante uma compactação o leitor pode
+ * ver um estado intermediário sem VAZIAS, e o resultado será descartado
+ * pelo seqlock de qualquer forma.
+ */
+bool TabelaCompartilhada::sondar(uint32_t codigo, size_t origem) const {
+    size_t indice = origem;
+    for (size_t passos = 0; passos < tamanho; ++passos) {
+        const uint32_t celula = celulas[indice].load(std::memory_order_relaxed);
+        if (celula == codigo) {
+            return true;
+        }
+        if (celula == CELULA_VAZIA) {
+            return false;
+        }
+        if (++indice == tamanho) {
+            indice = 0;
+        }
+    }
+    return false;
+}
+
+void TabelaCompartilhada::exigirEscritor(const char* operacao) const {
+    if (!escritor) {
+        throw std::logic_error(std::string(operacao) + " exige o mapeamento do escritor");
+    }
+}
+
+/**
+ * @brief Reinsere as chaves presentes sem as REMOVIDAS, sob o seqlock
+ *
+ * Seqlock do lado do escritor: a sequência fica ímpar (store relaxado e
+ * fence release, para que nenhuma célula reescrita seja vista antes dela)
+ * e volta a par com release ao fim. Os leitores que sobrepuserem a
+ * reescrita refazem a busca.
+ */
+void TabelaCompartilhada::compactar() {
+    RASTREAR_ESCOPO_DETALHE("compactarCompartilhada", "tabela", std::to_string(tamanho));
+
+    std::vector<uint32_t> presentes;
+    presentes.reserve(getNumElementos());
+    for (size_t i = 0; i < tamanho; ++i) {
+        const uint32_t celula = celulas[i].load(std::memory_order_relaxed);
+        if (celula != CELULA_VAZIA && celula != CELULA_REMOVIDA) {
+            presentes.push_back(celula);
+        }
+    }
+
+    const uint64_t sequencia = cabecalho->sequencia.load(std::memory_order_relaxed);
+    cabecalho->sequencia.store(sequencia + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < tamanho; ++i) {
+        celulas[i].store(CELULA_VAZIA, std::memory_order_relaxed);
+    }
+    for (uint32_t codigo : presentes) {
+        size_t indice = calcularHash(static_cast<int>(codigo ^ 0x80000000u));
+        while (celulas[indice].load(std::memory_order_relaxed) != CELULA_VAZIA) {
+            if (++indice == tamanho) {
+                indice = 0;
+            }
+        }
+        celulas[indice].store(codigo, std::memory_order_relaxed);
+    }
+    cabecalho->numRemovidos.store(0, std::memory_order_relaxed);
+    cabecalho->compactacoes.fetch_add(1, std::memory_order_relaxed);
+
+    cabecalho->sequencia.store(sequencia + 2, std::memory_order_release);
+}
+
+bool TabelaCompartilhada::inserir(int chave) {
+    exigirEscritor("inserir");
+    const uint32_t codigo = codificar(chave);
+    if (codigo == CELULA_VAZIA || codigo == CELULA_REMOVIDA) {
+        throw std::invalid_argument("INT_MIN e INT_MIN + 1 são reservados para células vazias e removidas");
+    }
+
+    // Procura a chave até a primeira VAZIA, guardando a primeira REMOVIDA para reutilizar
+    const size_t origem = calcularHash(chave);
+    size_t indice = origem;
+    size_t destino = tamanho;
+    for (size_t passos = 0; passos < tamanho; ++passos) {
+        const uint32_t celula = celulas[indice].load(std::memory_order_relaxed);
+        if (celula == codigo) {
+            return false;
+        }
+        if (celula == CELULA_REMOVIDA && destino == tamanho) {
+            destino = indice;
+        } else if (celula == CELULA_VAZIA) {
+            if (destino == tamanho) {
+                destino = indice;
+            }
+            break;
+        }
+        if (++indice == tamanho) {
+            indice = 0;
+        }
+    }
+
+    const size_t elementos = getNumElementos();
+    if (elementos + 1 > limiteOcupacao || destino == tamanho) {
+        RASTREAR_EVENTO("tabelaCheia", "tabela", "tamanho=" + std::to_string(tamanho));
+        throw std::runtime_error("Fator de carga muito alto na tabela compartilhada");
+    }
+
+    const bool reutiliza = celulas[destino].load(std::memory_order_relaxed) == CELULA_REMOVIDA;
+    if (!reutiliza && elementos + getNumRemovidos() + 1 > limiteOcupacao) {
+        // Uma VAZIA a menos deixaria a ocupação além do limite: remove as REMOVIDAS antes
+        compactar();
+        destino = origem;
+        while (celulas[destino].load(std::memory_order_relaxed) != CELULA_VAZIA) {
+            if (++destino == tamanho) {
+                destino = 0;
+            }
+        }
+    }
+
+    // Um único store torna a chave visível aos leitores
+    celulas[destino].store(codigo, std::memory_order_release);
+    if (reutiliza) {
+        cabecalho->numRemovidos.fetch_sub(1, std::memory_order_relaxed);
+    }
+    cabecalho->numElementos.store(elementos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool TabelaCompartilhada::remover(int chave) {
+    exigirEscritor("remover");
+    const uint32_t codigo = codificar(chave);
+    if (codigo == CELULA_VAZIA || codigo == CELULA_REMOVIDA) {
+        return false;
+    }
+
+    size_t indice = calcularHash(chave);
+    for (size_t passos = 0; passos < tamanho; ++passos) {
+        const uint32_t celula = celulas[indice].load(std::memory_order_relaxed);
+        if (celula == CELULA_VAZIA) {
+            return false;
+        }
+        if (celula == codigo) {
+            celulas[indice].store(CELULA_REMOVIDA, std::memory_order_release);
+            cabecalho->numElementos.fetch_sub(1, std::memory_order_relaxed);
+            cabecalho->numRemovidos.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (++indice == tamanho) {
+            indice = 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Busca com o lado leitor do seqlock
+ *
+ * Sequência lida com acquire antes da sondagem; fence acquire e nova
+ * leitura depois. Se for ímpar ou tiver mudado, uma compactação se
+ * sobrepôs à sondagem e ela é refeita. O escritor, único a mutar, lê
+ * suas próprias células diretamente.
+ */
+bool TabelaCompartilhada::buscar(int chave) const {
+    const uint32_t codigo = codificar(chave);
+    if (codigo == CELULA_VAZIA || codigo == CELULA_REMOVIDA) {
+        return false;
+    }
+    const size_t origem = calcularHash(chave);
+    if (escritor) {
+        return sondar(codigo, origem);
+    }
+
+    for (;;) {
+        const uint64_t antes = cabecalho->sequencia.load(std::memory_order_acquire);
+        if (antes & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        const bool encontrada = sondar(codigo, origem);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (cabecalho->sequencia.load(std::memory_order_relaxed) == antes) {
+            return encontrada;
+        }
+    }
+}
+
+void TabelaCompartilhada::publicar() {
+    exigirEscritor("publicar");
+    cabecalho->versao.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t TabelaCompartilhada::getVersao() const {
+    return cabecalho->versao.load(std::memory_order_acquire);
+}
+
+size_t TabelaCompartilhada::getNumElementos() const {
+    return static_cast<size_t>(cabecalho->numElementos.load(std::memory_order_relaxed));
+}
+
+size_t TabelaCompartilhada::getNumRemovidos() const {
+    return static_cast<size_t>(cabecalho->numRemovidos.load(std::memory_order_relaxed));
+}
+
+uint64_t TabelaCompartilhada::getCompactacoes() const {
+    return cabecalho->compactacoes.load(std::memory_order_relaxed);
+}
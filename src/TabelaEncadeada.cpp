@@ -13,8 +13,41 @@
  */
 
 #include "TabelaEncadeada.hpp"
+#include "DespachoCpu.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <malloc.h>
+#define ANALISE_HASH_TAMANHO_BLOCO(bloco) malloc_usable_size(bloco)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define ANALISE_HASH_TAMANHO_BLOCO(bloco) malloc_size(bloco)
+#endif
+
+/**
+ * @brief Mede o bloco de um nó na primeira chamada
+ *
+ * O new_delete_resource chega ao malloc pelo operator new, então o bloco
+ * de um malloc(sizeof(No)) é o mesmo de um nó da tabela.
+ */
+size_t TabelaEncadeada::bytesPorChave() {
+#ifdef ANALISE_HASH_TAMANHO_BLOCO
+    static const size_t bytes = [] {
+        void* bloco = std::malloc(sizeof(No));
+        if (bloco == nullptr) {
+            throw std::bad_alloc();
+        }
+        const size_t utilizavel = ANALISE_HASH_TAMANHO_BLOCO(bloco);
+        std::free(bloco);
+        return utilizavel + sizeof(size_t);
+    }();
+    return bytes;
+#else
+    return ((sizeof(No) + 8 + 15) / 16) * 16;
+#endif
+}
 
 /**
  * @brief Implementação do método de inserção
@@ -46,9 +79,7 @@ void TabelaEncadeada::inserir(int valor, TipoHash tipo) {
     
     // Cria um novo nó e o insere no início da lista
     // Inserção no início é O(1) e não requer percorrer a lista
-    auto novoNo = std::make_unique<No>(valor);
-    novoNo->proximo = std::move(tabela[indice]);
-    tabela[indice] = std::move(novoNo);
+    tabela[indice] = criarNo(valor, tabela[indice]);
     
     // Incrementa o contador de elementos
     ++numElementos;
@@ -76,17 +107,48 @@ bool TabelaEncadeada::buscar(int valor, TipoHash tipo) const {
         : calcularHashMultiplicacao(valor);
     
     // Percorre a lista encadeada na posição calculada
-    const No* atual = tabela[indice].get();
+    const No* atual = tabela[indice];
     while (atual != nullptr) {
         if (atual->valor == valor) {
             return true; // Elemento encontrado
         }
-        atual = atual->proximo.get();
+        atual = atual->proximo;
     }
     
     return false; // Elemento não encontrado
 }
 
+void TabelaEncadeada::buscarLote(const int* valores, size_t n, TipoHash tipo, uint8_t* encontrados) const {
+    const KernelsSimd& kernels = kernelsSimd();
+    size_t indices[LOTE_PREBUSCA];
+    const No* primeiros[LOTE_PREBUSCA];
+    for (size_t inicio = 0; inicio < n; inicio += LOTE_PREBUSCA) {
+        const size_t quantidade = std::min(LOTE_PREBUSCA, n - inicio);
+        if (tipo == TipoHash::DIVISAO) {
+            kernels.hashDivisaoLote(valores + inicio, quantidade, tamanho, indices);
+        } else {
+            kernels.hashMultiplicacaoLote(valores + inicio, quantidade, tamanho, CONSTANTE_MULTIPLICACAO, indices);
+        }
+        for (size_t i = 0; i < quantidade; ++i) {
+            preBuscarLinha(&tabela[indices[i]]);
+        }
+        for (size_t i = 0; i < quantidade; ++i) {
+            primeiros[i] = tabela[indices[i]];
+            if (primeiros[i] != nullptr) {
+                preBuscarLinha(primeiros[i]);
+            }
+        }
+        for (size_t i = 0; i < quantidade; ++i) {
+            const int valor = valores[inicio + i];
+            const No* atual = primeiros[i];
+            while (atual != nullptr && atual->valor != valor) {
+                atual = atual->proximo;
+            }
+            encontrados[inicio + i] = atual != nullptr;
+        }
+    }
+}
+
 /**
  * @brief Implementação do método de remoção
  * 
@@ -107,22 +169,26 @@ bool TabelaEncadeada::remover(int valor, TipoHash tipo) {
         : calcularHashMultiplicacao(valor);
     
     // Caso especial: remover o primeiro elemento da lista
-    if (tabela[indice] && tabela[indice]->valor == valor) {
-        tabela[indice] = std::move(tabela[indice]->proximo);
+    No* primeiro = tabela[indice];
+    if (primeiro && primeiro->valor == valor) {
+        tabela[indice] = primeiro->proximo;
+        liberarNo(primeiro);
         --numElementos;
         return true;
     }
     
     // Procurar o elemento na lista encadeada
-    No* atual = tabela[indice].get();
+    No* atual = primeiro;
     while (atual && atual->proximo) {
         if (atual->proximo->valor == valor) {
             // Remove o nó encontrado reconectando os ponteiros
-            atual->proximo = std::move(atual->proximo->proximo);
+            No* removido = atual->proximo;
+            atual->proximo = removido->proximo;
+            liberarNo(removido);
             --numElementos;
             return true;
         }
-        atual = atual->proximo.get();
+        atual = atual->proximo;
     }
     
     return false; // Valor não encontrado para remoção
@@ -147,19 +213,21 @@ TabelaEncadeada::EstatisticasDistribuicao TabelaEncadeada::obterEstatisticas() c
     stats.posicoesMaisUtilizada = 0;   // Maior lista encontrada
     stats.comprimentoMedio = 0.0;      // Média das listas não vazias
     stats.totalColisoes = 0;           // Total de colisões estimadas
+    stats.sondagemMediaSucesso = 0.0;  // Nós examinados por busca bem-sucedida
     
     size_t posicoes_nao_vazias = 0;    // Contador de posições com elementos
     size_t soma_comprimentos = 0;      // Soma dos comprimentos para cálculo da média
+    size_t soma_sondagens = 0;         // Soma das posições de cada elemento na sua lista
     
     // Percorre todas as posições da tabela
     for (const auto& lista : tabela) {
         size_t comprimento = 0;
-        const No* atual = lista.get();
+        const No* atual = lista;
         
         // Conta elementos na lista encadeada desta posição
         while (atual != nullptr) {
             comprimento++;
-            atual = atual->proximo.get();
+            atual = atual->proximo;
         }
         
         if (comprimento == 0) {
@@ -169,6 +237,7 @@ TabelaEncadeada::EstatisticasDistribuicao TabelaEncadeada::obterEstatisticas() c
             // Posição ocupada - atualiza estatísticas
             posicoes_nao_vazias++;
             soma_comprimentos += comprimento;
+            soma_sondagens += comprimento * (comprimento + 1) / 2;
             stats.posicoesMaisUtilizada = std::max(stats.posicoesMaisUtilizada, comprimento);
             
             // Cada elemento após o primeiro em uma lista representa uma colisão
@@ -181,6 +250,7 @@ TabelaEncadeada::EstatisticasDistribuicao TabelaEncadeada::obterEstatisticas() c
     // Calcula o comprimento médio das listas não vazias
     if (posicoes_nao_vazias > 0) {
         stats.comprimentoMedio = static_cast<double>(soma_comprimentos) / posicoes_nao_vazias;
+        stats.sondagemMediaSucesso = static_cast<double>(soma_sondagens) / soma_comprimentos;
     }
     
     return stats;
@@ -0,0 +1,279 @@
+/**
+ * @file TabelaRedimensionavel.cpp
+ * @brief Implementação da tabela com crescimento e rehash configurável
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "TabelaRedimensionavel.hpp"
+#include "Rastreamento.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+TabelaRedimensionavel::Arranjo TabelaRedimensionavel::Arranjo::criar(size_t tamanho) {
+    Arranjo arranjo;
+    if (tamanho == 0) {
+        return arranjo;
+    }
+    // calloc de arranjos grandes recebe páginas zeradas sob demanda do sistema
+    auto* memoria = static_cast<uint32_t*>(std::calloc(tamanho, sizeof(uint32_t)));
+    if (memoria == nullptr) {
+        throw std::bad_alloc();
+    }
+    arranjo.posicoes.reset(memoria);
+    arranjo.tamanho = tamanho;
+    return arranjo;
+}
+
+bool TabelaRedimensionavel::Arranjo::contem(uint32_t codigo, int chave) const {
+    if (tamanho == 0) {
+        return false;
+    }
+    size_t indice = static_cast<size_t>(std::abs(static_cast<int64_t>(chave))) % tamanho;
+    for (size_t tentativas = 0; tentativas < tamanho; ++tentativas) {
+        const uint32_t valor = posicoes[indice];
+        if (valor == 0) {
+            return false;
+        }
+        if (valor == codigo) {
+            return true;
+        }
+        indice = (indice + 1 == tamanho) ? 0 : indice + 1;
+    }
+    return false;
+}
+
+void TabelaRedimensionavel::Arranjo::inserir(uint32_t codigo, int chave) {
+    size_t indice = static_cast<size_t>(std::abs(static_cast<int64_t>(chave))) % tamanho;
+    while (posicoes[indice] != 0) {
+        indice = (indice + 1 == tamanho) ? 0 : indice + 1;
+    }
+    posicoes[indice] = codigo;
+    ++elementos;
+}
+
+size_t TabelaRedimensionavel::proximoPrimo(size_t n) {
+    if (n <= 2) return 2;
+    if (n % 2 == 0) ++n;
+    for (;; n += 2) {
+        bool primo = true;
+        for (size_t i = 3; i * i <= n; i += 2) {
+            if (n % i == 0) {
+                primo = false;
+                break;
+            }
+        }
+        if (primo) return n;
+    }
+}
+
+TabelaRedimensionavel::TabelaRedimensionavel(Modo modoRehash, size_t tamanhoInicial)
+    : modo(modoRehash),
+      atual(Arranjo::criar(proximoPrimo(std::max(tamanhoInicial, TAMANHO_MINIMO)))) {}
+
+TabelaRedimensionavel::~TabelaRedimensionavel() {
+    if (migrador.joinable()) {
+        migrador.join();
+    }
+}
+
+/**
+ * @brief Dobra a tabela (próximo primo) e inicia a migração conforme o modo
+ *
+ * PARADA_TOTAL migra tudo aqui mesmo. INCREMENTAL e SEGUNDO_PLANO apenas
+ * congelam o arranjo atual como "antigo"; a migração prossegue depois.
+ */
+void TabelaRedimensionavel::crescer() {
+    const size_t novoTamanho = proximoPrimo(2 * atual.tamanho + 1);
+    ++redimensionamentos;
+    RASTREAR_EVENTO("inicioRedimensionamento", "tabela",
+                    "de=" + std::to_string(atual.tamanho) + " para=" + std::to_string(novoTamanho));
+
+    switch (modo) {
+        case Modo::PARADA_TOTAL: {
+            RASTREAR_ESCOPO_DETALHE("rehashParadaTotal", "tabela", std::to_string(atual.elementos));
+            Arranjo novo = Arranjo::criar(novoTamanho);
+            for (size_t i = 0; i < atual.tamanho; ++i) {
+                const uint32_t codigo = atual.posicoes[i];
+                if (codigo != 0) {
+                    novo.inserir(codigo, decodificar(codigo));
+                }
+            }
+            atual = std::move(novo);
+            RASTREAR_EVENTO("fimRedimensionamento", "tabela", std::to_string(atual.tamanho));
+            break;
+        }
+        case Modo::INCREMENTAL:
+            antigo = std::move(atual);
+            atual = Arranjo::criar(novoTamanho);
+            indiceMigracao = 0;
+            pendentes = antigo.elementos;
+            break;
+        case Modo::SEGUNDO_PLANO:
+            antigo = std::move(atual);
+            atual = Arranjo::criar(novoTamanho);
+            // Recebe as inserções até o fim da migração, com a mesma ocupação máxima
+            auxiliar = Arranjo::criar(proximoPrimo(antigo.tamanho));
+            migracaoPronta.store(false, std::memory_order_relaxed);
+            // A thread só lê "antigo" e só escreve em "atual"; a thread que
+            // insere não toca em "atual" até concluirSegundoPlano()
+            migrador = std::thread([this]() {
+                RASTREAR_ESCOPO_DETALHE("migracaoSegundoPlano", "tabela", std::to_string(antigo.elementos));
+                for (size_t i = 0; i < antigo.tamanho; ++i) {
+                    const uint32_t codigo = antigo.posicoes[i];
+                    if (codigo != 0) {
+                        atual.inserir(codigo, decodificar(codigo));
+                    }
+                }
+                migracaoPronta.store(true, std::memory_order_release);
+            });
+            break;
+    }
+}
+
+void TabelaRedimensionavel::migrarPasso(size_t quantidade) {
+    const size_t fim = std::min(antigo.tamanho, indiceMigracao + quantidade);
+    for (; indiceMigracao < fim; ++indiceMigracao) {
+        const uint32_t codigo = antigo.posicoes[indiceMigracao];
+        if (codigo != 0) {
+            atual.inserir(codigo, decodificar(codigo));
+            --pendentes;
+        }
+    }
+    if (indiceMigracao == antigo.tamanho) {
+        antigo = Arranjo();
+        RASTREAR_EVENTO("fimRedimensionamento", "tabela", std::to_string(atual.tamanho));
+    }
+}
+
+void TabelaRedimensionavel::concluirSegundoPlano() {
+    RASTREAR_ESCOPO_DETALHE("incorporarAuxiliar", "tabela", std::to_string(auxiliar.elementos));
+    migrador.join();
+    for (size_t i = 0; i < auxiliar.tamanho; ++i) {
+        const uint32_t codigo = auxiliar.posicoes[i];
+        if (codigo != 0) {
+            atual.inserir(codigo, decodificar(codigo));
+        }
+    }
+    antigo = Arranjo();
+    auxiliar = Arranjo();
+    RASTREAR_EVENTO("fimRedimensionamento", "tabela", std::to_string(atual.tamanho));
+}
+
+bool TabelaRedimensionavel::inserir(int chave) {
+    if (chave == INT_MIN) {
+        throw std::invalid_argument("INT_MIN é reservado para posições vazias");
+    }
+    const uint32_t codigo = codificar(chave);
+
+    switch (modo) {
+        case Modo::PARADA_TOTAL:
+            if (atual.contem(codigo, chave)) {
+                return false;
+            }
+            if (atual.elementos + 1 > MAX_OCUPACAO * atual.tamanho) {
+                crescer();
+            }
+            atual.inserir(codigo, chave);
+            return true;
+
+        case Modo::INCREMENTAL:
+            if (migrando()) {
+                migrarPasso(PASSO_MIGRACAO);
+            }
+            if (atual.contem(codigo, chave) || (migrando() && antigo.contem(codigo, chave))) {
+                return false;
+            }
+            if (atual.elementos + pendentes + 1 > MAX_OCUPACAO * atual.tamanho) {
+                // Só ocorre com migração pendente se PASSO_MIGRACAO for pequeno demais
+                if (migrando()) {
+                    migrarPasso(antigo.tamanho);
+                }
+                crescer();
+            }
+            atual.inserir(codigo, chave);
+            return true;
+
+        case Modo::SEGUNDO_PLANO:
+            if (migrando() && migracaoPronta.load(std::memory_order_acquire)) {
+                concluirSegundoPlano();
+            }
+            if (migrando()) {
+                if (antigo.contem(codigo, chave) || auxiliar.contem(codigo, chave)) {
+                    return false;
+                }
+                if (auxiliar.elementos + 1 <= MAX_OCUPACAO * auxiliar.tamanho) {
+                    auxiliar.inserir(codigo, chave);
+                    return true;
+                }
+                // Auxiliar cheio: a inserção espera a migração terminar
+                concluirSegundoPlano();
+            }
+            if (atual.contem(codigo, chave)) {
+                return false;
+            }
+            if (atual.elementos + 1 > MAX_OCUPACAO * atual.tamanho) {
+                crescer();
+                auxiliar.inserir(codigo, chave);
+                return true;
+            }
+            atual.inserir(codigo, chave);
+            return true;
+    }
+    return false;
+}
+
+bool TabelaRedimensionavel::buscar(int chave) const {
+    const uint32_t codigo = codificar(chave);
+    switch (modo) {
+        case Modo::INCREMENTAL:
+            return atual.contem(codigo, chave) || (migrando() && antigo.contem(codigo, chave));
+        case Modo::SEGUNDO_PLANO:
+            if (migrando()) {
+                return auxiliar.contem(codigo, chave) || antigo.contem(codigo, chave);
+            }
+            return atual.contem(codigo, chave);
+        default:
+            return atual.contem(codigo, chave);
+    }
+}
+
+void TabelaRedimensionavel::finalizarMigracao() {
+    if (!migrando()) {
+        return;
+    }
+    if (modo == Modo::INCREMENTAL) {
+        migrarPasso(antigo.tamanho);
+    } else if (modo == Modo::SEGUNDO_PLANO) {
+        concluirSegundoPlano();
+    }
+}
+
+size_t TabelaRedimensionavel::getNumElementos() const {
+    if (!migrando()) {
+        return atual.elementos;
+    }
+    if (modo == Modo::INCREMENTAL) {
+        return atual.elementos + pendentes;
+    }
+    return antigo.elementos + auxiliar.elementos;
+}
+
+std::ostream& operator<<(std::ostream& os, TabelaRedimensionavel::Modo modo) {
+    switch (modo) {
+        case TabelaRedimensionavel::Modo::PARADA_TOTAL:
+            return os << "ParadaTotal";
+        case TabelaRedimensionavel::Modo::INCREMENTAL:
+            return os << "Incremental";
+        case TabelaRedimensionavel::Modo::SEGUNDO_PLANO:
+            return os << "SegundoPlano";
+    }
+    return os;
+}
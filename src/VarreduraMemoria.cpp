@@ -0,0 +1,261 @@
+/**
+ * @file VarreduraMemoria.cpp
+ * @brief Implementação da classe VarreduraMemoria
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ */
+
+#include "VarreduraMemoria.hpp"
+#include "TabelaEncadeada.hpp"
+#include "TabelaAberta.hpp"
+#include "CarregadorDados.hpp"
+#include "TabelaRedimensionavel.hpp"
+#include "Rastreamento.hpp"
+#include "MetadadosExecucao.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief Formata uma quantidade de bytes com unidade binária
+ * @param bytes Quantidade de bytes
+ * @return Texto como "48.0 KiB" ou "1.50 GiB"
+ */
+std::string formatarBytes(size_t bytes) {
+    const char* unidades[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    double valor = static_cast<double>(bytes);
+    int unidade = 0;
+    while (valor >= 1024.0 && unidade < 4) {
+        valor /= 1024.0;
+        ++unidade;
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(unidade == 0 ? 0 : 1) << valor << " " << unidades[unidade];
+    return oss.str();
+}
+
+} // namespace
+
+VarreduraMemoria::VarreduraMemoria(size_t minimo, size_t maximo, double fator, unsigned int semente)
+    : topologia(detectarTopologiaMemoria()),
+      minChaves(minimo), maxChaves(maximo), fatorPasso(fator), seed(semente) {
+    if (minimo == 0 || minimo > maximo) {
+        throw std::invalid_argument("Intervalo de chaves da varredura inválido");
+    }
+    if (fator <= 1.0) {
+        throw std::invalid_argument("Fator de passo da varredura deve ser maior que 1");
+    }
+    if (maximo > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("Máximo de chaves excede o intervalo de int");
+    }
+}
+
+size_t VarreduraMemoria::proximoPrimo(size_t n) {
+    return TabelaRedimensionavel::proximoPrimo(n);
+}
+
+/**
+ * @brief Mede inserção e busca de um motor com as duas funções hash
+ *
+ * A tabela é criada fora da região medida para que a alocação do array
+ * principal não entre no tempo de inserção. O número de acertos da busca
+ * é acumulado numa variável volátil para impedir que as chamadas sejam
+ * eliminadas pelo otimizador.
+ */
+template<typename Tabela>
+void VarreduraMemoria::medirMotor(const std::string& nome, size_t tamanhoTabela,
+                                  size_t bytesPorPosicao, size_t bytesPorChave,
+                                  const std::vector<int>& dados, const std::vector<int>& amostra) {
+    using TipoHash = typename Tabela::TipoHash;
+    const std::pair<TipoHash, const char*> hashes[] = {
+        {TipoHash::DIVISAO, "Divisao"},
+        {TipoHash::MULTIPLICACAO, "Multiplicacao"}
+    };
+
+    for (const auto& [tipo, nomeHash] : hashes) {
+        RASTREAR_ESCOPO_DETALHE("medirMotor", "varredura", nome + " " + nomeHash);
+        Tabela tabela(tamanhoTabela);
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        for (int valor : dados) {
+            tabela.inserir(valor, tipo);
+        }
+        auto meio = std::chrono::high_resolution_clock::now();
+
+        size_t acertos = 0;
+        for (int valor : amostra) {
+            acertos += tabela.buscar(valor, tipo) ? 1 : 0;
+        }
+        auto fim = std::chrono::high_resolution_clock::now();
+
+        static volatile size_t sumidouro = 0;
+        sumidouro = sumidouro + acertos;
+
+        size_t workingSet = tamanhoTabela * bytesPorPosicao + tabela.getNumElementos() * bytesPorChave;
+
+        resultados.push_back({
+            nome,
+            nomeHash,
+            dados.size(),
+            tamanhoTabela,
+            workingSet,
+            topologia.nivelPara(workingSet),
+            workingSet > topologia.alcanceTLB(),
+            std::chrono::duration<double, std::nano>(meio - inicio).count() / dados.size(),
+            std::chrono::duration<double, std::nano>(fim - meio).count() / amostra.size()
+        });
+    }
+}
+
+/**
+ * @brief Executa a progressão geométrica de tamanhos
+ *
+ * O dataset de cada passo é descartado antes do próximo para limitar
+ * o pico de memória ao maior passo.
+ */
+void VarreduraMemoria::executar() {
+    CarregadorDados carregador(seed, 1, std::numeric_limits<int>::max());
+    std::mt19937 geradorAmostra(seed);
+
+    const size_t limiteMemoria = topologia.memoriaFisica > 0
+        ? static_cast<size_t>(topologia.memoriaFisica * FRACAO_MEMORIA)
+        : std::numeric_limits<size_t>::max();
+
+    double passo = static_cast<double>(minChaves);
+    while (passo <= static_cast<double>(maxChaves)) {
+        const size_t n = static_cast<size_t>(std::llround(passo));
+        passo *= fatorPasso;
+
+        // TabelaAberta exige ocupação <= 0,5; encadeada usa fator de carga ~1
+        const size_t tamAberta = proximoPrimo(2 * n + 1);
+        const size_t tamEncadeada = proximoPrimo(n);
+
+        const size_t memAberta = tamAberta * TabelaAberta::BYTES_POR_POSICAO;
+        const size_t memEncadeada = tamEncadeada * TabelaEncadeada::BYTES_POR_POSICAO +
+                                    n * TabelaEncadeada::bytesPorChave();
+        const size_t memDados = n * sizeof(int) + std::min(n, MAX_AMOSTRA_BUSCA) * sizeof(int);
+        if (memDados + std::max(memAberta, memEncadeada) > limiteMemoria) {
+            std::cout << "  Passo de " << n << " chaves excede "
+                      << formatarBytes(limiteMemoria) << " de memória; varredura encerrada." << std::endl;
+            break;
+        }
+
+        RASTREAR_ESCOPO_DETALHE("passoVarredura", "varredura", std::to_string(n));
+        std::cout << "  Varredura com " << n << " chaves..." << std::flush;
+
+        auto dados = carregador.gerarNumerosAleatoriosComRepeticao(n);
+
+        // Amostra de chaves presentes em posições aleatórias do dataset
+        const size_t tamAmostra = std::min(n, MAX_AMOSTRA_BUSCA);
+        std::uniform_int_distribution<size_t> posicao(0, n - 1);
+        std::vector<int> amostra;
+        amostra.reserve(tamAmostra);
+        for (size_t i = 0; i < tamAmostra; ++i) {
+            amostra.push_back(dados[posicao(geradorAmostra)]);
+        }
+
+        medirMotor<TabelaEncadeada>("Encadeada", tamEncadeada, TabelaEncadeada::BYTES_POR_POSICAO,
+                                    TabelaEncadeada::bytesPorChave(), dados, amostra);
+        medirMotor<TabelaAberta>("Aberta", tamAberta, TabelaAberta::BYTES_POR_POSICAO,
+                                 TabelaAberta::bytesPorChave(), dados, amostra);
+
+        std::cout << " OK" << std::endl;
+    }
+}
+
+void VarreduraMemoria::imprimirRelatorio() const {
+    if (resultados.empty()) {
+        std::cout << "Nenhum resultado de varredura disponível." << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(92, '=') << std::endl;
+    std::cout << "VARREDURA DE WORKING SET" << std::endl;
+    std::cout << "L1d: " << formatarBytes(topologia.l1d)
+              << " | L2: " << formatarBytes(topologia.l2)
+              << " | LLC: " << formatarBytes(topologia.llc)
+              << " | Alcance TLB: " << formatarBytes(topologia.alcanceTLB())
+              << (topologia.tlbEstimada ? " (estimado)" : "") << std::endl;
+    std::cout << std::string(92, '=') << std::endl;
+
+    std::cout << std::left
+              << std::setw(10) << "Tipo"
+              << std::setw(14) << "Hash"
+              << std::setw(12) << "Chaves"
+              << std::setw(12) << "Work.Set"
+              << std::setw(7)  << "Nível"
+              << std::setw(10) << "ns/ins"
+              << std::setw(10) << "ns/busca"
+              << "Fronteira" << std::endl;
+    std::cout << std::string(92, '-') << std::endl;
+
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const auto& r = resultados[i];
+
+        // Procura o passo anterior do mesmo motor e hash
+        const ResultadoVarredura* anterior = nullptr;
+        for (size_t j = i; j-- > 0;) {
+            if (resultados[j].tipoTabela == r.tipoTabela && resultados[j].tipoFuncaoHash == r.tipoFuncaoHash) {
+                anterior = &resultados[j];
+                break;
+            }
+        }
+
+        std::string fronteira;
+        if (anterior && anterior->nivelMemoria != r.nivelMemoria) {
+            fronteira = "<- cruza " + r.nivelMemoria;
+        }
+        if (r.excedeTLB && (!anterior || !anterior->excedeTLB)) {
+            fronteira += fronteira.empty() ? "<- excede TLB" : ", excede TLB";
+        }
+
+        std::cout << std::left
+                  << std::setw(10) << r.tipoTabela
+                  << std::setw(14) << r.tipoFuncaoHash
+                  << std::setw(12) << r.quantidadeChaves
+                  << std::setw(12) << formatarBytes(r.workingSet)
+                  << std::setw(7)  << r.nivelMemoria
+                  << std::setw(10) << std::fixed << std::setprecision(1) << r.nsInsercao
+                  << std::setw(10) << std::fixed << std::setprecision(1) << r.nsBusca
+                  << fronteira << std::endl;
+    }
+
+    std::cout << std::string(92, '=') << std::endl;
+}
+
+void VarreduraMemoria::salvarResultados(const std::string& arquivo, const MetadadosExecucao& metadados) const {
+    std::ofstream arq(arquivo);
+    if (!arq.is_open()) {
+        throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
+    }
+    const std::string identificacao = metadados.valoresCsv();
+
+    arq << "TipoTabela,FuncaoHash,QuantidadeChaves,TamanhoTabela,WorkingSet(bytes),"
+        << "NivelMemoria,ExcedeTLB,NsInsercao,NsBusca," << MetadadosExecucao::CABECALHO_CSV << "\n";
+
+    for (const auto& r : resultados) {
+        arq << r.tipoTabela << ","
+            << r.tipoFuncaoHash << ","
+            << r.quantidadeChaves << ","
+            << r.tamanhoTabela << ","
+            << r.workingSet << ","
+            << r.nivelMemoria << ","
+            << (r.excedeTLB ? 1 : 0) << ","
+            << std::fixed << std::setprecision(2) << r.nsInsercao << ","
+            << std::setprecision(2) << r.nsBusca << "," << identificacao << "\n";
+    }
+
+    arq.close();
+    std::cout << "\nResultados da varredura salvos em: " << arquivo << std::endl;
+}
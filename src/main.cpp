@@ -11,7 +11,7 @@
  * 2. Executa testes com múltiplas configurações
  * 3. Mede tempos de inserção e busca com precisão
  * 4. Calcula estatísticas de colisões e fator de carga
- * 5. Gera relatórios em console e arquivo CSV
+ * 5. Gera relatórios em console, arquivo CSV e histórico JSON lines
  * 
  * @author Gabriel Freitas Souza
  * @author Roberli Schuina Silva
@@ -24,406 +24,2059 @@
 
 #include <iostream>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <limits>
+#include <cctype>
 #include <cmath>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
 
 #include "TabelaEncadeada.hpp"
 #include "TabelaAberta.hpp"
 #include "CarregadorDados.hpp"
+#include "ControleCache.hpp"
+#include "VarreduraMemoria.hpp"
+#include "ComparacaoAlocadores.hpp"
+#include "BenchmarkCrescimento.hpp"
+#include "BenchmarkPersistencia.hpp"
+#include "BenchmarkCompartilhada.hpp"
+#include "BenchmarkConjuntos.hpp"
+#include "BenchmarkDeduplicacao.hpp"
+#include "BenchmarkJuncao.hpp"
+#include "ComparacaoExecucoes.hpp"
+#include "DespachoCpu.hpp"
+#include "MetadadosExecucao.hpp"
+#include "EscritorJson.hpp"
+#include "Rastreamento.hpp"
+#include "ConfiguracaoBenchmark.hpp"
+#include "Estatistica.hpp"
+#include "ModeloSondagem.hpp"
+#include "ResultadoTeste.hpp"
+#include "SaidaResultados.hpp"
+#include "MedidorEnergia.hpp"
+#include "ProcessoIsolado.hpp"
+#include "RegistroMotores.hpp"
+#include "ServidorTabela.hpp"
+#include "GeradorCarga.hpp"
 
 /**
- * @brief Estrutura para armazenar resultados de um teste específico
- * 
- * Cada instância representa o resultado de um cenário de teste,
- * incluindo configuração usada e métricas coletadas.
- * 
- * Esta estrutura é usada para:
- * - Armazenar resultados temporariamente durante execução
- * - Gerar relatórios formatados
- * - Exportar dados para análise posterior (CSV)
+ * @brief Comparação estatística entre duas configurações
+ *
+ * As duas configurações diferem em um único fator (função hash ou motor)
+ * e compartilham dataset, mistura e threads. As amostras são as
+ * repetições de cada configuração.
  */
-struct ResultadoTeste {
-    std::string tipoTabela;      ///< "Encadeada" ou "Aberta"
-    size_t tamanhoTabela;        ///< Tamanho da tabela hash utilizada
-    size_t quantidadeDados;      ///< Número de elementos inseridos
-    std::string tipoFuncaoHash;  ///< "Divisao" ou "Multiplicacao"
-    double tempoInsercao;        ///< Tempo de inserção em milissegundos
-    double tempoBusca;           ///< Tempo de busca em milissegundos
-    size_t colisoes;             ///< Número estimado de colisões
-    double fatorCarga;           ///< Fator de carga (elementos/tamanho)
+struct ComparacaoConfiguracoes {
+    std::string fator;          ///< "hash" ou "motor"
+    std::string configuracaoA;  ///< Ex.: "Encadeada/29/Divisao"
+    std::string configuracaoB;  ///< Ex.: "Encadeada/29/Multiplicacao"
+    std::string contexto;       ///< Dataset (e mistura/threads, se houver)
+    std::string metrica;        ///< "insercao", "busca" ou "mistura"
+    size_t amostras;            ///< Repetições por configuração
+    double medianaA;            ///< Mediana de A em ms
+    double medianaB;            ///< Mediana de B em ms
+    double delta;               ///< Delta de Cliff (negativo: A mais rápida)
+    double pValor;              ///< p-valor do teste U de Mann-Whitney
+    double pAjustado;           ///< p-valor ajustado por Holm-Bonferroni
+    bool significativa;         ///< pAjustado < alfa
 };
 
 /**
  * @brief Classe gerenciadora de benchmarks
- * 
+ *
  * Responsável por:
- * - Executar testes sistemáticos nas tabelas hash
+ * - Expandir a ConfiguracaoBenchmark em cenários e executá-los
  * - Medir performance com precisão usando std::chrono
  * - Calcular estatísticas de colisões
  * - Gerar relatórios formatados
  * - Exportar resultados para arquivo CSV
- * 
+ *
  * A classe utiliza templates para medição genérica de tempo,
- * permitindo benchmarking de qualquer função lambda.
+ * permitindo benchmarking de qualquer função lambda, e para executar
+ * o mesmo cenário sobre qualquer motor de tabela hash.
  */
 class BenchmarkManager {
+public:
+    /**
+     * @brief Granularidade do isolamento por processo
+     */
+    enum class Isolamento {
+        NENHUM,     ///< Todos os cenários no processo principal
+        CENARIO,    ///< Um processo filho por cenário
+        MOTOR       ///< Um processo filho por motor x tamanho de tabela de cada dataset
+    };
+
 private:
     std::vector<ResultadoTeste> resultados;  ///< Armazena todos os resultados dos testes
+    std::vector<ComparacaoConfiguracoes> comparacoes; ///< Comparações da última análise
+    SaidaResultados saidaCsv;                ///< CSV gravado a cada cenário concluído
+    std::unique_ptr<MedidorEnergia> medidorEnergia; ///< Contadores RAPL (nullptr = sem energia)
+    Isolamento isolamento = Isolamento::NENHUM; ///< Processo de cada cenário
+    EvictorCache evictor;                    ///< Expulsa as caches antes das medições frias
+    unsigned int semente;                    ///< Semente dos datasets gerados e das buscas
+    std::string identificacao;               ///< Metadados gravados em cada linha do CSV (valoresCsv())
+    std::mt19937 geradorOperacoes;           ///< Sorteia as operações das fases mistas
+
+    /**
+     * @brief Tempos da fase de busca nos dois estados de cache
+     */
+    struct MedicaoBusca {
+        double fria;    ///< Tempo após evicção das caches (ms)
+        double quente;  ///< Tempo após pré-aquecimento da tabela (ms)
+        ConsumoEnergia energiaQuente;  ///< Energia da busca quente (com --energia)
+    };
+
+    /**
+     * @brief Um ponto da matriz de benchmarks
+     */
+    struct Cenario {
+        std::string motor;                  ///< Nome do motor em RegistroMotores.hpp
+        std::string hash;                   ///< "Divisao" ou "Multiplicacao"
+        size_t tamanhoTabela;               ///< Número de posições da tabela
+        const MisturaOperacoes* mistura;    ///< Fase mista (nullptr = nenhuma)
+        size_t threads;                     ///< Threads concorrentes na fase de busca
+        size_t repeticao;                   ///< Repetição (a partir de 1)
+    };
+
+    /**
+     * @brief Sondagens medidas na tabela construída
+     */
+    struct MedicaoSondagem {
+        double sucesso;     ///< Sondagens por busca bem-sucedida
+        double insucesso;   ///< Sondagens por busca malsucedida (0 se não analisada)
+    };
+
+    /**
+     * @brief Operação pré-gerada da fase mista
+     */
+    struct Operacao {
+        char tipo;  ///< 'b' busca, 'i' inserção, 'r' remoção
+        int valor;  ///< Chave da operação
+    };
 
     /**
      * @brief Template genérico para medição precisa de tempo
      * @tparam Func Tipo da função a ser medida
+     * @param fase Nome da fase medida, registrado no rastreamento
      * @param func Função lambda a ser executada e medida
+     * @param energia Recebe a energia da fase, se o medidor estiver ativo
      * @return Tempo de execução em milissegundos
-     * 
+     *
      * Utiliza std::chrono::high_resolution_clock para máxima precisão.
      * A conversão para milissegundos facilita interpretação dos resultados.
-     * 
+     * As leituras de energia (arquivos do sysfs) ficam fora do intervalo
+     * cronometrado.
+     *
      * @complexity O(1) + complexidade da função medida
      */
     template<typename Func>
-    double medirTempo(Func&& func) {
+    double medirTempo(const char* fase, Func&& func, ConsumoEnergia* energia = nullptr) {
+        RASTREAR_ESCOPO(fase, "benchmark");
+        static_cast<void>(fase); // Sem uso quando o rastreamento é removido na compilação
+        const bool medirEnergia = energia != nullptr && medidorEnergia != nullptr;
+        MedidorEnergia::Leitura energiaInicio;
+        if (medirEnergia) {
+            energiaInicio = medidorEnergia->ler();
+        }
         auto inicio = std::chrono::high_resolution_clock::now();
         func();  // Executa a função a ser medida
         auto fim = std::chrono::high_resolution_clock::now();
-        
-        // Converte para milissegundos com precisão decimal
-        auto duracao = std::chrono::duration_cast<std::chrono::microseconds>(fim - inicio);
-        return duracao.count() / 1000.0;
+        if (medirEnergia) {
+            *energia = medidorEnergia->consumo(energiaInicio, medidorEnergia->ler());
+        }
+
+        // Converte para milissegundos sem truncar em microssegundos, para
+        // reduzir empates entre repetições nos testes de significância
+        return std::chrono::duration<double, std::milli>(fim - inicio).count();
+    }
+
+    /**
+     * @brief Mede a fase de busca com caches frias e quentes
+     * @tparam Func Tipo da função de busca
+     * @param busca Função lambda que executa todas as buscas
+     * @return Tempos frio e quente em milissegundos
+     *
+     * - Frio: o EvictorCache percorre um buffer maior que a LLC antes da
+     *   medição, de modo que tabela e dados de busca vêm da memória principal
+     * - Quente: a busca é executada uma vez para pré-aquecer a tabela e a
+     *   execução seguinte é medida, refletindo o regime permanente
+     */
+    template<typename Func>
+    MedicaoBusca medirBusca(Func&& busca) {
+        MedicaoBusca medicao;
+
+        {
+            RASTREAR_ESCOPO("evictarCaches", "benchmark");
+            evictor.evictar();
+        }
+        medicao.fria = medirTempo("buscaFria", busca);
+
+        {
+            RASTREAR_ESCOPO("preAquecimento", "benchmark");
+            busca();
+        }
+        medicao.quente = medirTempo("buscaQuente", busca, &medicao.energiaQuente);
+
+        return medicao;
+    }
+
+    /**
+     * @brief Calcula estimativa de colisões segundo o modelo de sondagem do motor
+     * @tparam Tabela Motor conforme MotorTabela.hpp
+     * @param tabela Referência para a tabela
+     * @return Número estimado de colisões
+     *
+     * Com sondagem linear (MODELO_SONDAGEM = SONDAGEM_LINEAR), considera o
+     * clustering primário: colisões ≈ n * fc / 2, ou n com a tabela cheia.
+     *
+     * Nos demais motores, usa a distribuição de Poisson do número de chaves
+     * por posição inicial, com fator de carga λ = n/m:
+     * - Se λ ≤ 1: colisões ≈ n - m(1 - e^(-λ))
+     * - Se λ > 1: colisões ≈ n - m (saturação)
+     *
+     * A estimativa de Poisson conta chaves cuja posição inicial já estava
+     * ocupada e não depende de como o motor resolve a colisão.
+     */
+    template<typename Tabela>
+    size_t contarColisoes(const Tabela& tabela) {
+        RASTREAR_ESCOPO("estatisticas", "benchmark");
+        size_t elementos = tabela.getNumElementos();
+        size_t tamanho = tabela.getTamanho();
+
+        if constexpr (modeloSondagemMotor<Tabela> == ModeloSondagem::SONDAGEM_LINEAR) {
+            if (elementos <= tamanho) {
+                double fc = tabela.fatorCarga();
+                // Aproximação considerando clustering primário
+                return static_cast<size_t>(elementos * fc / 2.0);
+            }
+            return elementos; // Caso extremo: tabela cheia
+        } else {
+            if (elementos <= tamanho) {
+                double lambda = static_cast<double>(elementos) / tamanho;
+                // Aproximação: colisões = n - m * (1 - e^(-λ))
+                return static_cast<size_t>(elementos - tamanho * (1 - std::exp(-lambda)));
+            }
+
+            // Para fator de carga > 1, número de colisões ≈ elementos - tamanho
+            return elementos - tamanho;
+        }
+    }
+
+    /**
+     * @brief Mede as sondagens da tabela construída
+     * @param tabela Tabela já preenchida
+     * @param tipo Função hash usada na construção
+     * @return Sondagens por busca bem-sucedida e malsucedida
+     *
+     * Usa analisarSondagem() quando o motor a oferece (TabelaAberta) ou a
+     * posição média nas listas de obterEstatisticas() (TabelaEncadeada,
+     * cujas buscas malsucedidas examinam em média exatamente α nós e não
+     * são analisadas). Motores sem nenhuma das duas ficam com zero.
+     */
+    template<typename Tabela>
+    static MedicaoSondagem medirSondagens(const Tabela& tabela, typename Tabela::TipoHash tipo) {
+        if constexpr (TemAnaliseSondagem<Tabela>::value) {
+            auto stats = tabela.analisarSondagem(tipo);
+            return {stats.sondagemMedia, stats.sondagemMediaInsucesso};
+        } else if constexpr (TemEstatisticasDistribuicao<Tabela>::value) {
+            static_cast<void>(tipo);
+            return {tabela.obterEstatisticas().sondagemMediaSucesso, 0.0};
+        } else {
+            static_cast<void>(tabela);
+            static_cast<void>(tipo);
+            return {0.0, 0.0};
+        }
+    }
+
+    /**
+     * @brief Executa todas as buscas em uma ou mais threads
+     * @param tabela Tabela já preenchida
+     * @param tipo Função hash usada na construção
+     * @param dadosBusca Dataset para busca
+     * @param threads Número de threads concorrentes
+     *
+     * Com mais de uma thread, cada thread busca todo o dataset de busca na
+     * mesma tabela (somente leituras, sem travas). O tempo medido pelo
+     * chamador é o de parede e inclui a criação das threads.
+     */
+    template<typename Tabela>
+    static void buscarConcorrente(const Tabela& tabela, typename Tabela::TipoHash tipo,
+                                  const std::vector<int>& dadosBusca, size_t threads) {
+        auto buscarTodos = [&]() {
+            for (int valor : dadosBusca) {
+                tabela.buscar(valor, tipo);
+            }
+        };
+
+        if (threads <= 1) {
+            buscarTodos();
+            return;
+        }
+
+        std::vector<std::thread> trabalhadores;
+        trabalhadores.reserve(threads);
+        for (size_t t = 0; t < threads; ++t) {
+            trabalhadores.emplace_back(buscarTodos);
+        }
+        for (auto& trabalhador : trabalhadores) {
+            trabalhador.join();
+        }
+    }
+
+    /**
+     * @brief Sorteia a sequência de operações de uma fase mista
+     * @param mistura Percentuais de busca, inserção e remoção
+     * @param quantidade Número de operações
+     * @param dados Dataset inserido (origem das remoções)
+     * @param dadosBusca Dataset para busca (origem das buscas)
+     * @return Operações na ordem de execução
+     *
+     * A sequência é gerada fora da região medida. Inserções usam chaves
+     * decrescentes a partir de INT_MAX, fora do intervalo dos datasets,
+     * para que cada inserção acrescente um elemento novo.
+     */
+    std::vector<Operacao> gerarOperacoes(const MisturaOperacoes& mistura, size_t quantidade,
+                                         const std::vector<int>& dados,
+                                         const std::vector<int>& dadosBusca) {
+        std::uniform_int_distribution<unsigned> percentual(0, 99);
+        std::uniform_int_distribution<size_t> posicaoDados(0, dados.size() - 1);
+        std::uniform_int_distribution<size_t> posicaoBusca(0, dadosBusca.size() - 1);
+        int chaveNova = std::numeric_limits<int>::max();
+
+        std::vector<Operacao> operacoes;
+        operacoes.reserve(quantidade);
+        for (size_t i = 0; i < quantidade; ++i) {
+            unsigned sorteio = percentual(geradorOperacoes);
+            if (sorteio < mistura.busca) {
+                operacoes.push_back({'b', dadosBusca[posicaoBusca(geradorOperacoes)]});
+            } else if (sorteio < mistura.busca + mistura.insercao) {
+                operacoes.push_back({'i', chaveNova--});
+            } else {
+                operacoes.push_back({'r', dados[posicaoDados(geradorOperacoes)]});
+            }
+        }
+        return operacoes;
+    }
+
+    /**
+     * @brief Executa uma sequência de operações mistas
+     *
+     * Inserções recusadas pela TabelaAberta (ocupação acima do limite, sem
+     * redimensionamento) são ignoradas e contam apenas o tempo da recusa.
+     */
+    template<typename Tabela>
+    static void executarOperacoes(Tabela& tabela, typename Tabela::TipoHash tipo,
+                                  const std::vector<Operacao>& operacoes) {
+        for (const auto& operacao : operacoes) {
+            switch (operacao.tipo) {
+                case 'b':
+                    tabela.buscar(operacao.valor, tipo);
+                    break;
+                case 'i':
+                    try {
+                        tabela.inserir(operacao.valor, tipo);
+                    } catch (const std::runtime_error&) {
+                        // Tabela cheia ou fator de carga muito alto
+                    }
+                    break;
+                default:
+                    tabela.remover(operacao.valor, tipo);
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Executa um cenário completo sobre um motor de tabela hash
+     * @tparam Tabela Motor registrado em RegistroMotores.hpp
+     * @param cenario Ponto da matriz a executar
+     * @param rotuloDataset Origem dos dados, registrada no resultado
+     * @param dados Dataset para inserção
+     * @param dadosBusca Dataset para busca
+     * @param operacoesMistura Número de operações da fase mista
+     *
+     * Para cada cenário:
+     * - Cria nova instância da tabela
+     * - Mede tempo de inserção de todos os elementos; se a tabela recusar
+     *   uma inserção (TabelaAberta cheia ou com fator de carga muito alto),
+     *   a inserção é interrompida
+     * - Mede tempo de busca de elementos do dataset de busca, com caches
+     *   frias (primeiro acesso) e quentes (regime permanente)
+     * - Calcula estatísticas (colisões, fator de carga, sondagens)
+     * - Executa e mede a fase mista, se houver
+     *
+     * O resultado é devolvido em vez de registrado para que o cenário
+     * possa rodar num processo filho (isolamento) e voltar pelo pipe.
+     *
+     * @complexity O(n + t*b + o) onde n é tamanho de dados, b é tamanho de
+     *             dadosBusca, t o número de threads e o o de operações mistas
+     */
+    template<typename Tabela>
+    ResultadoTeste executarCenario(const Cenario& cenario, const std::string& rotuloDataset,
+                         const std::vector<int>& dados, const std::vector<int>& dadosBusca,
+                         size_t operacoesMistura) {
+        static_assert(ehMotorTabela<Tabela>, "Tabela não satisfaz a interface de MotorTabela.hpp");
+        RASTREAR_ESCOPO_DETALHE(cenario.hash == "Divisao" ? "Divisao" : "Multiplicacao", "benchmark",
+                                "threads=" + std::to_string(cenario.threads) +
+                                " repeticao=" + std::to_string(cenario.repeticao) +
+                                (cenario.mistura ? " mistura=" + cenario.mistura->rotulo() : ""));
+        const auto tipo = cenario.hash == "Divisao"
+            ? Tabela::TipoHash::DIVISAO
+            : Tabela::TipoHash::MULTIPLICACAO;
+
+        Tabela tabela(cenario.tamanhoTabela);
+
+        // Mede tempo de inserção
+        bool interrompida = false;
+        size_t insercoes = 0;
+        ConsumoEnergia energiaInsercao;
+        double tempoInsercao = medirTempo("insercao", [&]() {
+            for (int valor : dados) {
+                try {
+                    tabela.inserir(valor, tipo);
+                    ++insercoes;
+                } catch (const std::runtime_error&) {
+                    // Para se tabela cheia ou fator de carga muito alto
+                    interrompida = true;
+                    break;
+                }
+            }
+        }, &energiaInsercao);
+
+        // Mede tempo de busca
+        MedicaoBusca tempoBusca = medirBusca([&]() {
+            buscarConcorrente(tabela, tipo, dadosBusca, cenario.threads);
+        });
+
+        // Estatísticas refletem a tabela construída, antes da fase mista
+        size_t colisoes = contarColisoes(tabela);
+        double fatorCarga = tabela.fatorCarga();
+        MedicaoSondagem sondagem = medirSondagens(tabela, tipo);
+
+        double tempoMistura = 0.0;
+        ConsumoEnergia energiaMistura;
+        const bool temMistura = cenario.mistura && !dados.empty() && !dadosBusca.empty();
+        if (temMistura) {
+            auto operacoes = gerarOperacoes(*cenario.mistura, operacoesMistura, dados, dadosBusca);
+            tempoMistura = medirTempo("mistura", [&]() {
+                executarOperacoes(tabela, tipo, operacoes);
+            }, &energiaMistura);
+        }
+
+        ResultadoTeste resultado;
+        resultado.tipoTabela = cenario.motor;
+        resultado.tamanhoTabela = cenario.tamanhoTabela;
+        // Pode ser menor que dados.size() se a inserção foi interrompida
+        resultado.quantidadeDados = interrompida ? tabela.getNumElementos() : dados.size();
+        resultado.tipoFuncaoHash = cenario.hash;
+        resultado.tempoInsercao = tempoInsercao;
+        resultado.tempoBusca = tempoBusca.quente;
+        resultado.tempoBuscaFria = tempoBusca.fria;
+        resultado.colisoes = colisoes;
+        resultado.fatorCarga = fatorCarga;
+        resultado.dataset = rotuloDataset;
+        resultado.mistura = cenario.mistura ? cenario.mistura->rotulo() : "-";
+        resultado.tempoMistura = tempoMistura;
+        resultado.threads = cenario.threads;
+        resultado.repeticao = cenario.repeticao;
+        resultado.operacoesInsercao = insercoes;
+        resultado.operacoesBusca = dadosBusca.size() * std::max<size_t>(cenario.threads, 1);
+        resultado.operacoesMistura = temMistura ? operacoesMistura : 0;
+        resultado.sondagemSucesso = sondagem.sucesso;
+        resultado.sondagemInsucesso = sondagem.insucesso;
+        resultado.energiaMedida = medidorEnergia != nullptr;
+        resultado.energiaInsercao = energiaInsercao;
+        resultado.energiaBusca = tempoBusca.energiaQuente;
+        resultado.energiaMistura = energiaMistura;
+        resultado.identificacao = identificacao;
+        return resultado;
+    }
+
+    /**
+     * @brief Grava um cenário concluído no CSV e o guarda para os relatórios
+     *
+     * A gravação é imediata para que uma interrupção não perca o cenário.
+     */
+    void registrarResultado(ResultadoTeste resultado) {
+        saidaCsv.registrar(resultado);
+        resultados.push_back(std::move(resultado));
+    }
+
+    /**
+     * @brief Serializa resultados e o estado do gerador para o pipe
+     * @param lote Resultados medidos no processo filho
+     * @param gerador Gerador das fases mistas após as medições
+     * @return Texto com uma linha CSV e uma linha "T" por resultado,
+     *         seguidas do estado do gerador
+     *
+     * A linha CSV arredonda tempos, fator de carga e sondagens; a linha "T"
+     * os repete com precisão total, como seriam mantidos sem isolamento,
+     * para não criar empates artificiais nos testes de significância.
+     */
+    static std::string serializarLote(const std::vector<ResultadoTeste>& lote, const std::mt19937& gerador) {
+        std::ostringstream saida;
+        for (const auto& resultado : lote) {
+            SaidaResultados::escreverLinha(saida, resultado);
+            saida << "T " << std::setprecision(std::numeric_limits<double>::max_digits10)
+                  << resultado.tempoInsercao << " " << resultado.tempoBusca << " "
+                  << resultado.tempoBuscaFria << " " << resultado.tempoMistura << " "
+                  << resultado.fatorCarga << " " << resultado.sondagemSucesso << " "
+                  << resultado.sondagemInsucesso << "\n";
+        }
+        saida << "G " << gerador << "\n";
+        return saida.str();
+    }
+
+    /**
+     * @brief Reconstrói os resultados enviados pelo processo filho
+     * @param texto Saída de serializarLote
+     * @param gerador Recebe o estado do gerador do filho, para que as fases
+     *        mistas seguintes sorteiem as mesmas operações que sem isolamento
+     * @throws std::runtime_error se o texto estiver mal formado
+     */
+    static std::vector<ResultadoTeste> desserializarLote(const std::string& texto, std::mt19937& gerador) {
+        std::vector<ResultadoTeste> lote;
+        std::istringstream entrada(texto);
+        std::string linha;
+        bool temGerador = false;
+        while (std::getline(entrada, linha)) {
+            if (linha.rfind("T ", 0) == 0 && !lote.empty()) {
+                std::istringstream tempos(linha.substr(2));
+                auto& r = lote.back();
+                tempos >> r.tempoInsercao >> r.tempoBusca >> r.tempoBuscaFria >> r.tempoMistura
+                       >> r.fatorCarga >> r.sondagemSucesso >> r.sondagemInsucesso;
+            } else if (linha.rfind("G ", 0) == 0) {
+                std::istringstream estado(linha.substr(2));
+                temGerador = static_cast<bool>(estado >> gerador);
+            } else {
+                ResultadoTeste resultado;
+                if (!SaidaResultados::lerLinha(linha, resultado)) {
+                    throw std::runtime_error("Resultado mal formado do processo isolado: " + linha);
+                }
+                lote.push_back(std::move(resultado));
+            }
+        }
+        if (!temGerador) {
+            throw std::runtime_error("Processo isolado não enviou o estado do gerador");
+        }
+        return lote;
+    }
+
+    /**
+     * @brief Executa medições num processo filho e traz os resultados
+     * @tparam Func Função que mede e devolve std::vector<ResultadoTeste>
+     * @param medir Medições a executar no filho
+     * @return Resultados medidos no filho
+     */
+    template<typename Func>
+    std::vector<ResultadoTeste> executarIsolado(Func&& medir) {
+        const std::string resposta = executarEmProcessoFilho([&]() {
+            return serializarLote(medir(), geradorOperacoes);
+        });
+        return desserializarLote(resposta, geradorOperacoes);
+    }
+
+    /**
+     * @brief Tempos das repetições de um cenário, por fase do critério de estabilidade
+     *
+     * Índices 0, 1 e 2: inserção, busca quente e fase mista (vazio sem
+     * fase mista).
+     */
+    using AmostrasFases = std::array<std::vector<double>, 3>;
+
+    /**
+     * @brief Intervalos de confiança das fases de um cenário
+     */
+    struct AvaliacaoEstabilidade {
+        size_t repeticoes;                          ///< Repetições avaliadas
+        std::array<IntervaloQuantil, 3> medianas;   ///< IC da mediana por fase
+        std::array<IntervaloQuantil, 3> p99;        ///< IC do p99 por fase (se exigido)
+        double precisao;        ///< Maior semiamplitude relativa das medianas
+        double precisaoP99;     ///< Maior semiamplitude relativa dos p99 (0 se não exigido)
+        bool estavel;           ///< Critério atendido com ao menos o mínimo de repetições
+    };
+
+    /**
+     * @brief Acrescenta os tempos de uma repetição às amostras do cenário
+     */
+    static void acumularAmostras(AmostrasFases& amostras, const ResultadoTeste& resultado) {
+        amostras[0].push_back(resultado.tempoInsercao);
+        amostras[1].push_back(resultado.tempoBusca);
+        if (resultado.operacoesMistura > 0) {
+            amostras[2].push_back(resultado.tempoMistura);
+        }
+    }
+
+    /**
+     * @brief Avalia o critério de estabilidade sobre as repetições de um cenário
+     * @param amostras Tempos das repetições
+     * @param criterio Precisões, confiança e mínimo de repetições
+     * @return Intervalos de cada fase e se o critério foi atendido
+     *
+     * O cenário está estável quando, em todas as fases medidas, o IC da
+     * mediana (e do p99, se precisaoP99 > 0) tem semiamplitude relativa
+     * dentro da precisão. A busca fria fica fora do critério: com a evicção
+     * antes de cada medição, sua dispersão reflete a memória, não o ruído.
+     */
+    static AvaliacaoEstabilidade avaliarEstabilidade(const AmostrasFases& amostras,
+                                                     const CriterioEstabilidade& criterio) {
+        AvaliacaoEstabilidade avaliacao{};
+        avaliacao.repeticoes = amostras[0].size();
+        avaliacao.estavel = avaliacao.repeticoes >= criterio.minimo;
+        for (size_t fase = 0; fase < amostras.size(); ++fase) {
+            if (amostras[fase].empty()) {
+                // Fase não medida: intervalos com estimativa NaN
+                avaliacao.medianas[fase] = avaliacao.p99[fase] = intervaloQuantil({}, 0.5, criterio.confianca);
+                continue;
+            }
+            avaliacao.medianas[fase] = intervaloQuantil(amostras[fase], 0.5, criterio.confianca);
+            avaliacao.precisao = std::max(avaliacao.precisao, avaliacao.medianas[fase].semiamplitudeRelativa());
+            if (criterio.precisaoP99 > 0.0) {
+                avaliacao.p99[fase] = intervaloQuantil(amostras[fase], 0.99, criterio.confianca);
+                avaliacao.precisaoP99 = std::max(avaliacao.precisaoP99, avaliacao.p99[fase].semiamplitudeRelativa());
+            }
+        }
+        avaliacao.estavel = avaliacao.estavel && avaliacao.precisao <= criterio.precisao &&
+                            (criterio.precisaoP99 <= 0.0 || avaliacao.precisaoP99 <= criterio.precisaoP99);
+        return avaliacao;
+    }
+
+    /**
+     * @brief Percorre os cenários de um motor com um tamanho de tabela
+     * @param executar Mede um cenário, registra o resultado e o devolve
+     *
+     * Expande hash x mistura x threads x repetição. Com repetições fixas,
+     * a repetição vai de 1 a config.repeticoes. No modo até estabilizar,
+     * cada cenário se repete até avaliarEstabilidade() ser atendido, o
+     * orçamento de tempo esgotar ou o máximo de repetições ser atingido;
+     * o orçamento prevalece sobre o mínimo, mas ao menos uma repetição é
+     * medida. Repetições presentes no CSV retomado são puladas e entram
+     * como amostras do critério.
+     */
+    template<typename Func>
+    void percorrerCenarios(const ConfiguracaoBenchmark& config, const std::string& motor,
+                           size_t tamanhoTabela, const std::string& rotuloDataset, Func&& executar) {
+        using Relogio = std::chrono::steady_clock;
+        const CriterioEstabilidade& criterio = config.estabilidade;
+
+        // Sem misturas configuradas, cada cenário roda sem fase mista
+        std::vector<const MisturaOperacoes*> misturas;
+        for (const auto& mistura : config.misturas) {
+            misturas.push_back(&mistura);
+        }
+        if (misturas.empty()) {
+            misturas.push_back(nullptr);
+        }
+
+        for (const auto& hash : config.hashes) {
+            for (const MisturaOperacoes* mistura : misturas) {
+                for (size_t threads : config.threads) {
+                    AmostrasFases amostras;
+                    const auto inicio = Relogio::now();
+                    for (size_t repeticao = 1;; ++repeticao) {
+                        if (!criterio.ativo) {
+                            if (repeticao > config.repeticoes) break;
+                        } else if (repeticao > 1) {
+                            const double decorrido = std::chrono::duration<double>(Relogio::now() - inicio).count();
+                            if (decorrido >= criterio.orcamentoSegundos ||
+                                amostras[0].size() >= criterio.maximo ||
+                                avaliarEstabilidade(amostras, criterio).estavel) {
+                                break;
+                            }
+                        }
+
+                        const std::string chave = ResultadoTeste::chave(rotuloDataset, motor, tamanhoTabela, hash,
+                                                                        mistura ? mistura->rotulo() : "-",
+                                                                        threads, repeticao);
+                        if (saidaCsv.concluido(chave)) {
+                            if (criterio.ativo) {
+                                auto retomado = std::find_if(resultados.begin(), resultados.end(),
+                                    [&chave](const ResultadoTeste& r) { return r.chaveCenario() == chave; });
+                                if (retomado != resultados.end()) {
+                                    acumularAmostras(amostras, *retomado);
+                                }
+                            }
+                            continue;
+                        }
+                        acumularAmostras(amostras, executar(Cenario{motor, hash, tamanhoTabela, mistura,
+                                                                    threads, repeticao}));
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Conta os cenários de um motor e tamanho já presentes no CSV retomado
+     * @return Repetições retomadas até o limite da execução (repeticoes ou maximo)
+     */
+    size_t contarRetomados(const ConfiguracaoBenchmark& config, const std::string& motor,
+                           size_t tamanhoTabela, const std::string& rotuloDataset) const {
+        const size_t limite = config.estabilidade.ativo ? config.estabilidade.maximo : config.repeticoes;
+        std::vector<std::string> misturas;
+        for (const auto& mistura : config.misturas) {
+            misturas.push_back(mistura.rotulo());
+        }
+        if (misturas.empty()) {
+            misturas.push_back("-");
+        }
+
+        size_t retomados = 0;
+        for (const auto& hash : config.hashes) {
+            for (const auto& mistura : misturas) {
+                for (size_t threads : config.threads) {
+                    for (size_t repeticao = 1; repeticao <= limite; ++repeticao) {
+                        retomados += saidaCsv.concluido(ResultadoTeste::chave(rotuloDataset, motor, tamanhoTabela,
+                                                                              hash, mistura, threads, repeticao));
+                    }
+                }
+            }
+        }
+        return retomados;
+    }
+
+    /**
+     * @brief Executa todos os cenários de um motor com um tamanho de tabela
+     *
+     * Despacha cada cenário de percorrerCenarios() para o template
+     * executarCenario do motor registrado com esse nome; a escolha do tipo
+     * ocorre uma vez por cenário, fora das regiões medidas. Com isolamento, cada cenário
+     * (ou o percurso inteiro, no isolamento por motor) roda num processo
+     * filho; no modo até estabilizar a decisão de parar acompanha o
+     * percurso, dentro do filho.
+     */
+    void executarMotor(const ConfiguracaoBenchmark& config, const std::string& motor,
+                       size_t tamanhoTabela, const std::string& rotuloDataset,
+                       const std::vector<int>& dados, const std::vector<int>& dadosBusca) {
+        RASTREAR_ESCOPO_DETALHE("testarMotor", "benchmark",
+                                motor + " dados=" + std::to_string(dados.size()) +
+                                " tamanho=" + std::to_string(tamanhoTabela));
+        std::string nomeMotor = motor;
+        std::transform(nomeMotor.begin(), nomeMotor.end(), nomeMotor.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        std::cout << "  Testando tabela " << nomeMotor
+                  << " (tamanho: " << tamanhoTabela << ")..." << std::flush;
+
+        const size_t retomados = contarRetomados(config, motor, tamanhoTabela, rotuloDataset);
+
+        auto medir = [&](const Cenario& cenario) {
+            ResultadoTeste resultado;
+            const bool registrado = visitarMotor(motor, [&](const auto& motorRegistrado) {
+                using Tabela = typename std::decay_t<decltype(motorRegistrado)>::Tabela;
+                resultado = executarCenario<Tabela>(cenario, rotuloDataset, dados, dadosBusca,
+                                                    config.operacoesMistura);
+                resultado.modeloSondagem = motorRegistrado.modelo;
+            });
+            if (!registrado) {
+                throw std::runtime_error("Motor não registrado: " + motor);
+            }
+            return resultado;
+        };
+
+        switch (isolamento) {
+            case Isolamento::NENHUM:
+                percorrerCenarios(config, motor, tamanhoTabela, rotuloDataset, [&](const Cenario& cenario) {
+                    ResultadoTeste resultado = medir(cenario);
+                    registrarResultado(resultado);
+                    return resultado;
+                });
+                break;
+            case Isolamento::CENARIO:
+                percorrerCenarios(config, motor, tamanhoTabela, rotuloDataset, [&](const Cenario& cenario) {
+                    auto lote = executarIsolado([&]() {
+                        return std::vector<ResultadoTeste>{medir(cenario)};
+                    });
+                    registrarResultado(lote.front());
+                    return lote.front();
+                });
+                break;
+            case Isolamento::MOTOR:
+                for (auto& resultado : executarIsolado([&]() {
+                         std::vector<ResultadoTeste> lote;
+                         percorrerCenarios(config, motor, tamanhoTabela, rotuloDataset,
+                                           [&](const Cenario& cenario) {
+                             lote.push_back(medir(cenario));
+                             return lote.back();
+                         });
+                         return lote;
+                     })) {
+                    registrarResultado(std::move(resultado));
+                }
+                break;
+        }
+
+        std::cout << " OK";
+        if (retomados > 0) {
+            std::cout << " (" << retomados << " retomado(s))";
+        }
+        std::cout << std::endl;
+    }
+
+    /**
+     * @brief Calcula os tamanhos de tabela de um motor para um dataset
+     * @param dimensionamento Tamanhos fixos e fatores de carga do motor
+     * @param quantidade Número de elementos do dataset
+     * @return Tamanhos fixos seguidos dos derivados (menor primo >= n / fator)
+     */
+    static std::vector<size_t> tamanhosPara(const DimensionamentoMotor& dimensionamento, size_t quantidade) {
+        std::vector<size_t> tamanhos = dimensionamento.tamanhos;
+        for (double fator : dimensionamento.fatoresCarga) {
+            tamanhos.push_back(VarreduraMemoria::proximoPrimo(
+                static_cast<size_t>(std::ceil(quantidade / fator))));
+        }
+        return tamanhos;
+    }
+
+    /**
+     * @brief Gera um dataset sintético
+     * @param carregador Gerador de números aleatórios
+     * @param distribuicao Tipo e quantidade de chaves
+     * @return Chaves geradas
+     */
+    static std::vector<int> gerarDistribuicao(CarregadorDados& carregador,
+                                              const DistribuicaoDados& distribuicao) {
+        if (distribuicao.tipo == "sequencial") {
+            std::vector<int> dados(distribuicao.quantidade);
+            std::iota(dados.begin(), dados.end(), 1);
+            return dados;
+        }
+        return carregador.gerarNumerosAleatoriosComRepeticao(distribuicao.quantidade);
+    }
+
+    /**
+     * @brief Verifica se algum resultado usa dimensões além da matriz original
+     * @return true se há threads, repetições ou fases mistas a exibir
+     */
+    bool matrizEstendida() const {
+        return std::any_of(resultados.begin(), resultados.end(), [](const ResultadoTeste& r) {
+            return r.threads > 1 || r.repeticao > 1 || r.mistura != "-";
+        });
+    }
+
+public:
+    /**
+     * @brief Construtor do gerenciador
+     * @param metadados Ambiente e semente da execução, gravados em cada
+     *        cenário do CSV
+     *
+     * O carregador usa a semente diretamente e as fases mistas usam
+     * semente + 1, de modo que a mesma semente reproduz dadosBusca, os
+     * datasets gerados e as sequências de operações.
+     */
+    explicit BenchmarkManager(const MetadadosExecucao& metadados)
+        : semente(metadados.semente), identificacao(metadados.valoresCsv()),
+          geradorOperacoes(metadados.semente + 1u) {}
+
+    /**
+     * @brief Define se os cenários rodam em processos filhos
+     * @param modo Granularidade do isolamento
+     * @throws std::runtime_error se a plataforma não tiver fork()
+     */
+    void definirIsolamento(Isolamento modo) {
+        if (modo != Isolamento::NENHUM && !isolamentoDisponivel()) {
+            throw std::runtime_error("Isolamento por processo indisponível nesta plataforma");
+        }
+        isolamento = modo;
+    }
+
+    /**
+     * @brief Obtém os resultados medidos (e retomados)
+     */
+    const std::vector<ResultadoTeste>& getResultados() const {
+        return resultados;
+    }
+
+    /**
+     * @brief Ativa a medição de energia das fases pelos contadores RAPL
+     * @return true se os contadores estão disponíveis
+     *
+     * Sem powercap, sem RAPL (VMs, outras arquiteturas) ou sem permissão de
+     * leitura, avisa o motivo e o benchmark segue só com tempos.
+     */
+    bool ativarEnergia() {
+        auto medidor = std::make_unique<MedidorEnergia>();
+        if (!medidor->disponivel()) {
+            std::cerr << "Aviso: medição de energia indisponível (" << medidor->getMotivoIndisponivel()
+                      << "); seguindo sem energia." << std::endl;
+            return false;
+        }
+        std::cout << "Energia medida por RAPL: " << medidor->descricao() << std::endl;
+        medidorEnergia = std::move(medidor);
+        return true;
+    }
+
+    /**
+     * @brief Expande a configuração em cenários e executa todos
+     * @param config Matriz de benchmarks
+     *
+     * Ordem de expansão: dataset -> motor -> tamanho -> hash -> mistura ->
+     * threads -> repetição. Tamanhos derivados de fatores de carga são
+     * recalculados para cada dataset. Falhas em um dataset são reportadas
+     * e a execução continua com o próximo.
+     *
+     * @complexity O(d * c * n) onde d é o número de datasets, c o número
+     *             de cenários por dataset e n o tamanho médio dos datasets
+     */
+    void executar(const ConfiguracaoBenchmark& config) {
+        CarregadorDados carregador(semente);
+
+        // Geração de dataset para operações de busca (números aleatórios entre 1 e 1.000.000)
+        std::cout << "\nGerando dados para busca (" << config.quantidadeBuscas
+                  << " números aleatórios entre 1 e 1.000.000)...";
+        auto dadosBusca = carregador.gerarNumerosAleatoriosComRepeticao(config.quantidadeBuscas);
+        std::cout << " OK\n";
+
+        // Datasets de arquivo seguidos dos gerados
+        std::vector<std::string> rotulos = config.arquivos;
+        for (const auto& distribuicao : config.distribuicoes) {
+            rotulos.push_back(distribuicao.rotulo());
+        }
+
+        // Loop principal: testa cada dataset
+        for (size_t d = 0; d < rotulos.size(); ++d) {
+            const std::string& rotulo = rotulos[d];
+            try {
+                RASTREAR_ESCOPO_DETALHE("dataset", "benchmark", rotulo);
+                std::vector<int> dados;
+                if (d < config.arquivos.size()) {
+                    std::cout << "\nCarregando dados de: " << rotulo << std::endl;
+                    dados = carregador.carregarDeArquivo(rotulo);
+                } else {
+                    std::cout << "\nGerando dados: " << rotulo << std::endl;
+                    dados = gerarDistribuicao(carregador, config.distribuicoes[d - config.arquivos.size()]);
+                }
+
+                std::cout << "Executando testes com " << dados.size() << " elementos:" << std::endl;
+
+                for (const auto& motor : config.motores) {
+                    for (size_t tamanho : tamanhosPara(config.dimensionamento.at(motor), dados.size())) {
+                        executarMotor(config, motor, tamanho, rotulo, dados, dadosBusca);
+                    }
+                }
+
+            } catch (const std::exception& e) {
+                std::cerr << "Erro ao processar dataset " << rotulo << ": "
+                          << e.what() << std::endl;
+                continue; // Continua com próximo dataset
+            }
+        }
+    }
+
+    /**
+     * @brief Anexa a execução atual ao histórico de resultados
+     * @param arquivo Caminho do histórico (JSON lines)
+     * @param metadados Revisão, data e máquina da execução
+     * @param config Parâmetros do benchmark executado
+     * @throws std::runtime_error se não conseguir abrir o arquivo
+     *
+     * Cada execução ocupa exatamente uma linha JSON e o arquivo só é
+     * aberto em modo de anexação, de modo que execuções anteriores nunca
+     * são reescritas. O index.html carrega este arquivo para exibir a
+     * evolução do desempenho ao longo das alterações.
+     *
+     * @complexity O(r) onde r é o número de resultados
+     */
+    void anexarHistorico(const std::string& arquivo,
+                         const MetadadosExecucao& metadados,
+                         const ConfiguracaoBenchmark& config) {
+        RASTREAR_ESCOPO("anexarHistorico", "relatorio");
+        EscritorJson json;
+        json.abrirObjeto();
+        metadados.escreverJson(json);
+        json.campo("modo", "padrao").abrirObjeto("config");
+        config.escreverJson(json);
+        json.fecharObjeto().abrirArray("resultados");
+
+        for (const auto& resultado : resultados) {
+            json.abrirObjeto()
+                .campo("TipoTabela", resultado.tipoTabela)
+                .campo("TamanhoTabela", resultado.tamanhoTabela)
+                .campo("QuantidadeDados", resultado.quantidadeDados)
+                .campo("FuncaoHash", resultado.tipoFuncaoHash)
+                .campo("TempoInsercao(ms)", resultado.tempoInsercao)
+                .campo("TempoBusca(ms)", resultado.tempoBusca)
+                .campo("TempoBuscaFria(ms)", resultado.tempoBuscaFria)
+                .campo("Colisoes", resultado.colisoes)
+                .campo("FatorCarga", resultado.fatorCarga)
+                .campo("Dataset", resultado.dataset)
+                .campo("Mistura", resultado.mistura)
+                .campo("TempoMistura(ms)", resultado.tempoMistura)
+                .campo("Threads", resultado.threads)
+                .campo("Repeticao", resultado.repeticao)
+                .campo("OpsInsercao", resultado.operacoesInsercao)
+                .campo("OpsBusca", resultado.operacoesBusca)
+                .campo("OpsMistura", resultado.operacoesMistura)
+                .campo("NsInsercao", ResultadoTeste::nsPorOperacao(resultado.tempoInsercao, resultado.operacoesInsercao))
+                .campo("MopsInsercao", ResultadoTeste::mopsPorSegundo(resultado.tempoInsercao, resultado.operacoesInsercao))
+                .campo("NsBusca", ResultadoTeste::nsPorOperacao(resultado.tempoBusca, resultado.operacoesBusca))
+                .campo("MopsBusca", ResultadoTeste::mopsPorSegundo(resultado.tempoBusca, resultado.operacoesBusca))
+                .campo("NsBuscaFria", ResultadoTeste::nsPorOperacao(resultado.tempoBuscaFria, resultado.operacoesBusca))
+                .campo("MopsBuscaFria", ResultadoTeste::mopsPorSegundo(resultado.tempoBuscaFria, resultado.operacoesBusca))
+                .campo("NsMistura", ResultadoTeste::nsPorOperacao(resultado.tempoMistura, resultado.operacoesMistura))
+                .campo("MopsMistura", ResultadoTeste::mopsPorSegundo(resultado.tempoMistura, resultado.operacoesMistura))
+                .campo("SondagemSucesso", resultado.sondagemSucesso)
+                .campo("SondagemSucessoTeorica", resultado.sondagemSucessoTeorica())
+                .campo("SondagemInsucesso", resultado.sondagemInsucesso)
+                .campo("SondagemInsucessoTeorica", resultado.sondagemInsucessoTeorica())
+                .campo("ModeloSondagem", nomeModeloSondagem(resultado.modeloSondagem));
+            if (resultado.energiaMedida) {
+                json.campo("JPacoteInsercao", resultado.energiaInsercao.pacote)
+                    .campo("JDramInsercao", resultado.energiaInsercao.dram)
+                    .campo("JPacoteBusca", resultado.energiaBusca.pacote)
+                    .campo("JDramBusca", resultado.energiaBusca.dram)
+                    .campo("JPacoteMistura", resultado.energiaMistura.pacote)
+                    .campo("JDramMistura", resultado.energiaMistura.dram)
+                    .campo("JPorMopInsercao", ResultadoTeste::joulesPorMilhao(resultado.energiaInsercao, resultado.operacoesInsercao))
+                    .campo("JPorMopBusca", ResultadoTeste::joulesPorMilhao(resultado.energiaBusca, resultado.operacoesBusca))
+                    .campo("JPorMopMistura", ResultadoTeste::joulesPorMilhao(resultado.energiaMistura, resultado.operacoesMistura));
+            }
+            json.fecharObjeto();
+        }
+        json.fecharArray().fecharObjeto();
+
+        std::ofstream arq(arquivo, std::ios::app);
+        if (!arq.is_open()) {
+            throw std::runtime_error("Erro ao abrir histórico: " + arquivo);
+        }
+        arq << json.str() << "\n";
+        arq.flush();
+
+        std::cout << "Execução anexada ao histórico: " << arquivo << std::endl;
+    }
+
+    /**
+     * @brief Abre o CSV de resultados, gravado a cada cenário concluído
+     * @param arquivo Caminho do arquivo de saída
+     * @param retomar Se true, mantém e pula os cenários já presentes no arquivo
+     * @throws std::runtime_error se não conseguir criar ou retomar o arquivo
+     *
+     * Formato CSV:
+     * - Cabeçalho com nomes das colunas
+     * - Uma linha por resultado de teste, gravada assim que o cenário termina
+     * - Campos separados por vírgula
+     * - Números formatados com precisão apropriada
+     * - ns/op e Mops/s derivados para cada fase
+     *
+     * Os resultados retomados entram nos relatórios, nas comparações e no
+     * histórico como se tivessem sido medidos nesta execução.
+     */
+    void abrirSaidaCsv(const std::string& arquivo, bool retomar) {
+        saidaCsv.abrir(arquivo, retomar);
+        const auto& retomados = saidaCsv.getRetomados();
+        resultados.insert(resultados.end(), retomados.begin(), retomados.end());
+    }
+
+    /**
+     * @brief Fecha o CSV de resultados
+     */
+    void fecharSaidaCsv() {
+        saidaCsv.fechar();
+    }
+
+    /**
+     * @brief Imprime relatório formatado no console
+     *
+     * Gera tabela organizada com:
+     * - Cabeçalho descritivo
+     * - Colunas alinhadas
+     * - Números formatados para legibilidade
+     * - Separadores visuais
+     *
+     * As colunas de threads, repetição e fase mista só aparecem quando a
+     * configuração as utiliza, mantendo o relatório padrão em 92 colunas.
+     *
+     * @complexity O(r) onde r é o número de resultados
+     */
+    void imprimirRelatorio() {
+        RASTREAR_ESCOPO("imprimirRelatorio", "relatorio");
+        if (resultados.empty()) {
+            std::cout << "Nenhum resultado disponível." << std::endl;
+            return;
+        }
+
+        const bool estendida = matrizEstendida();
+        const size_t largura = estendida ? 128 : 92;
+
+        // Cabeçalho do relatório
+        std::cout << "\n" << std::string(largura, '=') << std::endl;
+        std::cout << "RELATÓRIO DE PERFORMANCE" << std::endl;
+        std::cout << std::string(largura, '=') << std::endl;
+
+        // Cabeçalho da tabela
+        std::cout << std::left
+                  << std::setw(10) << "Tipo"
+                  << std::setw(8)  << "Tam.Tab"
+                  << std::setw(8)  << "Dados"
+                  << std::setw(12) << "Hash"
+                  << std::setw(12) << "Inser.(ms)"
+                  << std::setw(12) << "Busca(ms)"
+                  << std::setw(12) << "BuscaFria"
+                  << std::setw(8)  << "Colisões"
+                  << std::setw(8)  << "F.Carga";
+        if (estendida) {
+            std::cout << std::setw(5)  << "Thr"
+                      << std::setw(5)  << "Rep"
+                      << std::setw(14) << "Mistura"
+                      << std::setw(12) << "Mist.(ms)";
+        }
+        std::cout << std::endl;
+
+        std::cout << std::string(largura, '-') << std::endl;
+
+        // Dados da tabela
+        for (const auto& resultado : resultados) {
+            std::cout << std::left
+                      << std::setw(10) << resultado.tipoTabela
+                      << std::setw(8)  << resultado.tamanhoTabela
+                      << std::setw(8)  << resultado.quantidadeDados
+                      << std::setw(12) << resultado.tipoFuncaoHash
+                      << std::setw(12) << std::fixed << std::setprecision(3) << resultado.tempoInsercao
+                      << std::setw(12) << std::fixed << std::setprecision(3) << resultado.tempoBusca
+                      << std::setw(12) << std::fixed << std::setprecision(3) << resultado.tempoBuscaFria
+                      << std::setw(8)  << resultado.colisoes
+                      << std::setw(8)  << std::fixed << std::setprecision(4) << resultado.fatorCarga;
+            if (estendida) {
+                std::cout << std::setw(5)  << resultado.threads
+                          << std::setw(5)  << resultado.repeticao
+                          << std::setw(14) << resultado.mistura
+                          << std::setw(12) << std::fixed << std::setprecision(3) << resultado.tempoMistura;
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << std::string(largura, '=') << std::endl;
+    }
+
+    /**
+     * @brief Imprime as sondagens medidas ao lado das esperadas pela teoria
+     * @param tolerancia Desvio relativo acima do qual a linha é sinalizada
+     *
+     * Os valores teóricos são os de Knuth para hashing uniforme, calculados
+     * a partir do fator de carga: ½(1 + 1/(1 − α)) e ½(1 + 1/(1 − α)²) para
+     * sondagem linear, 1 + α/2 para encadeamento. As sondagens dependem só
+     * da tabela construída, então cada dataset x motor x tamanho x hash
+     * aparece uma vez, independentemente de threads, mistura e repetição.
+     * Um desvio positivo grande expõe uma combinação ruim de função hash e
+     * tamanho (listas desbalanceadas ou clustering primário). O modelo é o
+     * declarado pelo motor; sem modelo, as colunas teóricas ficam com "-".
+     */
+    void imprimirAnaliseSondagem(double tolerancia) const {
+        RASTREAR_ESCOPO("imprimirAnaliseSondagem", "relatorio");
+        // fixed, precisão e alinhamento valem só para esta tabela
+        const std::ios_base::fmtflags formatoAnterior = std::cout.flags();
+        const std::streamsize precisaoAnterior = std::cout.precision();
+        std::cout << "\n" << std::string(118, '=') << std::endl;
+        std::cout << "SONDAGENS: TEÓRICO (Knuth, hashing uniforme) x MEDIDO" << std::endl;
+        std::cout << std::string(118, '=') << std::endl;
+
+        std::cout << std::left
+                  << std::setw(10) << "Tipo"
+                  << std::setw(9)  << "Tam.Tab"
+                  << std::setw(10) << "Dados"
+                  << std::setw(14) << "Hash"
+                  << std::setw(13) << "F.Carga"
+                  << std::setw(10) << "Suc.Med"
+                  << std::setw(10) << "Suc.Teo"
+                  << std::setw(9)  << "Desvio"
+                  << std::setw(10) << "Ins.Med"
+                  << std::setw(10) << "Ins.Teo"
+                  << std::setw(9)  << "Desvio" << std::endl;
+        std::cout << std::string(118, '-') << std::endl;
+
+        std::set<std::string> vistos;
+        size_t linhas = 0;
+        size_t sinalizadas = 0;
+        const std::string* datasetAnterior = nullptr;
+        for (const auto& r : resultados) {
+            const std::string chave = r.dataset + "|" + r.tipoTabela + "|" +
+                                      std::to_string(r.tamanhoTabela) + "|" + r.tipoFuncaoHash;
+            if (!vistos.insert(chave).second) {
+                continue;
+            }
+            if (!datasetAnterior || *datasetAnterior != r.dataset) {
+                std::cout << "[" << r.dataset << "]" << std::endl;
+                datasetAnterior = &r.dataset;
+            }
+
+            const bool temModelo = r.modeloSondagem != ModeloSondagem::NENHUM;
+            const double desvioSucesso = desvioRelativo(r.sondagemSucesso, r.sondagemSucessoTeorica());
+            const bool temInsucesso = r.sondagemInsucessoTeorica() > 0.0;
+            const double desvioInsucesso = temInsucesso
+                ? desvioRelativo(r.sondagemInsucesso, r.sondagemInsucessoTeorica())
+                : 0.0;
+            const bool sinalizada = std::abs(desvioSucesso) > tolerancia ||
+                                    std::abs(desvioInsucesso) > tolerancia;
+
+            std::cout << std::left
+                      << std::setw(10) << r.tipoTabela
+                      << std::setw(9)  << r.tamanhoTabela
+                      << std::setw(10) << r.quantidadeDados
+                      << std::setw(14) << r.tipoFuncaoHash
+                      << std::setw(13) << std::fixed << std::setprecision(4) << r.fatorCarga
+                      << std::setw(10) << std::setprecision(3) << r.sondagemSucesso;
+            if (temModelo) {
+                std::cout << std::setw(10) << r.sondagemSucessoTeorica()
+                          << std::setw(9)  << std::showpos << std::setprecision(1) << desvioSucesso * 100.0
+                          << std::noshowpos;
+            } else {
+                std::cout << std::setw(10) << "-" << std::setw(9) << "-";
+            }
+            if (temInsucesso) {
+                std::cout << std::setw(10) << std::setprecision(3) << r.sondagemInsucesso
+                          << std::setw(10) << r.sondagemInsucessoTeorica()
+                          << std::setw(9)  << std::showpos << std::setprecision(1) << desvioInsucesso * 100.0
+                          << std::noshowpos;
+            } else {
+                std::cout << std::setw(10) << "-" << std::setw(10) << "-" << std::setw(9) << "-";
+            }
+            std::cout << (sinalizada ? " << DESVIO" : "") << std::endl;
+
+            ++linhas;
+            sinalizadas += sinalizada ? 1 : 0;
+        }
+
+        std::cout << std::string(118, '-') << std::endl;
+        std::cout << "Desvio em % do teórico; " << sinalizadas << " de " << linhas
+                  << " configurações acima da tolerância de " << std::setprecision(0)
+                  << tolerancia * 100.0 << "%" << std::endl;
+        std::cout << std::string(118, '=') << std::endl;
+        std::cout.flags(formatoAnterior);
+        std::cout.precision(precisaoAnterior);
+    }
+
+    /**
+     * @brief Imprime ns/op e J por milhão de operações de cada fase
+     *
+     * Só imprime quando algum resultado foi medido com --energia. A energia
+     * é pacote + DRAM de todos os pacotes no intervalo da fase; a coluna
+     * DRAM% mostra a parcela da DRAM no total das três fases, que expõe as
+     * estruturas limitadas por banda de memória.
+     */
+    void imprimirEnergia() const {
+        RASTREAR_ESCOPO("imprimirEnergia", "relatorio");
+        if (std::none_of(resultados.begin(), resultados.end(),
+                         [](const ResultadoTeste& r) { return r.energiaMedida; })) {
+            return;
+        }
+        using R = ResultadoTeste;
+
+        std::cout << "\n" << std::string(112, '=') << std::endl;
+        std::cout << "ENERGIA POR FASE (RAPL, pacote + DRAM; J/Mop = joules por milhão de operações)" << std::endl;
+        std::cout << std::string(112, '=') << std::endl;
+
+        std::cout << std::left
+                  << std::setw(10) << "Tipo"
+                  << std::setw(8)  << "Dados"
+                  << std::setw(14) << "Hash"
+                  << std::setw(14) << "Dataset"
+                  << std::setw(11) << "Ins.ns/op"
+                  << std::setw(10) << "Ins.J/Mop"
+                  << std::setw(11) << "Bus.ns/op"
+                  << std::setw(10) << "Bus.J/Mop"
+                  << std::setw(11) << "Mis.ns/op"
+                  << std::setw(10) << "Mis.J/Mop"
+                  << "DRAM%" << std::endl;
+        std::cout << std::string(112, '-') << std::endl;
+
+        for (const auto& r : resultados) {
+            if (!r.energiaMedida) {
+                continue;
+            }
+            const double total = r.energiaInsercao.total() + r.energiaBusca.total() + r.energiaMistura.total();
+            const double dram = r.energiaInsercao.dram + r.energiaBusca.dram + r.energiaMistura.dram;
+            std::cout << std::left
+                      << std::setw(10) << r.tipoTabela
+                      << std::setw(8)  << r.quantidadeDados
+                      << std::setw(14) << r.tipoFuncaoHash
+                      << std::setw(14) << r.dataset.substr(0, 13)
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(11) << R::nsPorOperacao(r.tempoInsercao, r.operacoesInsercao)
+                      << std::setw(10) << std::setprecision(3) << R::joulesPorMilhao(r.energiaInsercao, r.operacoesInsercao)
+                      << std::setw(11) << std::setprecision(1) << R::nsPorOperacao(r.tempoBusca, r.operacoesBusca)
+                      << std::setw(10) << std::setprecision(3) << R::joulesPorMilhao(r.energiaBusca, r.operacoesBusca);
+            if (r.operacoesMistura > 0) {
+                std::cout << std::setw(11) << std::setprecision(1) << R::nsPorOperacao(r.tempoMistura, r.operacoesMistura)
+                          << std::setw(10) << std::setprecision(3) << R::joulesPorMilhao(r.energiaMistura, r.operacoesMistura);
+            } else {
+                std::cout << std::setw(11) << "-" << std::setw(10) << "-";
+            }
+            std::cout << std::setprecision(1) << (total > 0.0 ? dram / total * 100.0 : 0.0) << std::endl;
+        }
+
+        std::cout << std::string(112, '-') << std::endl;
+        std::cout << "Energia do pacote inteiro (não só do processo); fases de poucos ms ficam abaixo da" << std::endl;
+        std::cout << "resolução dos contadores (~1 ms) e devem ser lidas com cautela" << std::endl;
+        std::cout << std::string(112, '=') << std::endl;
+    }
+
+    /**
+     * @brief Imprime a variação entre repetições de cada configuração
+     * @param semIsolamento Resultados da mesma matriz sem isolamento, para
+     *        comparação lado a lado (nullptr = só a execução atual)
+     *
+     * A variação é o coeficiente de variação (desvio padrão / média) dos
+     * tempos das repetições de cada dataset x motor x tamanho x hash x
+     * mistura x threads. A linha final traz a mediana entre configurações,
+     * que resume o efeito do isolamento sobre o ruído de medição.
+     */
+    void imprimirVariacao(const std::vector<ResultadoTeste>* semIsolamento) const {
+        RASTREAR_ESCOPO("imprimirVariacao", "relatorio");
+        using Amostras = std::map<std::string, std::array<std::vector<double>, 3>>;
+        std::vector<const ResultadoTeste*> configuracoes;
+        auto agrupar = [&configuracoes](const std::vector<ResultadoTeste>& origem, bool registrar) {
+            Amostras grupos;
+            for (const auto& r : origem) {
+                const std::string chave = ResultadoTeste::chave(r.dataset, r.tipoTabela, r.tamanhoTabela,
+                                                                r.tipoFuncaoHash, r.mistura, r.threads, 0);
+                auto& amostras = grupos[chave];
+                if (registrar && amostras[0].empty()) {
+                    configuracoes.push_back(&r);
+                }
+                amostras[0].push_back(r.tempoInsercao);
+                amostras[1].push_back(r.tempoBusca);
+                amostras[2].push_back(r.tempoBuscaFria);
+            }
+            return grupos;
+        };
+        const Amostras atuais = agrupar(resultados, true);
+        const Amostras referencia = semIsolamento ? agrupar(*semIsolamento, false) : Amostras();
+
+        std::cout << "\n" << std::string(112, '=') << std::endl;
+        std::cout << "VARIAÇÃO ENTRE REPETIÇÕES (coeficiente de variação"
+                  << (semIsolamento ? "; sem isolamento / com isolamento)" : ")") << std::endl;
+        std::cout << std::string(112, '=') << std::endl;
+
+        const bool temRepeticoes = std::any_of(atuais.begin(), atuais.end(),
+            [](const Amostras::value_type& grupo) { return grupo.second[0].size() >= 2; });
+        if (!temRepeticoes) {
+            std::cout << "Sem repetições: use --repeticoes=N com N >= 2" << std::endl;
+            std::cout << std::string(112, '=') << std::endl;
+            return;
+        }
+
+        auto porcentagem = [](double cv) {
+            std::ostringstream oss;
+            if (std::isnan(cv)) {
+                oss << "-";
+            } else {
+                oss << std::fixed << std::setprecision(1) << cv * 100.0 << "%";
+            }
+            return oss.str();
+        };
+
+        const int larguraCelula = semIsolamento ? 18 : 12;
+        std::cout << std::left
+                  << std::setw(16) << "Dataset"
+                  << std::setw(10) << "Tipo"
+                  << std::setw(8)  << "Tam.Tab"
+                  << std::setw(14) << "Hash"
+                  << std::setw(5)  << "Rep"
+                  << std::setw(larguraCelula + 2) << "Inserção"
+                  << std::setw(larguraCelula) << "Busca"
+                  << "BuscaFria" << std::endl;
+        std::cout << std::string(112, '-') << std::endl;
+
+        std::array<std::vector<double>, 3> cvAtuais, cvReferencia;
+        for (const ResultadoTeste* r : configuracoes) {
+            const std::string chave = ResultadoTeste::chave(r->dataset, r->tipoTabela, r->tamanhoTabela,
+                                                            r->tipoFuncaoHash, r->mistura, r->threads, 0);
+            const auto& amostras = atuais.at(chave);
+            const auto encontrada = referencia.find(chave);
+
+            // Só o nome do arquivo: os datasets de data/ diferem apenas no fim
+            const std::string dataset = r->dataset.substr(r->dataset.find_last_of('/') + 1);
+            std::cout << std::left
+                      << std::setw(16) << dataset.substr(0, 15)
+                      << std::setw(10) << r->tipoTabela
+                      << std::setw(8)  << r->tamanhoTabela
+                      << std::setw(14) << r->tipoFuncaoHash
+                      << std::setw(5)  << amostras[0].size();
+            for (size_t m = 0; m < 3; ++m) {
+                const double cv = coeficienteVariacao(amostras[m]);
+                if (!std::isnan(cv)) cvAtuais[m].push_back(cv);
+                std::string celula = porcentagem(cv);
+                if (semIsolamento) {
+                    const double cvSem = encontrada != referencia.end()
+                        ? coeficienteVariacao(encontrada->second[m])
+                        : std::numeric_limits<double>::quiet_NaN();
+                    if (!std::isnan(cvSem)) cvReferencia[m].push_back(cvSem);
+                    celula = porcentagem(cvSem) + " / " + celula;
+                }
+                std::cout << std::setw(m < 2 ? larguraCelula : 0) << celula;
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << std::string(112, '-') << std::endl;
+        // setw conta bytes: "çõ" ocupa dois a mais que o visível
+        std::cout << std::left << std::setw(55) << "Mediana entre configurações";
+        for (size_t m = 0; m < 3; ++m) {
+            std::string celula = porcentagem(mediana(cvAtuais[m]));
+            if (semIsolamento) {
+                celula = porcentagem(mediana(cvReferencia[m])) + " / " + celula;
+            }
+            std::cout << std::setw(m < 2 ? larguraCelula : 0) << celula;
+        }
+        std::cout << std::endl;
+        std::cout << std::string(112, '=') << std::endl;
+    }
+
+    /**
+     * @brief Imprime a situação de convergência de cada cenário
+     * @param criterio Critério usado na execução (modo até estabilizar)
+     *
+     * Reavalia o critério sobre as repetições registradas, inclusive as
+     * medidas em processos filhos e as retomadas do CSV. Situações:
+     * "estável" (critério atendido), "máximo" (limite de repetições) ou
+     * "orçamento" (tempo esgotado antes da precisão pedida).
+     */
+    void imprimirConvergencia(const CriterioEstabilidade& criterio) const {
+        RASTREAR_ESCOPO("imprimirConvergencia", "relatorio");
+        std::vector<const ResultadoTeste*> cenarios;
+        std::map<std::string, AmostrasFases> grupos;
+        for (const auto& r : resultados) {
+            const std::string chave = ResultadoTeste::chave(r.dataset, r.tipoTabela, r.tamanhoTabela,
+                                                            r.tipoFuncaoHash, r.mistura, r.threads, 0);
+            auto& amostras = grupos[chave];
+            if (amostras[0].empty()) {
+                cenarios.push_back(&r);
+            }
+            acumularAmostras(amostras, r);
+        }
+
+        const bool comP99 = criterio.precisaoP99 > 0.0;
+        std::cout << "\n" << std::string(112, '=') << std::endl;
+        std::cout << "CONVERGÊNCIA DAS REPETIÇÕES (semiamplitude relativa do IC de "
+                  << std::fixed << std::setprecision(0) << criterio.confianca * 100.0 << "% da mediana; alvo "
+                  << std::setprecision(1) << criterio.precisao * 100.0 << "%";
+        if (comP99) {
+            std::cout << ", p99 " << criterio.precisaoP99 * 100.0 << "%";
+        }
+        std::cout << ")" << std::endl;
+        std::cout << std::string(112, '=') << std::endl;
+
+        auto porcentagem = [](const IntervaloQuantil& intervalo) {
+            std::ostringstream oss;
+            if (std::isnan(intervalo.estimativa)) {
+                oss << "-";
+            } else if (!intervalo.valido) {
+                oss << "n/d";
+            } else {
+                oss << std::fixed << std::setprecision(1) << intervalo.semiamplitudeRelativa() * 100.0 << "%";
+            }
+            return oss.str();
+        };
+
+        std::cout << std::left
+                  << std::setw(16) << "Dataset"
+                  << std::setw(10) << "Tipo"
+                  << std::setw(8)  << "Tam.Tab"
+                  << std::setw(14) << "Hash"
+                  << std::setw(12) << "Mistura"
+                  << std::setw(4)  << "Thr"
+                  << std::setw(6)  << "Rep"
+                  << std::setw(10) << "Ins.±"
+                  << std::setw(10) << "Bus.±"
+                  << std::setw(10) << "Mis.±"
+                  << std::setw(comP99 ? 12 : 0) << (comP99 ? "p99 pior±" : "")
+                  << "Situação" << std::endl;
+        std::cout << std::string(112, '-') << std::endl;
+
+        size_t estaveis = 0;
+        for (const ResultadoTeste* r : cenarios) {
+            const auto& amostras = grupos.at(ResultadoTeste::chave(r->dataset, r->tipoTabela, r->tamanhoTabela,
+                                                                   r->tipoFuncaoHash, r->mistura, r->threads, 0));
+            const AvaliacaoEstabilidade avaliacao = avaliarEstabilidade(amostras, criterio);
+            const char* situacao = avaliacao.estavel ? "estável"
+                                 : avaliacao.repeticoes >= criterio.maximo ? "máximo" : "orçamento";
+            estaveis += avaliacao.estavel;
+
+            const std::string dataset = r->dataset.substr(r->dataset.find_last_of('/') + 1);
+            // setw conta bytes: "±" ocupa um a mais que o visível
+            std::cout << std::left
+                      << std::setw(16) << dataset.substr(0, 15)
+                      << std::setw(10) << r->tipoTabela
+                      << std::setw(8)  << r->tamanhoTabela
+                      << std::setw(14) << r->tipoFuncaoHash
+                      << std::setw(12) << r->mistura
+                      << std::setw(4)  << r->threads
+                      << std::setw(6)  << avaliacao.repeticoes
+                      << std::setw(9)  << porcentagem(avaliacao.medianas[0])
+                      << std::setw(9)  << porcentagem(avaliacao.medianas[1])
+                      << std::setw(9)  << porcentagem(avaliacao.medianas[2]);
+            if (comP99) {
+                std::ostringstream p99;
+                if (std::isinf(avaliacao.precisaoP99)) {
+                    p99 << "n/d";
+                } else {
+                    p99 << std::fixed << std::setprecision(1) << avaliacao.precisaoP99 * 100.0 << "%";
+                }
+                std::cout << std::setw(11) << p99.str();
+            }
+            std::cout << situacao << std::endl;
+        }
+
+        std::cout << std::string(112, '-') << std::endl;
+        std::cout << estaveis << " de " << cenarios.size() << " cenário(s) estáveis; n/d = repetições"
+                  << " insuficientes para a confiança pedida" << std::endl;
+        std::cout << std::string(112, '=') << std::endl;
     }
 
     /**
-     * @brief Calcula estimativa de colisões para tabela encadeada
-     * @param tabela Referência para a tabela encadeada
-     * @return Número estimado de colisões
-     * 
-     * Para tabelas com encadeamento, usa aproximação baseada no
-     * fator de carga λ = n/m:
-     * - Se λ ≤ 1: colisões ≈ n - m(1 - e^(-λ))
-     * - Se λ > 1: colisões ≈ n - m (saturação)
-     * 
-     * Esta fórmula deriva da distribuição de Poisson para
-     * o número de elementos por posição.
+     * @brief Compara pares de configurações com testes de significância
+     * @param alfa Nível de significância da família de comparações
+     *
+     * Agrupa os resultados por configuração (motor x tamanho x hash) dentro
+     * de cada dataset, mistura e número de threads, usando as repetições
+     * como amostras. São comparados:
+     * - Funções hash: mesma tabela e tamanho, hashes diferentes
+     * - Motores: mesma função hash, todos os pares de tamanhos
+     *
+     * Para cada par e métrica (inserção, busca quente e fase mista) aplica
+     * o teste U de Mann-Whitney e o delta de Cliff. Os p-valores de todas
+     * as comparações são ajustados por Holm-Bonferroni antes de rotular a
+     * diferença como significativa. Configurações com menos de duas
+     * repetições não são comparadas.
+     *
+     * @complexity O(p * r²) onde p é o número de pares e r o de repetições
      */
-    size_t contarColisoesEncadeada(const TabelaEncadeada& tabela) {
-        size_t elementos = tabela.getNumElementos();
-        size_t tamanho = tabela.getTamanho();
-        
-        if (elementos <= tamanho) {
-            double lambda = static_cast<double>(elementos) / tamanho;
-            // Aproximação: colisões = n - m * (1 - e^(-λ))
-            return static_cast<size_t>(elementos - tamanho * (1 - std::exp(-lambda)));
-        }
-        
-        // Para fator de carga > 1, número de colisões ≈ elementos - tamanho
-        return elementos - tamanho;
-    }
+    void compararConfiguracoes(double alfa) {
+        RASTREAR_ESCOPO("compararConfiguracoes", "relatorio");
+        comparacoes.clear();
 
-    /**
-     * @brief Calcula estimativa de colisões para tabela aberta
-     * @param tabela Referência para a tabela aberta
-     * @return Número estimado de colisões
-     * 
-     * Para endereçamento aberto com sondagem linear:
-     * - Colisões estimadas ≈ n * fc / 2
-     * - Onde fc é o fator de carga
-     * 
-     * Esta estimativa considera o clustering primário
-     * típico da sondagem linear.
-     */
-    size_t contarColisoesAberta(const TabelaAberta& tabela) {
-        size_t elementos = tabela.getNumElementos();
-        size_t tamanho = tabela.getTamanho();
-        
-        if (elementos <= tamanho) {
-            double fc = tabela.fatorCarga();
-            // Aproximação considerando clustering primário
-            return static_cast<size_t>(elementos * fc / 2.0);
+        // Configurações na ordem de execução, com as repetições de cada uma
+        struct Grupo {
+            const ResultadoTeste* exemplo;
+            std::vector<const ResultadoTeste*> repeticoes;
+        };
+        std::vector<Grupo> grupos;
+        std::map<std::string, size_t> indice;
+        for (const auto& r : resultados) {
+            std::string chave = r.dataset + "|" + r.mistura + "|" + std::to_string(r.threads) + "|" +
+                                r.tipoTabela + "|" + std::to_string(r.tamanhoTabela) + "|" + r.tipoFuncaoHash;
+            auto it = indice.find(chave);
+            if (it == indice.end()) {
+                it = indice.emplace(chave, grupos.size()).first;
+                grupos.push_back({&r, {}});
+            }
+            grupos[it->second].repeticoes.push_back(&r);
         }
-        
-        return elementos; // Caso extremo: tabela cheia
-    }
 
-public:
-    /**
-     * @brief Executa testes completos na tabela encadeada
-     * @param dados Dataset para inserção
-     * @param dadosBusca Dataset para busca
-     * @param tamanhoTabela Tamanho da tabela a ser testada
-     * 
-     * Executa dois testes completos:
-     * 1. Com função hash de divisão
-     * 2. Com função hash de multiplicação
-     * 
-     * Para cada teste:
-     * - Cria nova instância da tabela
-     * - Mede tempo de inserção de todos os elementos
-     * - Mede tempo de busca de elementos do dataset de busca
-     * - Calcula estatísticas (colisões, fator de carga)
-     * - Armazena resultados para relatório
-     * 
-     * @complexity O(n + b) onde n é tamanho de dados e b é tamanho de dadosBusca
-     */
-    void testarTabelaEncadeada(const std::vector<int>& dados,
-                              const std::vector<int>& dadosBusca,
-                              size_t tamanhoTabela) {
-        std::cout << "  Testando tabela encadeada (tamanho: " << tamanhoTabela << ")...";
-
-        // Teste com função hash de divisão
-        {
-            TabelaEncadeada tabela(tamanhoTabela);
-            
-            // Mede tempo de inserção
-            double tempoInsercao = medirTempo([&]() { 
-                for (int valor : dados) {
-                    tabela.inserir(valor, TabelaEncadeada::TipoHash::DIVISAO);
-                }
-            });
-            
-            // Mede tempo de busca
-            double tempoBusca = medirTempo([&]() { 
-                for (int valor : dadosBusca) {
-                    tabela.buscar(valor, TabelaEncadeada::TipoHash::DIVISAO);
+        auto mesmoContexto = [](const ResultadoTeste& a, const ResultadoTeste& b) {
+            return a.dataset == b.dataset && a.mistura == b.mistura && a.threads == b.threads;
+        };
+        auto nome = [](const ResultadoTeste& r) {
+            return r.tipoTabela + "/" + std::to_string(r.tamanhoTabela) + "/" + r.tipoFuncaoHash;
+        };
+
+        using Metrica = std::pair<const char*, double ResultadoTeste::*>;
+        const Metrica metricas[] = {
+            {"insercao", &ResultadoTeste::tempoInsercao},
+            {"busca", &ResultadoTeste::tempoBusca},
+            {"mistura", &ResultadoTeste::tempoMistura}
+        };
+
+        for (size_t i = 0; i < grupos.size(); ++i) {
+            for (size_t j = i + 1; j < grupos.size(); ++j) {
+                const ResultadoTeste& a = *grupos[i].exemplo;
+                const ResultadoTeste& b = *grupos[j].exemplo;
+                if (!mesmoContexto(a, b) ||
+                    grupos[i].repeticoes.size() < 2 || grupos[j].repeticoes.size() < 2) {
+                    continue;
                 }
-            });
-            
-            // Armazena resultado
-            resultados.push_back({
-                "Encadeada",
-                tamanhoTabela,
-                dados.size(),
-                "Divisao",
-                tempoInsercao,
-                tempoBusca,
-                contarColisoesEncadeada(tabela),
-                tabela.fatorCarga()
-            });
-        }
-        
-        // Teste com função hash de multiplicação
-        {
-            TabelaEncadeada tabela(tamanhoTabela);
-            
-            double tempoInsercao = medirTempo([&]() { 
-                for (int valor : dados) {
-                    tabela.inserir(valor, TabelaEncadeada::TipoHash::MULTIPLICACAO);
+
+                std::string fator;
+                if (a.tipoTabela == b.tipoTabela && a.tamanhoTabela == b.tamanhoTabela) {
+                    fator = "hash";
+                } else if (a.tipoTabela != b.tipoTabela && a.tipoFuncaoHash == b.tipoFuncaoHash) {
+                    fator = "motor";
+                } else {
+                    continue; // Difere em mais de um fator ou só no tamanho
                 }
-            });
-            
-            double tempoBusca = medirTempo([&]() { 
-                for (int valor : dadosBusca) {
-                    tabela.buscar(valor, TabelaEncadeada::TipoHash::MULTIPLICACAO);
+
+                for (const auto& [nomeMetrica, campo] : metricas) {
+                    if (campo == &ResultadoTeste::tempoMistura && a.mistura == "-") {
+                        continue;
+                    }
+                    std::vector<double> amostraA, amostraB;
+                    for (const ResultadoTeste* r : grupos[i].repeticoes) amostraA.push_back(r->*campo);
+                    for (const ResultadoTeste* r : grupos[j].repeticoes) amostraB.push_back(r->*campo);
+
+                    ComparacaoConfiguracoes comparacao;
+                    comparacao.fator = fator;
+                    comparacao.configuracaoA = nome(a);
+                    comparacao.configuracaoB = nome(b);
+                    comparacao.contexto = a.dataset;
+                    if (a.mistura != "-") comparacao.contexto += " " + a.mistura;
+                    if (a.threads > 1) comparacao.contexto += " t" + std::to_string(a.threads);
+                    comparacao.metrica = nomeMetrica;
+                    comparacao.amostras = std::min(amostraA.size(), amostraB.size());
+                    comparacao.medianaA = mediana(amostraA);
+                    comparacao.medianaB = mediana(amostraB);
+                    comparacao.delta = deltaCliff(amostraA, amostraB);
+                    comparacao.pValor = testeMannWhitney(amostraA, amostraB).pValor;
+                    comparacoes.push_back(comparacao);
                 }
-            });
-            
-            resultados.push_back({
-                "Encadeada",
-                tamanhoTabela,
-                dados.size(),
-                "Multiplicacao",
-                tempoInsercao,
-                tempoBusca,
-                contarColisoesEncadeada(tabela),
-                tabela.fatorCarga()
-            });
+            }
+        }
+
+        std::vector<double> pValores;
+        for (const auto& c : comparacoes) pValores.push_back(c.pValor);
+        std::vector<double> ajustados = ajustarHolm(pValores);
+        for (size_t k = 0; k < comparacoes.size(); ++k) {
+            comparacoes[k].pAjustado = ajustados[k];
+            comparacoes[k].significativa = ajustados[k] < alfa;
         }
-        
-        std::cout << " OK" << std::endl;
     }
 
     /**
-     * @brief Executa testes completos na tabela aberta
-     * @param dados Dataset para inserção
-     * @param dadosBusca Dataset para busca
-     * 
-     * Similar ao teste da tabela encadeada, mas:
-     * - Usa tamanho fixo (50009) para evitar problemas de fator de carga
-     * - Inclui tratamento de exceções para tabela cheia
-     * - Para inserção se atingir limite de capacidade
-     * 
-     * O tamanho 50009 é primo e suficientemente grande para
-     * todos os datasets testados, mantendo fator de carga < 1.
-     * 
-     * @complexity O(n + b) onde n é tamanho de dados e b é tamanho de dadosBusca
-     */
-    void testarTabelaAberta(const std::vector<int>& dados,
-                           const std::vector<int>& dadosBusca) {
-        const size_t TAM = 50009; // Número primo para melhor distribuição
-        std::cout << "  Testando tabela aberta (tamanho: " << TAM << ")...";
-        
-        // Teste com função hash de divisão
-        {
-            TabelaAberta tabela(TAM);
-            
-            double tempoInsercao = medirTempo([&]() {
-                for (int valor : dados) {
-                    try {
-                        tabela.inserir(valor, TabelaAberta::TipoHash::DIVISAO);
-                    } catch (const std::runtime_error&) {
-                        // Para se tabela cheia ou fator de carga muito alto
-                        break;
-                    }
-                }
-            });
-            
-            double tempoBusca = medirTempo([&]() { 
-                for (int valor : dadosBusca) {
-                    tabela.buscar(valor, TabelaAberta::TipoHash::DIVISAO);
-                }
-            });
-            
-            resultados.push_back({
-                "Aberta",
-                TAM,
-                tabela.getNumElementos(), // Pode ser menor que dados.size() se houve overflow
-                "Divisao",
-                tempoInsercao,
-                tempoBusca,
-                contarColisoesAberta(tabela),
-                tabela.fatorCarga()
-            });
+     * @brief Imprime as comparações estatísticas no console
+     *
+     * A razão B/A compara as medianas; o efeito é o delta de Cliff com sua
+     * magnitude. Diferenças não significativas devem ser tratadas como ruído.
+     */
+    void imprimirComparacoes() const {
+        RASTREAR_ESCOPO("imprimirComparacoes", "relatorio");
+        std::cout << "\n" << std::string(136, '=') << std::endl;
+        std::cout << "COMPARAÇÕES ESTATÍSTICAS (Mann-Whitney U, delta de Cliff, Holm-Bonferroni)" << std::endl;
+        std::cout << std::string(136, '=') << std::endl;
+
+        if (comparacoes.empty()) {
+            std::cout << "Nenhuma comparação: são necessárias ao menos 2 repetições por configuração\n"
+                      << "(use --repeticoes=N ou repeticoes em [matriz]; recomendado N >= 10)." << std::endl;
+            std::cout << std::string(136, '=') << std::endl;
+            return;
         }
-        
-        // Teste com função hash de multiplicação
-        {
-            TabelaAberta tabela(TAM);
-            
-            double tempoInsercao = medirTempo([&]() {
-                for (int valor : dados) {
-                    try {
-                        tabela.inserir(valor, TabelaAberta::TipoHash::MULTIPLICACAO);
-                    } catch (const std::runtime_error&) {
-                        break;
-                    }
-                }
-            });
-            
-            double tempoBusca = medirTempo([&]() { 
-                for (int valor : dadosBusca) {
-                    tabela.buscar(valor, TabelaAberta::TipoHash::MULTIPLICACAO);
-                }
-            });
-            
-            resultados.push_back({
-                "Aberta",
-                TAM,
-                tabela.getNumElementos(),
-                "Multiplicacao",
-                tempoInsercao,
-                tempoBusca,
-                contarColisoesAberta(tabela),
-                tabela.fatorCarga()
-            });
+
+        std::cout << std::left
+                  << std::setw(30) << "A"
+                  << std::setw(30) << "B"
+                  << std::setw(11) << "Métrica"
+                  << std::setw(10) << "Med.A(ms)"
+                  << std::setw(10) << "Med.B(ms)"
+                  << std::setw(8)  << "B/A"
+                  << std::setw(8)  << "Delta"
+                  << std::setw(13) << "Efeito"
+                  << std::setw(9)  << "p(Holm)"
+                  << "Signif." << std::endl;
+        std::cout << std::string(136, '-') << std::endl;
+
+        size_t significativas = 0;
+        const std::string* contextoAnterior = nullptr;
+        for (const auto& c : comparacoes) {
+            // Cabeçalho a cada mudança de dataset, mistura ou threads
+            if (!contextoAnterior || *contextoAnterior != c.contexto) {
+                std::cout << "[" << c.contexto << "]" << std::endl;
+                contextoAnterior = &c.contexto;
+            }
+            std::cout << std::left
+                      << std::setw(30) << c.configuracaoA
+                      << std::setw(30) << c.configuracaoB
+                      << std::setw(10) << c.metrica
+                      << std::setw(10) << std::fixed << std::setprecision(3) << c.medianaA
+                      << std::setw(10) << std::fixed << std::setprecision(3) << c.medianaB
+                      << std::setw(8)  << std::fixed << std::setprecision(2) << c.medianaB / c.medianaA
+                      << std::setw(8)  << std::showpos << std::setprecision(2) << c.delta << std::noshowpos
+                      << std::setw(13) << magnitudeEfeito(c.delta)
+                      << std::setw(9)  << std::setprecision(4) << c.pAjustado
+                      << (c.significativa ? "sim" : "nao") << std::endl;
+            significativas += c.significativa ? 1 : 0;
         }
-        
-        std::cout << " OK" << std::endl;
+
+        std::cout << std::string(136, '-') << std::endl;
+        std::cout << significativas << " de " << comparacoes.size()
+                  << " diferenças significativas" << std::endl;
+        std::cout << std::string(136, '=') << std::endl;
     }
 
     /**
-     * @brief Salva todos os resultados em arquivo CSV
+     * @brief Salva as comparações estatísticas em arquivo CSV
      * @param arquivo Caminho do arquivo de saída
      * @throws std::runtime_error se não conseguir criar o arquivo
-     * 
-     * Formato CSV:
-     * - Cabeçalho com nomes das colunas
-     * - Uma linha por resultado de teste
-     * - Campos separados por vírgula
-     * - Números formatados com precisão apropriada
-     * 
-     * O arquivo gerado pode ser:
-     * - Importado em planilhas (Excel, LibreOffice)
-     * - Usado para gerar gráficos automáticos
-     * - Processado por scripts de análise
-     * 
-     * @complexity O(r) onde r é o número de resultados
      */
-    void salvarResultados(const std::string& arquivo) {
+    void salvarComparacoes(const std::string& arquivo) const {
+        RASTREAR_ESCOPO("salvarComparacoes", "relatorio");
         std::ofstream arq(arquivo);
         if (!arq.is_open()) {
             throw std::runtime_error("Erro ao criar arquivo: " + arquivo);
         }
-        
-        // Escreve cabeçalho CSV
-        arq << "TipoTabela,TamanhoTabela,QuantidadeDados,FuncaoHash,"
-            << "TempoInsercao(ms),TempoBusca(ms),Colisoes,FatorCarga\n";
-        
-        // Escreve dados formatados
-        for (const auto& resultado : resultados) {
-            arq << resultado.tipoTabela << ","
-                << resultado.tamanhoTabela << ","
-                << resultado.quantidadeDados << ","
-                << resultado.tipoFuncaoHash << ","
-                << std::fixed << std::setprecision(3) << resultado.tempoInsercao << ","
-                << std::setprecision(3) << resultado.tempoBusca << ","
-                << resultado.colisoes << ","
-                << std::setprecision(4) << resultado.fatorCarga << "\n";
+
+        arq << "Fator,ConfiguracaoA,ConfiguracaoB,Contexto,Metrica,Amostras,"
+            << "MedianaA(ms),MedianaB(ms),RazaoB/A,DeltaCliff,Efeito,PValor,PAjustado,Significativa\n";
+
+        for (const auto& c : comparacoes) {
+            arq << c.fator << ","
+                << c.configuracaoA << ","
+                << c.configuracaoB << ","
+                << c.contexto << ","
+                << c.metrica << ","
+                << c.amostras << ","
+                << std::fixed << std::setprecision(3) << c.medianaA << ","
+                << std::setprecision(3) << c.medianaB << ","
+                << std::setprecision(4) << c.medianaB / c.medianaA << ","
+                << std::setprecision(4) << c.delta << ","
+                << magnitudeEfeito(c.delta) << ","
+                << std::setprecision(6) << c.pValor << ","
+                << std::setprecision(6) << c.pAjustado << ","
+                << (c.significativa ? 1 : 0) << "\n";
         }
-        
+
         arq.close();
-        std::cout << "\nResultados salvos em: " << arquivo << std::endl;
+        std::cout << "Comparações salvas em: " << arquivo << std::endl;
     }
+};
 
-    /**
-     * @brief Imprime relatório formatado no console
-     * 
-     * Gera tabela organizada com:
-     * - Cabeçalho descritivo
-     * - Colunas alinhadas
-     * - Números formatados para legibilidade
-     * - Separadores visuais
-     * 
-     * O relatório permite análise rápida dos resultados
-     * sem necessidade de abrir arquivo externo.
-     * 
-     * @complexity O(r) onde r é o número de resultados
-     */
-    void imprimirRelatorio() {
-        if (resultados.empty()) {
-            std::cout << "Nenhum resultado disponível." << std::endl;
-            return;
+/**
+ * @brief Opções de execução obtidas da linha de comando
+ *
+ * Sem argumentos, o programa executa o benchmark padrão do Trabalho 2.
+ * As demais opções selecionam modos adicionais de análise. Histórico e
+ * rastreio informados na linha de comando têm precedência sobre a seção
+ * [saida] do arquivo de configuração.
+ */
+struct OpcoesExecucao {
+    bool ajuda = false;                     ///< Exibe as opções disponíveis e sai
+    bool varredura = false;                 ///< Executa a varredura de working set
+    bool retomar = false;                   ///< Retoma uma matriz interrompida a partir do CSV
+    bool energia = false;                   ///< Mede a energia das fases pelos contadores RAPL
+    BenchmarkManager::Isolamento isolamento = BenchmarkManager::Isolamento::NENHUM; ///< Processo de cada cenário
+    bool compararIsolamento = false;        ///< Executa a matriz sem e com isolamento e compara a variação
+    size_t varreduraMin = 1000;             ///< Chaves no primeiro passo da varredura
+    size_t varreduraMax = 1000000000;       ///< Limite de chaves da varredura
+    double varreduraFator = 2.0;            ///< Razão entre passos da varredura
+    bool alocadores = false;                ///< Compara os alocadores da TabelaEncadeada
+    std::vector<size_t> alocadoresChaves = {10000, 100000, 1000000}; ///< Chaves por medição de alocadores
+    bool crescimento = false;               ///< Mede a latência de inserção durante o crescimento
+    size_t crescimentoChaves = 1000000;     ///< Chaves inseridas por modo de rehash
+    bool persistencia = false;              ///< Mede o diário e a recuperação da TabelaDuravel
+    std::vector<size_t> persistenciaChaves = {10000, 100000, 1000000}; ///< Chaves por medição de recuperação
+    std::vector<size_t> persistenciaLotes = {1, 16, 256, 0}; ///< Mutações por fdatasync (0 = SO)
+    std::string persistenciaDiretorio;      ///< Diretório de trabalho (vazio = temporário do sistema)
+    bool compartilhada = false;             ///< Compara leitores com cópias privadas e com a TabelaCompartilhada
+    size_t compartilhadaChaves = 1000000;   ///< Chaves sorteadas para a tabela
+    std::vector<size_t> compartilhadaLeitores = {1, 2, 4}; ///< Processos leitores por medição
+    bool conjuntos = false;                 ///< Mede união, interseção e diferença entre tabelas
+    size_t conjuntosChaves = 1000000;       ///< Chaves de cada conjunto
+    size_t conjuntosThreads = 0;            ///< Threads do método paralelo (0 = núcleos)
+    bool juncao = false;                    ///< Compara a junção particionada com a de tabela única
+    size_t juncaoConstrucao = 4000000;      ///< Linhas geradas da coluna de construção
+    size_t juncaoSonda = 16000000;          ///< Linhas geradas da coluna de sondagem
+    std::vector<std::string> juncaoArquivos; ///< Datasets de construção e de sondagem (vazio = gerar)
+    size_t juncaoThreads = 0;               ///< Threads do método paralelo (0 = núcleos)
+    bool deduplicacao = false;              ///< Conta distintas em disco e com o unordered_set
+    std::string deduplicacaoArquivo;        ///< Dataset a deduplicar (vazio = gerar)
+    uint64_t deduplicacaoChaves = 20000000; ///< Chaves do dataset gerado
+    uint64_t deduplicacaoDistintas = 0;     ///< Intervalo das chaves geradas (0 = metade das chaves)
+    size_t deduplicacaoMemoriaMb = 64;      ///< Orçamento de memória dos motores, em MiB
+    std::string deduplicacaoDiretorio;      ///< Derrames e dataset gerado (vazio = temporário do sistema)
+    std::string deduplicacaoSaida;          ///< Dataset com as chaves únicas (vazio = não grava)
+    std::vector<std::string> compararCsv;   ///< CSVs base e novo a comparar (vazio = não compara)
+    std::vector<std::string> rotulos = {"base", "nova"}; ///< Nomes das execuções comparadas
+    std::string arquivoConfig;              ///< Matriz de benchmarks (vazio = padrão do Trabalho 2)
+    std::optional<std::string> arquivoHistorico; ///< Substitui o histórico da configuração ("" = desativado)
+    std::optional<std::string> arquivoRastreio;  ///< Substitui o rastreio da configuração
+    std::optional<unsigned int> semente;    ///< Substitui a semente da configuração
+    std::optional<size_t> repeticoes;       ///< Substitui as repetições da configuração
+    bool ateEstabilizar = false;            ///< Repete cada cenário até estabilizar
+    std::optional<double> precisao;         ///< Substitui a precisão de [estabilidade]
+    std::optional<double> orcamento;        ///< Substitui o orçamento por cenário de [estabilidade]
+    std::optional<NivelIsa> isa;            ///< Força o nível dos kernels SIMD (padrão: detectado)
+    std::string servidor;                   ///< Endereço de escuta do modo servidor (vazio = não serve)
+    std::string servidorMotor = "Aberta";   ///< Motor registrado servido
+    std::string servidorHash = "Divisao";   ///< Função hash da tabela servida
+    size_t servidorTamanho = 1000003;       ///< Posições da tabela servida
+    std::string carga;                      ///< Endereço do servidor a carregar (vazio = sem carga)
+    ConfiguracaoCarga configCarga;          ///< Conexões, pipelining, lote e mistura da carga
+};
+
+/**
+ * @brief Interpreta os argumentos da linha de comando
+ * @param argc Número de argumentos
+ * @param argv Array de argumentos
+ * @return Opções de execução preenchidas
+ * @throws std::invalid_argument se houver opção desconhecida ou valor inválido
+ *
+ * Opções no formato --nome ou --nome=valor.
+ */
+static OpcoesExecucao interpretarArgumentos(int argc, char* argv[]) {
+    OpcoesExecucao opcoes;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string valor;
+        size_t igual = arg.find('=');
+        if (igual != std::string::npos) {
+            valor = arg.substr(igual + 1);
+            arg = arg.substr(0, igual);
         }
-        
-        // Cabeçalho do relatório
-        std::cout << "\n" << std::string(80, '=') << std::endl;
-        std::cout << "RELATÓRIO DE PERFORMANCE" << std::endl;
-        std::cout << std::string(80, '=') << std::endl;
-        
-        // Cabeçalho da tabela
-        std::cout << std::left
-                  << std::setw(10) << "Tipo"
-                  << std::setw(8)  << "Tam.Tab"
-                  << std::setw(8)  << "Dados"
-                  << std::setw(12) << "Hash"
-                  << std::setw(12) << "Inser.(ms)"
-                  << std::setw(12) << "Busca(ms)"
-                  << std::setw(8)  << "Colisões"
-                  << std::setw(8)  << "F.Carga" << std::endl;
-        
-        std::cout << std::string(80, '-') << std::endl;
-        
-        // Dados da tabela
-        for (const auto& resultado : resultados) {
-            std::cout << std::left
-                      << std::setw(10) << resultado.tipoTabela
-                      << std::setw(8)  << resultado.tamanhoTabela
-                      << std::setw(8)  << resultado.quantidadeDados
-                      << std::setw(12) << resultado.tipoFuncaoHash
-                      << std::setw(12) << std::fixed << std::setprecision(3) << resultado.tempoInsercao
-                      << std::setw(12) << std::fixed << std::setprecision(3) << resultado.tempoBusca
-                      << std::setw(8)  << resultado.colisoes
-                      << std::setw(8)  << std::fixed << std::setprecision(4) << resultado.fatorCarga
-                      << std::endl;
+
+        bool reconhecida = true;
+        try {
+            if (arg == "--ajuda" || arg == "-h") {
+                opcoes.ajuda = true;
+            } else if (arg == "--config") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.arquivoConfig = valor;
+            } else if (arg == "--historico") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.arquivoHistorico = valor;
+            } else if (arg == "--rastreio") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.arquivoRastreio = valor;
+            } else if (arg == "--retomar") {
+                opcoes.retomar = true;
+            } else if (arg == "--energia") {
+                opcoes.energia = true;
+            } else if (arg == "--isolamento") {
+                if (valor.empty() || valor == "cenario") {
+                    opcoes.isolamento = BenchmarkManager::Isolamento::CENARIO;
+                } else if (valor == "motor") {
+                    opcoes.isolamento = BenchmarkManager::Isolamento::MOTOR;
+                } else if (valor == "comparar") {
+                    opcoes.isolamento = BenchmarkManager::Isolamento::CENARIO;
+                    opcoes.compararIsolamento = true;
+                } else {
+                    throw std::invalid_argument("modo");
+                }
+            } else if (arg == "--semente") {
+                size_t pos = 0;
+                unsigned long long numero = std::stoull(valor, &pos);
+                if (pos != valor.size() || numero > std::numeric_limits<unsigned int>::max()) {
+                    throw std::invalid_argument("fora do intervalo");
+                }
+                opcoes.semente = static_cast<unsigned int>(numero);
+            } else if (arg == "--repeticoes") {
+                size_t pos = 0;
+                opcoes.repeticoes = std::stoull(valor, &pos);
+                if (pos != valor.size() || *opcoes.repeticoes == 0) {
+                    throw std::invalid_argument("deve ser positivo");
+                }
+            } else if (arg == "--ate-estabilizar") {
+                opcoes.ateEstabilizar = true;
+                if (!valor.empty()) {
+                    opcoes.precisao = std::stod(valor);
+                }
+            } else if (arg == "--orcamento") {
+                opcoes.orcamento = std::stod(valor);
+            } else if (arg == "--isa") {
+                opcoes.isa = isaPorNome(valor);
+            } else if (arg == "--sem-historico") {
+                opcoes.arquivoHistorico = std::string();
+            } else if (arg == "--varredura") {
+                opcoes.varredura = true;
+            } else if (arg == "--varredura-min") {
+                opcoes.varreduraMin = std::stoull(valor);
+            } else if (arg == "--varredura-max") {
+                opcoes.varreduraMax = std::stoull(valor);
+            } else if (arg == "--varredura-fator") {
+                opcoes.varreduraFator = std::stod(valor);
+            } else if (arg == "--alocadores") {
+                opcoes.alocadores = true;
+            } else if (arg == "--alocadores-chaves") {
+                opcoes.alocadoresChaves.clear();
+                std::stringstream lista(valor);
+                std::string item;
+                while (std::getline(lista, item, ',')) {
+                    opcoes.alocadoresChaves.push_back(std::stoull(item));
+                }
+                if (opcoes.alocadoresChaves.empty()) throw std::invalid_argument("vazio");
+            } else if (arg == "--crescimento") {
+                opcoes.crescimento = true;
+            } else if (arg == "--crescimento-chaves") {
+                opcoes.crescimentoChaves = std::stoull(valor);
+            } else if (arg == "--persistencia") {
+                opcoes.persistencia = true;
+            } else if (arg == "--persistencia-chaves" || arg == "--persistencia-lotes") {
+                auto& lista = arg == "--persistencia-chaves" ? opcoes.persistenciaChaves : opcoes.persistenciaLotes;
+                lista.clear();
+                std::stringstream itens(valor);
+                std::string item;
+                while (std::getline(itens, item, ',')) {
+                    lista.push_back(std::stoull(item));
+                }
+                if (lista.empty()) throw std::invalid_argument("vazio");
+            } else if (arg == "--persistencia-dir") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.persistenciaDiretorio = valor;
+            } else if (arg == "--compartilhada") {
+                opcoes.compartilhada = true;
+            } else if (arg == "--compartilhada-chaves") {
+                opcoes.compartilhadaChaves = std::stoull(valor);
+            } else if (arg == "--compartilhada-leitores") {
+                opcoes.compartilhadaLeitores.clear();
+                std::stringstream itens(valor);
+                std::string item;
+                while (std::getline(itens, item, ',')) {
+                    opcoes.compartilhadaLeitores.push_back(std::stoull(item));
+                }
+                if (opcoes.compartilhadaLeitores.empty()) throw std::invalid_argument("vazio");
+            } else if (arg == "--conjuntos") {
+                opcoes.conjuntos = true;
+            } else if (arg == "--conjuntos-chaves") {
+                opcoes.conjuntosChaves = std::stoull(valor);
+            } else if (arg == "--conjuntos-threads") {
+                opcoes.conjuntosThreads = std::stoull(valor);
+            } else if (arg == "--juncao") {
+                opcoes.juncao = true;
+            } else if (arg == "--juncao-construcao") {
+                opcoes.juncaoConstrucao = std::stoull(valor);
+            } else if (arg == "--juncao-sonda") {
+                opcoes.juncaoSonda = std::stoull(valor);
+            } else if (arg == "--juncao-arquivos") {
+                const size_t virgula = valor.find(',');
+                if (virgula == std::string::npos || virgula == 0 || virgula + 1 == valor.size()) {
+                    throw std::invalid_argument("dois arquivos");
+                }
+                opcoes.juncaoArquivos = {valor.substr(0, virgula), valor.substr(virgula + 1)};
+            } else if (arg == "--juncao-threads") {
+                opcoes.juncaoThreads = std::stoull(valor);
+            } else if (arg == "--dedup") {
+                opcoes.deduplicacao = true;
+            } else if (arg == "--dedup-arquivo") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.deduplicacaoArquivo = valor;
+            } else if (arg == "--dedup-chaves") {
+                opcoes.deduplicacaoChaves = std::stoull(valor);
+            } else if (arg == "--dedup-distintas") {
+                opcoes.deduplicacaoDistintas = std::stoull(valor);
+            } else if (arg == "--dedup-memoria") {
+                opcoes.deduplicacaoMemoriaMb = std::stoull(valor);
+                if (opcoes.deduplicacaoMemoriaMb < 16) throw std::invalid_argument("mínimo de 16 MiB");
+            } else if (arg == "--dedup-dir") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.deduplicacaoDiretorio = valor;
+            } else if (arg == "--dedup-saida") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.deduplicacaoSaida = valor;
+            } else if (arg == "--servidor") {
+                EnderecoKv::ler(valor);
+                opcoes.servidor = valor;
+            } else if (arg == "--servidor-motor") {
+                if (valor.empty()) throw std::invalid_argument("vazio");
+                opcoes.servidorMotor = valor;
+            } else if (arg == "--servidor-hash") {
+                if (valor != "Divisao" && valor != "Multiplicacao") throw std::invalid_argument("hash");
+                opcoes.servidorHash = valor;
+            } else if (arg == "--servidor-tamanho") {
+                opcoes.servidorTamanho = std::stoull(valor);
+            } else if (arg == "--carga") {
+                EnderecoKv::ler(valor);
+                opcoes.carga = valor;
+            } else if (arg == "--carga-conexoes") {
+                opcoes.configCarga.conexoes = std::stoull(valor);
+            } else if (arg == "--carga-profundidade") {
+                opcoes.configCarga.profundidade = std::stoull(valor);
+            } else if (arg == "--carga-lote") {
+                opcoes.configCarga.lote = std::stoull(valor);
+            } else if (arg == "--carga-operacoes") {
+                opcoes.configCarga.operacoes = std::stoull(valor);
+            } else if (arg == "--carga-chaves") {
+                opcoes.configCarga.chaves = std::stoull(valor);
+            } else if (arg == "--carga-mistura") {
+                opcoes.configCarga.mistura = MisturaOperacoes::ler(valor);
+            } else if (arg == "--comparar-csv" || arg == "--rotulos") {
+                std::vector<std::string> partes;
+                std::stringstream lista(valor);
+                std::string item;
+                while (std::getline(lista, item, ',')) {
+                    partes.push_back(item);
+                }
+                if (partes.size() != 2 || partes[0].empty() || partes[1].empty()) {
+                    throw std::invalid_argument("esperados dois valores separados por vírgula");
+                }
+                (arg == "--rotulos" ? opcoes.rotulos : opcoes.compararCsv) = partes;
+            } else {
+                reconhecida = false;
+            }
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Valor inválido para " + arg + ": " + valor);
+        }
+
+        if (!reconhecida) {
+            throw std::invalid_argument("Opção desconhecida: " + arg);
         }
-        
-        std::cout << std::string(80, '=') << std::endl;
     }
-};
+
+    return opcoes;
+}
+
+/**
+ * @brief Exibe as opções de linha de comando disponíveis
+ */
+static void imprimirAjuda() {
+    std::cout << "Uso: analise_hash [opções]\n\n"
+              << "Sem opções, executa o benchmark padrão sobre os datasets de data/.\n\n"
+              << "  --ajuda, -h              Exibe esta mensagem\n"
+              << "  --config=ARQ             Matriz de benchmarks em arquivo INI (ver config/)\n"
+              << "  --historico=ARQ          Histórico JSON lines (padrão: historico_resultados.jsonl)\n"
+              << "  --sem-historico          Não anexa a execução ao histórico\n"
+              << "  --repeticoes=N           Repetições de cada cenário (>= 2 habilita testes de significância)\n"
+              << "  --ate-estabilizar[=P]    Repete cada cenário até o IC de 95% da mediana ficar em ±P (padrão: 0.02)\n"
+              << "  --orcamento=S            Segundos no máximo por cenário em --ate-estabilizar (padrão: 10)\n"
+              << "  --retomar                Pula cenários já gravados no CSV de uma execução interrompida\n"
+              << "  --energia                Mede J por milhão de operações de cada fase (RAPL, se disponível)\n"
+              << "  --isolamento[=M]         Processo filho por cenário (M=cenario, padrão), por motor (M=motor)\n"
+              << "                           ou matriz sem e com isolamento para comparar a variação (M=comparar)\n"
+              << "  --semente=N              Semente dos geradores (reproduz dados e buscas de outra execução)\n"
+              << "  --rastreio=ARQ           Grava fases da execução em formato trace-event (Chrome/Perfetto)\n"
+              << "  --isa=NIVEL              Força os kernels SIMD: escalar, sse2, avx2 ou avx512 (padrão: detectado)\n"
+              << "  --varredura              Varredura de working set de L1 até a DRAM\n"
+              << "  --varredura-min=N        Chaves no primeiro passo (padrão: 1000)\n"
+              << "  --varredura-max=N        Limite de chaves (padrão: 1000000000)\n"
+              << "  --varredura-fator=F      Razão entre passos (padrão: 2)\n"
+              << "  --alocadores             Compara new/delete, monotonic, pool e slab na tabela encadeada\n"
+              << "  --alocadores-chaves=L    Quantidades de chaves (padrão: 10000,100000,1000000)\n"
+              << "  --crescimento            Latência de inserção com rehash parado, incremental e em segundo plano\n"
+              << "  --crescimento-chaves=N   Chaves inseridas por modo (padrão: 1000000)\n"
+              << "  --persistencia           Custo do diário (WAL) por inserção e tempo de recuperação\n"
+              << "  --persistencia-chaves=L  Chaves das medições de recuperação (padrão: 10000,100000,1000000)\n"
+              << "  --persistencia-lotes=L   Mutações por fdatasync, 0 = a cargo do SO (padrão: 1,16,256,0)\n"
+              << "  --persistencia-dir=D     Diretório dos arquivos (padrão: temporário do sistema)\n"
+              << "  --compartilhada          Leitores em processos: cópias privadas x tabela em memória compartilhada\n"
+              << "  --compartilhada-chaves=N Chaves da tabela (padrão: 1000000)\n"
+              << "  --compartilhada-leitores=L\n"
+              << "                           Processos leitores simultâneos (padrão: 1,2,4)\n"
+              << "  --conjuntos              União, interseção e diferença entre tabelas x std::set_*\n"
+              << "  --conjuntos-chaves=N     Chaves de cada conjunto (padrão: 1000000)\n"
+              << "  --conjuntos-threads=N    Threads do método paralelo (padrão: 0 = núcleos disponíveis)\n"
+              << "  --juncao                 Junção hash particionada (radix) x tabela única, contagem e pares\n"
+              << "  --juncao-construcao=N    Linhas geradas da coluna de construção (padrão: 4000000)\n"
+              << "  --juncao-sonda=N         Linhas geradas da coluna de sondagem (padrão: 16000000)\n"
+              << "  --juncao-arquivos=A,B    Junta os datasets A (construção) e B (sondagem) em vez de gerar\n"
+              << "  --juncao-threads=N       Threads do método paralelo (padrão: 0 = núcleos disponíveis)\n"
+              << "  --dedup                  Conta distintas com derrames em disco (memória limitada) x unordered_set\n"
+              << "  --dedup-arquivo=A        Dataset a deduplicar (padrão: gera um)\n"
+              << "  --dedup-chaves=N         Chaves do dataset gerado (padrão: 20000000)\n"
+              << "  --dedup-distintas=D      Chaves geradas em [1, D] (padrão: metade das chaves)\n"
+              << "  --dedup-memoria=M        Orçamento de memória dos motores em MiB, mínimo 16 (padrão: 64)\n"
+              << "  --dedup-dir=D            Diretório dos derrames (padrão: temporário do sistema)\n"
+              << "  --dedup-saida=A          Grava as chaves únicas em A, no formato dos datasets\n"
+              << "  --servidor=END           Serve uma tabela em unix:/caminho ou tcp:127.0.0.1:porta até SIGINT\n"
+              << "  --servidor-motor=M       Motor servido (padrão: Aberta)\n"
+              << "  --servidor-hash=H        Divisao ou Multiplicacao (padrão: Divisao)\n"
+              << "  --servidor-tamanho=N     Posições da tabela servida (padrão: 1000003)\n"
+              << "  --carga=END              Gera carga GET/PUT/DEL contra um servidor e mede vazão e latência\n"
+              << "  --carga-conexoes=N       Conexões simultâneas (padrão: 4)\n"
+              << "  --carga-profundidade=N   Lotes em voo por conexão (padrão: 16)\n"
+              << "  --carga-lote=N           Operações por lote (padrão: 64)\n"
+              << "  --carga-operacoes=N      Operações medidas (padrão: 1000000)\n"
+              << "  --carga-chaves=N         Chaves sorteadas em [0, N) (padrão: 100000)\n"
+              << "  --carga-mistura=MIX      Percentuais, ex.: busca:90/insercao:5/remocao:5 (padrão)\n"
+              << "  --comparar-csv=A,B       Compara dois CSVs de resultados da mesma matriz (ex.: sem e com PGO)\n"
+              << "  --rotulos=A,B            Nomes das execuções no relatório de --comparar-csv\n";
+}
 
 /**
  * @brief Pausa o console em sistemas Windows
@@ -442,21 +2095,257 @@ static void pause_console() {
 #endif
 }
 
+/**
+ * @brief Executa a matriz de benchmarks
+ * @param config Matriz de benchmarks e saídas (com a semente já definida)
+ * @param metadados Ambiente e semente da execução, registrados no CSV e
+ *        no histórico
+ * @param opcoes Opções de execução (retomada, energia e isolamento)
+ *
+ * Expande a configuração em cenários, executa todos e gera os relatórios
+ * habilitados em [saida]: CSV (gravado durante a execução), console,
+ * comparações e histórico.
+ */
+static void executarBenchmark(const ConfiguracaoBenchmark& config, const MetadadosExecucao& metadados,
+                              const OpcoesExecucao& opcoes) {
+    RASTREAR_ESCOPO("benchmark", "benchmark");
+
+    // Referência da comparação: mesma matriz e semente, sem isolamento e sem saídas
+    std::optional<std::vector<ResultadoTeste>> semIsolamento;
+    if (opcoes.compararIsolamento) {
+        std::cout << "\nExecutando a matriz sem isolamento (referência da variação)..." << std::endl;
+        BenchmarkManager referencia(metadados);
+        referencia.executar(config);
+        semIsolamento = referencia.getResultados();
+        std::cout << "\nExecutando a matriz com um processo por cenário..." << std::endl;
+    }
+
+    BenchmarkManager benchmark(metadados);
+    benchmark.definirIsolamento(opcoes.isolamento);
+    if (opcoes.energia) {
+        benchmark.ativarEnergia();
+    }
+    if (!config.arquivoCsv.empty()) {
+        benchmark.abrirSaidaCsv(config.arquivoCsv, opcoes.retomar);
+    }
+    benchmark.executar(config);
+    benchmark.fecharSaidaCsv();
+
+    // Geração de relatórios
+    benchmark.compararConfiguracoes(config.alfa);
+    if (config.console) {
+        benchmark.imprimirRelatorio();
+        benchmark.imprimirAnaliseSondagem(config.toleranciaSondagem);
+        benchmark.imprimirEnergia();
+        if (opcoes.isolamento != BenchmarkManager::Isolamento::NENHUM) {
+            benchmark.imprimirVariacao(semIsolamento ? &*semIsolamento : nullptr);
+        }
+        if (config.estabilidade.ativo) {
+            benchmark.imprimirConvergencia(config.estabilidade);
+        }
+        benchmark.imprimirComparacoes();
+    }
+    if (!config.arquivoComparacoes.empty() && (config.repeticoes >= 2 || config.estabilidade.ativo)) {
+        benchmark.salvarComparacoes(config.arquivoComparacoes);
+    }
+    if (!config.arquivoHistorico.empty()) {
+        benchmark.anexarHistorico(config.arquivoHistorico, metadados, config);
+    }
+}
+
+/**
+ * @brief Executa a varredura de working set
+ * @param opcoes Opções de execução (limites e razão da varredura)
+ * @param metadados Ambiente, gravado no CSV, e semente dos datasets gerados
+ */
+static void executarVarredura(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("varredura", "varredura");
+
+    VarreduraMemoria varredura(opcoes.varreduraMin, opcoes.varreduraMax, opcoes.varreduraFator, metadados.semente);
+    std::cout << "\nExecutando varredura de working set..." << std::endl;
+    varredura.executar();
+    varredura.imprimirRelatorio();
+    varredura.salvarResultados("resultados_varredura.csv", metadados);
+}
+
+/**
+ * @brief Executa a comparação de alocadores da TabelaEncadeada
+ * @param opcoes Opções de execução (quantidades de chaves)
+ * @param metadados Ambiente, gravado no CSV, e semente dos datasets gerados
+ */
+static void executarComparacaoAlocadores(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("alocadores", "alocadores");
+
+    ComparacaoAlocadores comparacao(opcoes.alocadoresChaves, metadados.semente);
+    std::cout << "\nComparando alocadores da tabela encadeada..." << std::endl;
+    comparacao.executar();
+    comparacao.imprimirRelatorio();
+    comparacao.salvarResultados("resultados_alocadores.csv", metadados);
+}
+
+/**
+ * @brief Executa o benchmark de latência durante o crescimento
+ * @param opcoes Opções de execução (quantidade de chaves)
+ * @param metadados Ambiente, gravado no CSV, e semente das chaves geradas
+ */
+static void executarBenchmarkCrescimento(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("crescimento", "crescimento");
+
+    BenchmarkCrescimento benchmark(opcoes.crescimentoChaves, metadados.semente);
+    std::cout << "\nMedindo inserções durante o crescimento da tabela..." << std::endl;
+    benchmark.executar();
+    benchmark.imprimirRelatorio();
+    benchmark.salvarResultados("resultados_crescimento.csv", metadados);
+}
+
+/**
+ * @brief Executa o benchmark de persistência (diário e recuperação)
+ * @param opcoes Opções de execução (quantidades, lotes e diretório)
+ * @param metadados Ambiente, gravado no CSV, e semente das chaves geradas
+ */
+static void executarBenchmarkPersistencia(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("persistencia", "persistencia");
+
+    const std::string diretorio = opcoes.persistenciaDiretorio.empty()
+        ? (std::filesystem::temp_directory_path() / "analise_hash_persistencia").string()
+        : opcoes.persistenciaDiretorio;
+    BenchmarkPersistencia benchmark(opcoes.persistenciaChaves, opcoes.persistenciaLotes, diretorio,
+                                    metadados.semente);
+    std::cout << "\nMedindo diário e recuperação em " << diretorio << "..." << std::endl;
+    benchmark.executar();
+    benchmark.imprimirRelatorio();
+    benchmark.salvarResultados("resultados_persistencia.csv", "resultados_recuperacao.csv", metadados);
+}
+
+/**
+ * @brief Executa o benchmark de leitores com a tabela em memória compartilhada
+ * @param opcoes Opções de execução (chaves e números de leitores)
+ * @param metadados Ambiente, gravado no CSV, e semente das chaves e das consultas
+ */
+static void executarBenchmarkCompartilhada(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("compartilhada", "compartilhada");
+
+    BenchmarkCompartilhada benchmark(opcoes.compartilhadaChaves, opcoes.compartilhadaLeitores, metadados.semente);
+    std::cout << "\nMedindo leitores com cópias privadas e com a tabela compartilhada..." << std::endl;
+    benchmark.executar();
+    benchmark.imprimirRelatorio();
+    benchmark.salvarResultados("resultados_compartilhada.csv", metadados);
+}
+
+/**
+ * @brief Executa o benchmark de operações de conjunto entre tabelas
+ * @param opcoes Opções de execução (chaves e threads)
+ * @param metadados Ambiente, gravado no CSV, e semente das chaves
+ */
+static void executarBenchmarkConjuntos(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("conjuntos", "conjuntos");
+
+    BenchmarkConjuntos benchmark(opcoes.conjuntosChaves, opcoes.conjuntosThreads, metadados.semente);
+    std::cout << "\nMedindo operações de conjunto entre tabelas..." << std::endl;
+    benchmark.executar();
+    benchmark.imprimirRelatorio();
+    benchmark.salvarResultados("resultados_conjuntos.csv", metadados);
+}
+
+/**
+ * @brief Executa o benchmark de junção hash
+ * @param opcoes Opções de execução (linhas ou datasets e threads)
+ * @param metadados Ambiente, gravado no CSV, e semente das colunas geradas
+ */
+static void executarBenchmarkJuncao(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("juncao", "juncao");
+
+    BenchmarkJuncao benchmark = opcoes.juncaoArquivos.empty()
+        ? BenchmarkJuncao(opcoes.juncaoConstrucao, opcoes.juncaoSonda, opcoes.juncaoThreads, metadados.semente)
+        : BenchmarkJuncao(opcoes.juncaoArquivos[0], opcoes.juncaoArquivos[1], opcoes.juncaoThreads);
+    std::cout << "\nMedindo a junção hash com e sem particionamento..." << std::endl;
+    benchmark.executar();
+    benchmark.imprimirRelatorio();
+    benchmark.salvarResultados("resultados_juncao.csv", metadados);
+}
+
+/**
+ * @brief Executa o benchmark de contagem de distintas em disco
+ * @param opcoes Opções de execução (dataset, orçamento, diretório e saída)
+ * @param metadados Ambiente, gravado no CSV, e semente do dataset gerado
+ */
+static void executarBenchmarkDeduplicacao(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    RASTREAR_ESCOPO("deduplicacao", "deduplicacao");
+
+    const uint64_t distintas = opcoes.deduplicacaoDistintas != 0
+        ? opcoes.deduplicacaoDistintas
+        : std::max<uint64_t>(opcoes.deduplicacaoChaves / 2, 1);
+    BenchmarkDeduplicacao benchmark(opcoes.deduplicacaoArquivo, opcoes.deduplicacaoChaves, distintas,
+                                    opcoes.deduplicacaoMemoriaMb * 1024 * 1024, opcoes.deduplicacaoDiretorio,
+                                    opcoes.deduplicacaoSaida, metadados.semente);
+    std::cout << "\nContando chaves distintas com memória limitada..." << std::endl;
+    benchmark.executar();
+    benchmark.imprimirRelatorio();
+    benchmark.salvarResultados("resultados_deduplicacao.csv", metadados);
+}
+
+/**
+ * @brief Serve uma tabela pelo socket local até SIGINT/SIGTERM
+ * @param opcoes Opções de execução (endereço, motor, hash e tamanho)
+ */
+static void executarServidor(const OpcoesExecucao& opcoes) {
+    ServidorTabela servidor(EnderecoKv::ler(opcoes.servidor), opcoes.servidorMotor,
+                            opcoes.servidorHash, opcoes.servidorTamanho);
+    std::cout << "\nServindo " << servidor.getDescricaoMotor() << " em " << opcoes.servidor
+              << " (Ctrl+C encerra)..." << std::endl;
+    servidor.executar();
+
+    const EstatisticasServidor& e = servidor.getEstatisticas();
+    std::cout << "\nServidor encerrado: " << e.conexoesAceitas << " conexões, " << e.lotes << " lotes, "
+              << e.operacoes << " operações, " << e.errosProtocolo << " erros de protocolo, "
+              << servidor.getNumElementos() << " chaves na tabela" << std::endl;
+}
+
+/**
+ * @brief Gera carga contra um servidor e mede vazão e latência
+ * @param opcoes Opções de execução (endereço e parâmetros da carga)
+ * @param metadados Ambiente, gravado no CSV, e semente das chaves e operações sorteadas
+ */
+static void executarCarga(const OpcoesExecucao& opcoes, const MetadadosExecucao& metadados) {
+    ConfiguracaoCarga configuracao = opcoes.configCarga;
+    configuracao.semente = metadados.semente;
+    GeradorCarga gerador(EnderecoKv::ler(opcoes.carga), configuracao);
+    std::cout << "\nGerando carga em " << opcoes.carga << "..." << std::endl;
+    gerador.executar();
+    gerador.imprimirRelatorio();
+    gerador.salvarResultados("resultados_carga.csv", metadados);
+}
+
+/**
+ * @brief Compara dois CSVs de resultados da mesma matriz
+ * @param opcoes Opções de execução (arquivos e rótulos)
+ */
+static void executarComparacaoExecucoes(const OpcoesExecucao& opcoes) {
+    RASTREAR_ESCOPO("compararExecucoes", "relatorio");
+
+    ComparacaoExecucoes comparacao(opcoes.compararCsv[0], opcoes.compararCsv[1],
+                                   opcoes.rotulos[0], opcoes.rotulos[1]);
+    comparacao.executar();
+    comparacao.imprimirRelatorio();
+    comparacao.salvarResultados("comparacao_execucoes.csv");
+}
+
+
 /**
  * @brief Função principal do programa
- * @param argc Número de argumentos da linha de comando (não utilizado)
- * @param argv Array de argumentos da linha de comando (não utilizado)
+ * @param argc Número de argumentos da linha de comando
+ * @param argv Array de argumentos da linha de comando (ver imprimirAjuda)
  * @return 0 se execução bem-sucedida, 1 se erro
  * 
  * Fluxo principal:
- * 1. Inicialização de componentes (carregador, benchmark manager)
- * 2. Definição de parâmetros de teste
+ * 1. Leitura da matriz de benchmarks (--config ou padrão do Trabalho 2)
+ * 2. Inicialização de componentes (carregador, benchmark manager)
  * 3. Geração de dataset para busca
- * 4. Loop principal: para cada arquivo de dataset
+ * 4. Loop principal: para cada dataset
  *    a. Carrega dados
  *    b. Executa testes em todas as configurações
  *    c. Armazena resultados
- * 5. Gera relatórios (console + CSV)
+ * 5. Gera relatórios (console + CSV) e anexa a execução ao histórico
  * 6. Finalização com tratamento de erros
  * 
  * Tratamento robusto de erros:
@@ -470,61 +2359,105 @@ static void pause_console() {
  * - n = tamanho médio dos datasets
  * - t = número de configurações testadas
  */
-int main(int /*argc*/, char* /*argv*/[]) {
+int main(int argc, char* argv[]) {
     try {
+        OpcoesExecucao opcoes = interpretarArgumentos(argc, argv);
+        if (opcoes.ajuda) {
+            imprimirAjuda();
+            return 0;
+        }
+
+        // Kernels SIMD escolhidos antes de qualquer tabela ou thread
+        if (opcoes.isa) {
+            selecionarIsa(*opcoes.isa);
+        }
+
         // Cabeçalho do programa
         std::cout << "\n" << std::string(60, '=') << std::endl;
         std::cout << "ANÁLISE COMPARATIVA DE TABELAS HASH" << std::endl;
         std::cout << std::string(60, '=') << std::endl;
 
-        // Inicialização dos componentes principais
-        CarregadorDados carregador;
-        BenchmarkManager benchmark;
+        // Matriz do arquivo (ou padrão) com as saídas sobrescritas pela linha de comando
+        ConfiguracaoBenchmark config = opcoes.arquivoConfig.empty()
+            ? ConfiguracaoBenchmark::padrao()
+            : ConfiguracaoBenchmark::carregarArquivo(opcoes.arquivoConfig);
+        if (opcoes.arquivoHistorico) {
+            config.arquivoHistorico = *opcoes.arquivoHistorico;
+        }
+        if (opcoes.arquivoRastreio) {
+            config.arquivoRastreio = *opcoes.arquivoRastreio;
+        }
+        if (opcoes.semente) {
+            config.semente = opcoes.semente;
+        }
+        if (opcoes.repeticoes) {
+            config.repeticoes = *opcoes.repeticoes;
+        }
+        if (opcoes.ateEstabilizar) {
+            if (opcoes.repeticoes) {
+                throw std::invalid_argument("--repeticoes e --ate-estabilizar são incompatíveis");
+            }
+            config.estabilidade.ativo = true;
+        }
+        if (opcoes.precisao) {
+            config.estabilidade.precisao = *opcoes.precisao;
+        }
+        if (opcoes.orcamento) {
+            config.estabilidade.orcamentoSegundos = *opcoes.orcamento;
+        }
+        config.validar();
+        if (!config.semente) {
+            config.semente = std::random_device{}();
+        }
 
-        // Configuração dos tamanhos de tabela encadeada (números primos)
-        const std::vector<size_t> TAM_TABELA_ENCADEADA = {29, 97, 251, 499, 911};
-        
-        // Lista de arquivos de dataset conforme especificação do Trabalho 2
-        const std::vector<std::string> ARQUIVOS = {
-            "data/numeros_aleatorios_100.txt",
-            "data/numeros_aleatorios_500.txt",
-            "data/numeros_aleatorios_1000.txt",
-            "data/numeros_aleatorios_5000.txt",
-            "data/numeros_aleatorios_10000.txt",
-            "data/numeros_aleatorios_50000.txt"
-        };
+        // Ambiente e semente identificam a execução para reprodução
+        MetadadosExecucao metadados = coletarMetadadosExecucao();
+        metadados.semente = *config.semente;
+        metadados.imprimir(std::cout);
+        std::cout << "Semente: " << *config.semente
+                  << " (reproduza com --semente=" << *config.semente << ")" << std::endl;
 
-        // Geração de dataset para operações de busca (1000 números aleatórios entre 1 e 1.000.000)
-        std::cout << "\nGerando dados para busca (1000 números aleatórios entre 1 e 1.000.000)...";
-        auto dadosBusca = carregador.gerarNumerosAleatoriosComRepeticao(1000);
-        std::cout << " OK\n";
+        if (!config.arquivoRastreio.empty()) {
+#ifdef ANALISE_HASH_RASTREAMENTO
+            Rastreador::instancia().iniciar();
+#else
+            std::cerr << "Aviso: rastreamento desativado na compilação (ENABLE_TRACING=OFF); "
+                      << "rastreio ignorado." << std::endl;
+            config.arquivoRastreio.clear();
+#endif
+        }
 
-        // Loop principal: testa cada arquivo de dataset
-        for (const std::string& arquivo : ARQUIVOS) {
-            try {
-                std::cout << "\nCarregando dados de: " << arquivo << std::endl;
-                auto dados = carregador.carregarDeArquivo(arquivo);
-                
-                std::cout << "Executando testes com " << dados.size() << " elementos:" << std::endl;
-                
-                // Testa todas as configurações de tabela encadeada
-                for (size_t tamanho : TAM_TABELA_ENCADEADA) {
-                    benchmark.testarTabelaEncadeada(dados, dadosBusca, tamanho);
-                }
-                
-                // Testa tabela aberta (tamanho fixo)
-                benchmark.testarTabelaAberta(dados, dadosBusca);
-                
-            } catch (const std::exception& e) {
-                std::cerr << "Erro ao processar arquivo " << arquivo << ": " 
-                          << e.what() << std::endl;
-                continue; // Continua com próximo arquivo
-            }
+        // Modos de varredura, alocadores, crescimento, persistência, memória compartilhada, conjuntos,
+        // junção, deduplicação, servidor e comparação substituem o benchmark padrão
+        if (!opcoes.compararCsv.empty()) {
+            executarComparacaoExecucoes(opcoes);
+        } else if (!opcoes.servidor.empty()) {
+            executarServidor(opcoes);
+        } else if (!opcoes.carga.empty()) {
+            executarCarga(opcoes, metadados);
+        } else if (opcoes.varredura) {
+            executarVarredura(opcoes, metadados);
+        } else if (opcoes.alocadores) {
+            executarComparacaoAlocadores(opcoes, metadados);
+        } else if (opcoes.crescimento) {
+            executarBenchmarkCrescimento(opcoes, metadados);
+        } else if (opcoes.persistencia) {
+            executarBenchmarkPersistencia(opcoes, metadados);
+        } else if (opcoes.compartilhada) {
+            executarBenchmarkCompartilhada(opcoes, metadados);
+        } else if (opcoes.conjuntos) {
+            executarBenchmarkConjuntos(opcoes, metadados);
+        } else if (opcoes.juncao) {
+            executarBenchmarkJuncao(opcoes, metadados);
+        } else if (opcoes.deduplicacao) {
+            executarBenchmarkDeduplicacao(opcoes, metadados);
+        } else {
+            executarBenchmark(config, metadados, opcoes);
         }
 
-        // Geração de relatórios
-        benchmark.imprimirRelatorio();
-        benchmark.salvarResultados("resultados_benchmark.csv");
+        if (!config.arquivoRastreio.empty()) {
+            Rastreador::instancia().salvar(config.arquivoRastreio);
+        }
 
         std::cout << "\nAnálise concluída com sucesso!\n" << std::endl;
         pause_console();
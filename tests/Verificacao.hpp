@@ -0,0 +1,154 @@
+/**
+ * @file Verificacao.hpp
+ * @brief Apoio comum aos executáveis de teste registrados no CTest
+ *
+ * Cada executável reúne casos nomeados; o CTest chama um caso por teste
+ * (ex.: teste_funcional motores), o que mantém os resultados separados no
+ * relatório sem depender de um framework externo.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Convenções:
+ * - VERIFICAR lança FalhaVerificacao com arquivo, linha e descrição
+ * - Um caso que não se aplica à máquina ou ao build lança CasoPulado;
+ *   o código de saída CODIGO_PULADO é declarado como SKIP_RETURN_CODE
+ */
+
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+/// Código de saída de um caso pulado (SKIP_RETURN_CODE no CMake)
+constexpr int CODIGO_PULADO = 77;
+
+/**
+ * @brief Condição verificada que não se manteve
+ */
+class FalhaVerificacao : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Caso que não pode ser executado nesta máquina ou neste build
+ */
+class CasoPulado : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Verifica a condição; a descrição é montada só em caso de falha
+ * @param condicao Expressão verificada
+ * @param descricao Expressão de stream com o contexto (ex.: "chave " << k)
+ */
+#define VERIFICAR(condicao, descricao)                                                   \
+    do {                                                                                 \
+        if (!(condicao)) {                                                               \
+            std::ostringstream mensagem_;                                                \
+            mensagem_ << __FILE__ << ":" << __LINE__ << ": " #condicao " falhou: "      \
+                      << descricao;                                                      \
+            throw FalhaVerificacao(mensagem_.str());                                     \
+        }                                                                                \
+    } while (false)
+
+/**
+ * @brief Executa o caso nomeado em argv[1], ou todos se nenhum for informado
+ * @param casos Nome de cada caso para a função que o executa
+ * @return 0 se todos passarem, CODIGO_PULADO se algum for pulado e nenhum
+ *         falhar, 1 em caso de falha ou caso desconhecido
+ */
+inline int executarCasos(int argc, char* argv[], const std::map<std::string, std::function<void()>>& casos) {
+    std::map<std::string, std::function<void()>> selecionados;
+    if (argc < 2) {
+        selecionados = casos;
+    } else {
+        const auto caso = casos.find(argv[1]);
+        if (caso == casos.end()) {
+            std::cerr << "Caso desconhecido: " << argv[1] << "\nCasos:";
+            for (const auto& [nome, funcao] : casos) {
+                std::cerr << " " << nome;
+            }
+            std::cerr << std::endl;
+            return 1;
+        }
+        selecionados.insert(*caso);
+    }
+
+    int codigo = 0;
+    for (const auto& [nome, funcao] : selecionados) {
+        try {
+            funcao();
+            std::cout << "[ OK ] " << nome << std::endl;
+        } catch (const CasoPulado& e) {
+            std::cout << "[PULADO] " << nome << ": " << e.what() << std::endl;
+            if (codigo == 0) {
+                codigo = CODIGO_PULADO;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[FALHA] " << nome << ": " << e.what() << std::endl;
+            codigo = 1;
+        }
+    }
+    return codigo;
+}
+
+/**
+ * @brief Valores numéricos de um arquivo INI (linhas chave = valor)
+ *
+ * Segue o formato dos arquivos de config/: seções entre colchetes e
+ * comentários iniciados por '#' ou ';'. Cada valor fica sob "secao.chave".
+ *
+ * @throws std::runtime_error se o arquivo não abrir ou um valor não for numérico
+ */
+inline std::map<std::string, double> lerValoresIni(const std::string& arquivo) {
+    std::ifstream entrada(arquivo);
+    if (!entrada.is_open()) {
+        throw std::runtime_error("Erro ao abrir arquivo: " + arquivo);
+    }
+
+    auto aparar = [](std::string texto) {
+        const auto inicio = texto.find_first_not_of(" \t\r");
+        if (inicio == std::string::npos) {
+            return std::string();
+        }
+        return texto.substr(inicio, texto.find_last_not_of(" \t\r") - inicio + 1);
+    };
+
+    std::map<std::string, double> valores;
+    std::string secao;
+    std::string linha;
+    size_t numeroLinha = 0;
+    while (std::getline(entrada, linha)) {
+        ++numeroLinha;
+        linha = aparar(linha);
+        if (linha.empty() || linha[0] == '#' || linha[0] == ';') {
+            continue;
+        }
+        if (linha.front() == '[' && linha.back() == ']') {
+            secao = aparar(linha.substr(1, linha.size() - 2));
+            continue;
+        }
+        const auto igual = linha.find('=');
+        if (igual == std::string::npos) {
+            throw std::runtime_error(arquivo + ":" + std::to_string(numeroLinha) + ": esperado chave = valor");
+        }
+        const std::string chave = aparar(linha.substr(0, igual));
+        const std::string valor = aparar(linha.substr(igual + 1));
+        try {
+            valores[secao + "." + chave] = std::stod(valor);
+        } catch (const std::exception&) {
+            throw std::runtime_error(arquivo + ":" + std::to_string(numeroLinha) + ": valor inválido: " + valor);
+        }
+    }
+    return valores;
+}
@@ -0,0 +1,351 @@
+/**
+ * @file teste_desempenho.cpp
+ * @brief Testes de regressão de desempenho por razões entre caminhos
+ *
+ * Cada caso executa um cenário pequeno de semente fixa em dois caminhos
+ * (ex.: kernel escalar e vetorial) e compara a razão entre os tempos com
+ * o limite registrado em razoes_base.ini. Razões, e não tempos absolutos,
+ * valem em máquinas diferentes e sobrevivem a ruído moderado.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Uso: teste_desempenho <caso> <razoes_base.ini>
+ *
+ * Medição: os dois caminhos são alternados RODADAS vezes e cada um é
+ * representado pelo menor tempo, o estimador menos sensível a
+ * interrupções do sistema; a razão fora do limite é medida de novo até
+ * TENTATIVAS vezes antes de falhar. Builds sem NDEBUG e CPUs sem o nível de ISA
+ * exigido pulam o caso (código CODIGO_PULADO).
+ */
+
+#include "Verificacao.hpp"
+
+#include "DespachoCpu.hpp"
+#include "RecursosMemoria.hpp"
+#include "RegistroMotores.hpp"
+#include "TabelaRedimensionavel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+constexpr unsigned SEMENTE = 20241018;
+constexpr int RODADAS = 7;
+constexpr int TENTATIVAS = 3;
+
+/// Limites lidos de razoes_base.ini
+std::map<std::string, double> razoesBase;
+
+/**
+ * @brief Limite registrado para secao.chave
+ * @throws std::runtime_error se o arquivo de base não tiver o limite
+ */
+double limite(const std::string& chave) {
+    const auto valor = razoesBase.find(chave);
+    if (valor == razoesBase.end()) {
+        throw std::runtime_error("Limite ausente em razoes_base.ini: " + chave);
+    }
+    return valor->second;
+}
+
+void exigirBuildOtimizado() {
+#ifndef NDEBUG
+    throw CasoPulado("build sem NDEBUG (use Release ou RelWithDebInfo)");
+#endif
+}
+
+/// Segundos de uma execução de f
+template<typename Funcao>
+double cronometrar(Funcao&& f) {
+    const auto inicio = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+/**
+ * @brief Menor tempo de cada caminho em RODADAS execuções alternadas
+ * @param preparar Chamado antes de cada execução, fora da medição
+ */
+template<typename Preparar, typename A, typename B>
+std::pair<double, double> medirPar(Preparar&& preparar, A&& caminhoA, B&& caminhoB) {
+    double menorA = std::numeric_limits<double>::infinity();
+    double menorB = menorA;
+    for (int rodada = 0; rodada < RODADAS; ++rodada) {
+        preparar();
+        menorA = std::min(menorA, cronometrar(caminhoA));
+        preparar();
+        menorB = std::min(menorB, cronometrar(caminhoB));
+    }
+    return {menorA, menorB};
+}
+
+/// Destino dos resultados dos laços medidos, que o compilador não pode descartar
+volatile size_t sumidouro = 0;
+
+/// Mantém um vetor de índices calculado como resultado observável
+void consumir(const std::vector<size_t>& indices) {
+    sumidouro = sumidouro + indices.front() + indices.back();
+}
+
+/**
+ * @brief Mede o par até a razão respeitar o limite, em até TENTATIVAS vezes
+ * @param chave Limite em razoes_base.ini
+ * @param maximo true: custo = medido / referência deve ficar abaixo do
+ *        limite; false: velocidade = referência / medido deve ficar acima
+ *
+ * Uma nova medição antes da falha descarta interferências passageiras
+ * (outro processo, mudança de frequência); uma regressão real persiste.
+ */
+template<typename Preparar, typename Referencia, typename Medido>
+void exigirRazao(const std::string& chave, bool maximo, Preparar&& preparar,
+                 Referencia&& referencia, Medido&& medido) {
+    const double valorLimite = limite(chave);
+    double razao = 0.0;
+    for (int tentativa = 1; tentativa <= TENTATIVAS; ++tentativa) {
+        const auto [tempoReferencia, tempoMedido] = medirPar(preparar, referencia, medido);
+        razao = maximo ? tempoMedido / tempoReferencia : tempoReferencia / tempoMedido;
+        std::cout << std::left << std::setw(40) << chave << std::fixed << std::setprecision(2)
+                  << razao << "x (" << (maximo ? "máximo " : "mínimo ") << valorLimite << "x)" << std::endl;
+        if (maximo ? razao <= valorLimite : razao >= valorLimite) {
+            return;
+        }
+    }
+    VERIFICAR(false, chave << ": " << razao << "x " << (maximo ? "acima do máximo " : "abaixo do mínimo ")
+                           << valorLimite << "x em " << TENTATIVAS << " tentativas");
+}
+
+/**
+ * @brief Sondagem linear vetorial contra a escalar em buscas sem sucesso
+ *
+ * Chaves sequenciais com o método da divisão formam um único cluster; cada
+ * busca de uma chave ausente o percorre até o fim, como no dataset
+ * sequencial da matriz.
+ */
+void testarSondagem() {
+    exigirBuildOtimizado();
+    if (isaDetectada() == NivelIsa::ESCALAR) {
+        throw CasoPulado("CPU sem kernels vetoriais");
+    }
+
+    const size_t tamanho = 10007;
+    const int ocupadas = 4500;
+    TabelaAberta tabela(tamanho);
+    for (int chave = 0; chave < ocupadas; ++chave) {
+        tabela.inserir(chave, TabelaAberta::TipoHash::DIVISAO);
+    }
+    std::mt19937 gerador(SEMENTE);
+    std::vector<int> ausentes(20000);
+    for (auto& chave : ausentes) {
+        chave = static_cast<int>(tamanho) + static_cast<int>(gerador() % ocupadas);
+    }
+
+    auto buscar = [&]() {
+        size_t encontrados = 0;
+        for (int chave : ausentes) {
+            encontrados += tabela.buscar(chave, TabelaAberta::TipoHash::DIVISAO);
+        }
+        VERIFICAR(encontrados == 0, nomeIsa(kernelsSimd().nivel));
+    };
+
+    for (NivelIsa nivel : {NivelIsa::SSE2, NivelIsa::AVX2, NivelIsa::AVX512}) {
+        if (nivel > isaDetectada()) {
+            continue;
+        }
+        exigirRazao(std::string("sondagem.") + nomeIsa(nivel), false, [] {},
+                    [&] { selecionarIsa(NivelIsa::ESCALAR); buscar(); },
+                    [&] { selecionarIsa(nivel); buscar(); });
+    }
+    selecionarIsa(isaDetectada());
+}
+
+/**
+ * @brief Funções hash em lote de cada nível vetorial contra o laço escalar
+ */
+void testarHashLote() {
+    exigirBuildOtimizado();
+    if (isaDetectada() == NivelIsa::ESCALAR) {
+        throw CasoPulado("CPU sem kernels vetoriais");
+    }
+
+    std::mt19937 gerador(SEMENTE);
+    std::vector<int> chaves(1 << 16);
+    for (auto& chave : chaves) {
+        chave = static_cast<int>(gerador() % 1000000);
+    }
+    std::vector<size_t> indices(chaves.size());
+    const size_t tamanho = 10007;
+    const int repeticoes = 20;
+
+    auto divisao = [&](NivelIsa nivel) {
+        selecionarIsa(nivel);
+        const auto kernel = kernelsSimd().hashDivisaoLote;
+        for (int r = 0; r < repeticoes; ++r) {
+            kernel(chaves.data(), chaves.size(), tamanho, indices.data());
+            consumir(indices);
+        }
+    };
+    auto multiplicacao = [&](NivelIsa nivel) {
+        selecionarIsa(nivel);
+        const auto kernel = kernelsSimd().hashMultiplicacaoLote;
+        for (int r = 0; r < repeticoes; ++r) {
+            kernel(chaves.data(), chaves.size(), tamanho, 0.63274838, indices.data());
+            consumir(indices);
+        }
+    };
+
+    for (NivelIsa nivel : {NivelIsa::SSE2, NivelIsa::AVX2, NivelIsa::AVX512}) {
+        if (nivel > isaDetectada()) {
+            continue;
+        }
+        const std::string sufixo = nomeIsa(nivel);
+        exigirRazao("hash_lote.divisao_" + sufixo, false, [] {},
+                    [&] { divisao(NivelIsa::ESCALAR); }, [&] { divisao(nivel); });
+        exigirRazao("hash_lote.multiplicacao_" + sufixo, false, [] {},
+                    [&] { multiplicacao(NivelIsa::ESCALAR); }, [&] { multiplicacao(nivel); });
+    }
+    selecionarIsa(isaDetectada());
+}
+
+/**
+ * @brief Nós da TabelaEncadeada em slabs contra new/delete
+ *
+ * Carga e descarga completas da tabela, como na comparação de alocadores;
+ * a tabela e o recurso são recriados fora da medição.
+ */
+void testarAlocador() {
+    exigirBuildOtimizado();
+
+    std::mt19937 gerador(SEMENTE);
+    std::vector<int> chaves(200000);
+    for (auto& chave : chaves) {
+        chave = static_cast<int>(gerador() % 10000000);
+    }
+    const size_t tamanho = TabelaRedimensionavel::proximoPrimo(chaves.size() / 2);
+
+    std::unique_ptr<RecursoSlab> slab;
+    std::unique_ptr<TabelaEncadeada> padrao, comSlab;
+    auto carregarEDescarregar = [&](TabelaEncadeada& tabela) {
+        for (int chave : chaves) {
+            tabela.inserir(chave, TabelaEncadeada::TipoHash::DIVISAO);
+        }
+        for (int chave : chaves) {
+            tabela.remover(chave, TabelaEncadeada::TipoHash::DIVISAO);
+        }
+        VERIFICAR(tabela.getNumElementos() == 0, "tabela não esvaziada");
+    };
+
+    exigirRazao("alocador.slab", false,
+        [&] {
+            comSlab.reset();
+            slab = std::make_unique<RecursoSlab>(sizeof(No));
+            padrao = std::make_unique<TabelaEncadeada>(tamanho, std::pmr::new_delete_resource());
+            comSlab = std::make_unique<TabelaEncadeada>(tamanho, slab.get());
+        },
+        [&] { carregarEDescarregar(*padrao); },
+        [&] { carregarEDescarregar(*comSlab); });
+}
+
+/**
+ * @brief Cada motor registrado contra std::unordered_set<int>
+ *
+ * Inserção e busca bem-sucedida com as duas funções hash no fator de
+ * carga 0,5, no nível de ISA detectado. O limite é um custo máximo: o
+ * motor pode ser mais rápido que a referência, mas não muito mais lento.
+ */
+void testarMotores() {
+    exigirBuildOtimizado();
+
+    std::mt19937 gerador(SEMENTE);
+    std::vector<int> chaves(100000);
+    for (auto& chave : chaves) {
+        chave = static_cast<int>(gerador() % 100000000);
+    }
+    std::vector<int> buscas(chaves);
+    std::shuffle(buscas.begin(), buscas.end(), gerador);
+    const size_t tamanho = TabelaRedimensionavel::proximoPrimo(2 * chaves.size());
+
+    std::unordered_set<int> referencia;
+    auto carregarReferencia = [&] {
+        for (int chave : chaves) {
+            referencia.insert(chave);
+        }
+    };
+    auto buscarReferencia = [&] {
+        size_t encontrados = 0;
+        for (int chave : buscas) {
+            encontrados += referencia.count(chave);
+        }
+        VERIFICAR(encontrados == buscas.size(), "std::unordered_set");
+    };
+
+    std::apply([&](const auto&... motor) {
+        auto medir = [&](const auto& registrado) {
+            using Tabela = typename std::decay_t<decltype(registrado)>::Tabela;
+            using TipoHash = typename Tabela::TipoHash;
+            for (const auto& hash : {std::make_pair(TipoHash::DIVISAO, "Divisao"),
+                                     std::make_pair(TipoHash::MULTIPLICACAO, "Multiplicacao")}) {
+                const TipoHash tipo = hash.first;
+                const char* nomeHash = hash.second;
+                std::unique_ptr<Tabela> tabela;
+                auto preparar = [&] {
+                    referencia = std::unordered_set<int>(tamanho);
+                    tabela = std::make_unique<Tabela>(tamanho);
+                };
+                auto carregar = [&] {
+                    for (int chave : chaves) {
+                        tabela->inserir(chave, tipo);
+                    }
+                };
+                auto buscar = [&] {
+                    size_t encontrados = 0;
+                    for (int chave : buscas) {
+                        encontrados += static_cast<bool>(tabela->buscar(chave, tipo));
+                    }
+                    VERIFICAR(encontrados == buscas.size(), registrado.nome << "/" << nomeHash);
+                };
+
+                const std::string prefixo = std::string("motores.") + registrado.nome + "_" + nomeHash;
+                exigirRazao(prefixo + "_insercao", true, preparar, carregarReferencia, carregar);
+
+                preparar();
+                carregarReferencia();
+                carregar();
+                exigirRazao(prefixo + "_busca", true, [] {}, buscarReferencia, buscar);
+            }
+        };
+        (medir(motor), ...);
+    }, MOTORES_REGISTRADOS);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Uso: " << argv[0] << " <caso> <razoes_base.ini>" << std::endl;
+        return 1;
+    }
+    try {
+        razoesBase = lerValoresIni(argv[2]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return executarCasos(argc, argv, {
+        {"sondagem", testarSondagem},
+        {"hash_lote", testarHashLote},
+        {"alocador", testarAlocador},
+        {"motores", testarMotores},
+    });
+}
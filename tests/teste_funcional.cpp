@@ -0,0 +1,986 @@
+/**
+ * @file teste_funcional.cpp
+ * @brief Testes de corretude das operações do núcleo (analise_hash::nucleo)
+ *
+ * Compara os motores e a tabela redimensionável com std::unordered_set
+ * sob sequências aleatórias de semente fixa, e os kernels SIMD de cada
+ * nível suportado com os escalares.
+ *
+ * @author Gabriel Freitas Souza
+ * @author Roberli Schuina Silva
+ * @date 2024-10-18
+ * @version 1.0
+ *
+ * Casos (um teste do CTest cada):
+ * - motores: inserção, busca, busca em lote e remoção de todos os motores
+ *   registrados, com as duas funções hash, em cada nível de ISA
+ * - aberta_limites: recusa da TabelaAberta acima do limite de ocupação
+ * - redimensionavel: os três modos de rehash da TabelaRedimensionavel
+ * - kernels: cada kernel vetorial contra o escalar em entradas aleatórias
+ * - carregador: leitura de arquivo com linhas inválidas, CRLF e espaços,
+ *   inteira e em blocos de poucos bytes pelo LeitorDataset
+ * - persistencia: recuperação da TabelaDuravel de cada motor registrado
+ *   após snapshots periódicos e com a cauda do diário truncada
+ * - conjuntos: união, interseção e diferença de cada motor contra
+ *   std::set_*, numa thread e em partições paralelas
+ * - juncao: junção particionada e de tabela única contra os pares
+ *   esperados, com chaves repetidas, uma e duas passagens e colunas vazias
+ * - deduplicacao: contagem de distintas de cada motor contra std::set, em
+ *   memória, com dois ou mais níveis de derrames e com uma só chave repetida
+ * - compartilhada: TabelaCompartilhada contra std::unordered_set pelo
+ *   escritor e por um mapeamento de leitor, e um leitor em outro processo
+ *   durante mutações e compactações (pulado fora de sistemas POSIX)
+ * - servidor: protocolo do ServidorTabela, respostas após o shutdown da
+ *   escrita do cliente e contagens do GeradorCarga, em cada motor
+ *   registrado (pulado fora do Linux)
+ * - resultados: modelo de sondagem declarado por cada motor registrado,
+ *   linha do CSV de resultados gravada e lida de volta e metadados da
+ *   execução preservados ao retomar o arquivo
+ */
+
+#include "Verificacao.hpp"
+
+#include "CarregadorDados.hpp"
+#include "DeduplicacaoExterna.hpp"
+#include "DespachoCpu.hpp"
+#include "GeradorCarga.hpp"
+#include "JuncaoHash.hpp"
+#include "MetadadosExecucao.hpp"
+#include "OperacoesConjunto.hpp"
+#include "PersistenciaTabela.hpp"
+#include "RegistroMotores.hpp"
+#include "SaidaResultados.hpp"
+#include "ServidorTabela.hpp"
+#include "TabelaCompartilhada.hpp"
+#include "TabelaRedimensionavel.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr unsigned SEMENTE = 20241018;
+
+/// Níveis de ISA suportados por esta CPU, do escalar ao detectado
+std::vector<NivelIsa> niveisSuportados() {
+    std::vector<NivelIsa> niveis;
+    for (NivelIsa nivel : {NivelIsa::ESCALAR, NivelIsa::SSE2, NivelIsa::AVX2, NivelIsa::AVX512}) {
+        if (nivel <= isaDetectada()) {
+            niveis.push_back(nivel);
+        }
+    }
+    return niveis;
+}
+
+/**
+ * @brief Sequência aleatória de operações num motor, conferida a cada passo
+ *
+ * Metade das chaves é múltipla do tamanho mais um deslocamento pequeno, o
+ * que cria colisões nas duas funções hash, clusters na sondagem linear e
+ * reutilização de células removidas.
+ */
+template<typename Tabela>
+void verificarMotor(const char* nome, typename Tabela::TipoHash tipo, const char* nomeHash) {
+    constexpr size_t OPERACOES = 20000;
+    // Remoções deixam células REMOVIDO na TabelaAberta: o tamanho cobre a
+    // ocupação máxima possível (uma célula nova por inserção) abaixo do limite
+    const size_t tamanho = TabelaRedimensionavel::proximoPrimo(3 * OPERACOES);
+
+    Tabela tabela(tamanho);
+    std::unordered_set<int> referencia;
+    std::mt19937 gerador(SEMENTE);
+    std::uniform_int_distribution<int> operacao(0, 99);
+    std::uniform_int_distribution<int> livre(-5000, 5000);
+    std::uniform_int_distribution<int> multiplo(-40, 40);
+    std::uniform_int_distribution<int> deslocamento(0, 3);
+
+    auto sortearChave = [&]() {
+        return gerador() % 2 == 0
+            ? livre(gerador)
+            : multiplo(gerador) * static_cast<int>(tamanho) + deslocamento(gerador);
+    };
+
+    for (size_t passo = 0; passo < OPERACOES; ++passo) {
+        const int chave = sortearChave();
+        const int sorteio = operacao(gerador);
+        if (sorteio < 50) {
+            tabela.inserir(chave, tipo);
+            referencia.insert(chave);
+        } else if (sorteio < 80) {
+            VERIFICAR(static_cast<bool>(tabela.buscar(chave, tipo)) == (referencia.count(chave) == 1),
+                      nome << "/" << nomeHash << " chave " << chave << " no passo " << passo);
+        } else {
+            const bool removido = static_cast<bool>(tabela.remover(chave, tipo));
+            VERIFICAR(removido == (referencia.erase(chave) == 1),
+                      nome << "/" << nomeHash << " remoção de " << chave << " no passo " << passo);
+        }
+        VERIFICAR(tabela.getNumElementos() == referencia.size(),
+                  nome << "/" << nomeHash << " no passo " << passo);
+    }
+
+    for (int chave : referencia) {
+        VERIFICAR(tabela.buscar(chave, tipo), nome << "/" << nomeHash << " perdeu a chave " << chave);
+    }
+
+    // Busca em lote: mesmo resultado de buscar(), com um lote final incompleto;
+    // os extremos conferem o |k| dos kernels contra o das funções hash escalares
+    for (int extremo : {INT_MIN, INT_MAX}) {
+        tabela.inserir(extremo, tipo);
+        referencia.insert(extremo);
+    }
+    std::vector<int> consultas(1001);
+    for (int& chave : consultas) {
+        chave = sortearChave();
+    }
+    consultas[3] = INT_MIN;
+    consultas[500] = INT_MAX;
+    consultas[1000] = INT_MIN + 1;
+    std::vector<uint8_t> encontrados(consultas.size(), 2);
+    tabela.buscarLote(consultas.data(), consultas.size(), tipo, encontrados.data());
+    for (size_t i = 0; i < consultas.size(); ++i) {
+        VERIFICAR(encontrados[i] == (referencia.count(consultas[i]) == 1 ? 1 : 0),
+                  nome << "/" << nomeHash << " buscarLote da chave " << consultas[i]);
+    }
+
+    for (int chave : referencia) {
+        VERIFICAR(static_cast<bool>(tabela.remover(chave, tipo)), nome << "/" << nomeHash << " chave " << chave);
+    }
+    VERIFICAR(tabela.getNumElementos() == 0, nome << "/" << nomeHash);
+    VERIFICAR(!tabela.buscar(0, tipo), nome << "/" << nomeHash << " tabela esvaziada");
+}
+
+void testarMotores() {
+    for (NivelIsa nivel : niveisSuportados()) {
+        selecionarIsa(nivel);
+        std::apply([](const auto&... motor) {
+            auto verificar = [](const auto& registrado) {
+                using Tabela = typename std::decay_t<decltype(registrado)>::Tabela;
+                verificarMotor<Tabela>(registrado.nome, Tabela::TipoHash::DIVISAO, "Divisao");
+                verificarMotor<Tabela>(registrado.nome, Tabela::TipoHash::MULTIPLICACAO, "Multiplicacao");
+            };
+            (verificar(motor), ...);
+        }, MOTORES_REGISTRADOS);
+    }
+    selecionarIsa(isaDetectada());
+}
+
+void testarAbertaLimites() {
+    TabelaAberta tabela(11);
+    size_t inseridos = 0;
+    bool recusou = false;
+    for (int chave = 1; chave <= 11; ++chave) {
+        try {
+            tabela.inserir(chave, TabelaAberta::TipoHash::DIVISAO);
+            ++inseridos;
+        } catch (const std::runtime_error&) {
+            recusou = true;
+            break;
+        }
+    }
+    VERIFICAR(recusou, "tabela de 11 posições aceitou 11 chaves");
+    VERIFICAR(tabela.getNumElementos() == inseridos, "contagem alterada pela inserção recusada");
+    for (int chave = 1; chave <= static_cast<int>(inseridos); ++chave) {
+        VERIFICAR(tabela.buscar(chave, TabelaAberta::TipoHash::DIVISAO), "chave " << chave);
+    }
+
+    bool invalido = false;
+    try {
+        TabelaAberta vazia(0);
+    } catch (const std::invalid_argument&) {
+        invalido = true;
+    }
+    VERIFICAR(invalido, "tamanho zero aceito");
+}
+
+void testarRedimensionavel() {
+    using Modo = TabelaRedimensionavel::Modo;
+    for (Modo modo : {Modo::PARADA_TOTAL, Modo::INCREMENTAL, Modo::SEGUNDO_PLANO}) {
+        TabelaRedimensionavel tabela(modo);
+        std::unordered_set<int> referencia;
+        std::mt19937 gerador(SEMENTE);
+        std::uniform_int_distribution<int> chaves(INT_MIN + 1, INT_MAX);
+        for (size_t i = 0; i < 100000; ++i) {
+            // Um terço de repetições recentes exercita as duplicatas durante a migração
+            const int chave = i % 3 == 2 ? static_cast<int>(i / 2) : chaves(gerador) % 200000;
+            VERIFICAR(tabela.inserir(chave) == referencia.insert(chave).second,
+                      "modo " << tabela.getModo() << " chave " << chave);
+            if (i % 1000 == 0) {
+                VERIFICAR(tabela.buscar(chave), "modo " << tabela.getModo() << " chave " << chave);
+            }
+        }
+        tabela.finalizarMigracao();
+        VERIFICAR(tabela.getNumElementos() == referencia.size(), "modo " << tabela.getModo());
+        VERIFICAR(tabela.getRedimensionamentos() > 0, "modo " << tabela.getModo());
+        for (int chave = -200000; chave < 200000; ++chave) {
+            VERIFICAR(tabela.buscar(chave) == (referencia.count(chave) == 1),
+                      "modo " << tabela.getModo() << " chave " << chave);
+        }
+
+        bool recusou = false;
+        try {
+            tabela.inserir(INT_MIN);
+        } catch (const std::invalid_argument&) {
+            recusou = true;
+        }
+        VERIFICAR(recusou, "INT_MIN aceita no modo " << tabela.getModo());
+    }
+}
+
+void testarKernels() {
+    std::mt19937 gerador(SEMENTE);
+    selecionarIsa(NivelIsa::ESCALAR);
+    const KernelsSimd escalar = kernelsSimd();
+
+    for (NivelIsa nivel : niveisSuportados()) {
+        selecionarIsa(nivel);
+        const KernelsSimd& kernels = kernelsSimd();
+
+        // Sondagem: células com os três estados e valores repetidos
+        std::vector<Celula> celulas(257);
+        for (int rodada = 0; rodada < 200; ++rodada) {
+            for (auto& celula : celulas) {
+                const unsigned sorteio = gerador() % 10;
+                celula = Celula(static_cast<int>(gerador() % 8) - 1);
+                if (sorteio == 0) {
+                    celula = Celula();
+                } else if (sorteio == 1) {
+                    celula.marcarRemovido();
+                }
+            }
+            const int valor = static_cast<int>(gerador() % 8) - 1;
+            const size_t inicio = gerador() % celulas.size();
+            const size_t fim = inicio + gerador() % (celulas.size() - inicio + 1);
+            for (bool paraInsercao : {false, true}) {
+                VERIFICAR(kernels.sondarCelulas(celulas.data(), inicio, fim, valor, paraInsercao) ==
+                              escalar.sondarCelulas(celulas.data(), inicio, fim, valor, paraInsercao),
+                          nomeIsa(nivel) << " [" << inicio << ", " << fim << ") valor " << valor);
+            }
+        }
+
+        // Funções hash em lote: chaves negativas, extremos e caudas de todos os tamanhos
+        for (size_t n = 0; n <= 67; ++n) {
+            std::vector<int> lote(n);
+            for (auto& chave : lote) {
+                constexpr int EXTREMOS[] = {INT_MAX, INT_MIN, INT_MIN + 1};
+                const unsigned extremo = gerador() % 15;
+                chave = extremo < 3 ? EXTREMOS[extremo] : static_cast<int>(gerador());
+            }
+            for (size_t tamanho : {size_t{1}, size_t{17}, size_t{10007}, size_t{2147483647}}) {
+                std::vector<size_t> obtido(n), esperado(n);
+                kernels.hashDivisaoLote(lote.data(), n, tamanho, obtido.data());
+                escalar.hashDivisaoLote(lote.data(), n, tamanho, esperado.data());
+                VERIFICAR(obtido == esperado, nomeIsa(nivel) << " divisão n=" << n << " tamanho " << tamanho);
+                kernels.hashMultiplicacaoLote(lote.data(), n, tamanho, 0.63274838, obtido.data());
+                escalar.hashMultiplicacaoLote(lote.data(), n, tamanho, 0.63274838, esperado.data());
+                VERIFICAR(obtido == esperado,
+                          nomeIsa(nivel) << " multiplicação n=" << n << " tamanho " << tamanho);
+            }
+        }
+
+        // Quebras de linha em qualquer posição, inclusive ausentes
+        std::vector<char> texto(300);
+        for (int rodada = 0; rodada < 200; ++rodada) {
+            for (auto& c : texto) {
+                c = gerador() % 40 == 0 ? '\n' : static_cast<char>('0' + gerador() % 10);
+            }
+            const size_t inicio = gerador() % texto.size();
+            const size_t fim = inicio + gerador() % (texto.size() - inicio + 1);
+            VERIFICAR(kernels.localizarQuebra(texto.data() + inicio, texto.data() + fim) ==
+                          escalar.localizarQuebra(texto.data() + inicio, texto.data() + fim),
+                      nomeIsa(nivel) << " [" << inicio << ", " << fim << ")");
+        }
+    }
+    selecionarIsa(isaDetectada());
+}
+
+void testarCarregador() {
+    const auto arquivo = std::filesystem::temp_directory_path() / "analise_hash_teste_carregador.txt";
+    {
+        std::FILE* saida = std::fopen(arquivo.string().c_str(), "wb");
+        VERIFICAR(saida != nullptr, arquivo.string());
+        // Quantidade maior que a de números válidos, CRLF, espaços, sinal
+        // explícito, linha vazia, texto inválido e última linha sem '\n'
+        std::fputs("6\r\n5\n  7 \t\n\n+12\r\nabc\n-3\n8", saida);
+        std::fclose(saida);
+    }
+
+    const std::vector<int> esperado{5, 7, 12, -3, 8};
+    for (NivelIsa nivel : niveisSuportados()) {
+        selecionarIsa(nivel);
+        CarregadorDados carregador(SEMENTE);
+        VERIFICAR(carregador.carregarDeArquivo(arquivo.string()) == esperado, nomeIsa(nivel));
+    }
+    selecionarIsa(isaDetectada());
+
+    // Blocos menores que uma linha e leituras parciais, como nos derrames
+    for (size_t bytesBloco : {1, 2, 3, 64}) {
+        LeitorDataset leitor(arquivo.string(), bytesBloco);
+        VERIFICAR(leitor.getQuantidadeDeclarada() == 6, "bloco de " << bytesBloco);
+        std::vector<int> lidos;
+        int destino[2];
+        for (size_t n = leitor.ler(destino, 2); n > 0; n = leitor.ler(destino, 2)) {
+            lidos.insert(lidos.end(), destino, destino + n);
+        }
+        VERIFICAR(lidos == esperado, "bloco de " << bytesBloco);
+        VERIFICAR(leitor.getNumerosLidos() == esperado.size(), "bloco de " << bytesBloco);
+    }
+    std::filesystem::remove(arquivo);
+
+    bool ausente = false;
+    try {
+        CarregadorDados carregador(SEMENTE);
+        carregador.carregarDeArquivo(arquivo.string());
+    } catch (const std::runtime_error&) {
+        ausente = true;
+    }
+    VERIFICAR(ausente, "arquivo inexistente aceito");
+}
+
+/**
+ * @brief Mutações aleatórias numa TabelaDuravel, reabertas e conferidas
+ *
+ * Os snapshots periódicos caem no meio da sequência, de modo que a
+ * recuperação combina snapshot e cauda do diário. Por fim, bytes de um
+ * registro incompleto no fim do diário simulam uma escrita interrompida, e
+ * registrosPorSincronizacao = 0 deve gravar cada registro sem fdatasync.
+ */
+template<typename Tabela>
+void verificarPersistencia(const char* nome) {
+    const auto diretorio = std::filesystem::temp_directory_path() /
+                           (std::string("analise_hash_teste_persistencia_") + nome);
+    std::filesystem::remove_all(diretorio);
+
+    ConfiguracaoPersistencia config;
+    config.registrosPorSincronizacao = 1;
+    config.mutacoesPorSnapshot = 700;
+    const size_t tamanho = TabelaRedimensionavel::proximoPrimo(12000);
+    const auto tipo = Tabela::TipoHash::DIVISAO;
+
+    std::unordered_set<int> referencia;
+    std::mt19937 gerador(SEMENTE);
+    std::uniform_int_distribution<int> chaveSorteada(-2000, 2000);
+    auto conferir = [&](const TabelaDuravel<Tabela>& tabela, const char* etapa) {
+        VERIFICAR(tabela.getNumElementos() == referencia.size(),
+                  nome << " " << etapa << ": " << tabela.getNumElementos() << " de " << referencia.size());
+        for (int chave = -2000; chave <= 2000; ++chave) {
+            VERIFICAR(tabela.buscar(chave) == (referencia.count(chave) == 1), nome << " " << etapa << " chave " << chave);
+        }
+    };
+
+    for (int abertura = 0; abertura < 3; ++abertura) {
+        TabelaDuravel<Tabela> tabela(diretorio.string(), tamanho, tipo, config);
+        conferir(tabela, "recuperação");
+        for (int passo = 0; passo < 2500; ++passo) {
+            const int chave = chaveSorteada(gerador);
+            if (gerador() % 3 != 0) {
+                tabela.inserir(chave);
+                referencia.insert(chave);
+            } else {
+                VERIFICAR(tabela.remover(chave) == (referencia.erase(chave) == 1), nome << " remoção de " << chave);
+            }
+        }
+        tabela.aguardarSnapshot();
+        VERIFICAR(tabela.getEstatisticas().snapshots > 0, nome << " sem snapshot periódico");
+    }
+
+    // Registro incompleto no último segmento: descartado, sem afetar os anteriores
+    std::filesystem::path ultimo;
+    for (const auto& entrada : std::filesystem::directory_iterator(diretorio)) {
+        if (entrada.path().filename().string().rfind("diario.", 0) == 0 && entrada.path() > ultimo) {
+            ultimo = entrada.path();
+        }
+    }
+    VERIFICAR(!ultimo.empty(), nome << " sem segmento do diário");
+    {
+        std::FILE* arquivo = std::fopen(ultimo.string().c_str(), "ab");
+        VERIFICAR(arquivo != nullptr, ultimo.string());
+        std::fputs("\x01\x02\x03", arquivo);
+        std::fclose(arquivo);
+    }
+    {
+        TabelaDuravel<Tabela> tabela(diretorio.string(), tamanho, tipo, config);
+        conferir(tabela, "cauda truncada");
+        VERIFICAR(tabela.getEstatisticas().bytesDescartados == 3, nome << " " << tabela.getEstatisticas().bytesDescartados);
+        VERIFICAR(tabela.getEstatisticas().chavesSnapshot > 0, nome << " recuperação sem snapshot");
+    }
+    {
+        // Sem fdatasync, cada registro ainda é entregue ao SO na própria mutação
+        ConfiguracaoPersistencia semSincronizacao = config;
+        semSincronizacao.registrosPorSincronizacao = 0;
+        TabelaDuravel<Tabela> tabela(diretorio.string(), tamanho, tipo, semSincronizacao);
+        for (int chave = 5000; chave < 5010; ++chave) {
+            tabela.inserir(chave);
+            const auto& estatisticas = tabela.getEstatisticas();
+            VERIFICAR(estatisticas.bytesDiario == estatisticas.registros * PersistenciaTabela::BYTES_REGISTRO,
+                      nome << " registro retido no buffer: " << estatisticas.bytesDiario << " bytes");
+        }
+        VERIFICAR(tabela.getEstatisticas().sincronizacoes == 0, nome << " fdatasync com registrosPorSincronizacao = 0");
+    }
+    std::filesystem::remove_all(diretorio);
+}
+
+void testarPersistencia() {
+#if defined(__unix__) || defined(__APPLE__)
+    std::apply([](const auto&... motor) {
+        (verificarPersistencia<typename std::decay_t<decltype(motor)>::Tabela>(motor.nome), ...);
+    }, MOTORES_REGISTRADOS);
+#else
+    throw CasoPulado("persistência disponível apenas em sistemas POSIX");
+#endif
+}
+
+/**
+ * @brief Operações de conjunto de um motor contra std::set_* sobre vetores ordenados
+ */
+template<typename Tabela>
+void verificarConjuntos(const char* nome) {
+    std::mt19937 gerador(SEMENTE);
+    std::uniform_int_distribution<int> chaveSorteada(-30000, 30000);
+    std::vector<int> a(20000);
+    std::vector<int> b(12000);
+    for (int& chave : a) chave = chaveSorteada(gerador);
+    for (int& chave : b) chave = chaveSorteada(gerador);
+
+    const auto tipo = Tabela::TipoHash::MULTIPLICACAO;
+    const Tabela tabelaA = construirTabela<Tabela>(a, tipo);
+    const Tabela tabelaB = construirTabela<Tabela>(b, tipo, 0.3);
+
+    auto ordenadoSemRepeticao = [](std::vector<int> chaves) {
+        std::sort(chaves.begin(), chaves.end());
+        chaves.erase(std::unique(chaves.begin(), chaves.end()), chaves.end());
+        return chaves;
+    };
+    const std::vector<int> conjuntoA = ordenadoSemRepeticao(a);
+    const std::vector<int> conjuntoB = ordenadoSemRepeticao(b);
+    VERIFICAR(tabelaA.getNumElementos() == conjuntoA.size(), nome << " construirTabela");
+    std::vector<int> esperadaIntersecao, esperadaUniao, esperadaDiferenca;
+    std::set_intersection(conjuntoA.begin(), conjuntoA.end(), conjuntoB.begin(), conjuntoB.end(),
+                          std::back_inserter(esperadaIntersecao));
+    std::set_union(conjuntoA.begin(), conjuntoA.end(), conjuntoB.begin(), conjuntoB.end(),
+                   std::back_inserter(esperadaUniao));
+    std::set_difference(conjuntoA.begin(), conjuntoA.end(), conjuntoB.begin(), conjuntoB.end(),
+                        std::back_inserter(esperadaDiferenca));
+
+    // Uma thread; partições com bloco que não divide o total; mais threads que blocos
+    for (const ConfiguracaoConjunto& config : {ConfiguracaoConjunto{1, 4096}, ConfiguracaoConjunto{3, 37},
+                                               ConfiguracaoConjunto{64, 5000}}) {
+        const std::string contexto = std::string(nome) + " threads=" + std::to_string(config.threads);
+        auto ordenado = [](std::vector<int> chaves) {
+            std::sort(chaves.begin(), chaves.end());
+            return chaves;
+        };
+        VERIFICAR(ordenado(intersecao(tabelaA, tabelaB, tipo, config)) == esperadaIntersecao, contexto);
+        VERIFICAR(ordenado(intersecao(tabelaB, tabelaA, tipo, config)) == esperadaIntersecao, contexto);
+        VERIFICAR(ordenado(uniao(tabelaA, tabelaB, tipo, config)) == esperadaUniao, contexto);
+        VERIFICAR(ordenado(diferenca(tabelaA, tabelaB, tipo, config)) == esperadaDiferenca, contexto);
+
+        // Vetor com duplicatas: mantidas, na ordem original
+        std::vector<int> esperadoFiltro;
+        for (int chave : b) {
+            if (std::binary_search(conjuntoA.begin(), conjuntoA.end(), chave)) esperadoFiltro.push_back(chave);
+        }
+        VERIFICAR(filtrarChaves(b, tabelaA, tipo, true, config) == esperadoFiltro, contexto);
+    }
+}
+
+void testarConjuntos() {
+    std::apply([](const auto&... motor) {
+        (verificarConjuntos<typename std::decay_t<decltype(motor)>::Tabela>(motor.nome), ...);
+    }, MOTORES_REGISTRADOS);
+}
+
+void testarJuncao() {
+    std::mt19937 gerador(SEMENTE);
+    std::uniform_int_distribution<int> chaveSorteada(-5000, 5000);
+    std::vector<int> construcao(30000);
+    std::vector<int> sonda(50000);
+    for (int& chave : construcao) chave = chaveSorteada(gerador);
+    for (int& chave : sonda) chave = chaveSorteada(gerador);
+    construcao[0] = INT_MIN;
+    sonda[0] = INT_MIN;
+    sonda[1] = INT_MAX;
+
+    // Pares esperados: as linhas da construção ordenadas por chave, consultadas por intervalo
+    std::vector<std::pair<int, uint32_t>> porChave;
+    for (size_t i = 0; i < construcao.size(); ++i) porChave.emplace_back(construcao[i], static_cast<uint32_t>(i));
+    std::sort(porChave.begin(), porChave.end());
+    std::vector<std::pair<uint32_t, uint32_t>> esperados;
+    for (size_t j = 0; j < sonda.size(); ++j) {
+        const auto faixa = std::equal_range(porChave.begin(), porChave.end(), std::make_pair(sonda[j], 0u),
+            [](const auto& x, const auto& y) { return x.first < y.first; });
+        for (auto it = faixa.first; it != faixa.second; ++it) esperados.emplace_back(it->second, static_cast<uint32_t>(j));
+    }
+    std::sort(esperados.begin(), esperados.end());
+
+    auto conferir = [&](const ResultadoJuncao& resultado, const std::string& contexto) {
+        VERIFICAR(resultado.correspondencias == esperados.size(),
+                  contexto << ": " << resultado.correspondencias << " correspondências, esperadas " << esperados.size());
+        std::vector<std::pair<uint32_t, uint32_t>> obtidos;
+        for (const ParJuncao& par : resultado.pares) obtidos.emplace_back(par.linhaConstrucao, par.linhaSonda);
+        std::sort(obtidos.begin(), obtidos.end());
+        VERIFICAR(obtidos == esperados, contexto << " pares");
+    };
+
+    conferir(juntarSemParticao(construcao, sonda, true, ConfiguracaoJuncao{3, 0, 1}), "tabela única");
+    // Bits automáticos (uma passagem), poucos bits, duas passagens e mais partições que linhas
+    for (const ConfiguracaoJuncao& config : {ConfiguracaoJuncao{1, 0, 4096}, ConfiguracaoJuncao{4, 3, 1},
+                                             ConfiguracaoJuncao{3, 13, 1}, ConfiguracaoJuncao{2, 20, 1}}) {
+        const ResultadoJuncao resultado = juntarParticionado(construcao, sonda, true, config);
+        const std::string contexto = "particionada threads=" + std::to_string(config.threads) +
+                                     " bits=" + std::to_string(config.bitsRadix);
+        VERIFICAR(resultado.particoes == (size_t{1} << bitsParticao(construcao.size(), config)), contexto);
+        VERIFICAR(resultado.passagens == (resultado.particoes > (size_t{1} << BITS_POR_PASSAGEM) ? 2u : 1u), contexto);
+        conferir(resultado, contexto);
+    }
+    // 30000 linhas x 16 bytes em partições de 4 KiB: 2^7 partições
+    VERIFICAR(bitsParticao(construcao.size(), ConfiguracaoJuncao{1, 0, 4096}) == 7, "bits para 30000 linhas");
+    const ResultadoJuncao contagem = juntarParticionado(construcao, sonda, false, ConfiguracaoJuncao{2, 0, 4096});
+    VERIFICAR(contagem.correspondencias == esperados.size() && contagem.pares.empty(), "contagem sem pares");
+
+    const std::vector<int> vazia;
+    VERIFICAR(juntarParticionado(vazia, sonda, true).correspondencias == 0, "construção vazia");
+    VERIFICAR(juntarParticionado(construcao, vazia, true, ConfiguracaoJuncao{2, 5, 1}).pares.empty(), "sonda vazia");
+    VERIFICAR(juntarSemParticao(vazia, vazia, false).correspondencias == 0, "colunas vazias");
+    bool recusou = false;
+    try {
+        juntarParticionado(construcao, sonda, false, ConfiguracaoJuncao{1, 2 * BITS_POR_PASSAGEM + 1, 1});
+    } catch (const std::invalid_argument&) {
+        recusou = true;
+    }
+    VERIFICAR(recusou, "bits acima do limite aceitos");
+}
+
+/**
+ * @brief deduplicarArquivo de um motor contra std::set, com e sem derrames
+ */
+template<typename Tabela>
+void verificarDeduplicacao(const char* nome) {
+    const auto diretorio = std::filesystem::temp_directory_path() /
+                           (std::string("analise_hash_teste_deduplicacao_") + nome);
+    std::filesystem::remove_all(diretorio);
+    std::filesystem::create_directories(diretorio);
+    const auto dataset = diretorio / "dataset.txt";
+    const auto saidaUnicas = diretorio / "unicas.txt";
+    const auto derrames = diretorio / "derrames";
+    auto gravar = [&](const std::vector<int>& chaves) {
+        std::FILE* saida = std::fopen(dataset.string().c_str(), "wb");
+        VERIFICAR(saida != nullptr, dataset.string());
+        std::fprintf(saida, "%zu\n", chaves.size());
+        for (int chave : chaves) std::fprintf(saida, "%d\n", chave);
+        std::fclose(saida);
+    };
+    const auto tipo = Tabela::TipoHash::DIVISAO;
+
+    // Extremos de int, negativos e repetições
+    std::mt19937 gerador(SEMENTE);
+    std::uniform_int_distribution<int> chaveSorteada(-50000, 50000);
+    std::vector<int> chaves(200000);
+    for (int& chave : chaves) chave = chaveSorteada(gerador);
+    chaves[17] = INT_MIN;
+    chaves[1000] = INT_MAX;
+    chaves[150000] = INT_MIN;
+    gravar(chaves);
+    const std::set<int> esperadas(chaves.begin(), chaves.end());
+    long double soma = 0;
+    for (int chave : chaves) soma += chave;
+
+    ConfiguracaoDeduplicacao config;
+    config.bytesMemoria = 16 * 1024 * 1024;
+    config.diretorio = derrames.string();
+    config.arquivoUnicos = saidaUnicas.string();
+
+    // Cabe no orçamento: uma partição, sem derrames
+    ResultadoDeduplicacao resultado = deduplicarArquivo<Tabela>(dataset.string(), tipo, config);
+    VERIFICAR(resultado.chaves == chaves.size() && resultado.unicas == esperadas.size(),
+              nome << " em memória: " << resultado.unicas << " de " << esperadas.size());
+    VERIFICAR(resultado.particoes == 1 && resultado.niveis == 0 && resultado.bytesDerramados == 0,
+              nome << " em memória: " << resultado.particoes << " partições");
+    VERIFICAR(resultado.minimo == INT_MIN && resultado.maximo == INT_MAX, nome);
+    VERIFICAR(resultado.media == static_cast<double>(soma / chaves.size()), nome << " média " << resultado.media);
+
+    // Limite pequeno: mais de um nível de particionamento
+    config.chavesPorParticao = 500;
+    resultado = deduplicarArquivo<Tabela>(dataset.string(), tipo, config);
+    VERIFICAR(resultado.unicas == esperadas.size() && resultado.duplicatas() == chaves.size() - esperadas.size(),
+              nome << " em disco: " << resultado.unicas << " de " << esperadas.size());
+    VERIFICAR(resultado.niveis >= 2 && resultado.particoes > 256, nome << " " << resultado.niveis << " níveis");
+    VERIFICAR(resultado.maiorParticao <= 500, nome << " partição de " << resultado.maiorParticao);
+    VERIFICAR(resultado.minimo == INT_MIN && resultado.maximo == INT_MAX, nome);
+    VERIFICAR(resultado.media == static_cast<double>(soma / chaves.size()), nome << " média " << resultado.media);
+    VERIFICAR(std::filesystem::is_empty(derrames), nome << " derrames não apagados");
+    {
+        CarregadorDados carregador(SEMENTE);
+        const std::vector<int> unicas = carregador.carregarDeArquivo(saidaUnicas.string());
+        VERIFICAR(std::set<int>(unicas.begin(), unicas.end()) == esperadas && unicas.size() == esperadas.size(),
+                  nome << " saída com " << unicas.size() << " chaves");
+    }
+
+    // Partição limitada pelo custo de memória do próprio motor: 400000 chaves
+    // distintas cabem em 16 MiB na Aberta (20 bytes por chave), mas não na
+    // Encadeada (52)
+    std::vector<int> distintas(400000);
+    std::iota(distintas.begin(), distintas.end(), -200000);
+    gravar(distintas);
+    config.chavesPorParticao = 0;
+    resultado = deduplicarArquivo<Tabela>(dataset.string(), tipo, config);
+    const size_t custo = 2 * Tabela::BYTES_POR_POSICAO + Tabela::bytesPorChave() + sizeof(int);
+    const bool cabe = (config.bytesMemoria - 1024 * 1024) / custo >= distintas.size();
+    VERIFICAR(resultado.unicas == distintas.size() && (resultado.niveis == 0) == cabe,
+              nome << " com " << custo << " bytes por chave: " << resultado.niveis << " níveis");
+    config.chavesPorParticao = 500;
+
+    // Uma chave repetida: a divisão não separa nada e a partição é deduplicada assim mesmo
+    gravar(std::vector<int>(5000, -7));
+    resultado = deduplicarArquivo<Tabela>(dataset.string(), tipo, config);
+    VERIFICAR(resultado.chaves == 5000 && resultado.unicas == 1 && resultado.particoes == 1,
+              nome << " chave única: " << resultado.unicas << " em " << resultado.particoes << " partições");
+
+    bool recusado = false;
+    try {
+        config.bytesMemoria = 8 * 1024 * 1024;
+        deduplicarArquivo<Tabela>(dataset.string(), tipo, config);
+    } catch (const std::invalid_argument&) {
+        recusado = true;
+    }
+    VERIFICAR(recusado, nome << " orçamento abaixo do mínimo aceito");
+    std::filesystem::remove_all(diretorio);
+}
+
+void testarDeduplicacao() {
+    std::apply([](const auto&... motor) {
+        (verificarDeduplicacao<typename std::decay_t<decltype(motor)>::Tabela>(motor.nome), ...);
+    }, MOTORES_REGISTRADOS);
+}
+
+void testarCompartilhada() {
+#if defined(__unix__) || defined(__APPLE__)
+    using Tipo = TabelaCompartilhada::TipoHash;
+    const std::string nome = "/analise_hash_teste_" + std::to_string(::getpid());
+    TabelaCompartilhada::removerNome(nome);
+
+    // Escritor e leitor no mesmo processo, com mapeamentos distintos do segmento nomeado
+    for (Tipo tipo : {Tipo::DIVISAO, Tipo::MULTIPLICACAO}) {
+        TabelaCompartilhada escritor = TabelaCompartilhada::criar(nome, 1009, tipo);
+        const TabelaCompartilhada leitor = TabelaCompartilhada::abrir(nome);
+        VERIFICAR(TabelaCompartilhada::removerNome(nome), "nome não encontrado");
+        VERIFICAR(leitor.somenteLeitura() && leitor.getTamanho() == 1009 && leitor.getTipoHash() == tipo, "cabeçalho");
+
+        std::unordered_set<int> referencia;
+        std::mt19937 gerador(SEMENTE);
+        std::uniform_int_distribution<int> chaveSorteada(-1500, 1500);
+        for (int passo = 0; passo < 30000; ++passo) {
+            const int chave = chaveSorteada(gerador);
+            if (gerador() % 2 == 0 && referencia.size() < 650) {
+                VERIFICAR(escritor.inserir(chave) == referencia.insert(chave).second, "inserção de " << chave);
+            } else {
+                VERIFICAR(escritor.remover(chave) == (referencia.erase(chave) == 1), "remoção de " << chave);
+            }
+        }
+        escritor.publicar();
+        VERIFICAR(leitor.getVersao() == 1 && leitor.getNumElementos() == referencia.size(),
+                  leitor.getNumElementos() << " de " << referencia.size());
+        VERIFICAR(leitor.getCompactacoes() > 0, "sem compactação");
+        for (int chave = -1500; chave <= 1500; ++chave) {
+            const bool esperado = referencia.count(chave) == 1;
+            VERIFICAR(escritor.buscar(chave) == esperado && leitor.buscar(chave) == esperado, "chave " << chave);
+        }
+
+        bool recusada = false;
+        try {
+            escritor.inserir(INT_MIN + 1);
+        } catch (const std::invalid_argument&) {
+            recusada = true;
+        }
+        VERIFICAR(recusada && !leitor.buscar(INT_MIN), "chaves reservadas aceitas");
+        bool somenteLeitura = false;
+        try {
+            const_cast<TabelaCompartilhada&>(leitor).inserir(1);
+        } catch (const std::logic_error&) {
+            somenteLeitura = true;
+        }
+        VERIFICAR(somenteLeitura, "leitor aceitou inserção");
+    }
+
+    // Leitor em outro processo: chaves estáveis sempre presentes e ausentes
+    // nunca vistas enquanto o escritor remove e reinsere as demais
+    TabelaCompartilhada escritor = TabelaCompartilhada::criar(nome, 4001, Tipo::DIVISAO);
+    for (int chave = 0; chave < 2600; ++chave) {
+        escritor.inserir(chave);
+    }
+    int sinal[2];
+    VERIFICAR(::pipe(sinal) == 0, "pipe");
+    const pid_t filho = ::fork();
+    VERIFICAR(filho >= 0, "fork");
+    if (filho == 0) {
+        ::close(sinal[0]);
+        int codigo = 0;
+        try {
+            const TabelaCompartilhada leitor = TabelaCompartilhada::abrir(nome);
+            char pronto = 1;
+            if (::write(sinal[1], &pronto, 1) != 1) codigo = 3;
+            for (int volta = 0; volta < 200 && codigo == 0; ++volta) {
+                for (int chave = 0; chave < 1000; ++chave) {
+                    if (!leitor.buscar(chave) || leitor.buscar(-1 - chave)) codigo = 1;
+                }
+            }
+        } catch (...) {
+            codigo = 2;
+        }
+        ::_exit(codigo);
+    }
+    ::close(sinal[1]);
+    char pronto = 0;
+    const bool abriu = ::read(sinal[0], &pronto, 1) == 1;
+    ::close(sinal[0]);
+
+    std::mt19937 gerador(SEMENTE);
+    std::uniform_int_distribution<int> chaveSorteada(1000, 2599);
+    int status = 0;
+    while (::waitpid(filho, &status, WNOHANG) == 0) {
+        for (int passo = 0; passo < 512; ++passo) {
+            const int chave = chaveSorteada(gerador);
+            escritor.remover(chave);
+            escritor.inserir(chave + 10000);
+            escritor.remover(chave + 10000);
+            escritor.inserir(chave);
+        }
+        escritor.publicar();
+    }
+    TabelaCompartilhada::removerNome(nome);
+    VERIFICAR(abriu, "leitor não abriu o segmento");
+    VERIFICAR(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+              "leitor em outro processo: código " << (WIFEXITED(status) ? WEXITSTATUS(status) : -1));
+    VERIFICAR(escritor.getNumElementos() == 2600, escritor.getNumElementos());
+    VERIFICAR(escritor.getCompactacoes() > 0, "sem compactação durante a leitura");
+#else
+    throw CasoPulado("memória compartilhada disponível apenas em sistemas POSIX");
+#endif
+}
+
+void testarServidor() {
+#if defined(__linux__)
+    const auto caminho = std::filesystem::temp_directory_path() /
+                         ("analise_hash_teste_" + std::to_string(::getpid()) + ".sock");
+    const EnderecoKv endereco = EnderecoKv::ler("unix:" + caminho.string());
+
+    for (const std::string& nome : nomesMotores()) {
+        ServidorTabela servidor(endereco, nome, "Divisao", 10007);
+        std::exception_ptr erroServidor;
+        std::thread laco([&] {
+            try {
+                servidor.executar(false);
+            } catch (...) {
+                erroServidor = std::current_exception();
+            }
+        });
+
+        // Semântica de cada operação, incluindo código de operação inválido
+        const int descritor = conectarSocketKv(endereco);
+        const std::vector<ComandoKv> comandos{
+            {OperacaoKv::PUT, 5}, {OperacaoKv::PUT, 5}, {OperacaoKv::GET, 5}, {OperacaoKv::GET, 6},
+            {OperacaoKv::DEL, 5}, {OperacaoKv::DEL, 5}, {OperacaoKv::GET, 5}, {OperacaoKv::PUT, -7},
+            {OperacaoKv::GET, -7}, {static_cast<OperacaoKv>(9), 1}};
+        const std::vector<uint8_t> esperado{1, 0, 1, 0, 1, 0, 0, 1, 1, 2};
+        std::vector<uint8_t> buffer;
+        anexarRequisicaoKv(buffer, 77, comandos.data(), comandos.size());
+        VERIFICAR(::send(descritor, buffer.data(), buffer.size(), MSG_NOSIGNAL) ==
+                  static_cast<ssize_t>(buffer.size()), nome);
+        std::vector<uint8_t> resposta(KV_BYTES_CABECALHO + comandos.size());
+        VERIFICAR(::recv(descritor, resposta.data(), resposta.size(), MSG_WAITALL) ==
+                  static_cast<ssize_t>(resposta.size()), nome);
+        ::close(descritor);
+        VERIFICAR(tamanhoQuadroKv(resposta.data(), resposta.size()) == resposta.size(), nome);
+        VERIFICAR(lerU32(resposta.data() + 4) == 77 && lerU16(resposta.data() + 8) == comandos.size(), nome);
+        VERIFICAR(std::vector<uint8_t>(resposta.begin() + KV_BYTES_CABECALHO, resposta.end()) == esperado, nome);
+
+        // Lotes seguidos de shutdown(SHUT_WR), com mais respostas que LIMITE_SAIDA:
+        // todas chegam, em ordem, antes de o servidor fechar a conexão
+        constexpr size_t LOTES_FIM = 100;
+        const std::vector<ComandoKv> buscas(KV_MAX_OPERACOES, ComandoKv{OperacaoKv::GET, -7});
+        const int meiaConexao = conectarSocketKv(endereco);
+        std::thread envio([&] {
+            std::vector<uint8_t> lote;
+            for (size_t i = 0; i < LOTES_FIM; ++i) {
+                lote.clear();
+                anexarRequisicaoKv(lote, static_cast<uint32_t>(i), buscas.data(), buscas.size());
+                for (size_t enviados = 0; enviados < lote.size();) {
+                    const ssize_t n = ::send(meiaConexao, lote.data() + enviados, lote.size() - enviados,
+                                             MSG_NOSIGNAL);
+                    if (n <= 0) return;
+                    enviados += static_cast<size_t>(n);
+                }
+            }
+            ::shutdown(meiaConexao, SHUT_WR);
+        });
+        std::vector<uint8_t> respostas;
+        std::vector<uint8_t> bloco(64 * 1024);
+        for (ssize_t n; (n = ::recv(meiaConexao, bloco.data(), bloco.size(), 0)) > 0;) {
+            respostas.insert(respostas.end(), bloco.begin(), bloco.begin() + n);
+        }
+        envio.join();
+        ::close(meiaConexao);
+        const size_t bytesResposta = KV_BYTES_CABECALHO + buscas.size();
+        VERIFICAR(LOTES_FIM * bytesResposta > ServidorTabela::LIMITE_SAIDA, nome);
+        VERIFICAR(respostas.size() == LOTES_FIM * bytesResposta,
+                  nome << " meio fechamento: " << respostas.size() << " de " << LOTES_FIM * bytesResposta << " bytes");
+        for (size_t i = 0; i < LOTES_FIM && respostas.size() == LOTES_FIM * bytesResposta; ++i) {
+            const uint8_t* quadro = respostas.data() + i * bytesResposta;
+            VERIFICAR(lerU32(quadro + 4) == i && quadro[KV_BYTES_CABECALHO] == 1 && quadro[bytesResposta - 1] == 1,
+                      nome << " meio fechamento, lote " << i);
+        }
+
+        // Pipelining por várias conexões: toda operação respondida, sem erro
+        ConfiguracaoCarga config;
+        config.conexoes = 3;
+        config.profundidade = 4;
+        config.lote = 32;
+        config.operacoes = 20000;
+        config.chaves = 2000;
+        config.mistura = {50, 25, 25};
+        GeradorCarga gerador(endereco, config);
+        gerador.executar();
+        const ResultadoCarga& r = gerador.getResultado();
+        VERIFICAR(r.operacoes == config.operacoes && r.erros == 0, nome << ": " << r.operacoes << " operações, "
+                  << r.erros << " erros");
+        VERIFICAR(r.buscas + r.insercoes + r.remocoes == config.operacoes, nome);
+        VERIFICAR(r.acertos > 0 && r.acertos < r.buscas, nome << ": " << r.acertos << " acertos");
+
+        servidor.parar();
+        laco.join();
+        if (erroServidor) {
+            std::rethrow_exception(erroServidor);
+        }
+        // Operações: semântica + meio fechamento + pré-carga das chaves pares + fase medida
+        const EstatisticasServidor& e = servidor.getEstatisticas();
+        VERIFICAR(e.operacoes == comandos.size() + LOTES_FIM * buscas.size() + config.chaves / 2 + config.operacoes,
+                  nome << ": " << e.operacoes);
+        VERIFICAR(e.conexoesAceitas == 2 + config.conexoes && e.errosProtocolo == 0, nome);
+    }
+    VERIFICAR(!std::filesystem::exists(caminho), "socket não removido: " << caminho.string());
+#else
+    throw CasoPulado("modo servidor disponível apenas no Linux");
+#endif
+}
+
+/// Motor mínimo sem MODELO_SONDAGEM, como um motor novo que não o declara
+struct MotorSemModelo {
+    enum class TipoHash { DIVISAO, MULTIPLICACAO };
+};
+
+void testarResultados() {
+    static_assert(modeloSondagemMotor<MotorSemModelo> == ModeloSondagem::NENHUM,
+                  "motor sem MODELO_SONDAGEM deve ficar sem modelo");
+    static_assert(MotorRegistrado<TabelaEncadeada>::modelo == ModeloSondagem::ENCADEAMENTO, "Encadeada");
+    static_assert(MotorRegistrado<TabelaAberta>::modelo == ModeloSondagem::SONDAGEM_LINEAR, "Aberta");
+
+    ResultadoTeste resultado{};
+    resultado.tipoTabela = "Aberta";
+    resultado.tamanhoTabela = 97;
+    resultado.quantidadeDados = 48;
+    resultado.tipoFuncaoHash = "Divisao";
+    resultado.fatorCarga = 0.5;
+    resultado.dataset = "teste";
+    resultado.mistura = "-";
+    resultado.threads = 1;
+    resultado.repeticao = 1;
+    resultado.sondagemSucesso = 1.25;
+    resultado.sondagemInsucesso = 2.75;
+
+    // O modelo vem do motor, não do nome exibido
+    VERIFICAR(resultado.sondagemSucessoTeorica() == 0.0 && resultado.sondagemInsucessoTeorica() == 0.0,
+              "motor sem modelo com teóricos " << resultado.sondagemSucessoTeorica());
+    resultado.tipoTabela = "Nova";
+    resultado.modeloSondagem = ModeloSondagem::SONDAGEM_LINEAR;
+    VERIFICAR(resultado.sondagemSucessoTeorica() == 1.5 && resultado.sondagemInsucessoTeorica() == 2.5,
+              "sondagem linear " << resultado.sondagemSucessoTeorica() << " " << resultado.sondagemInsucessoTeorica());
+
+    for (auto modelo : {ModeloSondagem::NENHUM, ModeloSondagem::ENCADEAMENTO, ModeloSondagem::SONDAGEM_LINEAR}) {
+        resultado.modeloSondagem = modelo;
+        std::ostringstream linha;
+        SaidaResultados::escreverLinha(linha, resultado);
+        std::string texto = linha.str();
+        VERIFICAR(!texto.empty() && texto.back() == '\n', "linha sem quebra");
+        texto.pop_back();
+
+        ResultadoTeste lido{};
+        VERIFICAR(SaidaResultados::lerLinha(texto, lido), "linha não lida: " << texto);
+        VERIFICAR(lido.modeloSondagem == modelo && lido.tipoTabela == "Nova" && lido.sondagemInsucesso == 2.75 &&
+                  lido.chaveCenario() == resultado.chaveCenario(),
+                  "linha lida diferente da gravada: " << texto);
+    }
+    VERIFICAR(!SaidaResultados::lerLinha("Nova,97", resultado), "linha incompleta aceita");
+
+    // Metadados com vírgulas e aspas entre aspas, conservados ao retomar
+    const std::string cabecalho = SaidaResultados::CABECALHO;
+    const std::string colunasMetadados = MetadadosExecucao::CABECALHO_CSV;
+    VERIFICAR(cabecalho.size() > colunasMetadados.size() &&
+              cabecalho.compare(cabecalho.size() - colunasMetadados.size(), std::string::npos, colunasMetadados) == 0,
+              "cabeçalho sem as colunas de metadados: " << cabecalho);
+    MetadadosExecucao metadados{};
+    metadados.semente = 2787898819u;
+    metadados.revisaoGit = "abc1234";
+    metadados.modeloCpu = "CPU \"teste\", 8 núcleos";
+    metadados.tipoBuild = "Release";
+    metadados.flags = "-O2 -DLISTA=a,b";
+    resultado.identificacao = metadados.valoresCsv();
+
+    const auto arquivo = std::filesystem::temp_directory_path() / "analise_hash_teste_resultados.csv";
+    {
+        SaidaResultados saida;
+        saida.abrir(arquivo.string(), false);
+        saida.registrar(resultado);
+        resultado.identificacao.clear();
+        resultado.repeticao = 2;
+        saida.registrar(resultado);
+    }
+    SaidaResultados retomada;
+    retomada.abrir(arquivo.string(), true);
+    retomada.fechar();
+    const auto lidos = SaidaResultados::lerArquivo(arquivo.string());
+    VERIFICAR(retomada.getRetomados().size() == 2 && lidos.size() == 2,
+              "cenários retomados " << retomada.getRetomados().size() << ", lidos " << lidos.size());
+    VERIFICAR(lidos[0].identificacao == metadados.valoresCsv(), "metadados alterados: " << lidos[0].identificacao);
+    VERIFICAR(lidos[1].identificacao == MetadadosExecucao{}.valoresCsv(),
+              "metadados vazios alterados: " << lidos[1].identificacao);
+    std::filesystem::remove(arquivo);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    return executarCasos(argc, argv, {
+        {"motores", testarMotores},
+        {"aberta_limites", testarAbertaLimites},
+        {"redimensionavel", testarRedimensionavel},
+        {"kernels", testarKernels},
+        {"carregador", testarCarregador},
+        {"persistencia", testarPersistencia},
+        {"conjuntos", testarConjuntos},
+        {"juncao", testarJuncao},
+        {"deduplicacao", testarDeduplicacao},
+        {"compartilhada", testarCompartilhada},
+        {"servidor", testarServidor},
+        {"resultados", testarResultados},
+    });
+}